@@ -3,6 +3,10 @@
  * exp() and expf() are used to calculate the score for rate limiting.
  * expf() is used in the mainline path.
  * exp/expf are used to limit logging.
+ *
+ * The score and table cases time a score update as ntp_monitor() used
+ * to do it, with ldexpf() and expf(), and as it does now, from the
+ * decay tables.  The table code is copied from ntp_monitor.c.
  */
 
 #include <stdint.h>
@@ -17,6 +21,32 @@
 int NUM = 1000000;
 int STEPS = 1000;
 
+#define DECAY_TIME	20.0
+#define DECAY_SECS	256
+
+static float decay_sec[DECAY_SECS];
+static float decay_frac_hi[256];
+static float decay_frac_lo[256];
+
+static void decay_init(void) {
+    for (int i=0; i<DECAY_SECS; i++)
+        decay_sec[i] = (float)exp(-i / DECAY_TIME);
+    for (int i=0; i<256; i++) {
+        decay_frac_hi[i] = (float)exp(-(i / 256.0) / DECAY_TIME);
+        decay_frac_lo[i] = (float)exp(-(i / 65536.0) / DECAY_TIME);
+    }
+}
+
+static float decay(uint64_t interval) {
+    uint64_t t;
+
+    if (interval >= ((uint64_t)DECAY_SECS << 32) - 0x8000)
+        return expf(-ldexpf(interval, -32) / DECAY_TIME);
+    t = (interval + 0x8000) >> 16;
+    return decay_sec[t >> 16] * decay_frac_hi[(t >> 8) & 0xff] *
+           decay_frac_lo[t & 0xff];
+}
+
 /*******************************************************************/
 
 static void DoExp(void) {
@@ -53,6 +83,48 @@ static void DoExpf(void) {
     printf("expf: %8d    %.6f %.6f %.6f\n", (int)average, x, exp(0.0), exp(-1.0));
 }
 
+/* intervals from 1/64 s to about 16 s, as l_fp */
+#define INTERVAL(j)	((uint64_t)(j) << 26)
+
+static void DoScore(void) {
+    struct timespec start, stop;
+    double average;
+    float x = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i=0; i<NUM; i++) {
+       x = 0;
+       for (int j=0; j<STEPS; j++) {
+           x *= expf(-ldexpf(INTERVAL(j), -32) / DECAY_TIME);
+           x += 1.0 / DECAY_TIME;
+       }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    average = (stop.tv_sec-start.tv_sec)*1E9 + (stop.tv_nsec-start.tv_nsec);
+    average = average/NUM/STEPS;
+    printf("score:%8d    %.6f\n", (int)average, x);
+}
+
+static void DoTable(void) {
+    struct timespec start, stop;
+    double average;
+    float x = 0;
+
+    decay_init();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i=0; i<NUM; i++) {
+       x = 0;
+       for (int j=0; j<STEPS; j++) {
+           x *= decay(INTERVAL(j));
+           x += 1.0 / DECAY_TIME;
+       }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    average = (stop.tv_sec-start.tv_sec)*1E9 + (stop.tv_nsec-start.tv_nsec);
+    average = average/NUM/STEPS;
+    printf("table:%8d    %.6f\n", (int)average, x);
+}
+
 int main (int argc, char *argv[]) {
 
 	UNUSED_ARG(argc);
@@ -61,6 +133,8 @@ int main (int argc, char *argv[]) {
 	printf("         avg ns\n");
         DoExp();
         DoExpf();
+        DoScore();
+        DoTable();
 
 	return 0;
 }
@@ -0,0 +1,2 @@
+version = 0x2001900
+tools = [{'tool': 'asciidoc', 'tooldir': ['wafhelpers/'], 'funs': None}, {'tool': 'waf', 'tooldir': ['wafhelpers/'], 'funs': None}, {'tool': 'waf_unit_test', 'tooldir': None, 'funs': None}, {'tool': 'gnu_dirs', 'tooldir': None, 'funs': None}, {'tool': 'ar', 'tooldir': None, 'funs': None}, {'tool': 'c', 'tooldir': None, 'funs': None}, {'tool': 'gcc', 'tooldir': None, 'funs': None}, {'tool': 'compiler_c', 'tooldir': None, 'funs': None}, {'tool': 'bison', 'tooldir': None, 'funs': None}, {'tool': 'python', 'tooldir': None, 'funs': None}]
@@ -0,0 +1,75 @@
+AR = ['/usr/bin/ar']
+ARFLAGS = ['rcs']
+BINDIR = '/usr/local/bin'
+BIN_AWK = ['/usr/bin/awk']
+BIN_GIT = ['/usr/bin/git']
+BIN_LDCONFIG = ['/usr/sbin/ldconfig']
+BIN_SH = ['/usr/bin/sh']
+BISON = ['/usr/bin/bison']
+BISONFLAGS = ['-d']
+BUILD_DOC = False
+BUILD_MAN = False
+CC = ['/usr/bin/gcc']
+CCLNK_SRC_F = []
+CCLNK_TGT_F = ['-o']
+CC_NAME = 'gcc'
+CC_SRC_F = []
+CC_TGT_F = ['-c', '-o']
+CC_VERSION = ('12', '2', '0')
+CFLAGS = ['-std=c99', '-D_GNU_SOURCE']
+CFLAGS_MACBUNDLE = ['-fPIC']
+CFLAGS_cshlib = ['-fPIC']
+COMPILER_CC = 'gcc'
+CPPPATH_ST = '-I%s'
+DATADIR = '/usr/local/share'
+DATAROOTDIR = '/usr/local/share'
+DEFINES = ['NTPSEC_VERSION="1.2.3+"', 'NTPSEC_VERSION_EXTENDED="1.2.3+1b2fe3b-dirty"']
+DEFINES_ST = '-D%s'
+DEFINE_COMMENTS = {'NTPSEC_VERSION': '', 'NTPSEC_VERSION_EXTENDED': '', 'USEBACKTRACE': '', 'HAS_PIC': '', 'HAS_PIE': '', 'HAS_unused': '', 'HAS_w_cast_qual': '', 'HAS_w_disabled_optimization': '', 'HAS_w_float_equal': '', 'HAS_w_format': '', 'HAS_w_format_security': '', 'HAS_w_format_signedness': '', 'HAS_w_implicit_function_declaration': '', 'HAS_w_init_self': '', 'HAS_w_invalid_pch': '', 'HAS_w_missing_declarations': '', 'HAS_w_multichar': '', 'HAS_w_packed': '', 'HAS_w_pointer_arith': '', 'HAS_w_shadow': '', 'HAS_w_suggest_attribute_noreturn': '', 'HAS_w_write_strings': '', 'HAS_f_stack_protector_all': '', 'HAS_z_now': '', 'HAS_relro': '', 'HAVE_STRUCT_IF_LADDRCONF': '', 'HAVE_STRUCT_IF_LADDRREQ': '', 'HAVE_STRUCT_TIMEX': '', 'HAVE_STRUCT_NTPTIMEVAL': '', 'HAVE_STRUCT_TIMEX_TIME_TICK': '', 'HAVE_STRUCT_TIMEX_MODES': '', 'HAVE_STRUCT_NTPTIMEVAL_TIME_TV_NSEC': '', 'HAVE_STRUCT_NTPTIMEVAL_TAI': '', 'NTP_SIZEOF_LONG': '', 'NTP_SIZEOF_TIME_T': '', 'HAVE__UNWIND_BACKTRACE': '', 'HAVE_ADJTIMEX': '', 'HAVE_BACKTRACE_SYMBOLS_FD': '', 'HAVE_EPOLL_CREATE1': '', 'HAVE_NTP_ADJTIME': '', 'HAVE_NTP_GETTIME': '', 'HAVE_RECVMMSG': '', 'HAVE_RES_INIT': '', 'HAVE_SCHED_SETAFFINITY': '', 'HAVE_SENDMMSG': '', 'HAVE_STRLCPY': '', 'HAVE_STRLCAT': '', 'HAVE_TIMEGM': '', 'HAVE_PRIV_NTP_ADJTIME': '', 'HAVE_TIMER_CREATE': '', 'HAVE_CMAC_CTX_NEW': '', 'HAVE_EVP_PKEY_NEW_CMAC_KEY': '', 'HAVE_STDBOOL_H': '', 'HAVE_ALLOCA_H': '', 'HAVE_ARPA_NAMESER_H': '', 'HAVE_BSD_STRING_H': '', 'HAVE_IFADDRS_H': '', 'HAVE_LINUX_FILTER_H': '', 'HAVE_LINUX_ERRQUEUE_H': '', 'HAVE_LINUX_IF_ADDR_H': '', 'HAVE_LINUX_RTNETLINK_H': '', 'HAVE_LINUX_NET_TSTAMP_H': '', 'HAVE_LINUX_SERIAL_H': '', 'HAVE_LINUX_SOCK_DIAG_H': '', 'HAVE_NET_IF6_H': '', 'HAVE_NET_ROUTE_H': '', 'HAVE_OPENSSL_OPENSSLV_H': '', 'HAVE_PRIV_H': '', 'HAVE_STDATOMIC_H': '', 'HAVE_SYS_CLOCKCTL_H': '', 'HAVE_SYS_IOCTL_H': '', 'HAVE_SYS_MODEM_H': '', 'HAVE_SYS_SOCKIO_H': '', 'HAVE_SYS_SYSCTL_H': '', 'HAVE_TIMEPPS_H': '', 'HAVE_SYS_TIMEPPS_H': '', 'HAVE_SYS_TIMEX_H': '', 'ISC_PLATFORM_HAVESALEN': '', 'STRERROR_CHAR': '', 'HAVE_LIBSCF_H': '', 'HAVE_LINUX_IO_URING_H': '', 'ENABLE_DROPROOT': '', 'NEED_REUSEADDR_FOR_IFADDRBIND': '', 'DIR_SEP': '', 'HAVE_SYS_PRCTL_H': '', 'HAVE_SYS_CAPABILITY_H': '', 'HAVE_DNS_SD_H': '', 'ENABLE_CLASSIC_MODE': '', 'XXX_LIBSSL_VERSION': '', 'PYTHONDIR': '', 'PYTHONARCHDIR': '', 'HAVE_PYEXT': '', 'HAVE_PYTHON_H': ''}
+DEST_BINFMT = 'elf'
+DEST_CPU = 'x86_64'
+DEST_OS = 'linux'
+DOCDIR = '/usr/local/share/doc/ntpsec'
+DVIDIR = '/usr/local/share/doc/ntpsec'
+EXEC_PREFIX = '/usr/local'
+HTMLDIR = '/usr/local/share/doc/ntpsec'
+INCLUDEDIR = '/usr/local/include'
+INFODIR = '/usr/local/share/info'
+LIBDIR = '/usr/local/lib64'
+LIBEXECDIR = '/usr/local/libexec'
+LIBPATH_ST = '-L%s'
+LIB_ST = '-l%s'
+LINKFLAGS_MACBUNDLE = ['-bundle', '-undefined', 'dynamic_lookup']
+LINKFLAGS_cshlib = ['-shared']
+LINKFLAGS_cstlib = ['-Wl,-Bstatic']
+LINK_CC = ['/usr/bin/gcc']
+LOCALEDIR = '/usr/local/share/locale'
+LOCALSTATEDIR = '/usr/local/var'
+M4 = ['/usr/bin/m4']
+MANDIR = '/usr/local/share/man'
+NTPSEC_VERSION = '1.2.3+'
+NTPSEC_VERSION_EXTENDED = '1.2.3+1b2fe3b-dirty'
+OLDINCLUDEDIR = '/usr/include'
+OPT_STORE = {}
+PACKAGE = 'ntpsec'
+PDFDIR = '/usr/local/share/doc/ntpsec'
+PKGCONFIG = ['/usr/bin/pkg-config']
+PREFIX = '/usr/local'
+PSDIR = '/usr/local/share/doc/ntpsec'
+RPATH_ST = '-Wl,-rpath,%s'
+SBINDIR = '/usr/local/sbin'
+SHAREDSTATEDIR = '/usr/local/com'
+SHLIB_MARKER = '-Wl,-Bdynamic'
+SONAME_ST = '-Wl,-h,%s'
+STLIBPATH_ST = '-L%s'
+STLIB_MARKER = '-Wl,-Bstatic'
+STLIB_ST = '-l%s'
+SYSCONFDIR = '/usr/local/etc'
+SYSTEMD_systemdsystemunitdir = '/lib/systemd/system'
+cprogram_PATTERN = '%s'
+cshlib_PATTERN = 'lib%s.so'
+cstlib_PATTERN = 'lib%s.a'
+define_key = ['NTPSEC_VERSION', 'NTPSEC_VERSION_EXTENDED']
+macbundle_PATTERN = '%s.bundle'
+ntpc = 'ffi'
+ntpcver = '1.1.0'
@@ -0,0 +1,171 @@
+ = 1
+AR = ['/usr/bin/ar']
+ARFLAGS = ['rcs']
+BINDIR = '/usr/local/bin'
+BIN_AWK = ['/usr/bin/awk']
+BIN_GIT = ['/usr/bin/git']
+BIN_LDCONFIG = ['/usr/sbin/ldconfig']
+BIN_SH = ['/usr/bin/sh']
+BISON = ['/usr/bin/bison']
+BISONFLAGS = ['-d']
+BUILD_DOC = False
+BUILD_MAN = False
+CC = ['/usr/bin/gcc']
+CCLNK_SRC_F = []
+CCLNK_TGT_F = ['-o']
+CC_NAME = 'gcc'
+CC_SRC_F = []
+CC_TGT_F = ['-c', '-o']
+CC_VERSION = ('12', '2', '0')
+CFLAGS = ['-DUNITY_EXCLUDE_FLOAT_PRINT', '-Wshadow', '-Wpacked', '-Wcast-qual', '-Wmissing-declarations', '-Wdisabled-optimization', '-Wimplicit-function-declaration', '-Winvalid-pch', '-Wpointer-arith', '-Wwrite-strings', '-Winit-self', '-Wfloat-equal', '-Wformat', '-Wformat-signedness', '-Wformat-security', '-Wsuggest-attribute=noreturn', '-fPIC', '-O1', '-Wall', '-Wextra', '-Wmissing-prototypes', '-Wstrict-prototypes', '-Wundef', '-Wunused', '-g', '-std=c99', '-D_GNU_SOURCE']
+CFLAGS_MACBUNDLE = ['-fPIC']
+CFLAGS_PYEXT = ['-g', '-fwrapv', '-O3']
+CFLAGS_bin = ['-fPIE', '-pie', '-fPIC', '-O1', '-Wall', '-Wextra', '-Wmissing-prototypes', '-Wstrict-prototypes', '-Wundef', '-Wunused', '-g', '-std=c99', '-D_GNU_SOURCE']
+CFLAGS_cshlib = ['-fPIC']
+COMPILER_CC = 'gcc'
+CPPPATH_ST = '-I%s'
+CXXFLAGS_PYEXT = ['-g', '-fwrapv', '-O3']
+DATADIR = '/usr/local/share'
+DATAROOTDIR = '/usr/local/share'
+DEFINES = ['PYTHONDIR="/usr/local/lib/python3.11/site-packages"', 'PYTHONARCHDIR="/usr/local/lib/python3.11/site-packages"', 'HAVE_PYEXT=1', 'HAVE_PYTHON_H=1']
+DEFINES_PYEXT = ['NDEBUG']
+DEFINES_ST = '-D%s'
+DEFINE_COMMENTS = {'NTPSEC_VERSION': '', 'NTPSEC_VERSION_EXTENDED': '', 'USEBACKTRACE': '', 'HAS_PIC': '', 'HAS_PIE': '', 'HAS_unused': '', 'HAS_w_cast_qual': '', 'HAS_w_disabled_optimization': '', 'HAS_w_float_equal': '', 'HAS_w_format': '', 'HAS_w_format_security': '', 'HAS_w_format_signedness': '', 'HAS_w_implicit_function_declaration': '', 'HAS_w_init_self': '', 'HAS_w_invalid_pch': '', 'HAS_w_missing_declarations': '', 'HAS_w_multichar': '', 'HAS_w_packed': '', 'HAS_w_pointer_arith': '', 'HAS_w_shadow': '', 'HAS_w_suggest_attribute_noreturn': '', 'HAS_w_write_strings': '', 'HAS_f_stack_protector_all': '', 'HAS_z_now': '', 'HAS_relro': '', 'HAVE_STRUCT_IF_LADDRCONF': '', 'HAVE_STRUCT_IF_LADDRREQ': '', 'HAVE_STRUCT_TIMEX': '', 'HAVE_STRUCT_NTPTIMEVAL': '', 'HAVE_STRUCT_TIMEX_TIME_TICK': '', 'HAVE_STRUCT_TIMEX_MODES': '', 'HAVE_STRUCT_NTPTIMEVAL_TIME_TV_NSEC': '', 'HAVE_STRUCT_NTPTIMEVAL_TAI': '', 'NTP_SIZEOF_LONG': '', 'NTP_SIZEOF_TIME_T': '', 'HAVE__UNWIND_BACKTRACE': '', 'HAVE_ADJTIMEX': '', 'HAVE_BACKTRACE_SYMBOLS_FD': '', 'HAVE_EPOLL_CREATE1': '', 'HAVE_NTP_ADJTIME': '', 'HAVE_NTP_GETTIME': '', 'HAVE_RECVMMSG': '', 'HAVE_RES_INIT': '', 'HAVE_SCHED_SETAFFINITY': '', 'HAVE_SENDMMSG': '', 'HAVE_STRLCPY': '', 'HAVE_STRLCAT': '', 'HAVE_TIMEGM': '', 'HAVE_PRIV_NTP_ADJTIME': '', 'HAVE_TIMER_CREATE': '', 'HAVE_CMAC_CTX_NEW': '', 'HAVE_EVP_PKEY_NEW_CMAC_KEY': '', 'HAVE_STDBOOL_H': '', 'HAVE_ALLOCA_H': '', 'HAVE_ARPA_NAMESER_H': '', 'HAVE_BSD_STRING_H': '', 'HAVE_IFADDRS_H': '', 'HAVE_LINUX_FILTER_H': '', 'HAVE_LINUX_ERRQUEUE_H': '', 'HAVE_LINUX_IF_ADDR_H': '', 'HAVE_LINUX_RTNETLINK_H': '', 'HAVE_LINUX_NET_TSTAMP_H': '', 'HAVE_LINUX_SERIAL_H': '', 'HAVE_LINUX_SOCK_DIAG_H': '', 'HAVE_NET_IF6_H': '', 'HAVE_NET_ROUTE_H': '', 'HAVE_OPENSSL_OPENSSLV_H': '', 'HAVE_PRIV_H': '', 'HAVE_STDATOMIC_H': '', 'HAVE_SYS_CLOCKCTL_H': '', 'HAVE_SYS_IOCTL_H': '', 'HAVE_SYS_MODEM_H': '', 'HAVE_SYS_SOCKIO_H': '', 'HAVE_SYS_SYSCTL_H': '', 'HAVE_TIMEPPS_H': '', 'HAVE_SYS_TIMEPPS_H': '', 'HAVE_SYS_TIMEX_H': '', 'ISC_PLATFORM_HAVESALEN': '', 'STRERROR_CHAR': '', 'HAVE_LIBSCF_H': '', 'HAVE_LINUX_IO_URING_H': '', 'ENABLE_DROPROOT': '', 'NEED_REUSEADDR_FOR_IFADDRBIND': '', 'DIR_SEP': '', 'HAVE_SYS_PRCTL_H': '', 'HAVE_SYS_CAPABILITY_H': '', 'HAVE_DNS_SD_H': '', 'ENABLE_CLASSIC_MODE': '', 'XXX_LIBSSL_VERSION': '', 'PYTHONDIR': '', 'PYTHONARCHDIR': '', 'HAVE_PYEXT': '', 'HAVE_PYTHON_H': ''}
+DEST_BINFMT = 'elf'
+DEST_CPU = 'x86_64'
+DEST_OS = 'linux'
+DOCDIR = '/usr/local/share/doc/ntpsec'
+DVIDIR = '/usr/local/share/doc/ntpsec'
+EXEC_PREFIX = '/usr/local'
+HAS_PIC = 1
+HAS_PIE = 1
+HAS_f_stack_protector_all = 1
+HAS_relro = 1
+HAS_w_cast_qual = 1
+HAS_w_disabled_optimization = 1
+HAS_w_float_equal = 1
+HAS_w_format = 1
+HAS_w_format_security = 1
+HAS_w_format_signedness = 1
+HAS_w_implicit_function_declaration = 1
+HAS_w_init_self = 1
+HAS_w_invalid_pch = 1
+HAS_w_missing_declarations = 1
+HAS_w_multichar = 1
+HAS_w_packed = 1
+HAS_w_pointer_arith = 1
+HAS_w_shadow = 1
+HAS_w_suggest_attribute_noreturn = 1
+HAS_w_write_strings = 1
+HAS_z_now = 1
+HAVE_ADJTIMEX = 1
+HAVE_ALLOCA_H = 1
+HAVE_ARPA_NAMESER_H = 1
+HAVE_BACKTRACE_SYMBOLS_FD = 1
+HAVE_CMAC_CTX_NEW = 1
+HAVE_EPOLL_CREATE1 = 1
+HAVE_EVP_PKEY_NEW_CMAC_KEY = 1
+HAVE_IFADDRS_H = 1
+HAVE_LINUX_ERRQUEUE_H = 1
+HAVE_LINUX_FILTER_H = 1
+HAVE_LINUX_IF_ADDR_H = 1
+HAVE_LINUX_IO_URING_H = 1
+HAVE_LINUX_NET_TSTAMP_H = 1
+HAVE_LINUX_RTNETLINK_H = 1
+HAVE_LINUX_SERIAL_H = 1
+HAVE_LINUX_SOCK_DIAG_H = 1
+HAVE_NET_ROUTE_H = 1
+HAVE_NTP_ADJTIME = 1
+HAVE_NTP_GETTIME = 1
+HAVE_OPENSSL_OPENSSLV_H = 1
+HAVE_PYEXT = 1
+HAVE_PYTHON_H = 1
+HAVE_RECVMMSG = 1
+HAVE_RES_INIT = 1
+HAVE_SCHED_SETAFFINITY = 1
+HAVE_SENDMMSG = 1
+HAVE_STDATOMIC_H = 1
+HAVE_STDBOOL_H = 1
+HAVE_STRUCT_NTPTIMEVAL = 1
+HAVE_STRUCT_NTPTIMEVAL_TAI = 1
+HAVE_STRUCT_TIMEX = 1
+HAVE_STRUCT_TIMEX_MODES = 1
+HAVE_SYS_IOCTL_H = 1
+HAVE_SYS_PRCTL_H = 1
+HAVE_SYS_TIMEX_H = 1
+HAVE_TIMEGM = 1
+HAVE_TIMER_CREATE = 1
+HAVE__UNWIND_BACKTRACE = 1
+HEADER_SYS_TIMEX_H = True
+HTMLDIR = '/usr/local/share/doc/ntpsec'
+INCLUDEDIR = '/usr/local/include'
+INCLUDES_PYEXT = ['/root/.pyenv/versions/3.11.7/include/python3.11']
+INFODIR = '/usr/local/share/info'
+LDFLAGS = ['-lssp_nonshared', '-fstack-protector-all', '-Wl,-z,now', '-Wl,-z,relro']
+LIBDIR = '/usr/local/lib64'
+LIBEXECDIR = '/usr/local/libexec'
+LIBPATH_PYEXT = ['/root/.pyenv/versions/3.11.7/lib']
+LIBPATH_ST = '-L%s'
+LIB_CRYPTO = ['crypto']
+LIB_M = ['m']
+LIB_PTHREAD = ['pthread']
+LIB_PYEXT = ['dl', 'm', 'dl', 'm']
+LIB_RT = ['rt']
+LIB_SSL = ['ssl']
+LIB_SSP_NONSHARED = ['ssp_nonshared']
+LIB_ST = '-l%s'
+LINKFLAGS_MACBUNDLE = ['-bundle', '-undefined', 'dynamic_lookup']
+LINKFLAGS_NTPD = ['-pie']
+LINKFLAGS_cshlib = ['-shared']
+LINKFLAGS_cstlib = ['-Wl,-Bstatic']
+LINK_CC = ['/usr/bin/gcc']
+LOCALEDIR = '/usr/local/share/locale'
+LOCALSTATEDIR = '/usr/local/var'
+M4 = ['/usr/bin/m4']
+MANDIR = '/usr/local/share/man'
+NTPSEC_VERSION = '1.2.3+'
+NTPSEC_VERSION_EXTENDED = '1.2.3+1b2fe3b-dirty'
+NTP_SIZEOF_LONG = '8'
+NTP_SIZEOF_TIME_T = '8'
+OLDINCLUDEDIR = '/usr/include'
+OPT_STORE = {}
+PACKAGE = 'ntpsec'
+PDFDIR = '/usr/local/share/doc/ntpsec'
+PKGCONFIG = ['/usr/bin/pkg-config']
+PREFIX = '/usr/local'
+PSDIR = '/usr/local/share/doc/ntpsec'
+PYC = 1
+PYFLAGS = ''
+PYFLAGS_OPT = '-O'
+PYO = 1
+PYSHEBANG = '/usr/bin/env python'
+PYTAG = 'cpython-311'
+PYTHON = ['/root/.pyenv/versions/3.11.7/bin/python']
+PYTHONARCHDIR = '/usr/local/lib/python3.11/site-packages'
+PYTHONDIR = '/usr/local/lib/python3.11/site-packages'
+PYTHON_ARGPARSE = True
+PYTHON_CONFIG = ['/root/.pyenv/versions/3.11.7/bin/python-config']
+PYTHON_CURSES = True
+PYTHON_VERSION = '3.11'
+RPATH_PYEXT = ['/root/.pyenv/versions/3.11.7/lib', '/root/.pyenv/versions/3.11.7/lib']
+RPATH_ST = '-Wl,-rpath,%s'
+SBINDIR = '/usr/local/sbin'
+SHAREDSTATEDIR = '/usr/local/com'
+SHLIB_MARKER = '-Wl,-Bdynamic'
+SONAME_ST = '-Wl,-h,%s'
+STLIBPATH_ST = '-L%s'
+STLIB_MARKER = '-Wl,-Bstatic'
+STLIB_ST = '-l%s'
+STRERROR_CHAR = 1
+SYSCONFDIR = '/usr/local/etc'
+SYSTEMD_systemdsystemunitdir = '/lib/systemd/system'
+XXX_LIBSSL_VERSION = 'OpenSSL 3.0.17 1 Jul 2025\n'
+cfg_files = ['/root/repo/build/config.h']
+cprogram_PATTERN = '%s'
+cshlib_PATTERN = 'lib%s.so'
+cstlib_PATTERN = 'lib%s.a'
+define_key = ['PYTHONDIR', 'PYTHONARCHDIR', 'HAVE_PYEXT', 'HAVE_PYTHON_H']
+macbundle_PATTERN = '%s.bundle'
+ntpc = 'ffi'
+ntpcver = '1.1.0'
+pyext_PATTERN = '%s.cpython-311-x86_64-linux-gnu.so'
@@ -0,0 +1,96 @@
+/* WARNING! All changes made to this file will be lost! */
+
+#ifndef W_CONFIG_H_WAF
+#define W_CONFIG_H_WAF
+
+#define NTPSEC_VERSION "1.2.3+"
+#define NTPSEC_VERSION_EXTENDED "1.2.3+1b2fe3b-dirty"
+#define USEBACKTRACE 1
+#define HAS_PIC 1
+#define HAS_PIE 1
+/* #undef HAS_unused */
+#define HAS_w_cast_qual 1
+#define HAS_w_disabled_optimization 1
+#define HAS_w_float_equal 1
+#define HAS_w_format 1
+#define HAS_w_format_security 1
+#define HAS_w_format_signedness 1
+#define HAS_w_implicit_function_declaration 1
+#define HAS_w_init_self 1
+#define HAS_w_invalid_pch 1
+#define HAS_w_missing_declarations 1
+#define HAS_w_multichar 1
+#define HAS_w_packed 1
+#define HAS_w_pointer_arith 1
+#define HAS_w_shadow 1
+#define HAS_w_suggest_attribute_noreturn 1
+#define HAS_w_write_strings 1
+#define HAS_f_stack_protector_all 1
+#define HAS_z_now 1
+#define HAS_relro 1
+/* #undef HAVE_STRUCT_IF_LADDRCONF */
+/* #undef HAVE_STRUCT_IF_LADDRREQ */
+#define HAVE_STRUCT_TIMEX 1
+#define HAVE_STRUCT_NTPTIMEVAL 1
+/* #undef HAVE_STRUCT_TIMEX_TIME_TICK */
+#define HAVE_STRUCT_TIMEX_MODES 1
+/* #undef HAVE_STRUCT_NTPTIMEVAL_TIME_TV_NSEC */
+#define HAVE_STRUCT_NTPTIMEVAL_TAI 1
+#define NTP_SIZEOF_LONG 8 /* Size of long from <None> */
+#define NTP_SIZEOF_TIME_T 8 /* Size of time_t from <time.h> */
+#define HAVE__UNWIND_BACKTRACE 1 /* Whether _Unwind_Backtrace() exists */
+#define HAVE_ADJTIMEX 1 /* Whether adjtimex() exists */
+#define HAVE_BACKTRACE_SYMBOLS_FD 1 /* Whether backtrace_symbols_fd() exists */
+#define HAVE_EPOLL_CREATE1 1 /* Whether epoll_create1() exists */
+#define HAVE_NTP_ADJTIME 1 /* Whether ntp_adjtime() exists */
+#define HAVE_NTP_GETTIME 1 /* Whether ntp_gettime() exists */
+#define HAVE_RECVMMSG 1 /* Whether recvmmsg() exists */
+#define HAVE_RES_INIT 1 /* Whether res_init() exists */
+#define HAVE_SCHED_SETAFFINITY 1 /* Whether sched_setaffinity() exists */
+#define HAVE_SENDMMSG 1 /* Whether sendmmsg() exists */
+/* #undef HAVE_STRLCPY */
+/* #undef HAVE_STRLCAT */
+#define HAVE_TIMEGM 1 /* Whether timegm() exists */
+/* #undef HAVE_PRIV_NTP_ADJTIME */
+#define HAVE_TIMER_CREATE 1 /* Whether timer_create() exists */
+#define HAVE_CMAC_CTX_NEW 1 /* Whether CMAC_CTX_new() exists */
+#define HAVE_EVP_PKEY_NEW_CMAC_KEY 1 /* Whether EVP_PKEY_new_CMAC_key() exists */
+#define HAVE_STDBOOL_H 1 /* Sanity check. */
+#define HAVE_ALLOCA_H 1 /* <alloca.h> header */
+#define HAVE_ARPA_NAMESER_H 1 /* <arpa/nameser.h> header */
+/* #undef HAVE_BSD_STRING_H */
+#define HAVE_IFADDRS_H 1 /* <ifaddrs.h> header */
+#define HAVE_LINUX_FILTER_H 1 /* <linux/filter.h> header */
+#define HAVE_LINUX_ERRQUEUE_H 1 /* <linux/errqueue.h> header */
+#define HAVE_LINUX_IF_ADDR_H 1 /* <linux/if_addr.h> header */
+#define HAVE_LINUX_RTNETLINK_H 1 /* <linux/rtnetlink.h> header */
+#define HAVE_LINUX_NET_TSTAMP_H 1 /* <linux/net_tstamp.h> header */
+#define HAVE_LINUX_SERIAL_H 1 /* <linux/serial.h> header */
+#define HAVE_LINUX_SOCK_DIAG_H 1 /* <linux/sock_diag.h> header */
+/* #undef HAVE_NET_IF6_H */
+#define HAVE_NET_ROUTE_H 1 /* <net/route.h> header */
+#define HAVE_OPENSSL_OPENSSLV_H 1 /* <openssl/opensslv.h> header */
+/* #undef HAVE_PRIV_H */
+#define HAVE_STDATOMIC_H 1 /* <stdatomic.h> header */
+/* #undef HAVE_SYS_CLOCKCTL_H */
+#define HAVE_SYS_IOCTL_H 1 /* <sys/ioctl.h> header */
+/* #undef HAVE_SYS_MODEM_H */
+/* #undef HAVE_SYS_SOCKIO_H */
+/* #undef HAVE_SYS_SYSCTL_H */
+/* #undef HAVE_TIMEPPS_H */
+/* #undef HAVE_SYS_TIMEPPS_H */
+#define HAVE_SYS_TIMEX_H 1 /* <sys/timex.h> header */
+/* #undef ISC_PLATFORM_HAVESALEN */
+#define STRERROR_CHAR 1 /* Whether strerror_r returns char* */
+/* #undef HAVE_LIBSCF_H */
+#define HAVE_LINUX_IO_URING_H 1 /* <linux/io_uring.h> header */
+#define ENABLE_DROPROOT 1 /* Drop root after initialising */
+#define NEED_REUSEADDR_FOR_IFADDRBIND 1 /* Whether SO_REUSEADDR is needed to open same sockets on alternate interfaces, required by Linux at least */
+#define DIR_SEP '/' /* Directory separator used */
+#define HAVE_SYS_PRCTL_H 1
+/* #undef HAVE_SYS_CAPABILITY_H */
+/* #undef HAVE_DNS_SD_H */
+/* #undef ENABLE_CLASSIC_MODE */
+/* #undef XXX_LIBSSL_VERSION */
+
+#endif /* W_CONFIG_H_WAF */
@@ -0,0 +1,1040 @@
+/*
+ * ntp_keyword.h
+ * 
+ * NOTE: edit this file with caution, it is generated by keyword-gen.c
+ *	 Generated 2026-10-16 18:35:54 UTC	  diff_ignore_line
+ *
+ */
+#include "ntp_scanner.h"
+#include "ntp_parser.tab.h"
+
+#define LOWEST_KEYWORD_ID 258
+
+const char * const keyword_text[196] = {
+	/* 0       258                  258 */	"aead",
+	/* 1       259                  259 */	"age",
+	/* 2       260                  260 */	"all",
+	/* 3       261                  261 */	"allan",
+	/* 4       262                  262 */	"allpeers",
+	/* 5       263                  263 */	NULL,
+	/* 6       264                  264 */	"auth",
+	/* 7       265                  265 */	"average",
+	/* 8       266                  266 */	"baud",
+	/* 9       267                  267 */	"bias",
+	/* 10      268                  268 */	"burst",
+	/* 11      269                  269 */	"busypoll",
+	/* 12      270                  270 */	"calibrate",
+	/* 13      271                  271 */	"ca",
+	/* 14      272                  272 */	"ceiling",
+	/* 15      273                  273 */	"cert",
+	/* 16      274                  274 */	"clock",
+	/* 17      275                  275 */	"clockstats",
+	/* 18      276                  276 */	NULL,
+	/* 19      277                  277 */	"cookie",
+	/* 20      278                  278 */	"controlkey",
+	/* 21      279                  279 */	"ctl",
+	/* 22      280                  280 */	"day",
+	/* 23      281                  281 */	"default",
+	/* 24      282                  282 */	"disable",
+	/* 25      283                  283 */	"dispersion",
+	/* 26      284                  284 */	NULL,
+	/* 27      285                  285 */	"driftfile",
+	/* 28      286                  286 */	"drop",
+	/* 29      287                  287 */	"dscp",
+	/* 30      288                  288 */	NULL,
+	/* 31      289                  289 */	"extra",
+	/* 32      290                  290 */	"...",
+	/* 33      291                  291 */	"enable",
+	/* 34      292                  292 */	"end",
+	/* 35      293                  293 */	NULL,
+	/* 36      294                  294 */	"file",
+	/* 37      295                  295 */	"filegen",
+	/* 38      296                  296 */	"filenum",
+	/* 39      297                  297 */	"flag1",
+	/* 40      298                  298 */	"flag2",
+	/* 41      299                  299 */	"flag3",
+	/* 42      300                  300 */	"flag4",
+	/* 43      301                  301 */	"flake",
+	/* 44      302                  302 */	"floor",
+	/* 45      303                  303 */	"freq",
+	/* 46      304                  304 */	"fudge",
+	/* 47      305                  305 */	"huffpuff",
+	/* 48      306                  306 */	"iburst",
+	/* 49      307                  307 */	"ifdeltas",
+	/* 50      308                  308 */	"ignore",
+	/* 51      309                  309 */	"incalloc",
+	/* 52      310                  310 */	"incmem",
+	/* 53      311                  311 */	"initalloc",
+	/* 54      312                  312 */	"initmem",
+	/* 55      313                  313 */	"includefile",
+	/* 56      314                  314 */	NULL,
+	/* 57      315                  315 */	"interface",
+	/* 58      316                  316 */	NULL,
+	/* 59      317                  317 */	"io",
+	/* 60      318                  318 */	"iocpu",
+	/* 61      319                  319 */	"ipv4",
+	/* 62      320                  320 */	"-4",
+	/* 63      321                  321 */	"ipv6",
+	/* 64      322                  322 */	"-6",
+	/* 65      323                  323 */	"kelimit",
+	/* 66      324                  324 */	"kernel",
+	/* 67      325                  325 */	"ketimeout",
+	/* 68      326                  326 */	"keworkers",
+	/* 69      327                  327 */	"key",
+	/* 70      328                  328 */	"keys",
+	/* 71      329                  329 */	"kod",
+	/* 72      330                  330 */	"mssntp",
+	/* 73      331                  331 */	"leapfile",
+	/* 74      332                  332 */	"leapsmearinterval",
+	/* 75      333                  333 */	"limit",
+	/* 76      334                  334 */	"limited",
+	/* 77      335                  335 */	"link",
+	/* 78      336                  336 */	"listen",
+	/* 79      337                  337 */	"logconfig",
+	/* 80      338                  338 */	"logfile",
+	/* 81      339                  339 */	"loopstats",
+	/* 82      340                  340 */	"mask",
+	/* 83      341                  341 */	"maxage",
+	/* 84      342                  342 */	"maxclock",
+	/* 85      343                  343 */	"maxdepth",
+	/* 86      344                  344 */	"maxdisp",
+	/* 87      345                  345 */	"maxdist",
+	/* 88      346                  346 */	"maxmem",
+	/* 89      347                  347 */	"maxpoll",
+	/* 90      348                  348 */	"maxtls",
+	/* 91      349                  349 */	"mdnstries",
+	/* 92      350                  350 */	"mem",
+	/* 93      351                  351 */	"memlock",
+	/* 94      352                  352 */	"minage",
+	/* 95      353                  353 */	"minclock",
+	/* 96      354                  354 */	"mindepth",
+	/* 97      355                  355 */	"mindist",
+	/* 98      356                  356 */	"minpoll",
+	/* 99      357                  357 */	"minsane",
+	/* 100     358                  358 */	"mintls",
+	/* 101     359                  359 */	"mode",
+	/* 102     360                  360 */	"monitor",
+	/* 103     361                  361 */	"month",
+	/* 104     362                  362 */	"mru",
+	/* 105     363                  363 */	"nic",
+	/* 106     364                  364 */	"nolink",
+	/* 107     365                  365 */	"nomodify",
+	/* 108     366                  366 */	"nomrulist",
+	/* 109     367                  367 */	"none",
+	/* 110     368                  368 */	"nonvolatile",
+	/* 111     369                  369 */	"nopeer",
+	/* 112     370                  370 */	"noquery",
+	/* 113     371                  371 */	"noselect",
+	/* 114     372                  372 */	"noserve",
+	/* 115     373                  373 */	"notrap",
+	/* 116     374                  374 */	"notrust",
+	/* 117     375                  375 */	"noval",
+	/* 118     376                  376 */	"ntp",
+	/* 119     377                  377 */	"ntpport",
+	/* 120     378                  378 */	"ntpsigndsocket",
+	/* 121     379                  379 */	"nts",
+	/* 122     380                  380 */	"ntsstats",
+	/* 123     381                  381 */	"ntskestats",
+	/* 124     382                  382 */	"orphan",
+	/* 125     383                  383 */	"orphanwait",
+	/* 126     384                  384 */	"panic",
+	/* 127     385                  385 */	"path",
+	/* 128     386                  386 */	"peer",
+	/* 129     387                  387 */	"peerstats",
+	/* 130     388                  388 */	"phone",
+	/* 131     389                  389 */	"pid",
+	/* 132     390                  390 */	"pidfile",
+	/* 133     391                  391 */	"pool",
+	/* 134     392                  392 */	"port",
+	/* 135     393                  393 */	"ppspath",
+	/* 136     394                  394 */	"prefer",
+	/* 137     395                  395 */	"prefixaverage",
+	/* 138     396                  396 */	"prefixkod",
+	/* 139     397                  397 */	"prefixv4",
+	/* 140     398                  398 */	"prefixv6",
+	/* 141     399                  399 */	"protostats",
+	/* 142     400                  400 */	"rawstats",
+	/* 143     401                  401 */	"refclock",
+	/* 144     402                  402 */	"refid",
+	/* 145     403                  403 */	"requestkey",
+	/* 146     404                  404 */	NULL,
+	/* 147     405                  405 */	"recvbatch",
+	/* 148     406                  406 */	"reset",
+	/* 149     407                  407 */	"restrict",
+	/* 150     408                  408 */	"rlimit",
+	/* 151     409                  409 */	NULL,
+	/* 152     410                  410 */	"server",
+	/* 153     411                  411 */	"setvar",
+	/* 154     412                  412 */	"source",
+	/* 155     413                  413 */	"stacksize",
+	/* 156     414                  414 */	"stagestats",
+	/* 157     415                  415 */	"stagetime",
+	/* 158     416                  416 */	"statistics",
+	/* 159     417                  417 */	"stats",
+	/* 160     418                  418 */	"statsdir",
+	/* 161     419                  419 */	"step",
+	/* 162     420                  420 */	"stepback",
+	/* 163     421                  421 */	"stepfwd",
+	/* 164     422                  422 */	"stepout",
+	/* 165     423                  423 */	"stratum",
+	/* 166     424                  424 */	"subtype",
+	/* 167     425                  425 */	NULL,
+	/* 168     426                  426 */	"sys",
+	/* 169     427                  427 */	"sysstats",
+	/* 170     428                  428 */	"tick",
+	/* 171     429                  429 */	"time1",
+	/* 172     430                  430 */	"time2",
+	/* 173     431                  431 */	"timer",
+	/* 174     432                  432 */	"tinker",
+	/* 175     433                  433 */	"tlsciphersuites",
+	/* 176     434                  434 */	"tlsecdhcurves",
+	/* 177     435                  435 */	"tlscipherserverpreference",
+	/* 178     436                  436 */	"tos",
+	/* 179     437                  437 */	"true",
+	/* 180     438                  438 */	"trustedkey",
+	/* 181     439                  439 */	"txstamps",
+	/* 182     440                  440 */	"type",
+	/* 183     441                  441 */	NULL,
+	/* 184     442                  442 */	"unit",
+	/* 185     443                  443 */	"unconfig",
+	/* 186     444                  444 */	"unpeer",
+	/* 187     445                  445 */	"unrestrict",
+	/* 188     446                  446 */	"uring",
+	/* 189     447                  447 */	"usestats",
+	/* 190     448                  448 */	"version",
+	/* 191     449                  449 */	NULL,
+	/* 192     450                  450 */	"week",
+	/* 193     451                  451 */	"wildcard",
+	/* 194     452                  452 */	"workers",
+	/* 195     453                  453 */	"year"
+};
+
+#define SCANNER_INIT_S 820
+
+const scan_state sst[823] = {
+/*SS_T( ch,	f-by, match, other ),				 */
+  0,				      /*     0                   */
+  S_ST( '-',	3,      322,     0 ), /*     1                   */
+  S_ST( '.',	3,        3,     1 ), /*     2                   */
+  S_ST( '.',	3,      290,     0 ), /*     3 .                 */
+  S_ST( 'a',	3,       16,     2 ), /*     4                   */
+  S_ST( 'e',	3,        6,     0 ), /*     5 a                 */
+  S_ST( 'a',	3,      258,     0 ), /*     6 ae                */
+  S_ST( 'g',	3,      259,     5 ), /*     7 a                 */
+  S_ST( 'l',	3,      260,     7 ), /*     8 a                 */
+  S_ST( 'a',	3,      261,     0 ), /*     9 all               */
+  S_ST( 'p',	3,       11,     9 ), /*    10 all               */
+  S_ST( 'e',	3,       12,     0 ), /*    11 allp              */
+  S_ST( 'e',	3,       13,     0 ), /*    12 allpe             */
+  S_ST( 'r',	3,      262,     0 ), /*    13 allpee            */
+  S_ST( 'u',	3,       15,     8 ), /*    14 a                 */
+  S_ST( 't',	3,      264,     0 ), /*    15 au                */
+  S_ST( 'v',	3,       17,    14 ), /*    16 a                 */
+  S_ST( 'e',	3,       18,     0 ), /*    17 av                */
+  S_ST( 'r',	3,       19,     0 ), /*    18 ave               */
+  S_ST( 'a',	3,       20,     0 ), /*    19 aver              */
+  S_ST( 'g',	3,      265,     0 ), /*    20 avera             */
+  S_ST( 'b',	3,       26,     4 ), /*    21                   */
+  S_ST( 'a',	3,       23,     0 ), /*    22 b                 */
+  S_ST( 'u',	3,      266,     0 ), /*    23 ba                */
+  S_ST( 'i',	3,       25,    22 ), /*    24 b                 */
+  S_ST( 'a',	3,      267,     0 ), /*    25 bi                */
+  S_ST( 'u',	3,       29,    24 ), /*    26 b                 */
+  S_ST( 'r',	3,       28,     0 ), /*    27 bu                */
+  S_ST( 's',	3,      268,     0 ), /*    28 bur               */
+  S_ST( 's',	3,       30,    27 ), /*    29 bu                */
+  S_ST( 'y',	3,       31,     0 ), /*    30 bus               */
+  S_ST( 'p',	3,       32,     0 ), /*    31 busy              */
+  S_ST( 'o',	3,       33,     0 ), /*    32 busyp             */
+  S_ST( 'l',	3,      269,     0 ), /*    33 busypo            */
+  S_ST( 'c',	3,       65,    21 ), /*    34                   */
+  S_ST( 'l',	3,       36,     0 ), /*    35 ca                */
+  S_ST( 'i',	3,       37,     0 ), /*    36 cal               */
+  S_ST( 'b',	3,       38,     0 ), /*    37 cali              */
+  S_ST( 'r',	3,       39,     0 ), /*    38 calib             */
+  S_ST( 'a',	3,       40,     0 ), /*    39 calibr            */
+  S_ST( 't',	3,      270,     0 ), /*    40 calibra           */
+  S_ST( 'e',	3,       46,   271 ), /*    41 c                 */
+  S_ST( 'i',	3,       43,     0 ), /*    42 ce                */
+  S_ST( 'l',	3,       44,     0 ), /*    43 cei               */
+  S_ST( 'i',	3,       45,     0 ), /*    44 ceil              */
+  S_ST( 'n',	3,      272,     0 ), /*    45 ceili             */
+  S_ST( 'r',	3,      273,    42 ), /*    46 ce                */
+  S_ST( 'l',	3,       48,    41 ), /*    47 c                 */
+  S_ST( 'o',	3,       49,     0 ), /*    48 cl                */
+  S_ST( 'c',	3,      274,     0 ), /*    49 clo               */
+  S_ST( 's',	3,       51,     0 ), /*    50 clock             */
+  S_ST( 't',	3,       52,     0 ), /*    51 clocks            */
+  S_ST( 'a',	3,       53,     0 ), /*    52 clockst           */
+  S_ST( 't',	3,      275,     0 ), /*    53 clocksta          */
+  S_ST( 'o',	3,       62,    47 ), /*    54 c                 */
+  S_ST( 'n',	3,       56,     0 ), /*    55 co                */
+  S_ST( 't',	3,       57,     0 ), /*    56 con               */
+  S_ST( 'r',	3,       58,     0 ), /*    57 cont              */
+  S_ST( 'o',	3,       59,     0 ), /*    58 contr             */
+  S_ST( 'l',	3,       60,     0 ), /*    59 contro            */
+  S_ST( 'k',	3,       61,     0 ), /*    60 control           */
+  S_ST( 'e',	3,      278,     0 ), /*    61 controlk          */
+  S_ST( 'o',	3,       63,    55 ), /*    62 co                */
+  S_ST( 'k',	3,       64,     0 ), /*    63 coo               */
+  S_ST( 'i',	3,      277,     0 ), /*    64 cook              */
+  S_ST( 't',	3,      279,    54 ), /*    65 c                 */
+  S_ST( 'd',	3,       92,    34 ), /*    66                   */
+  S_ST( 'a',	3,      280,     0 ), /*    67 d                 */
+  S_ST( 'e',	3,       69,    67 ), /*    68 d                 */
+  S_ST( 'f',	3,       70,     0 ), /*    69 de                */
+  S_ST( 'a',	3,       71,     0 ), /*    70 def               */
+  S_ST( 'u',	3,       72,     0 ), /*    71 defa              */
+  S_ST( 'l',	3,      281,     0 ), /*    72 defau             */
+  S_ST( 'i',	3,       74,    68 ), /*    73 d                 */
+  S_ST( 's',	3,       78,     0 ), /*    74 di                */
+  S_ST( 'a',	3,       76,     0 ), /*    75 dis               */
+  S_ST( 'b',	3,       77,     0 ), /*    76 disa              */
+  S_ST( 'l',	3,      282,     0 ), /*    77 disab             */
+  S_ST( 'p',	3,       79,    75 ), /*    78 dis               */
+  S_ST( 'e',	3,       80,     0 ), /*    79 disp              */
+  S_ST( 'r',	3,       81,     0 ), /*    80 dispe             */
+  S_ST( 's',	3,       82,     0 ), /*    81 disper            */
+  S_ST( 'i',	3,       83,     0 ), /*    82 dispers           */
+  S_ST( 'o',	3,      283,     0 ), /*    83 dispersi          */
+  S_ST( 'r',	3,       91,    73 ), /*    84 d                 */
+  S_ST( 'i',	3,       86,     0 ), /*    85 dr                */
+  S_ST( 'f',	3,       87,     0 ), /*    86 dri               */
+  S_ST( 't',	3,       88,     0 ), /*    87 drif              */
+  S_ST( 'f',	3,       89,     0 ), /*    88 drift             */
+  S_ST( 'i',	3,       90,     0 ), /*    89 driftf            */
+  S_ST( 'l',	3,      285,     0 ), /*    90 driftfi           */
+  S_ST( 'o',	3,      286,    85 ), /*    91 dr                */
+  S_ST( 's',	3,       93,    84 ), /*    92 d                 */
+  S_ST( 'c',	3,      287,     0 ), /*    93 ds                */
+  S_ST( 'e',	3,       99,    66 ), /*    94                   */
+  S_ST( 'n',	3,      292,     0 ), /*    95 e                 */
+  S_ST( 'a',	3,       97,     0 ), /*    96 en                */
+  S_ST( 'b',	3,       98,     0 ), /*    97 ena               */
+  S_ST( 'l',	3,      291,     0 ), /*    98 enab              */
+  S_ST( 'x',	3,      100,    95 ), /*    99 e                 */
+  S_ST( 't',	3,      101,     0 ), /*   100 ex                */
+  S_ST( 'r',	3,      289,     0 ), /*   101 ext               */
+  S_ST( 'f',	3,      117,    94 ), /*   102                   */
+  S_ST( 'i',	3,      104,     0 ), /*   103 f                 */
+  S_ST( 'l',	3,      294,     0 ), /*   104 fi                */
+  S_ST( 'g',	3,      106,     0 ), /*   105 file              */
+  S_ST( 'e',	3,      295,     0 ), /*   106 fileg             */
+  S_ST( 'n',	3,      108,   105 ), /*   107 file              */
+  S_ST( 'u',	3,      296,     0 ), /*   108 filen             */
+  S_ST( 'l',	3,      113,   103 ), /*   109 f                 */
+  S_ST( 'a',	3,      112,     0 ), /*   110 fl                */
+  S_ST( 'g',	3,      300,     0 ), /*   111 fla               */
+  S_ST( 'k',	3,      301,   111 ), /*   112 fla               */
+  S_ST( 'o',	3,      114,   110 ), /*   113 fl                */
+  S_ST( 'o',	3,      302,     0 ), /*   114 flo               */
+  S_ST( 'r',	3,      116,   109 ), /*   115 f                 */
+  S_ST( 'e',	3,      303,     0 ), /*   116 fr                */
+  S_ST( 'u',	3,      118,   115 ), /*   117 f                 */
+  S_ST( 'd',	3,      119,     0 ), /*   118 fu                */
+  S_ST( 'g',	3,      304,     0 ), /*   119 fud               */
+  S_ST( 'h',	3,      121,   102 ), /*   120                   */
+  S_ST( 'u',	3,      122,     0 ), /*   121 h                 */
+  S_ST( 'f',	3,      123,     0 ), /*   122 hu                */
+  S_ST( 'f',	3,      124,     0 ), /*   123 huf               */
+  S_ST( 'p',	3,      125,     0 ), /*   124 huff              */
+  S_ST( 'u',	3,      126,     0 ), /*   125 huffp             */
+  S_ST( 'f',	3,      305,     0 ), /*   126 huffpu            */
+  S_ST( 'i',	3,      173,   120 ), /*   127                   */
+  S_ST( 'b',	3,      129,     0 ), /*   128 i                 */
+  S_ST( 'u',	3,      130,     0 ), /*   129 ib                */
+  S_ST( 'r',	3,      131,     0 ), /*   130 ibu               */
+  S_ST( 's',	3,      306,     0 ), /*   131 ibur              */
+  S_ST( 'f',	3,      133,   128 ), /*   132 i                 */
+  S_ST( 'd',	3,      134,     0 ), /*   133 if                */
+  S_ST( 'e',	3,      135,     0 ), /*   134 ifd               */
+  S_ST( 'l',	3,      136,     0 ), /*   135 ifde              */
+  S_ST( 't',	3,      137,     0 ), /*   136 ifdel             */
+  S_ST( 'a',	3,      307,     0 ), /*   137 ifdelt            */
+  S_ST( 'g',	3,      139,   132 ), /*   138 i                 */
+  S_ST( 'n',	3,      140,     0 ), /*   139 ig                */
+  S_ST( 'o',	3,      141,     0 ), /*   140 ign               */
+  S_ST( 'r',	3,      308,     0 ), /*   141 igno              */
+  S_ST( 'n',	3,      165,   138 ), /*   142 i                 */
+  S_ST( 'c',	3,      155,     0 ), /*   143 in                */
+  S_ST( 'a',	3,      145,     0 ), /*   144 inc               */
+  S_ST( 'l',	3,      146,     0 ), /*   145 inca              */
+  S_ST( 'l',	3,      147,     0 ), /*   146 incal             */
+  S_ST( 'o',	3,      309,     0 ), /*   147 incall            */
+  S_ST( 'l',	3,      149,   144 ), /*   148 inc               */
+  S_ST( 'u',	3,      150,     0 ), /*   149 incl              */
+  S_ST( 'd',	3,      151,     0 ), /*   150 inclu             */
+  S_ST( 'e',	3,      152,     0 ), /*   151 includ            */
+  S_ST( 'f',	3,      153,     0 ), /*   152 include           */
+  S_ST( 'i',	3,      154,     0 ), /*   153 includef          */
+  S_ST( 'l',	3,      313,     0 ), /*   154 includefi         */
+  S_ST( 'm',	3,      156,   148 ), /*   155 inc               */
+  S_ST( 'e',	3,      310,     0 ), /*   156 incm              */
+  S_ST( 'i',	3,      158,   143 ), /*   157 in                */
+  S_ST( 't',	3,      163,     0 ), /*   158 ini               */
+  S_ST( 'a',	3,      160,     0 ), /*   159 init              */
+  S_ST( 'l',	3,      161,     0 ), /*   160 inita             */
+  S_ST( 'l',	3,      162,     0 ), /*   161 inital            */
+  S_ST( 'o',	3,      311,     0 ), /*   162 initall           */
+  S_ST( 'm',	3,      164,   159 ), /*   163 init              */
+  S_ST( 'e',	3,      312,     0 ), /*   164 initm             */
+  S_ST( 't',	3,      166,   157 ), /*   165 in                */
+  S_ST( 'e',	3,      167,     0 ), /*   166 int               */
+  S_ST( 'r',	3,      168,     0 ), /*   167 inte              */
+  S_ST( 'f',	3,      169,     0 ), /*   168 inter             */
+  S_ST( 'a',	3,      170,     0 ), /*   169 interf            */
+  S_ST( 'c',	3,      315,     0 ), /*   170 interfa           */
+  S_ST( 'c',	3,      172,     0 ), /*   171 io                */
+  S_ST( 'p',	3,      318,     0 ), /*   172 ioc               */
+  S_ST( 'p',	3,      174,   317 ), /*   173 i                 */
+  S_ST( 'v',	3,      321,     0 ), /*   174 ip                */
+  S_ST( 'k',	3,      196,   127 ), /*   175                   */
+  S_ST( 'e',	3,      327,     0 ), /*   176 k                 */
+  S_ST( 'l',	3,      178,     0 ), /*   177 ke                */
+  S_ST( 'i',	3,      179,     0 ), /*   178 kel               */
+  S_ST( 'm',	3,      180,     0 ), /*   179 keli              */
+  S_ST( 'i',	3,      323,     0 ), /*   180 kelim             */
+  S_ST( 'r',	3,      182,   177 ), /*   181 ke                */
+  S_ST( 'n',	3,      183,     0 ), /*   182 ker               */
+  S_ST( 'e',	3,      324,     0 ), /*   183 kern              */
+  S_ST( 't',	3,      185,   181 ), /*   184 ke                */
+  S_ST( 'i',	3,      186,     0 ), /*   185 ket               */
+  S_ST( 'm',	3,      187,     0 ), /*   186 keti              */
+  S_ST( 'e',	3,      188,     0 ), /*   187 ketim             */
+  S_ST( 'o',	3,      189,     0 ), /*   188 ketime            */
+  S_ST( 'u',	3,      325,     0 ), /*   189 ketimeo           */
+  S_ST( 'w',	3,      191,   184 ), /*   190 ke                */
+  S_ST( 'o',	3,      192,     0 ), /*   191 kew               */
+  S_ST( 'r',	3,      193,     0 ), /*   192 kewo              */
+  S_ST( 'k',	3,      194,     0 ), /*   193 kewor             */
+  S_ST( 'e',	3,      195,     0 ), /*   194 kework            */
+  S_ST( 'r',	3,      326,     0 ), /*   195 keworke           */
+  S_ST( 'o',	3,      329,   176 ), /*   196 k                 */
+  S_ST( 'l',	3,      224,   175 ), /*   197                   */
+  S_ST( 'e',	3,      199,     0 ), /*   198 l                 */
+  S_ST( 'a',	3,      200,     0 ), /*   199 le                */
+  S_ST( 'p',	3,      204,     0 ), /*   200 lea               */
+  S_ST( 'f',	3,      202,     0 ), /*   201 leap              */
+  S_ST( 'i',	3,      203,     0 ), /*   202 leapf             */
+  S_ST( 'l',	3,      331,     0 ), /*   203 leapfi            */
+  S_ST( 's',	3,      205,   201 ), /*   204 leap              */
+  S_ST( 'm',	3,      206,     0 ), /*   205 leaps             */
+  S_ST( 'e',	3,      207,     0 ), /*   206 leapsm            */
+  S_ST( 'a',	3,      208,     0 ), /*   207 leapsme           */
+  S_ST( 'r',	3,      209,     0 ), /*   208 leapsmea          */
+  S_ST( 'i',	3,      210,     0 ), /*   209 leapsmear         */
+  S_ST( 'n',	3,      211,     0 ), /*   210 leapsmeari        */
+  S_ST( 't',	3,      212,     0 ), /*   211 leapsmearin       */
+  S_ST( 'e',	3,      213,     0 ), /*   212 leapsmearint      */
+  S_ST( 'r',	3,      214,     0 ), /*   213 leapsmearinte     */
+  S_ST( 'v',	3,      215,     0 ), /*   214 leapsmearinter    */
+  S_ST( 'a',	3,      332,     0 ), /*   215 leapsmearinterv   */
+  S_ST( 'i',	3,      221,   198 ), /*   216 l                 */
+  S_ST( 'm',	3,      218,     0 ), /*   217 li                */
+  S_ST( 'i',	3,      333,     0 ), /*   218 lim               */
+  S_ST( 'e',	3,      334,     0 ), /*   219 limit             */
+  S_ST( 'n',	3,      335,   217 ), /*   220 li                */
+  S_ST( 's',	3,      222,   220 ), /*   221 li                */
+  S_ST( 't',	3,      223,     0 ), /*   222 lis               */
+  S_ST( 'e',	3,      336,     0 ), /*   223 list              */
+  S_ST( 'o',	3,      234,   216 ), /*   224 l                 */
+  S_ST( 'g',	3,      231,     0 ), /*   225 lo                */
+  S_ST( 'c',	3,      227,     0 ), /*   226 log               */
+  S_ST( 'o',	3,      228,     0 ), /*   227 logc              */
+  S_ST( 'n',	3,      229,     0 ), /*   228 logco             */
+  S_ST( 'f',	3,      230,     0 ), /*   229 logcon            */
+  S_ST( 'i',	3,      337,     0 ), /*   230 logconf           */
+  S_ST( 'f',	3,      232,   226 ), /*   231 log               */
+  S_ST( 'i',	3,      233,     0 ), /*   232 logf              */
+  S_ST( 'l',	3,      338,     0 ), /*   233 logfi             */
+  S_ST( 'o',	3,      235,   225 ), /*   234 lo                */
+  S_ST( 'p',	3,      236,     0 ), /*   235 loo               */
+  S_ST( 's',	3,      237,     0 ), /*   236 loop              */
+  S_ST( 't',	3,      238,     0 ), /*   237 loops             */
+  S_ST( 'a',	3,      239,     0 ), /*   238 loopst            */
+  S_ST( 't',	3,      339,     0 ), /*   239 loopsta           */
+  S_ST( 'm',	3,      488,   197 ), /*   240                   */
+  S_ST( 'a',	3,      243,     0 ), /*   241 m                 */
+  S_ST( 's',	3,      340,     0 ), /*   242 ma                */
+  S_ST( 'x',	3,      288,   242 ), /*   243 ma                */
+  S_ST( 'a',	3,      245,     0 ), /*   244 max               */
+  S_ST( 'g',	3,      341,     0 ), /*   245 maxa              */
+  S_ST( 'c',	3,      247,   244 ), /*   246 max               */
+  S_ST( 'l',	3,      248,     0 ), /*   247 maxc              */
+  S_ST( 'o',	3,      249,     0 ), /*   248 maxcl             */
+  S_ST( 'c',	3,      342,     0 ), /*   249 maxclo            */
+  S_ST( 'd',	3,      254,   246 ), /*   250 max               */
+  S_ST( 'e',	3,      252,     0 ), /*   251 maxd              */
+  S_ST( 'p',	3,      253,     0 ), /*   252 maxde             */
+  S_ST( 't',	3,      343,     0 ), /*   253 maxdep            */
+  S_ST( 'i',	3,      255,   251 ), /*   254 maxd              */
+  S_ST( 's',	3,      345,     0 ), /*   255 maxdi             */
+  S_ST( 'm',	3,      257,   250 ), /*   256 max               */
+  S_ST( 'e',	3,      346,     0 ), /*   257 maxm              */
+  S_ST( 'd',	1,        0,     0 ), /*   258 258               */
+  S_ST( 'e',	0,        0,     0 ), /*   259 259               */
+  S_ST( 'l',	0,       10,     0 ), /*   260 260               */
+  S_ST( 'n',	0,        0,     0 ), /*   261 261               */
+  S_ST( 's',	0,        0,     0 ), /*   262 262               */
+  S_ST( 'p',	3,      276,   256 ), /*   263 max               */
+  S_ST( 'h',	0,        0,     0 ), /*   264 264               */
+  S_ST( 'e',	0,        0,     0 ), /*   265 265               */
+  S_ST( 'd',	0,        0,     0 ), /*   266 266               */
+  S_ST( 's',	0,        0,     0 ), /*   267 267               */
+  S_ST( 't',	0,        0,     0 ), /*   268 268               */
+  S_ST( 'l',	0,        0,     0 ), /*   269 269               */
+  S_ST( 'e',	0,        0,     0 ), /*   270 270               */
+  S_ST( 'a',	0,       35,     0 ), /*   271 271               */
+  S_ST( 'g',	0,        0,     0 ), /*   272 272               */
+  S_ST( 't',	0,        0,     0 ), /*   273 273               */
+  S_ST( 'k',	1,       50,     0 ), /*   274 274               */
+  S_ST( 's',	0,        0,     0 ), /*   275 275               */
+  S_ST( 'o',	3,      284,     0 ), /*   276 maxp              */
+  S_ST( 'e',	0,        0,     0 ), /*   277 277               */
+  S_ST( 'y',	0,        0,     0 ), /*   278 278               */
+  S_ST( 'l',	0,        0,     0 ), /*   279 279               */
+  S_ST( 'y',	0,        0,     0 ), /*   280 280               */
+  S_ST( 't',	0,        0,     0 ), /*   281 281               */
+  S_ST( 'e',	0,        0,     0 ), /*   282 282               */
+  S_ST( 'n',	0,        0,     0 ), /*   283 283               */
+  S_ST( 'l',	3,      347,     0 ), /*   284 maxpo             */
+  S_ST( 'e',	1,        0,     0 ), /*   285 285               */
+  S_ST( 'p',	0,        0,     0 ), /*   286 286               */
+  S_ST( 'p',	0,        0,     0 ), /*   287 287               */
+  S_ST( 't',	3,      293,   263 ), /*   288 max               */
+  S_ST( 'a',	0,        0,     0 ), /*   289 289               */
+  S_ST( '.',	0,        0,     0 ), /*   290 290               */
+  S_ST( 'e',	0,        0,     0 ), /*   291 291               */
+  S_ST( 'd',	0,        0,    96 ), /*   292 292               */
+  S_ST( 'l',	3,      348,     0 ), /*   293 maxt              */
+  S_ST( 'e',	1,      107,     0 ), /*   294 294               */
+  S_ST( 'n',	0,        0,     0 ), /*   295 295               */
+  S_ST( 'm',	0,        0,     0 ), /*   296 296               */
+  S_ST( '1',	0,        0,     0 ), /*   297 297               */
+  S_ST( '2',	0,        0,   297 ), /*   298 298               */
+  S_ST( '3',	0,        0,   298 ), /*   299 299               */
+  S_ST( '4',	0,        0,   299 ), /*   300 300               */
+  S_ST( 'e',	0,        0,     0 ), /*   301 301               */
+  S_ST( 'r',	0,        0,     0 ), /*   302 302               */
+  S_ST( 'q',	0,        0,     0 ), /*   303 303               */
+  S_ST( 'e',	1,        0,     0 ), /*   304 304               */
+  S_ST( 'f',	0,        0,     0 ), /*   305 305               */
+  S_ST( 't',	0,        0,     0 ), /*   306 306               */
+  S_ST( 's',	0,        0,     0 ), /*   307 307               */
+  S_ST( 'e',	0,        0,     0 ), /*   308 308               */
+  S_ST( 'c',	0,        0,     0 ), /*   309 309               */
+  S_ST( 'm',	0,        0,     0 ), /*   310 310               */
+  S_ST( 'c',	0,        0,     0 ), /*   311 311               */
+  S_ST( 'm',	0,        0,     0 ), /*   312 312               */
+  S_ST( 'e',	1,        0,     0 ), /*   313 313               */
+  S_ST( 'd',	3,      316,   241 ), /*   314 m                 */
+  S_ST( 'e',	0,        0,     0 ), /*   315 315               */
+  S_ST( 'n',	3,      404,     0 ), /*   316 md                */
+  S_ST( 'o',	0,      171,   142 ), /*   317 317               */
+  S_ST( 'u',	0,        0,     0 ), /*   318 318               */
+  S_ST( '4',	0,        0,     0 ), /*   319 319               */
+  S_ST( '4',	0,        0,     0 ), /*   320 320               */
+  S_ST( '6',	0,        0,   319 ), /*   321 321               */
+  S_ST( '6',	0,        0,   320 ), /*   322 322               */
+  S_ST( 't',	0,        0,     0 ), /*   323 323               */
+  S_ST( 'l',	0,        0,     0 ), /*   324 324               */
+  S_ST( 't',	0,        0,     0 ), /*   325 325               */
+  S_ST( 's',	0,        0,     0 ), /*   326 326               */
+  S_ST( 'y',	0,      328,   190 ), /*   327 327               */
+  S_ST( 's',	1,        0,     0 ), /*   328 328               */
+  S_ST( 'd',	0,        0,     0 ), /*   329 329               */
+  S_ST( 'p',	0,        0,     0 ), /*   330 330               */
+  S_ST( 'e',	1,        0,     0 ), /*   331 331               */
+  S_ST( 'l',	0,        0,     0 ), /*   332 332               */
+  S_ST( 't',	0,      219,     0 ), /*   333 333               */
+  S_ST( 'd',	0,        0,     0 ), /*   334 334               */
+  S_ST( 'k',	0,        0,     0 ), /*   335 335               */
+  S_ST( 'n',	0,        0,     0 ), /*   336 336               */
+  S_ST( 'g',	2,        0,     0 ), /*   337 337               */
+  S_ST( 'e',	1,        0,     0 ), /*   338 338               */
+  S_ST( 's',	0,        0,     0 ), /*   339 339               */
+  S_ST( 'k',	0,        0,     0 ), /*   340 340               */
+  S_ST( 'e',	0,        0,     0 ), /*   341 341               */
+  S_ST( 'k',	0,        0,     0 ), /*   342 342               */
+  S_ST( 'h',	0,        0,     0 ), /*   343 343               */
+  S_ST( 'p',	0,        0,     0 ), /*   344 344               */
+  S_ST( 't',	0,        0,   344 ), /*   345 345               */
+  S_ST( 'm',	0,        0,     0 ), /*   346 346               */
+  S_ST( 'l',	0,        0,     0 ), /*   347 347               */
+  S_ST( 's',	0,        0,     0 ), /*   348 348               */
+  S_ST( 's',	0,        0,     0 ), /*   349 349               */
+  S_ST( 'm',	0,      455,     0 ), /*   350 350               */
+  S_ST( 'k',	0,        0,     0 ), /*   351 351               */
+  S_ST( 'e',	0,        0,     0 ), /*   352 352               */
+  S_ST( 'k',	0,        0,     0 ), /*   353 353               */
+  S_ST( 'h',	0,        0,     0 ), /*   354 354               */
+  S_ST( 't',	0,        0,     0 ), /*   355 355               */
+  S_ST( 'l',	0,        0,     0 ), /*   356 356               */
+  S_ST( 'e',	0,        0,     0 ), /*   357 357               */
+  S_ST( 's',	0,        0,     0 ), /*   358 358               */
+  S_ST( 'e',	0,        0,     0 ), /*   359 359               */
+  S_ST( 'r',	0,        0,     0 ), /*   360 360               */
+  S_ST( 'h',	0,        0,     0 ), /*   361 361               */
+  S_ST( 'u',	0,        0,     0 ), /*   362 362               */
+  S_ST( 'c',	0,        0,     0 ), /*   363 363               */
+  S_ST( 'k',	0,        0,     0 ), /*   364 364               */
+  S_ST( 'y',	0,        0,     0 ), /*   365 365               */
+  S_ST( 't',	0,        0,     0 ), /*   366 366               */
+  S_ST( 'e',	0,        0,     0 ), /*   367 367               */
+  S_ST( 'e',	0,        0,     0 ), /*   368 368               */
+  S_ST( 'r',	0,        0,     0 ), /*   369 369               */
+  S_ST( 'y',	0,        0,     0 ), /*   370 370               */
+  S_ST( 't',	0,        0,     0 ), /*   371 371               */
+  S_ST( 'e',	0,        0,     0 ), /*   372 372               */
+  S_ST( 'p',	0,        0,     0 ), /*   373 373               */
+  S_ST( 't',	0,        0,     0 ), /*   374 374               */
+  S_ST( 'l',	0,        0,     0 ), /*   375 375               */
+  S_ST( 'p',	0,      541,     0 ), /*   376 376               */
+  S_ST( 't',	0,        0,     0 ), /*   377 377               */
+  S_ST( 't',	1,        0,     0 ), /*   378 378               */
+  S_ST( 's',	0,      557,   376 ), /*   379 379               */
+  S_ST( 's',	0,        0,     0 ), /*   380 380               */
+  S_ST( 's',	0,        0,     0 ), /*   381 381               */
+  S_ST( 'n',	0,      566,     0 ), /*   382 382               */
+  S_ST( 't',	0,        0,     0 ), /*   383 383               */
+  S_ST( 'c',	0,        0,     0 ), /*   384 384               */
+  S_ST( 'h',	1,        0,     0 ), /*   385 385               */
+  S_ST( 'r',	1,      576,     0 ), /*   386 386               */
+  S_ST( 's',	0,        0,     0 ), /*   387 387               */
+  S_ST( 'e',	2,        0,     0 ), /*   388 388               */
+  S_ST( 'd',	0,      584,     0 ), /*   389 389               */
+  S_ST( 'e',	1,        0,     0 ), /*   390 390               */
+  S_ST( 'l',	1,        0,     0 ), /*   391 391               */
+  S_ST( 't',	0,        0,     0 ), /*   392 392               */
+  S_ST( 'h',	1,        0,     0 ), /*   393 393               */
+  S_ST( 'r',	0,        0,     0 ), /*   394 394               */
+  S_ST( 'e',	0,        0,     0 ), /*   395 395               */
+  S_ST( 'd',	0,        0,     0 ), /*   396 396               */
+  S_ST( '4',	0,        0,     0 ), /*   397 397               */
+  S_ST( '6',	0,        0,   397 ), /*   398 398               */
+  S_ST( 's',	0,        0,     0 ), /*   399 399               */
+  S_ST( 's',	0,        0,     0 ), /*   400 400               */
+  S_ST( 'k',	1,        0,     0 ), /*   401 401               */
+  S_ST( 'd',	1,        0,     0 ), /*   402 402               */
+  S_ST( 'y',	0,        0,     0 ), /*   403 403               */
+  S_ST( 's',	3,      409,     0 ), /*   404 mdn               */
+  S_ST( 'h',	0,        0,     0 ), /*   405 405               */
+  S_ST( 't',	0,        0,     0 ), /*   406 406               */
+  S_ST( 't',	0,        0,     0 ), /*   407 407               */
+  S_ST( 't',	0,        0,     0 ), /*   408 408               */
+  S_ST( 't',	3,      425,     0 ), /*   409 mdns              */
+  S_ST( 'r',	1,        0,     0 ), /*   410 410               */
+  S_ST( 'r',	1,        0,     0 ), /*   411 411               */
+  S_ST( 'e',	0,        0,     0 ), /*   412 412               */
+  S_ST( 'e',	0,        0,     0 ), /*   413 413               */
+  S_ST( 's',	0,        0,     0 ), /*   414 414               */
+  S_ST( 'e',	0,        0,     0 ), /*   415 415               */
+  S_ST( 's',	0,        0,     0 ), /*   416 416               */
+  S_ST( 's',	0,      688,   683 ), /*   417 417               */
+  S_ST( 'r',	1,        0,     0 ), /*   418 418               */
+  S_ST( 'p',	0,      696,     0 ), /*   419 419               */
+  S_ST( 'k',	0,        0,     0 ), /*   420 420               */
+  S_ST( 'd',	0,        0,     0 ), /*   421 421               */
+  S_ST( 't',	0,        0,     0 ), /*   422 422               */
+  S_ST( 'm',	0,        0,     0 ), /*   423 423               */
+  S_ST( 'e',	0,        0,     0 ), /*   424 424               */
+  S_ST( 'r',	3,      441,     0 ), /*   425 mdnst             */
+  S_ST( 's',	0,      708,     0 ), /*   426 426               */
+  S_ST( 's',	0,        0,     0 ), /*   427 427               */
+  S_ST( 'k',	0,        0,     0 ), /*   428 428               */
+  S_ST( '1',	0,        0,     0 ), /*   429 429               */
+  S_ST( '2',	0,        0,   429 ), /*   430 430               */
+  S_ST( 'r',	0,        0,   430 ), /*   431 431               */
+  S_ST( 'r',	0,        0,     0 ), /*   432 432               */
+  S_ST( 's',	1,        0,     0 ), /*   433 433               */
+  S_ST( 's',	1,        0,     0 ), /*   434 434               */
+  S_ST( 'e',	0,        0,     0 ), /*   435 435               */
+  S_ST( 's',	0,        0,     0 ), /*   436 436               */
+  S_ST( 'e',	0,        0,     0 ), /*   437 437               */
+  S_ST( 'y',	0,        0,     0 ), /*   438 438               */
+  S_ST( 's',	0,        0,     0 ), /*   439 439               */
+  S_ST( 'e',	0,        0,     0 ), /*   440 440               */
+  S_ST( 'i',	3,      449,     0 ), /*   441 mdnstr            */
+  S_ST( 't',	0,        0,     0 ), /*   442 442               */
+  S_ST( 'g',	1,        0,     0 ), /*   443 443               */
+  S_ST( 'r',	1,        0,     0 ), /*   444 444               */
+  S_ST( 't',	0,        0,     0 ), /*   445 445               */
+  S_ST( 'g',	0,        0,     0 ), /*   446 446               */
+  S_ST( 's',	0,        0,     0 ), /*   447 447               */
+  S_ST( 'n',	0,        0,     0 ), /*   448 448               */
+  S_ST( 'e',	3,      349,     0 ), /*   449 mdnstri           */
+  S_ST( 'k',	0,        0,     0 ), /*   450 450               */
+  S_ST( 'd',	0,        0,     0 ), /*   451 451               */
+  S_ST( 's',	0,        0,     0 ), /*   452 452               */
+  S_ST( 'r',	0,        0,     0 ), /*   453 453               */
+  S_ST( 'e',	3,      350,   314 ), /*   454 m                 */
+  S_ST( 'l',	3,      456,     0 ), /*   455 mem               */
+  S_ST( 'o',	3,      457,     0 ), /*   456 meml              */
+  S_ST( 'c',	3,      351,     0 ), /*   457 memlo             */
+  S_ST( 'i',	3,      459,   454 ), /*   458 m                 */
+  S_ST( 'n',	3,      478,     0 ), /*   459 mi                */
+  S_ST( 'a',	3,      461,     0 ), /*   460 min               */
+  S_ST( 'g',	3,      352,     0 ), /*   461 mina              */
+  S_ST( 'c',	3,      463,   460 ), /*   462 min               */
+  S_ST( 'l',	3,      464,     0 ), /*   463 minc              */
+  S_ST( 'o',	3,      465,     0 ), /*   464 mincl             */
+  S_ST( 'c',	3,      353,     0 ), /*   465 minclo            */
+  S_ST( 'd',	3,      470,   462 ), /*   466 min               */
+  S_ST( 'e',	3,      468,     0 ), /*   467 mind              */
+  S_ST( 'p',	3,      469,     0 ), /*   468 minde             */
+  S_ST( 't',	3,      354,     0 ), /*   469 mindep            */
+  S_ST( 'i',	3,      471,   467 ), /*   470 mind              */
+  S_ST( 's',	3,      355,     0 ), /*   471 mindi             */
+  S_ST( 'p',	3,      473,   466 ), /*   472 min               */
+  S_ST( 'o',	3,      474,     0 ), /*   473 minp              */
+  S_ST( 'l',	3,      356,     0 ), /*   474 minpo             */
+  S_ST( 's',	3,      476,   472 ), /*   475 min               */
+  S_ST( 'a',	3,      477,     0 ), /*   476 mins              */
+  S_ST( 'n',	3,      357,     0 ), /*   477 minsa             */
+  S_ST( 't',	3,      479,   475 ), /*   478 min               */
+  S_ST( 'l',	3,      358,     0 ), /*   479 mint              */
+  S_ST( 'o',	3,      482,   458 ), /*   480 m                 */
+  S_ST( 'd',	3,      359,     0 ), /*   481 mo                */
+  S_ST( 'n',	3,      486,   481 ), /*   482 mo                */
+  S_ST( 'i',	3,      484,     0 ), /*   483 mon               */
+  S_ST( 't',	3,      485,     0 ), /*   484 moni              */
+  S_ST( 'o',	3,      360,     0 ), /*   485 monit             */
+  S_ST( 't',	3,      361,   483 ), /*   486 mon               */
+  S_ST( 'r',	3,      362,   480 ), /*   487 m                 */
+  S_ST( 's',	3,      489,   487 ), /*   488 m                 */
+  S_ST( 's',	3,      490,     0 ), /*   489 ms                */
+  S_ST( 'n',	3,      491,     0 ), /*   490 mss               */
+  S_ST( 't',	3,      330,     0 ), /*   491 mssn              */
+  S_ST( 'n',	3,      537,   240 ), /*   492                   */
+  S_ST( 'i',	3,      363,     0 ), /*   493 n                 */
+  S_ST( 'o',	3,      535,   493 ), /*   494 n                 */
+  S_ST( 'l',	3,      496,     0 ), /*   495 no                */
+  S_ST( 'i',	3,      497,     0 ), /*   496 nol               */
+  S_ST( 'n',	3,      364,     0 ), /*   497 noli              */
+  S_ST( 'm',	3,      503,   495 ), /*   498 no                */
+  S_ST( 'o',	3,      500,     0 ), /*   499 nom               */
+  S_ST( 'd',	3,      501,     0 ), /*   500 nomo              */
+  S_ST( 'i',	3,      502,     0 ), /*   501 nomod             */
+  S_ST( 'f',	3,      365,     0 ), /*   502 nomodi            */
+  S_ST( 'r',	3,      504,   499 ), /*   503 nom               */
+  S_ST( 'u',	3,      505,     0 ), /*   504 nomr              */
+  S_ST( 'l',	3,      506,     0 ), /*   505 nomru             */
+  S_ST( 'i',	3,      507,     0 ), /*   506 nomrul            */
+  S_ST( 's',	3,      366,     0 ), /*   507 nomruli           */
+  S_ST( 'n',	3,      509,   498 ), /*   508 no                */
+  S_ST( 'v',	3,      510,   367 ), /*   509 non               */
+  S_ST( 'o',	3,      511,     0 ), /*   510 nonv              */
+  S_ST( 'l',	3,      512,     0 ), /*   511 nonvo             */
+  S_ST( 'a',	3,      513,     0 ), /*   512 nonvol            */
+  S_ST( 't',	3,      514,     0 ), /*   513 nonvola           */
+  S_ST( 'i',	3,      515,     0 ), /*   514 nonvolat          */
+  S_ST( 'l',	3,      368,     0 ), /*   515 nonvolati         */
+  S_ST( 'p',	3,      517,   508 ), /*   516 no                */
+  S_ST( 'e',	3,      518,     0 ), /*   517 nop               */
+  S_ST( 'e',	3,      369,     0 ), /*   518 nope              */
+  S_ST( 'q',	3,      520,   516 ), /*   519 no                */
+  S_ST( 'u',	3,      521,     0 ), /*   520 noq               */
+  S_ST( 'e',	3,      522,     0 ), /*   521 noqu              */
+  S_ST( 'r',	3,      370,     0 ), /*   522 noque             */
+  S_ST( 's',	3,      524,   519 ), /*   523 no                */
+  S_ST( 'e',	3,      528,     0 ), /*   524 nos               */
+  S_ST( 'l',	3,      526,     0 ), /*   525 nose              */
+  S_ST( 'e',	3,      527,     0 ), /*   526 nosel             */
+  S_ST( 'c',	3,      371,     0 ), /*   527 nosele            */
+  S_ST( 'r',	3,      529,   525 ), /*   528 nose              */
+  S_ST( 'v',	3,      372,     0 ), /*   529 noser             */
+  S_ST( 't',	3,      531,   523 ), /*   530 no                */
+  S_ST( 'r',	3,      533,     0 ), /*   531 not               */
+  S_ST( 'a',	3,      373,     0 ), /*   532 notr              */
+  S_ST( 'u',	3,      534,   532 ), /*   533 notr              */
+  S_ST( 's',	3,      374,     0 ), /*   534 notru             */
+  S_ST( 'v',	3,      536,   530 ), /*   535 no                */
+  S_ST( 'a',	3,      375,     0 ), /*   536 nov               */
+  S_ST( 't',	3,      379,   494 ), /*   537 n                 */
+  S_ST( 'p',	3,      539,     0 ), /*   538 ntp               */
+  S_ST( 'o',	3,      540,     0 ), /*   539 ntpp              */
+  S_ST( 'r',	3,      377,     0 ), /*   540 ntppo             */
+  S_ST( 's',	3,      542,   538 ), /*   541 ntp               */
+  S_ST( 'i',	3,      543,     0 ), /*   542 ntps              */
+  S_ST( 'g',	3,      544,     0 ), /*   543 ntpsi             */
+  S_ST( 'n',	3,      545,     0 ), /*   544 ntpsig            */
+  S_ST( 'd',	3,      546,     0 ), /*   545 ntpsign           */
+  S_ST( 's',	3,      547,     0 ), /*   546 ntpsignd          */
+  S_ST( 'o',	3,      548,     0 ), /*   547 ntpsignds         */
+  S_ST( 'c',	3,      549,     0 ), /*   548 ntpsigndso        */
+  S_ST( 'k',	3,      550,     0 ), /*   549 ntpsigndsoc       */
+  S_ST( 'e',	3,      378,     0 ), /*   550 ntpsigndsock      */
+  S_ST( 'k',	3,      552,     0 ), /*   551 nts               */
+  S_ST( 'e',	3,      553,     0 ), /*   552 ntsk              */
+  S_ST( 's',	3,      554,     0 ), /*   553 ntske             */
+  S_ST( 't',	3,      555,     0 ), /*   554 ntskes            */
+  S_ST( 'a',	3,      556,     0 ), /*   555 ntskest           */
+  S_ST( 't',	3,      381,     0 ), /*   556 ntskesta          */
+  S_ST( 's',	3,      558,   551 ), /*   557 nts               */
+  S_ST( 't',	3,      559,     0 ), /*   558 ntss              */
+  S_ST( 'a',	3,      560,     0 ), /*   559 ntsst             */
+  S_ST( 't',	3,      380,     0 ), /*   560 ntssta            */
+  S_ST( 'o',	3,      562,   492 ), /*   561                   */
+  S_ST( 'r',	3,      563,     0 ), /*   562 o                 */
+  S_ST( 'p',	3,      564,     0 ), /*   563 or                */
+  S_ST( 'h',	3,      565,     0 ), /*   564 orp               */
+  S_ST( 'a',	3,      382,     0 ), /*   565 orph              */
+  S_ST( 'w',	3,      567,     0 ), /*   566 orphan            */
+  S_ST( 'a',	3,      568,     0 ), /*   567 orphanw           */
+  S_ST( 'i',	3,      383,     0 ), /*   568 orphanwa          */
+  S_ST( 'p',	3,      595,   561 ), /*   569                   */
+  S_ST( 'a',	3,      573,     0 ), /*   570 p                 */
+  S_ST( 'n',	3,      572,     0 ), /*   571 pa                */
+  S_ST( 'i',	3,      384,     0 ), /*   572 pan               */
+  S_ST( 't',	3,      385,   571 ), /*   573 pa                */
+  S_ST( 'e',	3,      575,   570 ), /*   574 p                 */
+  S_ST( 'e',	3,      386,     0 ), /*   575 pe                */
+  S_ST( 's',	3,      577,     0 ), /*   576 peer              */
+  S_ST( 't',	3,      578,     0 ), /*   577 peers             */
+  S_ST( 'a',	3,      579,     0 ), /*   578 peerst            */
+  S_ST( 't',	3,      387,     0 ), /*   579 peersta           */
+  S_ST( 'h',	3,      581,   574 ), /*   580 p                 */
+  S_ST( 'o',	3,      582,     0 ), /*   581 ph                */
+  S_ST( 'n',	3,      388,     0 ), /*   582 pho               */
+  S_ST( 'i',	3,      389,   580 ), /*   583 p                 */
+  S_ST( 'f',	3,      585,     0 ), /*   584 pid               */
+  S_ST( 'i',	3,      586,     0 ), /*   585 pidf              */
+  S_ST( 'l',	3,      390,     0 ), /*   586 pidfi             */
+  S_ST( 'o',	3,      589,   583 ), /*   587 p                 */
+  S_ST( 'o',	3,      391,     0 ), /*   588 po                */
+  S_ST( 'r',	3,      392,   588 ), /*   589 po                */
+  S_ST( 'p',	3,      591,   587 ), /*   590 p                 */
+  S_ST( 's',	3,      592,     0 ), /*   591 pp                */
+  S_ST( 'p',	3,      593,     0 ), /*   592 pps               */
+  S_ST( 'a',	3,      594,     0 ), /*   593 ppsp              */
+  S_ST( 't',	3,      393,     0 ), /*   594 ppspa             */
+  S_ST( 'r',	3,      610,   590 ), /*   595 p                 */
+  S_ST( 'e',	3,      597,     0 ), /*   596 pr                */
+  S_ST( 'f',	3,      599,     0 ), /*   597 pre               */
+  S_ST( 'e',	3,      394,     0 ), /*   598 pref              */
+  S_ST( 'i',	3,      600,   598 ), /*   599 pref              */
+  S_ST( 'x',	3,      609,     0 ), /*   600 prefi             */
+  S_ST( 'a',	3,      602,     0 ), /*   601 prefix            */
+  S_ST( 'v',	3,      603,     0 ), /*   602 prefixa           */
+  S_ST( 'e',	3,      604,     0 ), /*   603 prefixav          */
+  S_ST( 'r',	3,      605,     0 ), /*   604 prefixave         */
+  S_ST( 'a',	3,      606,     0 ), /*   605 prefixaver        */
+  S_ST( 'g',	3,      395,     0 ), /*   606 prefixavera       */
+  S_ST( 'k',	3,      608,   601 ), /*   607 prefix            */
+  S_ST( 'o',	3,      396,     0 ), /*   608 prefixk           */
+  S_ST( 'v',	3,      398,   607 ), /*   609 prefix            */
+  S_ST( 'o',	3,      611,   596 ), /*   610 pr                */
+  S_ST( 't',	3,      612,     0 ), /*   611 pro               */
+  S_ST( 'o',	3,      613,     0 ), /*   612 prot              */
+  S_ST( 's',	3,      614,     0 ), /*   613 proto             */
+  S_ST( 't',	3,      615,     0 ), /*   614 protos            */
+  S_ST( 'a',	3,      616,     0 ), /*   615 protost           */
+  S_ST( 't',	3,      399,     0 ), /*   616 protosta          */
+  S_ST( 'r',	3,      650,   569 ), /*   617                   */
+  S_ST( 'a',	3,      619,     0 ), /*   618 r                 */
+  S_ST( 'w',	3,      620,     0 ), /*   619 ra                */
+  S_ST( 's',	3,      621,     0 ), /*   620 raw               */
+  S_ST( 't',	3,      622,     0 ), /*   621 raws              */
+  S_ST( 'a',	3,      623,     0 ), /*   622 rawst             */
+  S_ST( 't',	3,      400,     0 ), /*   623 rawsta            */
+  S_ST( 'e',	3,      644,   618 ), /*   624 r                 */
+  S_ST( 'c',	3,      626,     0 ), /*   625 re                */
+  S_ST( 'v',	3,      627,     0 ), /*   626 rec               */
+  S_ST( 'b',	3,      628,     0 ), /*   627 recv              */
+  S_ST( 'a',	3,      629,     0 ), /*   628 recvb             */
+  S_ST( 't',	3,      630,     0 ), /*   629 recvba            */
+  S_ST( 'c',	3,      405,     0 ), /*   630 recvbat           */
+  S_ST( 'f',	3,      636,   625 ), /*   631 re                */
+  S_ST( 'c',	3,      633,     0 ), /*   632 ref               */
+  S_ST( 'l',	3,      634,     0 ), /*   633 refc              */
+  S_ST( 'o',	3,      635,     0 ), /*   634 refcl             */
+  S_ST( 'c',	3,      401,     0 ), /*   635 refclo            */
+  S_ST( 'i',	3,      402,   632 ), /*   636 ref               */
+  S_ST( 'q',	3,      638,   631 ), /*   637 re                */
+  S_ST( 'u',	3,      639,     0 ), /*   638 req               */
+  S_ST( 'e',	3,      640,     0 ), /*   639 requ              */
+  S_ST( 's',	3,      641,     0 ), /*   640 reque             */
+  S_ST( 't',	3,      642,     0 ), /*   641 reques            */
+  S_ST( 'k',	3,      643,     0 ), /*   642 request           */
+  S_ST( 'e',	3,      403,     0 ), /*   643 requestk          */
+  S_ST( 's',	3,      646,   637 ), /*   644 re                */
+  S_ST( 'e',	3,      406,     0 ), /*   645 res               */
+  S_ST( 't',	3,      647,   645 ), /*   646 res               */
+  S_ST( 'r',	3,      648,     0 ), /*   647 rest              */
+  S_ST( 'i',	3,      649,     0 ), /*   648 restr             */
+  S_ST( 'c',	3,      407,     0 ), /*   649 restri            */
+  S_ST( 'l',	3,      651,   624 ), /*   650 r                 */
+  S_ST( 'i',	3,      652,     0 ), /*   651 rl                */
+  S_ST( 'm',	3,      653,     0 ), /*   652 rli               */
+  S_ST( 'i',	3,      408,     0 ), /*   653 rlim              */
+  S_ST( 's',	3,      707,   617 ), /*   654                   */
+  S_ST( 'e',	3,      659,     0 ), /*   655 s                 */
+  S_ST( 'r',	3,      657,     0 ), /*   656 se                */
+  S_ST( 'v',	3,      658,     0 ), /*   657 ser               */
+  S_ST( 'e',	3,      410,     0 ), /*   658 serv              */
+  S_ST( 't',	3,      660,   656 ), /*   659 se                */
+  S_ST( 'v',	3,      661,     0 ), /*   660 set               */
+  S_ST( 'a',	3,      411,     0 ), /*   661 setv              */
+  S_ST( 'o',	3,      663,   655 ), /*   662 s                 */
+  S_ST( 'u',	3,      664,     0 ), /*   663 so                */
+  S_ST( 'r',	3,      665,     0 ), /*   664 sou               */
+  S_ST( 'c',	3,      412,     0 ), /*   665 sour              */
+  S_ST( 't',	3,      698,   662 ), /*   666 s                 */
+  S_ST( 'a',	3,      682,     0 ), /*   667 st                */
+  S_ST( 'c',	3,      669,     0 ), /*   668 sta               */
+  S_ST( 'k',	3,      670,     0 ), /*   669 stac              */
+  S_ST( 's',	3,      671,     0 ), /*   670 stack             */
+  S_ST( 'i',	3,      672,     0 ), /*   671 stacks            */
+  S_ST( 'z',	3,      413,     0 ), /*   672 stacksi           */
+  S_ST( 'g',	3,      674,   668 ), /*   673 sta               */
+  S_ST( 'e',	3,      679,     0 ), /*   674 stag              */
+  S_ST( 's',	3,      676,     0 ), /*   675 stage             */
+  S_ST( 't',	3,      677,     0 ), /*   676 stages            */
+  S_ST( 'a',	3,      678,     0 ), /*   677 stagest           */
+  S_ST( 't',	3,      414,     0 ), /*   678 stagesta          */
+  S_ST( 't',	3,      680,   675 ), /*   679 stage             */
+  S_ST( 'i',	3,      681,     0 ), /*   680 staget            */
+  S_ST( 'm',	3,      415,     0 ), /*   681 stageti           */
+  S_ST( 't',	3,      417,   673 ), /*   682 sta               */
+  S_ST( 'i',	3,      684,     0 ), /*   683 stat              */
+  S_ST( 's',	3,      685,     0 ), /*   684 stati             */
+  S_ST( 't',	3,      686,     0 ), /*   685 statis            */
+  S_ST( 'i',	3,      687,     0 ), /*   686 statist           */
+  S_ST( 'c',	3,      416,     0 ), /*   687 statisti          */
+  S_ST( 'd',	3,      689,     0 ), /*   688 stats             */
+  S_ST( 'i',	3,      418,     0 ), /*   689 statsd            */
+  S_ST( 'e',	3,      419,   667 ), /*   690 st                */
+  S_ST( 'b',	3,      692,     0 ), /*   691 step              */
+  S_ST( 'a',	3,      693,     0 ), /*   692 stepb             */
+  S_ST( 'c',	3,      420,     0 ), /*   693 stepba            */
+  S_ST( 'f',	3,      695,   691 ), /*   694 step              */
+  S_ST( 'w',	3,      421,     0 ), /*   695 stepf             */
+  S_ST( 'o',	3,      697,   694 ), /*   696 step              */
+  S_ST( 'u',	3,      422,     0 ), /*   697 stepo             */
+  S_ST( 'r',	3,      699,   690 ), /*   698 st                */
+  S_ST( 'a',	3,      700,     0 ), /*   699 str               */
+  S_ST( 't',	3,      701,     0 ), /*   700 stra              */
+  S_ST( 'u',	3,      423,     0 ), /*   701 strat             */
+  S_ST( 'u',	3,      703,   666 ), /*   702 s                 */
+  S_ST( 'b',	3,      704,     0 ), /*   703 su                */
+  S_ST( 't',	3,      705,     0 ), /*   704 sub               */
+  S_ST( 'y',	3,      706,     0 ), /*   705 subt              */
+  S_ST( 'p',	3,      424,     0 ), /*   706 subty             */
+  S_ST( 'y',	3,      426,   702 ), /*   707 s                 */
+  S_ST( 's',	3,      709,     0 ), /*   708 sys               */
+  S_ST( 't',	3,      710,     0 ), /*   709 syss              */
+  S_ST( 'a',	3,      711,     0 ), /*   710 sysst             */
+  S_ST( 't',	3,      427,     0 ), /*   711 syssta            */
+  S_ST( 't',	3,      771,   654 ), /*   712                   */
+  S_ST( 'i',	3,      717,     0 ), /*   713 t                 */
+  S_ST( 'c',	3,      428,     0 ), /*   714 ti                */
+  S_ST( 'm',	3,      716,   714 ), /*   715 ti                */
+  S_ST( 'e',	3,      431,     0 ), /*   716 tim               */
+  S_ST( 'n',	3,      718,   715 ), /*   717 ti                */
+  S_ST( 'k',	3,      719,     0 ), /*   718 tin               */
+  S_ST( 'e',	3,      432,     0 ), /*   719 tink              */
+  S_ST( 'l',	3,      721,   713 ), /*   720 t                 */
+  S_ST( 's',	3,      747,     0 ), /*   721 tl                */
+  S_ST( 'c',	3,      723,     0 ), /*   722 tls               */
+  S_ST( 'i',	3,      724,     0 ), /*   723 tlsc              */
+  S_ST( 'p',	3,      725,     0 ), /*   724 tlsci             */
+  S_ST( 'h',	3,      726,     0 ), /*   725 tlscip            */
+  S_ST( 'e',	3,      727,     0 ), /*   726 tlsciph           */
+  S_ST( 'r',	3,      728,     0 ), /*   727 tlsciphe          */
+  S_ST( 's',	3,      743,     0 ), /*   728 tlscipher         */
+  S_ST( 'e',	3,      730,     0 ), /*   729 tlsciphers        */
+  S_ST( 'r',	3,      731,     0 ), /*   730 tlscipherse       */
+  S_ST( 'v',	3,      732,     0 ), /*   731 tlscipherser      */
+  S_ST( 'e',	3,      733,     0 ), /*   732 tlscipherserv     */
+  S_ST( 'r',	3,      734,     0 ), /*   733 tlscipherserve    */
+  S_ST( 'p',	3,      735,     0 ), /*   734 tlscipherserver   */
+  S_ST( 'r',	3,      736,     0 ), /*   735 tlscipherserverp  */
+  S_ST( 'e',	3,      737,     0 ), /*   736 tlscipherserverpr */
+  S_ST( 'f',	3,      738,     0 ), /*   737 tlscipherserverpre */
+  S_ST( 'e',	3,      739,     0 ), /*   738 tlscipherserverpref */
+  S_ST( 'r',	3,      740,     0 ), /*   739 tlscipherserverprefe */
+  S_ST( 'e',	3,      741,     0 ), /*   740 tlscipherserverprefer */
+  S_ST( 'n',	3,      742,     0 ), /*   741 tlscipherserverprefere */
+  S_ST( 'c',	3,      435,     0 ), /*   742 tlscipherserverpreferen */
+  S_ST( 'u',	3,      744,   729 ), /*   743 tlsciphers        */
+  S_ST( 'i',	3,      745,     0 ), /*   744 tlsciphersu       */
+  S_ST( 't',	3,      746,     0 ), /*   745 tlsciphersui      */
+  S_ST( 'e',	3,      433,     0 ), /*   746 tlsciphersuit     */
+  S_ST( 'e',	3,      748,   722 ), /*   747 tls               */
+  S_ST( 'c',	3,      749,     0 ), /*   748 tlse              */
+  S_ST( 'd',	3,      750,     0 ), /*   749 tlsec             */
+  S_ST( 'h',	3,      751,     0 ), /*   750 tlsecd            */
+  S_ST( 'c',	3,      752,     0 ), /*   751 tlsecdh           */
+  S_ST( 'u',	3,      753,     0 ), /*   752 tlsecdhc          */
+  S_ST( 'r',	3,      754,     0 ), /*   753 tlsecdhcu         */
+  S_ST( 'v',	3,      755,     0 ), /*   754 tlsecdhcur        */
+  S_ST( 'e',	3,      434,     0 ), /*   755 tlsecdhcurv       */
+  S_ST( 'o',	3,      436,   720 ), /*   756 t                 */
+  S_ST( 'r',	3,      758,   756 ), /*   757 t                 */
+  S_ST( 'u',	3,      759,     0 ), /*   758 tr                */
+  S_ST( 's',	3,      760,   437 ), /*   759 tru               */
+  S_ST( 't',	3,      761,     0 ), /*   760 trus              */
+  S_ST( 'e',	3,      762,     0 ), /*   761 trust             */
+  S_ST( 'd',	3,      763,     0 ), /*   762 truste            */
+  S_ST( 'k',	3,      764,     0 ), /*   763 trusted           */
+  S_ST( 'e',	3,      438,     0 ), /*   764 trustedk          */
+  S_ST( 'x',	3,      766,   757 ), /*   765 t                 */
+  S_ST( 's',	3,      767,     0 ), /*   766 tx                */
+  S_ST( 't',	3,      768,     0 ), /*   767 txs               */
+  S_ST( 'a',	3,      769,     0 ), /*   768 txst              */
+  S_ST( 'm',	3,      770,     0 ), /*   769 txsta             */
+  S_ST( 'p',	3,      439,     0 ), /*   770 txstam            */
+  S_ST( 'y',	3,      772,   765 ), /*   771 t                 */
+  S_ST( 'p',	3,      440,     0 ), /*   772 ty                */
+  S_ST( 'u',	3,      794,   712 ), /*   773                   */
+  S_ST( 'n',	3,      784,     0 ), /*   774 u                 */
+  S_ST( 'c',	3,      776,     0 ), /*   775 un                */
+  S_ST( 'o',	3,      777,     0 ), /*   776 unc               */
+  S_ST( 'n',	3,      778,     0 ), /*   777 unco              */
+  S_ST( 'f',	3,      779,     0 ), /*   778 uncon             */
+  S_ST( 'i',	3,      443,     0 ), /*   779 unconf            */
+  S_ST( 'i',	3,      442,   775 ), /*   780 un                */
+  S_ST( 'p',	3,      782,   780 ), /*   781 un                */
+  S_ST( 'e',	3,      783,     0 ), /*   782 unp               */
+  S_ST( 'e',	3,      444,     0 ), /*   783 unpe              */
+  S_ST( 'r',	3,      785,   781 ), /*   784 un                */
+  S_ST( 'e',	3,      786,     0 ), /*   785 unr               */
+  S_ST( 's',	3,      787,     0 ), /*   786 unre              */
+  S_ST( 't',	3,      788,     0 ), /*   787 unres             */
+  S_ST( 'r',	3,      789,     0 ), /*   788 unrest            */
+  S_ST( 'i',	3,      790,     0 ), /*   789 unrestr           */
+  S_ST( 'c',	3,      445,     0 ), /*   790 unrestri          */
+  S_ST( 'r',	3,      792,   774 ), /*   791 u                 */
+  S_ST( 'i',	3,      793,     0 ), /*   792 ur                */
+  S_ST( 'n',	3,      446,     0 ), /*   793 uri               */
+  S_ST( 's',	3,      795,   791 ), /*   794 u                 */
+  S_ST( 'e',	3,      796,     0 ), /*   795 us                */
+  S_ST( 's',	3,      797,     0 ), /*   796 use               */
+  S_ST( 't',	3,      798,     0 ), /*   797 uses              */
+  S_ST( 'a',	3,      799,     0 ), /*   798 usest             */
+  S_ST( 't',	3,      447,     0 ), /*   799 usesta            */
+  S_ST( 'v',	3,      801,   773 ), /*   800                   */
+  S_ST( 'e',	3,      802,     0 ), /*   801 v                 */
+  S_ST( 'r',	3,      803,     0 ), /*   802 ve                */
+  S_ST( 's',	3,      804,     0 ), /*   803 ver               */
+  S_ST( 'i',	3,      805,     0 ), /*   804 vers              */
+  S_ST( 'o',	3,      448,     0 ), /*   805 versi             */
+  S_ST( 'w',	3,      815,   800 ), /*   806                   */
+  S_ST( 'e',	3,      808,     0 ), /*   807 w                 */
+  S_ST( 'e',	3,      450,     0 ), /*   808 we                */
+  S_ST( 'i',	3,      810,   807 ), /*   809 w                 */
+  S_ST( 'l',	3,      811,     0 ), /*   810 wi                */
+  S_ST( 'd',	3,      812,     0 ), /*   811 wil               */
+  S_ST( 'c',	3,      813,     0 ), /*   812 wild              */
+  S_ST( 'a',	3,      814,     0 ), /*   813 wildc             */
+  S_ST( 'r',	3,      451,     0 ), /*   814 wildca            */
+  S_ST( 'o',	3,      816,   809 ), /*   815 w                 */
+  S_ST( 'r',	3,      817,     0 ), /*   816 wo                */
+  S_ST( 'k',	3,      818,     0 ), /*   817 wor               */
+  S_ST( 'e',	3,      819,     0 ), /*   818 work              */
+  S_ST( 'r',	3,      452,     0 ), /*   819 worke             */
+  S_ST( 'y',	3,      821,   806 ), /*   820 [initial state]   */
+  S_ST( 'e',	3,      822,     0 ), /*   821 y                 */
+  S_ST( 'a',	3,      453,     0 )  /*   822 ye                */
+};
+
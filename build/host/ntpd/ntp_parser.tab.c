@@ -0,0 +1,3282 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 13 "/root/repo/ntpd/ntp_parser.y"
+
+  #include "config.h"
+
+  #include "ntp.h"
+  #include "ntpd.h"
+  #include "ntp_machine.h"
+  #include "ntp_stdlib.h"
+  #include "ntp_filegen.h"
+  #include "ntp_scanner.h"
+  #include "ntp_config.h"
+
+  #define YYMALLOC	emalloc
+  #define YYFREE	free
+  #define YYERROR_VERBOSE
+  #define YYMAXDEPTH	1000	/* stop the madness sooner */
+  void yyerror(const char *msg);
+
+#line 89 "ntp_parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "ntp_parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_Aead = 3,                     /* T_Aead  */
+  YYSYMBOL_T_Age = 4,                      /* T_Age  */
+  YYSYMBOL_T_All = 5,                      /* T_All  */
+  YYSYMBOL_T_Allan = 6,                    /* T_Allan  */
+  YYSYMBOL_T_Allpeers = 7,                 /* T_Allpeers  */
+  YYSYMBOL_T_Ask = 8,                      /* T_Ask  */
+  YYSYMBOL_T_Auth = 9,                     /* T_Auth  */
+  YYSYMBOL_T_Average = 10,                 /* T_Average  */
+  YYSYMBOL_T_Baud = 11,                    /* T_Baud  */
+  YYSYMBOL_T_Bias = 12,                    /* T_Bias  */
+  YYSYMBOL_T_Burst = 13,                   /* T_Burst  */
+  YYSYMBOL_T_Busypoll = 14,                /* T_Busypoll  */
+  YYSYMBOL_T_Calibrate = 15,               /* T_Calibrate  */
+  YYSYMBOL_T_Ca = 16,                      /* T_Ca  */
+  YYSYMBOL_T_Ceiling = 17,                 /* T_Ceiling  */
+  YYSYMBOL_T_Cert = 18,                    /* T_Cert  */
+  YYSYMBOL_T_Clock = 19,                   /* T_Clock  */
+  YYSYMBOL_T_Clockstats = 20,              /* T_Clockstats  */
+  YYSYMBOL_T_Cohort = 21,                  /* T_Cohort  */
+  YYSYMBOL_T_Cookie = 22,                  /* T_Cookie  */
+  YYSYMBOL_T_ControlKey = 23,              /* T_ControlKey  */
+  YYSYMBOL_T_Ctl = 24,                     /* T_Ctl  */
+  YYSYMBOL_T_Day = 25,                     /* T_Day  */
+  YYSYMBOL_T_Default = 26,                 /* T_Default  */
+  YYSYMBOL_T_Disable = 27,                 /* T_Disable  */
+  YYSYMBOL_T_Dispersion = 28,              /* T_Dispersion  */
+  YYSYMBOL_T_Double = 29,                  /* T_Double  */
+  YYSYMBOL_T_Driftfile = 30,               /* T_Driftfile  */
+  YYSYMBOL_T_Drop = 31,                    /* T_Drop  */
+  YYSYMBOL_T_Dscp = 32,                    /* T_Dscp  */
+  YYSYMBOL_T_Expire = 33,                  /* T_Expire  */
+  YYSYMBOL_T_Extra = 34,                   /* T_Extra  */
+  YYSYMBOL_T_Ellipsis = 35,                /* T_Ellipsis  */
+  YYSYMBOL_T_Enable = 36,                  /* T_Enable  */
+  YYSYMBOL_T_End = 37,                     /* T_End  */
+  YYSYMBOL_T_False = 38,                   /* T_False  */
+  YYSYMBOL_T_File = 39,                    /* T_File  */
+  YYSYMBOL_T_Filegen = 40,                 /* T_Filegen  */
+  YYSYMBOL_T_Filenum = 41,                 /* T_Filenum  */
+  YYSYMBOL_T_Flag1 = 42,                   /* T_Flag1  */
+  YYSYMBOL_T_Flag2 = 43,                   /* T_Flag2  */
+  YYSYMBOL_T_Flag3 = 44,                   /* T_Flag3  */
+  YYSYMBOL_T_Flag4 = 45,                   /* T_Flag4  */
+  YYSYMBOL_T_Flake = 46,                   /* T_Flake  */
+  YYSYMBOL_T_Floor = 47,                   /* T_Floor  */
+  YYSYMBOL_T_Freq = 48,                    /* T_Freq  */
+  YYSYMBOL_T_Fudge = 49,                   /* T_Fudge  */
+  YYSYMBOL_T_Huffpuff = 50,                /* T_Huffpuff  */
+  YYSYMBOL_T_Iburst = 51,                  /* T_Iburst  */
+  YYSYMBOL_T_Ifdeltas = 52,                /* T_Ifdeltas  */
+  YYSYMBOL_T_Ignore = 53,                  /* T_Ignore  */
+  YYSYMBOL_T_Incalloc = 54,                /* T_Incalloc  */
+  YYSYMBOL_T_Incmem = 55,                  /* T_Incmem  */
+  YYSYMBOL_T_Initalloc = 56,               /* T_Initalloc  */
+  YYSYMBOL_T_Initmem = 57,                 /* T_Initmem  */
+  YYSYMBOL_T_Includefile = 58,             /* T_Includefile  */
+  YYSYMBOL_T_Integer = 59,                 /* T_Integer  */
+  YYSYMBOL_T_Interface = 60,               /* T_Interface  */
+  YYSYMBOL_T_Intrange = 61,                /* T_Intrange  */
+  YYSYMBOL_T_Io = 62,                      /* T_Io  */
+  YYSYMBOL_T_Iocpu = 63,                   /* T_Iocpu  */
+  YYSYMBOL_T_Ipv4 = 64,                    /* T_Ipv4  */
+  YYSYMBOL_T_Ipv4_flag = 65,               /* T_Ipv4_flag  */
+  YYSYMBOL_T_Ipv6 = 66,                    /* T_Ipv6  */
+  YYSYMBOL_T_Ipv6_flag = 67,               /* T_Ipv6_flag  */
+  YYSYMBOL_T_Kelimit = 68,                 /* T_Kelimit  */
+  YYSYMBOL_T_Kernel = 69,                  /* T_Kernel  */
+  YYSYMBOL_T_Ketimeout = 70,               /* T_Ketimeout  */
+  YYSYMBOL_T_Keworkers = 71,               /* T_Keworkers  */
+  YYSYMBOL_T_Key = 72,                     /* T_Key  */
+  YYSYMBOL_T_Keys = 73,                    /* T_Keys  */
+  YYSYMBOL_T_Kod = 74,                     /* T_Kod  */
+  YYSYMBOL_T_Mssntp = 75,                  /* T_Mssntp  */
+  YYSYMBOL_T_Leapfile = 76,                /* T_Leapfile  */
+  YYSYMBOL_T_Leapsmearinterval = 77,       /* T_Leapsmearinterval  */
+  YYSYMBOL_T_Limit = 78,                   /* T_Limit  */
+  YYSYMBOL_T_Limited = 79,                 /* T_Limited  */
+  YYSYMBOL_T_Link = 80,                    /* T_Link  */
+  YYSYMBOL_T_Listen = 81,                  /* T_Listen  */
+  YYSYMBOL_T_Logconfig = 82,               /* T_Logconfig  */
+  YYSYMBOL_T_Logfile = 83,                 /* T_Logfile  */
+  YYSYMBOL_T_Loopstats = 84,               /* T_Loopstats  */
+  YYSYMBOL_T_Mask = 85,                    /* T_Mask  */
+  YYSYMBOL_T_Maxage = 86,                  /* T_Maxage  */
+  YYSYMBOL_T_Maxclock = 87,                /* T_Maxclock  */
+  YYSYMBOL_T_Maxdepth = 88,                /* T_Maxdepth  */
+  YYSYMBOL_T_Maxdisp = 89,                 /* T_Maxdisp  */
+  YYSYMBOL_T_Maxdist = 90,                 /* T_Maxdist  */
+  YYSYMBOL_T_Maxmem = 91,                  /* T_Maxmem  */
+  YYSYMBOL_T_Maxpoll = 92,                 /* T_Maxpoll  */
+  YYSYMBOL_T_Maxtls = 93,                  /* T_Maxtls  */
+  YYSYMBOL_T_Mdnstries = 94,               /* T_Mdnstries  */
+  YYSYMBOL_T_Mem = 95,                     /* T_Mem  */
+  YYSYMBOL_T_Memlock = 96,                 /* T_Memlock  */
+  YYSYMBOL_T_Minage = 97,                  /* T_Minage  */
+  YYSYMBOL_T_Minclock = 98,                /* T_Minclock  */
+  YYSYMBOL_T_Mindepth = 99,                /* T_Mindepth  */
+  YYSYMBOL_T_Mindist = 100,                /* T_Mindist  */
+  YYSYMBOL_T_Minpoll = 101,                /* T_Minpoll  */
+  YYSYMBOL_T_Minsane = 102,                /* T_Minsane  */
+  YYSYMBOL_T_Mintls = 103,                 /* T_Mintls  */
+  YYSYMBOL_T_Mode = 104,                   /* T_Mode  */
+  YYSYMBOL_T_Monitor = 105,                /* T_Monitor  */
+  YYSYMBOL_T_Month = 106,                  /* T_Month  */
+  YYSYMBOL_T_Mru = 107,                    /* T_Mru  */
+  YYSYMBOL_T_Nic = 108,                    /* T_Nic  */
+  YYSYMBOL_T_Nolink = 109,                 /* T_Nolink  */
+  YYSYMBOL_T_Nomodify = 110,               /* T_Nomodify  */
+  YYSYMBOL_T_Nomrulist = 111,              /* T_Nomrulist  */
+  YYSYMBOL_T_None = 112,                   /* T_None  */
+  YYSYMBOL_T_Nonvolatile = 113,            /* T_Nonvolatile  */
+  YYSYMBOL_T_Nopeer = 114,                 /* T_Nopeer  */
+  YYSYMBOL_T_Noquery = 115,                /* T_Noquery  */
+  YYSYMBOL_T_Noselect = 116,               /* T_Noselect  */
+  YYSYMBOL_T_Noserve = 117,                /* T_Noserve  */
+  YYSYMBOL_T_Notrap = 118,                 /* T_Notrap  */
+  YYSYMBOL_T_Notrust = 119,                /* T_Notrust  */
+  YYSYMBOL_T_Noval = 120,                  /* T_Noval  */
+  YYSYMBOL_T_Ntp = 121,                    /* T_Ntp  */
+  YYSYMBOL_T_Ntpport = 122,                /* T_Ntpport  */
+  YYSYMBOL_T_NtpSignDsocket = 123,         /* T_NtpSignDsocket  */
+  YYSYMBOL_T_Nts = 124,                    /* T_Nts  */
+  YYSYMBOL_T_Ntsstats = 125,               /* T_Ntsstats  */
+  YYSYMBOL_T_Ntskestats = 126,             /* T_Ntskestats  */
+  YYSYMBOL_T_Orphan = 127,                 /* T_Orphan  */
+  YYSYMBOL_T_Orphanwait = 128,             /* T_Orphanwait  */
+  YYSYMBOL_T_Panic = 129,                  /* T_Panic  */
+  YYSYMBOL_T_Path = 130,                   /* T_Path  */
+  YYSYMBOL_T_Peer = 131,                   /* T_Peer  */
+  YYSYMBOL_T_Peerstats = 132,              /* T_Peerstats  */
+  YYSYMBOL_T_Phone = 133,                  /* T_Phone  */
+  YYSYMBOL_T_Pid = 134,                    /* T_Pid  */
+  YYSYMBOL_T_Pidfile = 135,                /* T_Pidfile  */
+  YYSYMBOL_T_Pool = 136,                   /* T_Pool  */
+  YYSYMBOL_T_Port = 137,                   /* T_Port  */
+  YYSYMBOL_T_Ppspath = 138,                /* T_Ppspath  */
+  YYSYMBOL_T_Prefer = 139,                 /* T_Prefer  */
+  YYSYMBOL_T_Prefixaverage = 140,          /* T_Prefixaverage  */
+  YYSYMBOL_T_Prefixkod = 141,              /* T_Prefixkod  */
+  YYSYMBOL_T_Prefixv4 = 142,               /* T_Prefixv4  */
+  YYSYMBOL_T_Prefixv6 = 143,               /* T_Prefixv6  */
+  YYSYMBOL_T_Protostats = 144,             /* T_Protostats  */
+  YYSYMBOL_T_Rawstats = 145,               /* T_Rawstats  */
+  YYSYMBOL_T_Refclock = 146,               /* T_Refclock  */
+  YYSYMBOL_T_Refid = 147,                  /* T_Refid  */
+  YYSYMBOL_T_Requestkey = 148,             /* T_Requestkey  */
+  YYSYMBOL_T_Require = 149,                /* T_Require  */
+  YYSYMBOL_T_Recvbatch = 150,              /* T_Recvbatch  */
+  YYSYMBOL_T_Reset = 151,                  /* T_Reset  */
+  YYSYMBOL_T_Restrict = 152,               /* T_Restrict  */
+  YYSYMBOL_T_Rlimit = 153,                 /* T_Rlimit  */
+  YYSYMBOL_T_Saveconfigdir = 154,          /* T_Saveconfigdir  */
+  YYSYMBOL_T_Server = 155,                 /* T_Server  */
+  YYSYMBOL_T_Setvar = 156,                 /* T_Setvar  */
+  YYSYMBOL_T_Source = 157,                 /* T_Source  */
+  YYSYMBOL_T_Stacksize = 158,              /* T_Stacksize  */
+  YYSYMBOL_T_Stagestats = 159,             /* T_Stagestats  */
+  YYSYMBOL_T_Stagetime = 160,              /* T_Stagetime  */
+  YYSYMBOL_T_Statistics = 161,             /* T_Statistics  */
+  YYSYMBOL_T_Stats = 162,                  /* T_Stats  */
+  YYSYMBOL_T_Statsdir = 163,               /* T_Statsdir  */
+  YYSYMBOL_T_Step = 164,                   /* T_Step  */
+  YYSYMBOL_T_Stepback = 165,               /* T_Stepback  */
+  YYSYMBOL_T_Stepfwd = 166,                /* T_Stepfwd  */
+  YYSYMBOL_T_Stepout = 167,                /* T_Stepout  */
+  YYSYMBOL_T_Stratum = 168,                /* T_Stratum  */
+  YYSYMBOL_T_Subtype = 169,                /* T_Subtype  */
+  YYSYMBOL_T_String = 170,                 /* T_String  */
+  YYSYMBOL_T_Sys = 171,                    /* T_Sys  */
+  YYSYMBOL_T_Sysstats = 172,               /* T_Sysstats  */
+  YYSYMBOL_T_Tick = 173,                   /* T_Tick  */
+  YYSYMBOL_T_Time1 = 174,                  /* T_Time1  */
+  YYSYMBOL_T_Time2 = 175,                  /* T_Time2  */
+  YYSYMBOL_T_Timer = 176,                  /* T_Timer  */
+  YYSYMBOL_T_Tinker = 177,                 /* T_Tinker  */
+  YYSYMBOL_T_Tlsciphersuites = 178,        /* T_Tlsciphersuites  */
+  YYSYMBOL_T_Tlsecdhcurves = 179,          /* T_Tlsecdhcurves  */
+  YYSYMBOL_T_Tlscipherserverpreference = 180, /* T_Tlscipherserverpreference  */
+  YYSYMBOL_T_Tos = 181,                    /* T_Tos  */
+  YYSYMBOL_T_True = 182,                   /* T_True  */
+  YYSYMBOL_T_Trustedkey = 183,             /* T_Trustedkey  */
+  YYSYMBOL_T_Txstamps = 184,               /* T_Txstamps  */
+  YYSYMBOL_T_Type = 185,                   /* T_Type  */
+  YYSYMBOL_T_U_int = 186,                  /* T_U_int  */
+  YYSYMBOL_T_Unit = 187,                   /* T_Unit  */
+  YYSYMBOL_T_Unconfig = 188,               /* T_Unconfig  */
+  YYSYMBOL_T_Unpeer = 189,                 /* T_Unpeer  */
+  YYSYMBOL_T_Unrestrict = 190,             /* T_Unrestrict  */
+  YYSYMBOL_T_Uring = 191,                  /* T_Uring  */
+  YYSYMBOL_T_Usestats = 192,               /* T_Usestats  */
+  YYSYMBOL_T_Version = 193,                /* T_Version  */
+  YYSYMBOL_T_WanderThreshold = 194,        /* T_WanderThreshold  */
+  YYSYMBOL_T_Week = 195,                   /* T_Week  */
+  YYSYMBOL_T_Wildcard = 196,               /* T_Wildcard  */
+  YYSYMBOL_T_Workers = 197,                /* T_Workers  */
+  YYSYMBOL_T_Year = 198,                   /* T_Year  */
+  YYSYMBOL_T_Flag = 199,                   /* T_Flag  */
+  YYSYMBOL_T_EOC = 200,                    /* T_EOC  */
+  YYSYMBOL_201_ = 201,                     /* '='  */
+  YYSYMBOL_202_ = 202,                     /* '('  */
+  YYSYMBOL_203_ = 203,                     /* ')'  */
+  YYSYMBOL_YYACCEPT = 204,                 /* $accept  */
+  YYSYMBOL_configuration = 205,            /* configuration  */
+  YYSYMBOL_command_list = 206,             /* command_list  */
+  YYSYMBOL_command = 207,                  /* command  */
+  YYSYMBOL_server_command = 208,           /* server_command  */
+  YYSYMBOL_client_type = 209,              /* client_type  */
+  YYSYMBOL_address = 210,                  /* address  */
+  YYSYMBOL_ip_address = 211,               /* ip_address  */
+  YYSYMBOL_address_fam = 212,              /* address_fam  */
+  YYSYMBOL_option_list = 213,              /* option_list  */
+  YYSYMBOL_option = 214,                   /* option  */
+  YYSYMBOL_option_flag = 215,              /* option_flag  */
+  YYSYMBOL_option_flag_keyword = 216,      /* option_flag_keyword  */
+  YYSYMBOL_option_int = 217,               /* option_int  */
+  YYSYMBOL_option_int_keyword = 218,       /* option_int_keyword  */
+  YYSYMBOL_option_double = 219,            /* option_double  */
+  YYSYMBOL_option_boolean = 220,           /* option_boolean  */
+  YYSYMBOL_option_string = 221,            /* option_string  */
+  YYSYMBOL_option_double_keyword = 222,    /* option_double_keyword  */
+  YYSYMBOL_option_bool_keyword = 223,      /* option_bool_keyword  */
+  YYSYMBOL_unpeer_command = 224,           /* unpeer_command  */
+  YYSYMBOL_unpeer_keyword = 225,           /* unpeer_keyword  */
+  YYSYMBOL_other_mode_command = 226,       /* other_mode_command  */
+  YYSYMBOL_authentication_command = 227,   /* authentication_command  */
+  YYSYMBOL_orphan_mode_command = 228,      /* orphan_mode_command  */
+  YYSYMBOL_tos_option_list = 229,          /* tos_option_list  */
+  YYSYMBOL_tos_option = 230,               /* tos_option  */
+  YYSYMBOL_tos_option_int_keyword = 231,   /* tos_option_int_keyword  */
+  YYSYMBOL_tos_option_dbl_keyword = 232,   /* tos_option_dbl_keyword  */
+  YYSYMBOL_monitoring_command = 233,       /* monitoring_command  */
+  YYSYMBOL_stats_list = 234,               /* stats_list  */
+  YYSYMBOL_stat = 235,                     /* stat  */
+  YYSYMBOL_filegen_option_list = 236,      /* filegen_option_list  */
+  YYSYMBOL_filegen_option = 237,           /* filegen_option  */
+  YYSYMBOL_link_nolink = 238,              /* link_nolink  */
+  YYSYMBOL_enable_disable = 239,           /* enable_disable  */
+  YYSYMBOL_filegen_type = 240,             /* filegen_type  */
+  YYSYMBOL_restrict_prefix = 241,          /* restrict_prefix  */
+  YYSYMBOL_access_control_command = 242,   /* access_control_command  */
+  YYSYMBOL_ac_flag_list = 243,             /* ac_flag_list  */
+  YYSYMBOL_access_control_flag = 244,      /* access_control_flag  */
+  YYSYMBOL_limit_option_list = 245,        /* limit_option_list  */
+  YYSYMBOL_limit_option = 246,             /* limit_option  */
+  YYSYMBOL_limit_option_keyword = 247,     /* limit_option_keyword  */
+  YYSYMBOL_mru_option_list = 248,          /* mru_option_list  */
+  YYSYMBOL_mru_option = 249,               /* mru_option  */
+  YYSYMBOL_mru_option_keyword = 250,       /* mru_option_keyword  */
+  YYSYMBOL_fudge_command = 251,            /* fudge_command  */
+  YYSYMBOL_fudge_factor_list = 252,        /* fudge_factor_list  */
+  YYSYMBOL_fudge_factor = 253,             /* fudge_factor  */
+  YYSYMBOL_fudge_factor_dbl_keyword = 254, /* fudge_factor_dbl_keyword  */
+  YYSYMBOL_fudge_factor_bool_keyword = 255, /* fudge_factor_bool_keyword  */
+  YYSYMBOL_refclock_command = 256,         /* refclock_command  */
+  YYSYMBOL_optional_unit = 257,            /* optional_unit  */
+  YYSYMBOL_rlimit_command = 258,           /* rlimit_command  */
+  YYSYMBOL_rlimit_option_list = 259,       /* rlimit_option_list  */
+  YYSYMBOL_rlimit_option = 260,            /* rlimit_option  */
+  YYSYMBOL_rlimit_option_keyword = 261,    /* rlimit_option_keyword  */
+  YYSYMBOL_system_option_command = 262,    /* system_option_command  */
+  YYSYMBOL_system_option_list = 263,       /* system_option_list  */
+  YYSYMBOL_system_option = 264,            /* system_option  */
+  YYSYMBOL_system_option_flag_keyword = 265, /* system_option_flag_keyword  */
+  YYSYMBOL_system_option_local_flag_keyword = 266, /* system_option_local_flag_keyword  */
+  YYSYMBOL_extra_command = 267,            /* extra_command  */
+  YYSYMBOL_extra_option_list = 268,        /* extra_option_list  */
+  YYSYMBOL_extra_option = 269,             /* extra_option  */
+  YYSYMBOL_extra_option_keyword = 270,     /* extra_option_keyword  */
+  YYSYMBOL_tinker_command = 271,           /* tinker_command  */
+  YYSYMBOL_tinker_option_list = 272,       /* tinker_option_list  */
+  YYSYMBOL_tinker_option = 273,            /* tinker_option  */
+  YYSYMBOL_tinker_option_keyword = 274,    /* tinker_option_keyword  */
+  YYSYMBOL_nts_command = 275,              /* nts_command  */
+  YYSYMBOL_nts_option_list = 276,          /* nts_option_list  */
+  YYSYMBOL_nts_option = 277,               /* nts_option  */
+  YYSYMBOL_nts_string_option_keyword = 278, /* nts_string_option_keyword  */
+  YYSYMBOL_nts_number_option_keyword = 279, /* nts_number_option_keyword  */
+  YYSYMBOL_miscellaneous_command = 280,    /* miscellaneous_command  */
+  YYSYMBOL_misc_cmd_dbl_keyword = 281,     /* misc_cmd_dbl_keyword  */
+  YYSYMBOL_misc_cmd_int_keyword = 282,     /* misc_cmd_int_keyword  */
+  YYSYMBOL_misc_cmd_str_keyword = 283,     /* misc_cmd_str_keyword  */
+  YYSYMBOL_misc_cmd_str_lcl_keyword = 284, /* misc_cmd_str_lcl_keyword  */
+  YYSYMBOL_drift_parm = 285,               /* drift_parm  */
+  YYSYMBOL_variable_assign = 286,          /* variable_assign  */
+  YYSYMBOL_t_default_or_zero = 287,        /* t_default_or_zero  */
+  YYSYMBOL_log_config_list = 288,          /* log_config_list  */
+  YYSYMBOL_log_config_command = 289,       /* log_config_command  */
+  YYSYMBOL_interface_command = 290,        /* interface_command  */
+  YYSYMBOL_interface_nic = 291,            /* interface_nic  */
+  YYSYMBOL_nic_rule_class = 292,           /* nic_rule_class  */
+  YYSYMBOL_nic_rule_action = 293,          /* nic_rule_action  */
+  YYSYMBOL_reset_command = 294,            /* reset_command  */
+  YYSYMBOL_counter_set_list = 295,         /* counter_set_list  */
+  YYSYMBOL_counter_set_keyword = 296,      /* counter_set_keyword  */
+  YYSYMBOL_integer_list_range = 297,       /* integer_list_range  */
+  YYSYMBOL_integer_list_range_elt = 298,   /* integer_list_range_elt  */
+  YYSYMBOL_integer_range = 299,            /* integer_range  */
+  YYSYMBOL_string_list = 300,              /* string_list  */
+  YYSYMBOL_boolean = 301,                  /* boolean  */
+  YYSYMBOL_number = 302                    /* number  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  223
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   635
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  204
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  99
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  324
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  415
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   455
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_uint8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+     202,   203,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,   201,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
+     125,   126,   127,   128,   129,   130,   131,   132,   133,   134,
+     135,   136,   137,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,   147,   148,   149,   150,   151,   152,   153,   154,
+     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
+     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
+     175,   176,   177,   178,   179,   180,   181,   182,   183,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193,   194,
+     195,   196,   197,   198,   199,   200
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   341,   341,   345,   346,   347,   363,   364,   365,   366,
+     367,   368,   369,   370,   371,   372,   373,   374,   375,   376,
+     377,   378,   386,   396,   397,   398,   402,   403,   408,   413,
+     415,   421,   422,   430,   431,   432,   433,   434,   438,   443,
+     444,   445,   446,   447,   448,   449,   453,   455,   457,   469,
+     470,   471,   472,   473,   474,   475,   476,   480,   485,   490,
+     492,   494,   496,   498,   500,   502,   504,   509,   510,   511,
+     515,   516,   517,   518,   527,   535,   549,   550,   559,   570,
+     572,   574,   580,   582,   592,   597,   602,   610,   612,   614,
+     619,   620,   621,   622,   623,   627,   628,   629,   630,   631,
+     640,   642,   651,   661,   666,   674,   675,   676,   677,   678,
+     679,   680,   681,   682,   683,   688,   689,   697,   707,   716,
+     731,   736,   737,   741,   742,   746,   747,   748,   749,   750,
+     751,   752,   761,   762,   766,   770,   774,   782,   790,   798,
+     813,   828,   837,   851,   852,   860,   861,   862,   863,   864,
+     865,   866,   867,   868,   869,   870,   871,   872,   873,   877,
+     882,   890,   895,   896,   897,   898,   899,   900,   901,   905,
+     910,   918,   923,   924,   925,   926,   927,   928,   929,   930,
+     931,   939,   949,   954,   962,   964,   966,   975,   980,   981,
+     985,   986,   987,   988,   996,  1008,  1010,  1020,  1025,  1030,
+    1038,  1043,  1044,  1045,  1054,  1056,  1061,  1066,  1074,  1076,
+    1093,  1094,  1095,  1096,  1100,  1108,  1113,  1118,  1126,  1131,
+    1132,  1133,  1134,  1135,  1136,  1137,  1138,  1139,  1148,  1153,
+    1158,  1166,  1171,  1172,  1173,  1174,  1175,  1176,  1177,  1178,
+    1179,  1188,  1193,  1198,  1206,  1208,  1210,  1212,  1214,  1216,
+    1223,  1224,  1225,  1226,  1227,  1228,  1229,  1230,  1231,  1235,
+    1236,  1237,  1238,  1246,  1247,  1248,  1255,  1262,  1269,  1285,
+    1304,  1306,  1308,  1310,  1312,  1317,  1318,  1322,  1326,  1335,
+    1339,  1340,  1341,  1345,  1356,  1366,  1375,  1380,  1382,  1386,
+    1391,  1399,  1424,  1431,  1441,  1442,  1446,  1447,  1448,  1449,
+    1453,  1454,  1455,  1459,  1464,  1469,  1477,  1478,  1479,  1480,
+    1481,  1482,  1483,  1493,  1498,  1506,  1508,  1512,  1517,  1522,
+    1530,  1539,  1540,  1544,  1545
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "T_Aead", "T_Age",
+  "T_All", "T_Allan", "T_Allpeers", "T_Ask", "T_Auth", "T_Average",
+  "T_Baud", "T_Bias", "T_Burst", "T_Busypoll", "T_Calibrate", "T_Ca",
+  "T_Ceiling", "T_Cert", "T_Clock", "T_Clockstats", "T_Cohort", "T_Cookie",
+  "T_ControlKey", "T_Ctl", "T_Day", "T_Default", "T_Disable",
+  "T_Dispersion", "T_Double", "T_Driftfile", "T_Drop", "T_Dscp",
+  "T_Expire", "T_Extra", "T_Ellipsis", "T_Enable", "T_End", "T_False",
+  "T_File", "T_Filegen", "T_Filenum", "T_Flag1", "T_Flag2", "T_Flag3",
+  "T_Flag4", "T_Flake", "T_Floor", "T_Freq", "T_Fudge", "T_Huffpuff",
+  "T_Iburst", "T_Ifdeltas", "T_Ignore", "T_Incalloc", "T_Incmem",
+  "T_Initalloc", "T_Initmem", "T_Includefile", "T_Integer", "T_Interface",
+  "T_Intrange", "T_Io", "T_Iocpu", "T_Ipv4", "T_Ipv4_flag", "T_Ipv6",
+  "T_Ipv6_flag", "T_Kelimit", "T_Kernel", "T_Ketimeout", "T_Keworkers",
+  "T_Key", "T_Keys", "T_Kod", "T_Mssntp", "T_Leapfile",
+  "T_Leapsmearinterval", "T_Limit", "T_Limited", "T_Link", "T_Listen",
+  "T_Logconfig", "T_Logfile", "T_Loopstats", "T_Mask", "T_Maxage",
+  "T_Maxclock", "T_Maxdepth", "T_Maxdisp", "T_Maxdist", "T_Maxmem",
+  "T_Maxpoll", "T_Maxtls", "T_Mdnstries", "T_Mem", "T_Memlock", "T_Minage",
+  "T_Minclock", "T_Mindepth", "T_Mindist", "T_Minpoll", "T_Minsane",
+  "T_Mintls", "T_Mode", "T_Monitor", "T_Month", "T_Mru", "T_Nic",
+  "T_Nolink", "T_Nomodify", "T_Nomrulist", "T_None", "T_Nonvolatile",
+  "T_Nopeer", "T_Noquery", "T_Noselect", "T_Noserve", "T_Notrap",
+  "T_Notrust", "T_Noval", "T_Ntp", "T_Ntpport", "T_NtpSignDsocket",
+  "T_Nts", "T_Ntsstats", "T_Ntskestats", "T_Orphan", "T_Orphanwait",
+  "T_Panic", "T_Path", "T_Peer", "T_Peerstats", "T_Phone", "T_Pid",
+  "T_Pidfile", "T_Pool", "T_Port", "T_Ppspath", "T_Prefer",
+  "T_Prefixaverage", "T_Prefixkod", "T_Prefixv4", "T_Prefixv6",
+  "T_Protostats", "T_Rawstats", "T_Refclock", "T_Refid", "T_Requestkey",
+  "T_Require", "T_Recvbatch", "T_Reset", "T_Restrict", "T_Rlimit",
+  "T_Saveconfigdir", "T_Server", "T_Setvar", "T_Source", "T_Stacksize",
+  "T_Stagestats", "T_Stagetime", "T_Statistics", "T_Stats", "T_Statsdir",
+  "T_Step", "T_Stepback", "T_Stepfwd", "T_Stepout", "T_Stratum",
+  "T_Subtype", "T_String", "T_Sys", "T_Sysstats", "T_Tick", "T_Time1",
+  "T_Time2", "T_Timer", "T_Tinker", "T_Tlsciphersuites", "T_Tlsecdhcurves",
+  "T_Tlscipherserverpreference", "T_Tos", "T_True", "T_Trustedkey",
+  "T_Txstamps", "T_Type", "T_U_int", "T_Unit", "T_Unconfig", "T_Unpeer",
+  "T_Unrestrict", "T_Uring", "T_Usestats", "T_Version",
+  "T_WanderThreshold", "T_Week", "T_Wildcard", "T_Workers", "T_Year",
+  "T_Flag", "T_EOC", "'='", "'('", "')'", "$accept", "configuration",
+  "command_list", "command", "server_command", "client_type", "address",
+  "ip_address", "address_fam", "option_list", "option", "option_flag",
+  "option_flag_keyword", "option_int", "option_int_keyword",
+  "option_double", "option_boolean", "option_string",
+  "option_double_keyword", "option_bool_keyword", "unpeer_command",
+  "unpeer_keyword", "other_mode_command", "authentication_command",
+  "orphan_mode_command", "tos_option_list", "tos_option",
+  "tos_option_int_keyword", "tos_option_dbl_keyword", "monitoring_command",
+  "stats_list", "stat", "filegen_option_list", "filegen_option",
+  "link_nolink", "enable_disable", "filegen_type", "restrict_prefix",
+  "access_control_command", "ac_flag_list", "access_control_flag",
+  "limit_option_list", "limit_option", "limit_option_keyword",
+  "mru_option_list", "mru_option", "mru_option_keyword", "fudge_command",
+  "fudge_factor_list", "fudge_factor", "fudge_factor_dbl_keyword",
+  "fudge_factor_bool_keyword", "refclock_command", "optional_unit",
+  "rlimit_command", "rlimit_option_list", "rlimit_option",
+  "rlimit_option_keyword", "system_option_command", "system_option_list",
+  "system_option", "system_option_flag_keyword",
+  "system_option_local_flag_keyword", "extra_command", "extra_option_list",
+  "extra_option", "extra_option_keyword", "tinker_command",
+  "tinker_option_list", "tinker_option", "tinker_option_keyword",
+  "nts_command", "nts_option_list", "nts_option",
+  "nts_string_option_keyword", "nts_number_option_keyword",
+  "miscellaneous_command", "misc_cmd_dbl_keyword", "misc_cmd_int_keyword",
+  "misc_cmd_str_keyword", "misc_cmd_str_lcl_keyword", "drift_parm",
+  "variable_assign", "t_default_or_zero", "log_config_list",
+  "log_config_command", "interface_command", "interface_nic",
+  "nic_rule_class", "nic_rule_action", "reset_command", "counter_set_list",
+  "counter_set_keyword", "integer_list_range", "integer_list_range_elt",
+  "integer_range", "string_list", "boolean", "number", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-242)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-7)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+       1,  -189,   -46,     7,  -151,  -242,    33,     7,  -242,    14,
+     -47,  -145,  -242,  -144,  -242,  -242,   260,  -134,  -242,   -19,
+     398,  -242,  -242,  -128,   235,  -242,  -121,  -242,  -242,  -118,
+      -6,    56,  -242,   -29,  -242,  -242,  -116,    14,  -115,  -242,
+      83,   308,   -27,  -242,  -242,  -242,    57,   310,  -131,  -242,
+     -47,  -242,    -9,  -242,  -242,  -242,  -242,   -22,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,   -13,    22,  -104,
+     -97,  -242,    60,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,     7,  -242,  -242,  -242,    53,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,    33,  -242,   -13,     7,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,   177,  -242,   -83,   445,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,   260,  -242,   -13,  -242,
+    -134,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,   398,  -242,    31,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,   -13,  -242,
+    -242,  -242,  -242,   235,  -242,   -76,   -13,  -242,   -73,   -88,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,    56,  -242,
+    -242,  -242,  -242,   -29,  -242,    41,  -100,  -242,    14,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+      83,  -242,   -13,  -242,   -15,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,   308,  -242,    43,   -13,  -242,    44,
+     -27,  -242,  -242,  -242,   -95,  -242,  -242,   -64,  -242,  -242,
+     -63,    89,    91,  -242,  -242,    35,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,    -2,  -242,  -242,  -242,  -242,
+      12,  -242,  -242,  -242,  -242,   -48,    68,  -242,  -242,   177,
+    -242,   -13,   -15,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,    71,  -242,  -242,  -242,  -242,
+     -26,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,   108,  -242,  -242,   192,   -88,   180,  -242,  -242,  -242,
+     180,   180,   -25,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,   -20,  -242,  -242,     4,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,   192,   140,   112,     2,     6,  -242,
+    -242,  -242,     9,    10,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,    11,    15,  -242,
+      17,    18,   118,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,   -44,  -242,  -242,  -242,   -13,   -15,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,   180,   180,   180,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,   -11,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,   180,  -242
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int16 yydefact[] =
+{
+       0,     0,     0,     0,   285,   277,     0,     0,   270,     0,
+       0,     0,   294,     0,   279,   278,     0,     0,   280,     0,
+       0,   295,   275,     0,     0,    25,     0,   281,    24,     0,
+       0,     0,   132,     0,   282,    23,     0,     0,     0,   276,
+       0,     0,     0,    76,    77,   133,     0,     2,     0,     7,
+       0,     8,     0,     9,    10,    13,    11,     0,    12,    14,
+      15,    16,    17,    18,    19,    20,    21,     0,     0,     0,
+       0,   263,     0,   264,     5,    79,   210,   211,   212,   213,
+     214,   205,   207,   208,   209,   283,   271,   219,   220,   221,
+     222,   223,   224,   225,   226,   227,   215,   217,     0,   204,
+     105,   106,   112,   113,   107,   110,   108,   114,   109,   111,
+     115,    29,    30,    28,     0,    26,     0,     6,    80,   162,
+     163,   164,   165,   166,   167,   168,   134,   160,     0,   291,
+     272,   290,    78,   172,   173,   174,   175,   176,   178,   179,
+     177,   180,   135,   170,     0,    83,   250,   251,   252,   253,
+     246,   247,   259,   260,   261,   254,   255,   256,     0,   262,
+     257,   258,   248,   241,   243,     0,     0,   319,   273,   195,
+      81,   306,   307,   308,   309,   310,   311,   312,   303,   305,
+     203,   201,   202,   197,   199,     0,     0,   274,   100,   104,
+     101,   232,   233,   234,   235,   236,   237,   238,   239,   240,
+     228,   230,     0,    90,     0,    91,    99,    96,    97,    98,
+      95,    94,    92,    93,    84,    86,     0,     0,   315,     0,
+      82,   314,   316,     1,     0,     4,    31,     0,    74,   143,
+       0,    29,    30,   143,   143,    26,   324,   323,   265,   266,
+     267,   268,   302,   301,   300,     0,   206,   284,   216,   218,
+     102,   190,   191,   192,   193,     0,     0,   188,   189,   181,
+     183,     0,     0,    27,   269,   159,   161,   289,   169,   171,
+     249,   242,   244,   245,   318,     0,    31,   304,   198,   200,
+       0,   103,   229,   231,   322,   320,   321,    89,    85,    87,
+      88,     0,   313,     3,    22,   195,   138,   143,   143,   143,
+     141,   136,     0,   296,   297,   298,   293,   299,   292,   124,
+     123,     0,   121,   122,     0,   116,   119,   120,   187,   186,
+     182,   184,   185,   196,   194,   288,     0,     0,     0,    56,
+      67,    39,     0,     0,    49,    70,    71,    72,    73,    40,
+      50,    52,    51,    53,    41,    42,    43,     0,     0,    44,
+       0,     0,     0,    54,    68,    69,    45,    55,    32,    33,
+      38,    34,     0,    35,    37,    36,     0,     0,    75,   145,
+     146,   147,   148,   149,   150,   151,   152,   153,   154,   155,
+     156,   157,   158,   144,   142,   139,   140,   143,   117,   131,
+     127,   129,   125,   126,   128,   130,   118,   287,   286,     0,
+      66,    62,    64,    65,    60,    61,    59,    63,    48,    46,
+      47,    57,    58,   137,   317
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -242,  -242,  -242,   -42,  -242,  -242,    36,   -56,  -242,   -80,
+    -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,  -242,   -16,  -242,  -242,  -242,
+    -242,   -23,  -242,  -242,  -242,  -242,  -242,  -242,  -242,  -227,
+    -242,  -242,    81,  -242,  -242,    67,  -242,  -242,  -242,   -45,
+    -242,  -242,  -242,   -84,  -242,  -242,    30,  -242,  -242,   208,
+     -72,  -242,  -242,  -242,  -242,   120,  -242,  -242,  -242,    23,
+    -242,  -242,  -242,    55,  -242,  -242,  -242,  -242,  -242,  -242,
+    -242,  -242,  -242,  -242,  -242,    98,  -242,  -242,  -242,  -242,
+    -242,  -242,    51,  -242,    19,  -242,  -242,  -241,   -98
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    46,    47,    48,    49,    50,   114,   115,   116,   294,
+     358,   359,   360,   361,   362,   363,   364,   365,   366,   367,
+      51,    52,    53,    54,    55,   214,   215,   216,   217,    56,
+     188,   110,   250,   315,   316,   317,   396,    57,    58,   296,
+     383,   126,   127,   128,   142,   143,   144,    59,   259,   260,
+     261,   262,    60,   276,    61,   183,   184,   185,    62,    81,
+      82,    83,    84,    63,    96,    97,    98,    64,   200,   201,
+     202,    65,   163,   164,   165,   166,    66,    67,    68,    69,
+      70,    86,   187,   398,   130,   131,    71,    72,   308,   245,
+      73,   178,   179,   220,   221,   222,   168,   287,   238
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+     249,   235,     1,   303,   229,   224,   300,   301,   389,   246,
+     227,    74,   180,    75,   189,   409,   236,   230,   111,    85,
+     112,   322,    76,   284,     2,   117,   118,   246,     3,   390,
+     266,     4,   218,     5,   100,     6,   129,     7,     8,   309,
+     132,     9,   145,   231,   285,   232,   237,    87,   310,   167,
+      10,   311,   169,   170,   186,   190,   111,   223,   112,    11,
+     270,    12,   304,   171,   305,   172,   240,   181,   273,   225,
+     384,   385,   386,   241,    13,   264,    77,    14,    15,    16,
+     173,   239,   247,    17,    18,    88,   226,   263,   228,   191,
+     269,   242,   312,   234,   272,    19,    89,   274,   101,   275,
+     279,   280,   289,   291,   283,   293,   295,   297,    20,    21,
+     391,   192,    78,   243,    22,   298,   392,   299,   174,   290,
+     302,   313,   318,   113,    23,    24,   412,   319,    79,   182,
+     323,   193,    25,   194,    26,   233,    27,    28,   393,   102,
+     103,   244,   410,   326,   325,   113,   104,    29,   113,    30,
+     388,   175,    31,    32,    33,    34,    35,    36,   105,   106,
+     413,   113,    37,   321,    38,   281,   397,   286,   306,    80,
+      90,   399,   400,   107,    39,   219,   401,   408,    40,   402,
+     403,   404,    41,    91,    42,   405,   108,   406,   407,    43,
+      44,    45,   414,    92,   307,   327,   324,   314,   288,   394,
+     328,    -6,   395,   329,   330,   331,   109,   265,   332,   268,
+     333,   368,   195,   278,   320,    99,   248,    93,   271,   251,
+     252,   253,   254,   282,    94,   334,   369,   176,   267,   277,
+      95,     0,   177,   370,   335,   336,   337,   338,   146,   292,
+       0,     0,     0,   339,     0,     0,   387,   196,   197,   198,
+     199,   147,     0,   148,   371,   372,     0,   149,     0,   373,
+       0,     0,   150,     0,   340,     0,     0,     0,   411,     0,
+     119,   151,     0,   120,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   341,     0,     0,     0,     0,     0,
+     374,   375,     0,   342,   376,   377,   343,   378,   379,   380,
+       0,     0,   381,   152,     0,   153,   154,   155,   344,     0,
+       0,     0,   345,     0,     0,     0,   346,     0,     0,     0,
+       0,     0,   347,     0,   255,   203,     0,     0,   156,   204,
+     348,   349,     0,     2,   121,     0,     0,     3,   157,   350,
+       4,   351,     5,     0,     6,   256,     7,     8,     0,     0,
+       9,   257,   258,     0,     0,   205,     0,     0,     0,    10,
+     352,   353,     0,     0,     0,     0,   354,   355,    11,     0,
+      12,   158,   159,   382,   356,     0,     0,     0,     0,     0,
+       0,     0,     0,    13,     0,   357,    14,    15,    16,     0,
+       0,     0,    17,    18,     0,   206,     0,   207,   208,     0,
+     122,   123,   124,   125,    19,     0,   209,     0,   210,     0,
+     211,     0,     0,   160,   161,   162,     0,    20,    21,     0,
+       0,     0,     0,    22,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    23,    24,   212,   213,     0,     0,     0,
+       0,    25,     0,    26,     0,    27,    28,     0,     0,     0,
+       0,     0,   133,   134,   135,   136,    29,     0,    30,     0,
+       0,    31,    32,    33,    34,    35,    36,     0,     2,     0,
+       0,    37,     3,    38,     0,     4,     0,     5,     0,     6,
+       0,     7,     8,    39,   137,     9,   138,    40,     0,   139,
+       0,    41,     0,    42,    10,   140,     0,   141,    43,    44,
+      45,     0,     0,    11,     0,    12,     0,     0,     0,     0,
+      -6,     0,     0,     0,     0,     0,     0,     0,    13,     0,
+       0,    14,    15,    16,     0,     0,     0,    17,    18,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    19,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    20,    21,     0,     0,     0,     0,    22,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    23,    24,
+       0,     0,     0,     0,     0,     0,    25,     0,    26,     0,
+      27,    28,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    29,     0,    30,     0,     0,    31,    32,    33,    34,
+      35,    36,     0,     0,     0,     0,    37,     0,    38,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    39,     0,
+       0,     0,    40,     0,     0,     0,    41,     0,    42,     0,
+       0,     0,     0,    43,    44,    45
+};
+
+static const yytype_int16 yycheck[] =
+{
+      98,    57,     1,     5,    26,    47,   233,   234,     4,    81,
+      19,   200,    41,    59,    37,    59,    29,    39,    65,   170,
+      67,   262,    15,    38,    23,   170,   170,    99,    27,    25,
+     128,    30,    59,    32,    20,    34,   170,    36,    37,    27,
+      59,    40,   170,    65,    59,    67,    59,    14,    36,   170,
+      49,    39,   170,    59,   170,   170,    65,     0,    67,    58,
+     158,    60,    64,     7,    66,     9,   170,    96,   166,   200,
+     297,   298,   299,   170,    73,   117,    69,    76,    77,    78,
+      24,    59,    29,    82,    83,    52,    50,   170,    52,     6,
+      59,    31,    80,    57,   170,    94,    63,   170,    84,   187,
+      59,   201,    59,    59,   202,   200,   170,   170,   107,   108,
+     106,    28,   105,    53,   113,    26,   112,    26,    62,   217,
+      85,   109,   170,   170,   123,   124,   367,    59,   121,   158,
+      59,    48,   131,    50,   133,   157,   135,   136,   134,   125,
+     126,    81,   186,    35,   170,   170,   132,   146,   170,   148,
+     170,    95,   151,   152,   153,   154,   155,   156,   144,   145,
+     387,   170,   161,   261,   163,   188,    26,   182,   170,   162,
+     137,    59,   170,   159,   173,   202,   170,    59,   177,   170,
+     170,   170,   181,   150,   183,   170,   172,   170,   170,   188,
+     189,   190,   203,   160,   196,     3,   276,   185,   214,   195,
+       8,   200,   198,    11,    12,    13,   192,   126,    16,   142,
+      18,   295,   129,   183,   259,     7,    96,   184,   163,    42,
+      43,    44,    45,   200,   191,    33,    46,   171,   130,   178,
+     197,    -1,   176,    53,    42,    43,    44,    45,     3,   220,
+      -1,    -1,    -1,    51,    -1,    -1,   302,   164,   165,   166,
+     167,    16,    -1,    18,    74,    75,    -1,    22,    -1,    79,
+      -1,    -1,    27,    -1,    72,    -1,    -1,    -1,   366,    -1,
+      10,    36,    -1,    13,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    92,    -1,    -1,    -1,    -1,    -1,
+     110,   111,    -1,   101,   114,   115,   104,   117,   118,   119,
+      -1,    -1,   122,    68,    -1,    70,    71,    72,   116,    -1,
+      -1,    -1,   120,    -1,    -1,    -1,   124,    -1,    -1,    -1,
+      -1,    -1,   130,    -1,   147,    17,    -1,    -1,    93,    21,
+     138,   139,    -1,    23,    74,    -1,    -1,    27,   103,   147,
+      30,   149,    32,    -1,    34,   168,    36,    37,    -1,    -1,
+      40,   174,   175,    -1,    -1,    47,    -1,    -1,    -1,    49,
+     168,   169,    -1,    -1,    -1,    -1,   174,   175,    58,    -1,
+      60,   136,   137,   193,   182,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    73,    -1,   193,    76,    77,    78,    -1,
+      -1,    -1,    82,    83,    -1,    87,    -1,    89,    90,    -1,
+     140,   141,   142,   143,    94,    -1,    98,    -1,   100,    -1,
+     102,    -1,    -1,   178,   179,   180,    -1,   107,   108,    -1,
+      -1,    -1,    -1,   113,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,   123,   124,   127,   128,    -1,    -1,    -1,
+      -1,   131,    -1,   133,    -1,   135,   136,    -1,    -1,    -1,
+      -1,    -1,    54,    55,    56,    57,   146,    -1,   148,    -1,
+      -1,   151,   152,   153,   154,   155,   156,    -1,    23,    -1,
+      -1,   161,    27,   163,    -1,    30,    -1,    32,    -1,    34,
+      -1,    36,    37,   173,    86,    40,    88,   177,    -1,    91,
+      -1,   181,    -1,   183,    49,    97,    -1,    99,   188,   189,
+     190,    -1,    -1,    58,    -1,    60,    -1,    -1,    -1,    -1,
+     200,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    73,    -1,
+      -1,    76,    77,    78,    -1,    -1,    -1,    82,    83,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    94,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   107,   108,    -1,    -1,    -1,    -1,   113,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   123,   124,
+      -1,    -1,    -1,    -1,    -1,    -1,   131,    -1,   133,    -1,
+     135,   136,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   146,    -1,   148,    -1,    -1,   151,   152,   153,   154,
+     155,   156,    -1,    -1,    -1,    -1,   161,    -1,   163,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   173,    -1,
+      -1,    -1,   177,    -1,    -1,    -1,   181,    -1,   183,    -1,
+      -1,    -1,    -1,   188,   189,   190
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int16 yystos[] =
+{
+       0,     1,    23,    27,    30,    32,    34,    36,    37,    40,
+      49,    58,    60,    73,    76,    77,    78,    82,    83,    94,
+     107,   108,   113,   123,   124,   131,   133,   135,   136,   146,
+     148,   151,   152,   153,   154,   155,   156,   161,   163,   173,
+     177,   181,   183,   188,   189,   190,   205,   206,   207,   208,
+     209,   224,   225,   226,   227,   228,   233,   241,   242,   251,
+     256,   258,   262,   267,   271,   275,   280,   281,   282,   283,
+     284,   290,   291,   294,   200,    59,    15,    69,   105,   121,
+     162,   263,   264,   265,   266,   170,   285,    14,    52,    63,
+     137,   150,   160,   184,   191,   197,   268,   269,   270,   263,
+      20,    84,   125,   126,   132,   144,   145,   159,   172,   192,
+     235,    65,    67,   170,   210,   211,   212,   170,   170,    10,
+      13,    74,   140,   141,   142,   143,   245,   246,   247,   170,
+     288,   289,    59,    54,    55,    56,    57,    86,    88,    91,
+      97,    99,   248,   249,   250,   170,     3,    16,    18,    22,
+      27,    36,    68,    70,    71,    72,    93,   103,   136,   137,
+     178,   179,   180,   276,   277,   278,   279,   170,   300,   170,
+      59,     7,     9,    24,    62,    95,   171,   176,   295,   296,
+      41,    96,   158,   259,   260,   261,   170,   286,   234,   235,
+     170,     6,    28,    48,    50,   129,   164,   165,   166,   167,
+     272,   273,   274,    17,    21,    47,    87,    89,    90,    98,
+     100,   102,   127,   128,   229,   230,   231,   232,    59,   202,
+     297,   298,   299,     0,   207,   200,   210,    19,   210,    26,
+      39,    65,    67,   157,   210,   211,    29,    59,   302,    59,
+     170,   170,    31,    53,    81,   293,   264,    29,   269,   302,
+     236,    42,    43,    44,    45,   147,   168,   174,   175,   252,
+     253,   254,   255,   170,   207,   246,   302,   289,   249,    59,
+     302,   277,   170,   302,   170,   187,   257,   296,   260,    59,
+     201,   235,   273,   302,    38,    59,   182,   301,   230,    59,
+     302,    59,   298,   200,   213,   170,   243,   170,    26,    26,
+     243,   243,    85,     5,    64,    66,   170,   196,   292,    27,
+      36,    39,    80,   109,   185,   237,   238,   239,   170,    59,
+     253,   302,   301,    59,   213,   170,    35,     3,     8,    11,
+      12,    13,    16,    18,    33,    42,    43,    44,    45,    51,
+      72,    92,   101,   104,   116,   120,   124,   130,   138,   139,
+     147,   149,   168,   169,   174,   175,   182,   193,   214,   215,
+     216,   217,   218,   219,   220,   221,   222,   223,   257,    46,
+      53,    74,    75,    79,   110,   111,   114,   115,   117,   118,
+     119,   122,   193,   244,   243,   243,   243,   211,   170,     4,
+      25,   106,   112,   134,   195,   198,   240,    26,   287,    59,
+     170,   170,   170,   170,   170,   170,   170,   170,    59,    59,
+     186,   302,   301,   243,   203
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int16 yyr1[] =
+{
+       0,   204,   205,   206,   206,   206,   207,   207,   207,   207,
+     207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
+     207,   207,   208,   209,   209,   209,   210,   210,   211,   212,
+     212,   213,   213,   214,   214,   214,   214,   214,   215,   216,
+     216,   216,   216,   216,   216,   216,   217,   217,   217,   218,
+     218,   218,   218,   218,   218,   218,   218,   219,   220,   221,
+     221,   221,   221,   221,   221,   221,   221,   222,   222,   222,
+     223,   223,   223,   223,   224,   224,   225,   225,   226,   227,
+     227,   227,   227,   227,   228,   229,   229,   230,   230,   230,
+     231,   231,   231,   231,   231,   232,   232,   232,   232,   232,
+     233,   233,   233,   234,   234,   235,   235,   235,   235,   235,
+     235,   235,   235,   235,   235,   236,   236,   237,   237,   237,
+     237,   238,   238,   239,   239,   240,   240,   240,   240,   240,
+     240,   240,   241,   241,   242,   242,   242,   242,   242,   242,
+     242,   242,   242,   243,   243,   244,   244,   244,   244,   244,
+     244,   244,   244,   244,   244,   244,   244,   244,   244,   245,
+     245,   246,   247,   247,   247,   247,   247,   247,   247,   248,
+     248,   249,   250,   250,   250,   250,   250,   250,   250,   250,
+     250,   251,   252,   252,   253,   253,   253,   253,   254,   254,
+     255,   255,   255,   255,   256,   257,   257,   258,   259,   259,
+     260,   261,   261,   261,   262,   262,   263,   263,   264,   264,
+     265,   265,   265,   265,   266,   267,   268,   268,   269,   270,
+     270,   270,   270,   270,   270,   270,   270,   270,   271,   272,
+     272,   273,   274,   274,   274,   274,   274,   274,   274,   274,
+     274,   275,   276,   276,   277,   277,   277,   277,   277,   277,
+     278,   278,   278,   278,   278,   278,   278,   278,   278,   279,
+     279,   279,   279,   280,   280,   280,   280,   280,   280,   280,
+     280,   280,   280,   280,   280,   281,   281,   282,   282,   283,
+     284,   284,   284,   285,   285,   285,   286,   287,   287,   288,
+     288,   289,   290,   290,   291,   291,   292,   292,   292,   292,
+     293,   293,   293,   294,   295,   295,   296,   296,   296,   296,
+     296,   296,   296,   297,   297,   298,   298,   299,   300,   300,
+     301,   301,   301,   302,   302
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     3,     2,     2,     0,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     3,     1,     1,     1,     1,     2,     1,     1,
+       1,     0,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     2,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     1,     1,     1,
+       1,     1,     1,     1,     2,     4,     1,     1,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     2,     2,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     2,     3,     2,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     0,     2,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     2,     2,     3,     5,     3,     4,
+       4,     3,     4,     0,     2,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     2,
+       1,     2,     1,     1,     1,     1,     1,     1,     1,     2,
+       1,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     2,     1,     2,     2,     2,     2,     1,     1,
+       1,     1,     1,     1,     4,     0,     2,     2,     2,     1,
+       2,     1,     1,     1,     2,     2,     2,     1,     1,     1,
+       1,     1,     1,     1,     1,     2,     2,     1,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     2,     2,
+       1,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     2,     2,     1,     2,     2,     1,     1,     1,     2,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     2,     2,     2,     2,     3,
+       1,     2,     2,     2,     2,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     2,     0,     4,     1,     0,     2,
+       1,     1,     3,     3,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     2,     2,     1,     1,     1,     1,     1,
+       1,     1,     1,     2,     1,     1,     1,     5,     2,     1,
+       1,     1,     1,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 5: /* command_list: error T_EOC  */
+#line 348 "/root/repo/ntpd/ntp_parser.y"
+                {
+			/* I will need to incorporate much more fine grained
+			 * error messages. The following should suffice for
+			 * the time being.
+			 */
+			struct FILE_INFO * ip_ctx = lex_current();
+			msyslog(LOG_ERR,
+				"CONFIG: syntax error in %s line %d, column %d",
+				ip_ctx->fname,
+				ip_ctx->errpos.nline,
+				ip_ctx->errpos.ncol);
+			parsing_errors++;
+		}
+#line 1826 "ntp_parser.tab.c"
+    break;
+
+  case 22: /* server_command: client_type address option_list  */
+#line 387 "/root/repo/ntpd/ntp_parser.y"
+                {
+			peer_node *my_node;
+
+			my_node = create_peer_node((yyvsp[-2].Integer), (yyvsp[-1].Address_node), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.peers, my_node);
+		}
+#line 1837 "ntp_parser.tab.c"
+    break;
+
+  case 27: /* address: address_fam T_String  */
+#line 404 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Address_node) = create_address_node((yyvsp[0].String), (yyvsp[-1].Integer)); }
+#line 1843 "ntp_parser.tab.c"
+    break;
+
+  case 28: /* ip_address: T_String  */
+#line 409 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Address_node) = create_address_node((yyvsp[0].String), AF_UNSPEC); }
+#line 1849 "ntp_parser.tab.c"
+    break;
+
+  case 29: /* address_fam: T_Ipv4_flag  */
+#line 414 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = AF_INET; }
+#line 1855 "ntp_parser.tab.c"
+    break;
+
+  case 30: /* address_fam: T_Ipv6_flag  */
+#line 416 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = AF_INET6; }
+#line 1861 "ntp_parser.tab.c"
+    break;
+
+  case 31: /* option_list: %empty  */
+#line 421 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val_fifo) = NULL; }
+#line 1867 "ntp_parser.tab.c"
+    break;
+
+  case 32: /* option_list: option_list option  */
+#line 423 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 1876 "ntp_parser.tab.c"
+    break;
+
+  case 38: /* option_flag: option_flag_keyword  */
+#line 439 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 1882 "ntp_parser.tab.c"
+    break;
+
+  case 46: /* option_int: option_int_keyword T_Integer  */
+#line 454 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 1888 "ntp_parser.tab.c"
+    break;
+
+  case 47: /* option_int: option_int_keyword T_U_int  */
+#line 456 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_uval((yyvsp[-1].Integer), (unsigned int)(yyvsp[0].Integer)); }
+#line 1894 "ntp_parser.tab.c"
+    break;
+
+  case 48: /* option_int: T_Stratum T_Integer  */
+#line 458 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) >= 0 && (yyvsp[0].Integer) <= STRATUM_UNSPEC) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("fudge factor: stratum value out of bounds, ignored");
+			}
+		}
+#line 1907 "ntp_parser.tab.c"
+    break;
+
+  case 57: /* option_double: option_double_keyword number  */
+#line 481 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 1913 "ntp_parser.tab.c"
+    break;
+
+  case 58: /* option_boolean: option_bool_keyword boolean  */
+#line 486 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 1919 "ntp_parser.tab.c"
+    break;
+
+  case 59: /* option_string: T_Refid T_String  */
+#line 491 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1925 "ntp_parser.tab.c"
+    break;
+
+  case 60: /* option_string: T_Path T_String  */
+#line 493 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1931 "ntp_parser.tab.c"
+    break;
+
+  case 61: /* option_string: T_Ppspath T_String  */
+#line 495 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1937 "ntp_parser.tab.c"
+    break;
+
+  case 62: /* option_string: T_Ask T_String  */
+#line 497 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1943 "ntp_parser.tab.c"
+    break;
+
+  case 63: /* option_string: T_Require T_String  */
+#line 499 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1949 "ntp_parser.tab.c"
+    break;
+
+  case 64: /* option_string: T_Ca T_String  */
+#line 501 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1955 "ntp_parser.tab.c"
+    break;
+
+  case 65: /* option_string: T_Cert T_String  */
+#line 503 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1961 "ntp_parser.tab.c"
+    break;
+
+  case 66: /* option_string: T_Aead T_String  */
+#line 505 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1967 "ntp_parser.tab.c"
+    break;
+
+  case 74: /* unpeer_command: unpeer_keyword address  */
+#line 528 "/root/repo/ntpd/ntp_parser.y"
+                {
+			unpeer_node *my_node;
+
+			my_node = create_unpeer_node((yyvsp[0].Address_node));
+			if (my_node)
+				APPEND_G_FIFO(cfgt.unpeers, my_node);
+		}
+#line 1979 "ntp_parser.tab.c"
+    break;
+
+  case 75: /* unpeer_command: unpeer_keyword T_Clock T_String optional_unit  */
+#line 536 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifdef REFCLOCK
+			unpeer_node *my_node;
+
+			my_node = create_unpeer_node(addr_from_typeunit((yyvsp[-1].String), (yyvsp[0].Integer)));
+			if (my_node)
+				APPEND_G_FIFO(cfgt.unpeers, my_node);
+#else
+			yyerror("no refclock support was compiled in.");
+#endif /* REFCLOCK */
+		}
+#line 1995 "ntp_parser.tab.c"
+    break;
+
+  case 78: /* other_mode_command: T_Mdnstries T_Integer  */
+#line 560 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.mdnstries = (yyvsp[0].Integer); }
+#line 2001 "ntp_parser.tab.c"
+    break;
+
+  case 79: /* authentication_command: T_ControlKey T_Integer  */
+#line 571 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.control_key = (yyvsp[0].Integer); }
+#line 2007 "ntp_parser.tab.c"
+    break;
+
+  case 80: /* authentication_command: T_Keys T_String  */
+#line 573 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.keys = (yyvsp[0].String); }
+#line 2013 "ntp_parser.tab.c"
+    break;
+
+  case 81: /* authentication_command: T_Requestkey T_Integer  */
+#line 575 "/root/repo/ntpd/ntp_parser.y"
+                        {
+			    msyslog(LOG_WARNING,
+				    "CONFIG: requestkey is a no-op because "
+				    "ntpdc has been removed.");
+			}
+#line 2023 "ntp_parser.tab.c"
+    break;
+
+  case 82: /* authentication_command: T_Trustedkey integer_list_range  */
+#line 581 "/root/repo/ntpd/ntp_parser.y"
+                { CONCAT_G_FIFOS(cfgt.auth.trusted_key_list, (yyvsp[0].Attr_val_fifo)); }
+#line 2029 "ntp_parser.tab.c"
+    break;
+
+  case 83: /* authentication_command: T_NtpSignDsocket T_String  */
+#line 583 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.ntp_signd_socket = (yyvsp[0].String); }
+#line 2035 "ntp_parser.tab.c"
+    break;
+
+  case 84: /* orphan_mode_command: T_Tos tos_option_list  */
+#line 593 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.orphan_cmds, (yyvsp[0].Attr_val_fifo)); }
+#line 2041 "ntp_parser.tab.c"
+    break;
+
+  case 85: /* tos_option_list: tos_option_list tos_option  */
+#line 598 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2050 "ntp_parser.tab.c"
+    break;
+
+  case 86: /* tos_option_list: tos_option  */
+#line 603 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2059 "ntp_parser.tab.c"
+    break;
+
+  case 87: /* tos_option: tos_option_int_keyword T_Integer  */
+#line 611 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (double)(yyvsp[0].Integer)); }
+#line 2065 "ntp_parser.tab.c"
+    break;
+
+  case 88: /* tos_option: tos_option_dbl_keyword number  */
+#line 613 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2071 "ntp_parser.tab.c"
+    break;
+
+  case 89: /* tos_option: T_Cohort boolean  */
+#line 615 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (double)(yyvsp[0].Integer)); }
+#line 2077 "ntp_parser.tab.c"
+    break;
+
+  case 100: /* monitoring_command: T_Statistics stats_list  */
+#line 641 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.stats_list, (yyvsp[0].Int_fifo)); }
+#line 2083 "ntp_parser.tab.c"
+    break;
+
+  case 101: /* monitoring_command: T_Statsdir T_String  */
+#line 643 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				cfgt.stats_dir = (yyvsp[0].String);
+			} else {
+				YYFREE((yyvsp[0].String));
+				yyerror("statsdir remote configuration ignored");
+			}
+		}
+#line 2096 "ntp_parser.tab.c"
+    break;
+
+  case 102: /* monitoring_command: T_Filegen stat filegen_option_list  */
+#line 652 "/root/repo/ntpd/ntp_parser.y"
+                {
+			filegen_node *fgn;
+
+			fgn = create_filegen_node((yyvsp[-1].Integer), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.filegen_opts, fgn);
+		}
+#line 2107 "ntp_parser.tab.c"
+    break;
+
+  case 103: /* stats_list: stats_list stat  */
+#line 662 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2116 "ntp_parser.tab.c"
+    break;
+
+  case 104: /* stats_list: stat  */
+#line 667 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2125 "ntp_parser.tab.c"
+    break;
+
+  case 115: /* filegen_option_list: %empty  */
+#line 688 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val_fifo) = NULL; }
+#line 2131 "ntp_parser.tab.c"
+    break;
+
+  case 116: /* filegen_option_list: filegen_option_list filegen_option  */
+#line 690 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2140 "ntp_parser.tab.c"
+    break;
+
+  case 117: /* filegen_option: T_File T_String  */
+#line 698 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+			} else {
+				(yyval.Attr_val) = NULL;
+				YYFREE((yyvsp[0].String));
+				yyerror("filegen file remote config ignored");
+			}
+		}
+#line 2154 "ntp_parser.tab.c"
+    break;
+
+  case 118: /* filegen_option: T_Type filegen_type  */
+#line 708 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("filegen type remote config ignored");
+			}
+		}
+#line 2167 "ntp_parser.tab.c"
+    break;
+
+  case 119: /* filegen_option: link_nolink  */
+#line 717 "/root/repo/ntpd/ntp_parser.y"
+                {
+			const char *err;
+
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				if (T_Link == (yyvsp[0].Integer))
+					err = "filegen link remote config ignored";
+				else
+					err = "filegen nolink remote config ignored";
+				yyerror(err);
+			}
+		}
+#line 2186 "ntp_parser.tab.c"
+    break;
+
+  case 120: /* filegen_option: enable_disable  */
+#line 732 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 2192 "ntp_parser.tab.c"
+    break;
+
+  case 134: /* access_control_command: T_Limit limit_option_list  */
+#line 767 "/root/repo/ntpd/ntp_parser.y"
+                {
+			CONCAT_G_FIFOS(cfgt.limit_opts, (yyvsp[0].Attr_val_fifo));
+		}
+#line 2200 "ntp_parser.tab.c"
+    break;
+
+  case 135: /* access_control_command: T_Mru mru_option_list  */
+#line 771 "/root/repo/ntpd/ntp_parser.y"
+                {
+			CONCAT_G_FIFOS(cfgt.mru_opts, (yyvsp[0].Attr_val_fifo));
+		}
+#line 2208 "ntp_parser.tab.c"
+    break;
+
+  case 136: /* access_control_command: restrict_prefix address ac_flag_list  */
+#line 775 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-2].Integer), (yyvsp[-1].Address_node), NULL, (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2220 "ntp_parser.tab.c"
+    break;
+
+  case 137: /* access_control_command: restrict_prefix ip_address T_Mask ip_address ac_flag_list  */
+#line 783 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-4].Integer), (yyvsp[-3].Address_node), (yyvsp[-1].Address_node), (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2232 "ntp_parser.tab.c"
+    break;
+
+  case 138: /* access_control_command: restrict_prefix T_Default ac_flag_list  */
+#line 791 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-2].Integer), NULL, NULL, (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2244 "ntp_parser.tab.c"
+    break;
+
+  case 139: /* access_control_command: restrict_prefix T_Ipv4_flag T_Default ac_flag_list  */
+#line 799 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-3].Integer),
+				create_address_node(
+					estrdup("0.0.0.0"),
+					AF_INET),
+				create_address_node(
+					estrdup("0.0.0.0"),
+					AF_INET),
+				(yyvsp[0].Int_fifo),
+				lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2263 "ntp_parser.tab.c"
+    break;
+
+  case 140: /* access_control_command: restrict_prefix T_Ipv6_flag T_Default ac_flag_list  */
+#line 814 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-3].Integer),
+				create_address_node(
+					estrdup("::"),
+					AF_INET6),
+				create_address_node(
+					estrdup("::"),
+					AF_INET6),
+				(yyvsp[0].Int_fifo),
+				lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2282 "ntp_parser.tab.c"
+    break;
+
+  case 141: /* access_control_command: restrict_prefix T_Source ac_flag_list  */
+#line 829 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *	rn;
+
+			APPEND_G_FIFO((yyvsp[0].Int_fifo), create_int_node((yyvsp[-1].Integer)));
+			rn = create_restrict_node(
+				(yyvsp[-2].Integer), NULL, NULL, (yyvsp[0].Int_fifo), lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2295 "ntp_parser.tab.c"
+    break;
+
+  case 142: /* access_control_command: restrict_prefix T_File T_String ac_flag_list  */
+#line 838 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *	rn;
+
+			APPEND_G_FIFO((yyvsp[0].Int_fifo), create_int_node((yyvsp[-2].Integer)));
+			rn = create_restrict_node((yyvsp[-3].Integer),
+				create_address_node((yyvsp[-1].String), AF_UNSPEC),
+				NULL, (yyvsp[0].Int_fifo), lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2309 "ntp_parser.tab.c"
+    break;
+
+  case 143: /* ac_flag_list: %empty  */
+#line 851 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Int_fifo) = NULL; }
+#line 2315 "ntp_parser.tab.c"
+    break;
+
+  case 144: /* ac_flag_list: ac_flag_list access_control_flag  */
+#line 853 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2324 "ntp_parser.tab.c"
+    break;
+
+  case 159: /* limit_option_list: limit_option_list limit_option  */
+#line 878 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2333 "ntp_parser.tab.c"
+    break;
+
+  case 160: /* limit_option_list: limit_option  */
+#line 883 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2342 "ntp_parser.tab.c"
+    break;
+
+  case 161: /* limit_option: limit_option_keyword number  */
+#line 891 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2348 "ntp_parser.tab.c"
+    break;
+
+  case 169: /* mru_option_list: mru_option_list mru_option  */
+#line 906 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2357 "ntp_parser.tab.c"
+    break;
+
+  case 170: /* mru_option_list: mru_option  */
+#line 911 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2366 "ntp_parser.tab.c"
+    break;
+
+  case 171: /* mru_option: mru_option_keyword T_Integer  */
+#line 919 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2372 "ntp_parser.tab.c"
+    break;
+
+  case 181: /* fudge_command: T_Fudge address fudge_factor_list  */
+#line 940 "/root/repo/ntpd/ntp_parser.y"
+                {
+			addr_opts_node *aon;
+
+			aon = create_addr_opts_node((yyvsp[-1].Address_node), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.fudge, aon);
+		}
+#line 2383 "ntp_parser.tab.c"
+    break;
+
+  case 182: /* fudge_factor_list: fudge_factor_list fudge_factor  */
+#line 950 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2392 "ntp_parser.tab.c"
+    break;
+
+  case 183: /* fudge_factor_list: fudge_factor  */
+#line 955 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2401 "ntp_parser.tab.c"
+    break;
+
+  case 184: /* fudge_factor: fudge_factor_dbl_keyword number  */
+#line 963 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2407 "ntp_parser.tab.c"
+    break;
+
+  case 185: /* fudge_factor: fudge_factor_bool_keyword boolean  */
+#line 965 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2413 "ntp_parser.tab.c"
+    break;
+
+  case 186: /* fudge_factor: T_Stratum T_Integer  */
+#line 967 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) >= 0 && (yyvsp[0].Integer) <= 16) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("fudge factor: stratum value not in [0..16], ignored");
+			}
+		}
+#line 2426 "ntp_parser.tab.c"
+    break;
+
+  case 187: /* fudge_factor: T_Refid T_String  */
+#line 976 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 2432 "ntp_parser.tab.c"
+    break;
+
+  case 194: /* refclock_command: T_Refclock T_String optional_unit option_list  */
+#line 997 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifdef REFCLOCK
+			address_node *fakeaddr = addr_from_typeunit((yyvsp[-2].String), (yyvsp[-1].Integer));
+			peer_node *my_node = create_peer_node(T_Server, fakeaddr, (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.peers, my_node);
+#endif /* REFCLOCK */
+		}
+#line 2444 "ntp_parser.tab.c"
+    break;
+
+  case 195: /* optional_unit: %empty  */
+#line 1008 "/root/repo/ntpd/ntp_parser.y"
+                        {(yyval.Integer) = 0;}
+#line 2450 "ntp_parser.tab.c"
+    break;
+
+  case 196: /* optional_unit: T_Unit T_Integer  */
+#line 1011 "/root/repo/ntpd/ntp_parser.y"
+                        {(yyval.Integer) = (yyvsp[0].Integer);}
+#line 2456 "ntp_parser.tab.c"
+    break;
+
+  case 197: /* rlimit_command: T_Rlimit rlimit_option_list  */
+#line 1021 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.rlimit, (yyvsp[0].Attr_val_fifo)); }
+#line 2462 "ntp_parser.tab.c"
+    break;
+
+  case 198: /* rlimit_option_list: rlimit_option_list rlimit_option  */
+#line 1026 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2471 "ntp_parser.tab.c"
+    break;
+
+  case 199: /* rlimit_option_list: rlimit_option  */
+#line 1031 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2480 "ntp_parser.tab.c"
+    break;
+
+  case 200: /* rlimit_option: rlimit_option_keyword T_Integer  */
+#line 1039 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2486 "ntp_parser.tab.c"
+    break;
+
+  case 204: /* system_option_command: T_Enable system_option_list  */
+#line 1055 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.enable_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2492 "ntp_parser.tab.c"
+    break;
+
+  case 205: /* system_option_command: T_Disable system_option_list  */
+#line 1057 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.disable_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2498 "ntp_parser.tab.c"
+    break;
+
+  case 206: /* system_option_list: system_option_list system_option  */
+#line 1062 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2507 "ntp_parser.tab.c"
+    break;
+
+  case 207: /* system_option_list: system_option  */
+#line 1067 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2516 "ntp_parser.tab.c"
+    break;
+
+  case 208: /* system_option: system_option_flag_keyword  */
+#line 1075 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 2522 "ntp_parser.tab.c"
+    break;
+
+  case 209: /* system_option: system_option_local_flag_keyword  */
+#line 1077 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer));
+			} else {
+				char err_str[128];
+
+				(yyval.Attr_val) = NULL;
+				snprintf(err_str, sizeof(err_str),
+					 "enable/disable %s remote configuration ignored",
+					 keyword((yyvsp[0].Integer)));
+				yyerror(err_str);
+			}
+		}
+#line 2540 "ntp_parser.tab.c"
+    break;
+
+  case 215: /* extra_command: T_Extra extra_option_list  */
+#line 1109 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.extra, (yyvsp[0].Attr_val_fifo)); }
+#line 2546 "ntp_parser.tab.c"
+    break;
+
+  case 216: /* extra_option_list: extra_option_list extra_option  */
+#line 1114 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2555 "ntp_parser.tab.c"
+    break;
+
+  case 217: /* extra_option_list: extra_option  */
+#line 1119 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2564 "ntp_parser.tab.c"
+    break;
+
+  case 218: /* extra_option: extra_option_keyword number  */
+#line 1127 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2570 "ntp_parser.tab.c"
+    break;
+
+  case 228: /* tinker_command: T_Tinker tinker_option_list  */
+#line 1149 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.tinker, (yyvsp[0].Attr_val_fifo)); }
+#line 2576 "ntp_parser.tab.c"
+    break;
+
+  case 229: /* tinker_option_list: tinker_option_list tinker_option  */
+#line 1154 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2585 "ntp_parser.tab.c"
+    break;
+
+  case 230: /* tinker_option_list: tinker_option  */
+#line 1159 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2594 "ntp_parser.tab.c"
+    break;
+
+  case 231: /* tinker_option: tinker_option_keyword number  */
+#line 1167 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2600 "ntp_parser.tab.c"
+    break;
+
+  case 241: /* nts_command: T_Nts nts_option_list  */
+#line 1189 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.nts, (yyvsp[0].Attr_val_fifo)); }
+#line 2606 "ntp_parser.tab.c"
+    break;
+
+  case 242: /* nts_option_list: nts_option_list nts_option  */
+#line 1194 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2615 "ntp_parser.tab.c"
+    break;
+
+  case 243: /* nts_option_list: nts_option  */
+#line 1199 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2624 "ntp_parser.tab.c"
+    break;
+
+  case 244: /* nts_option: nts_string_option_keyword T_String  */
+#line 1207 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 2630 "ntp_parser.tab.c"
+    break;
+
+  case 245: /* nts_option: nts_number_option_keyword number  */
+#line 1209 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2636 "ntp_parser.tab.c"
+    break;
+
+  case 246: /* nts_option: T_Disable  */
+#line 1211 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[0].Integer), 0); }
+#line 2642 "ntp_parser.tab.c"
+    break;
+
+  case 247: /* nts_option: T_Enable  */
+#line 1213 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[0].Integer), 1); }
+#line 2648 "ntp_parser.tab.c"
+    break;
+
+  case 248: /* nts_option: T_Tlscipherserverpreference  */
+#line 1215 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[0].Integer), 1); }
+#line 2654 "ntp_parser.tab.c"
+    break;
+
+  case 249: /* nts_option: T_Pool number  */
+#line 1217 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2660 "ntp_parser.tab.c"
+    break;
+
+  case 265: /* miscellaneous_command: misc_cmd_dbl_keyword number  */
+#line 1249 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2671 "ntp_parser.tab.c"
+    break;
+
+  case 266: /* miscellaneous_command: misc_cmd_int_keyword T_Integer  */
+#line 1256 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2682 "ntp_parser.tab.c"
+    break;
+
+  case 267: /* miscellaneous_command: misc_cmd_str_keyword T_String  */
+#line 1263 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2693 "ntp_parser.tab.c"
+    break;
+
+  case 268: /* miscellaneous_command: misc_cmd_str_lcl_keyword T_String  */
+#line 1270 "/root/repo/ntpd/ntp_parser.y"
+                {
+			char error_text[64];
+			attr_val *av;
+
+			if (lex_from_file()) {
+				av = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+				APPEND_G_FIFO(cfgt.vars, av);
+			} else {
+				YYFREE((yyvsp[0].String));
+				snprintf(error_text, sizeof(error_text),
+					 "%s remote config ignored",
+					 keyword((yyvsp[-1].Integer)));
+				yyerror(error_text);
+			}
+		}
+#line 2713 "ntp_parser.tab.c"
+    break;
+
+  case 269: /* miscellaneous_command: T_Includefile T_String command  */
+#line 1286 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (!lex_from_file()) {
+				YYFREE((yyvsp[-1].String)); /* avoid leak */
+				yyerror("remote includefile ignored");
+				break;
+			}
+			if (lex_level() > MAXINCLUDELEVEL) {
+				fprintf(stderr, "getconfig(): Maximum include file level exceeded.\n");
+				msyslog(LOG_ERR, "CONFIG: Maximum include file level exceeded.");
+			} else {
+				const char * path = (yyvsp[-1].String);
+				if (!lex_push_file(path)) {
+					fprintf(stderr, "getconfig(): Couldn't open <%s>\n", path);
+					msyslog(LOG_ERR, "CONFIG: Couldn't open <%s>", path);
+				}
+			}
+			YYFREE((yyvsp[-1].String)); /* avoid leak */
+		}
+#line 2736 "ntp_parser.tab.c"
+    break;
+
+  case 270: /* miscellaneous_command: T_End  */
+#line 1305 "/root/repo/ntpd/ntp_parser.y"
+                        { lex_flush_stack(); }
+#line 2742 "ntp_parser.tab.c"
+    break;
+
+  case 271: /* miscellaneous_command: T_Driftfile drift_parm  */
+#line 1307 "/root/repo/ntpd/ntp_parser.y"
+                        { /* see drift_parm below for actions */ }
+#line 2748 "ntp_parser.tab.c"
+    break;
+
+  case 272: /* miscellaneous_command: T_Logconfig log_config_list  */
+#line 1309 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.logconfig, (yyvsp[0].Attr_val_fifo)); }
+#line 2754 "ntp_parser.tab.c"
+    break;
+
+  case 273: /* miscellaneous_command: T_Phone string_list  */
+#line 1311 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.phone, (yyvsp[0].String_fifo)); }
+#line 2760 "ntp_parser.tab.c"
+    break;
+
+  case 274: /* miscellaneous_command: T_Setvar variable_assign  */
+#line 1313 "/root/repo/ntpd/ntp_parser.y"
+                        { APPEND_G_FIFO(cfgt.setvar, (yyvsp[0].Set_var)); }
+#line 2766 "ntp_parser.tab.c"
+    break;
+
+  case 278: /* misc_cmd_int_keyword: T_Leapsmearinterval  */
+#line 1327 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifndef ENABLE_LEAP_SMEAR
+			yyerror("Built without LEAP_SMEAR support.");
+#endif
+		}
+#line 2776 "ntp_parser.tab.c"
+    break;
+
+  case 283: /* drift_parm: T_String  */
+#line 1346 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				attr_val *av;
+				av = create_attr_sval(T_Driftfile, (yyvsp[0].String));
+				APPEND_G_FIFO(cfgt.vars, av);
+			} else {
+				YYFREE((yyvsp[0].String));
+				yyerror("driftfile remote configuration ignored");
+			}
+		}
+#line 2791 "ntp_parser.tab.c"
+    break;
+
+  case 284: /* drift_parm: T_String T_Double  */
+#line 1357 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval(T_Driftfile, (yyvsp[-1].String));
+			APPEND_G_FIFO(cfgt.vars, av);
+			av = create_attr_dval(T_WanderThreshold, (yyvsp[0].Double));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2804 "ntp_parser.tab.c"
+    break;
+
+  case 285: /* drift_parm: %empty  */
+#line 1366 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval(T_Driftfile, estrdup(""));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2815 "ntp_parser.tab.c"
+    break;
+
+  case 286: /* variable_assign: T_String '=' T_String t_default_or_zero  */
+#line 1376 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Set_var) = create_setvar_node((yyvsp[-3].String), (yyvsp[-1].String), (yyvsp[0].Integer)); }
+#line 2821 "ntp_parser.tab.c"
+    break;
+
+  case 288: /* t_default_or_zero: %empty  */
+#line 1382 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 0; }
+#line 2827 "ntp_parser.tab.c"
+    break;
+
+  case 289: /* log_config_list: log_config_list log_config_command  */
+#line 1387 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2836 "ntp_parser.tab.c"
+    break;
+
+  case 290: /* log_config_list: log_config_command  */
+#line 1392 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2845 "ntp_parser.tab.c"
+    break;
+
+  case 291: /* log_config_command: T_String  */
+#line 1400 "/root/repo/ntpd/ntp_parser.y"
+                {
+			char	prefix;
+			char *	type;
+
+			switch ((yyvsp[0].String)[0]) {
+
+			case '+':
+			case '-':
+			case '=':
+				prefix = (yyvsp[0].String)[0];
+				type = (yyvsp[0].String) + 1;
+				break;
+
+			default:
+				prefix = '=';
+				type = (yyvsp[0].String);
+			}
+
+			(yyval.Attr_val) = create_attr_sval(prefix, estrdup(type));
+			YYFREE((yyvsp[0].String));
+		}
+#line 2871 "ntp_parser.tab.c"
+    break;
+
+  case 292: /* interface_command: interface_nic nic_rule_action nic_rule_class  */
+#line 1425 "/root/repo/ntpd/ntp_parser.y"
+                {
+			nic_rule_node *nrn;
+
+			nrn = create_nic_rule_node((yyvsp[0].Integer), NULL, (yyvsp[-1].Integer));
+			APPEND_G_FIFO(cfgt.nic_rules, nrn);
+		}
+#line 2882 "ntp_parser.tab.c"
+    break;
+
+  case 293: /* interface_command: interface_nic nic_rule_action T_String  */
+#line 1432 "/root/repo/ntpd/ntp_parser.y"
+                {
+			nic_rule_node *nrn;
+
+			nrn = create_nic_rule_node(0, (yyvsp[0].String), (yyvsp[-1].Integer));
+			APPEND_G_FIFO(cfgt.nic_rules, nrn);
+		}
+#line 2893 "ntp_parser.tab.c"
+    break;
+
+  case 303: /* reset_command: T_Reset counter_set_list  */
+#line 1460 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.reset_counters, (yyvsp[0].Int_fifo)); }
+#line 2899 "ntp_parser.tab.c"
+    break;
+
+  case 304: /* counter_set_list: counter_set_list counter_set_keyword  */
+#line 1465 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2908 "ntp_parser.tab.c"
+    break;
+
+  case 305: /* counter_set_list: counter_set_keyword  */
+#line 1470 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2917 "ntp_parser.tab.c"
+    break;
+
+  case 313: /* integer_list_range: integer_list_range integer_list_range_elt  */
+#line 1494 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2926 "ntp_parser.tab.c"
+    break;
+
+  case 314: /* integer_list_range: integer_list_range_elt  */
+#line 1499 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2935 "ntp_parser.tab.c"
+    break;
+
+  case 315: /* integer_list_range_elt: T_Integer  */
+#line 1507 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival('i', (yyvsp[0].Integer)); }
+#line 2941 "ntp_parser.tab.c"
+    break;
+
+  case 317: /* integer_range: '(' T_Integer T_Ellipsis T_Integer ')'  */
+#line 1513 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_rangeval('-', (yyvsp[-3].Integer), (yyvsp[-1].Integer)); }
+#line 2947 "ntp_parser.tab.c"
+    break;
+
+  case 318: /* string_list: string_list T_String  */
+#line 1518 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.String_fifo) = (yyvsp[-1].String_fifo);
+			APPEND_G_FIFO((yyval.String_fifo), create_string_node((yyvsp[0].String)));
+		}
+#line 2956 "ntp_parser.tab.c"
+    break;
+
+  case 319: /* string_list: T_String  */
+#line 1523 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.String_fifo) = NULL;
+			APPEND_G_FIFO((yyval.String_fifo), create_string_node((yyvsp[0].String)));
+		}
+#line 2965 "ntp_parser.tab.c"
+    break;
+
+  case 320: /* boolean: T_Integer  */
+#line 1531 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) != 0 && (yyvsp[0].Integer) != 1) {
+				yyerror("Integer value is not boolean (0 or 1). Assuming 1");
+				(yyval.Integer) = 1;
+			} else {
+				(yyval.Integer) = (yyvsp[0].Integer);
+			}
+		}
+#line 2978 "ntp_parser.tab.c"
+    break;
+
+  case 321: /* boolean: T_True  */
+#line 1539 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 1; }
+#line 2984 "ntp_parser.tab.c"
+    break;
+
+  case 322: /* boolean: T_False  */
+#line 1540 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 0; }
+#line 2990 "ntp_parser.tab.c"
+    break;
+
+  case 323: /* number: T_Integer  */
+#line 1544 "/root/repo/ntpd/ntp_parser.y"
+                                { (yyval.Double) = (double)(yyvsp[0].Integer); }
+#line 2996 "ntp_parser.tab.c"
+    break;
+
+
+#line 3000 "ntp_parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 1549 "/root/repo/ntpd/ntp_parser.y"
+
+
+#ifdef REFCLOCK
+address_node *
+addr_from_typeunit(char *type, int unit)
+{
+	char addrbuf[1025];	/* NI_MAXHOSTS on Linux */
+	int dtype;
+
+	for (dtype = 1; dtype < (int)num_refclock_conf; dtype++)
+	    if (refclock_conf[dtype]->basename != NULL && strcasecmp(refclock_conf[dtype]->basename, type) == 0)
+		goto foundit;
+	 msyslog(LOG_ERR, "CONFIG: Unknown driver name %s", type);
+	 exit(1);
+foundit:
+	snprintf(addrbuf, sizeof(addrbuf), "127.127.%d.%d", dtype, unit);
+	return create_address_node(estrdup(addrbuf), AF_INET);
+}
+#endif /* REFCLOCK */
+
+void
+yyerror(
+	const char *msg
+	)
+{
+	int retval;
+	struct FILE_INFO * ip_ctx;
+
+	ip_ctx = lex_current();
+	ip_ctx->errpos = ip_ctx->tokpos;
+
+	msyslog(LOG_ERR, "CONFIG: line %d column %d %s",
+		ip_ctx->errpos.nline, ip_ctx->errpos.ncol, msg);
+	if (lex_from_file()) {
+                /* all is good, so far */
+                return;
+        }
+        /* Uh, oh, got an error */
+
+	/* Increment the number of errors */
+	++remote_config.no_errors;
+
+	/* Save the error message in the correct buffer */
+	if ((MAXLINE - 10) < remote_config.err_pos) {
+		/* err_msg already full, ignore this */
+		return;
+	}
+	retval = snprintf(remote_config.err_msg + remote_config.err_pos,
+			  (size_t)(MAXLINE - remote_config.err_pos),
+			  "column %d %s", ip_ctx->errpos.ncol, msg);
+
+	/* Increment the value of err_pos */
+	if (retval > 0) {
+		/* careful, retval is not bytes written, it is
+		 * bytes that would have been written if space had
+                 * been available */
+		remote_config.err_pos += retval;
+		if (MAXLINE < remote_config.err_pos) {
+			/* err_msg overflowed! */
+			remote_config.err_pos = MAXLINE;
+		}
+	}
+}
+
+
+/*
+ * token_name - convert T_ token integers to text
+ *		example: token_name(T_Server) returns "T_Server"
+ */
+const char *
+token_name(
+	int token
+	)
+{
+	return yytname[YYTRANSLATE(token)];
+}
+
+
+/* Initial Testing function -- ignore */
+#if 0
+int main(int argc, char *argv[])
+{
+	ip_file = FOPEN(argv[1], "r");
+	if (!ip_file)
+		fprintf(stderr, "ERROR!! Could not open file: %s\n", argv[1]);
+	yyparse();
+	return 0;
+}
+#endif
+
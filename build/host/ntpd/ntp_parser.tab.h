@@ -0,0 +1,293 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_NTP_PARSER_TAB_H_INCLUDED
+# define YY_YY_NTP_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_Aead = 258,                  /* T_Aead  */
+    T_Age = 259,                   /* T_Age  */
+    T_All = 260,                   /* T_All  */
+    T_Allan = 261,                 /* T_Allan  */
+    T_Allpeers = 262,              /* T_Allpeers  */
+    T_Ask = 263,                   /* T_Ask  */
+    T_Auth = 264,                  /* T_Auth  */
+    T_Average = 265,               /* T_Average  */
+    T_Baud = 266,                  /* T_Baud  */
+    T_Bias = 267,                  /* T_Bias  */
+    T_Burst = 268,                 /* T_Burst  */
+    T_Busypoll = 269,              /* T_Busypoll  */
+    T_Calibrate = 270,             /* T_Calibrate  */
+    T_Ca = 271,                    /* T_Ca  */
+    T_Ceiling = 272,               /* T_Ceiling  */
+    T_Cert = 273,                  /* T_Cert  */
+    T_Clock = 274,                 /* T_Clock  */
+    T_Clockstats = 275,            /* T_Clockstats  */
+    T_Cohort = 276,                /* T_Cohort  */
+    T_Cookie = 277,                /* T_Cookie  */
+    T_ControlKey = 278,            /* T_ControlKey  */
+    T_Ctl = 279,                   /* T_Ctl  */
+    T_Day = 280,                   /* T_Day  */
+    T_Default = 281,               /* T_Default  */
+    T_Disable = 282,               /* T_Disable  */
+    T_Dispersion = 283,            /* T_Dispersion  */
+    T_Double = 284,                /* T_Double  */
+    T_Driftfile = 285,             /* T_Driftfile  */
+    T_Drop = 286,                  /* T_Drop  */
+    T_Dscp = 287,                  /* T_Dscp  */
+    T_Expire = 288,                /* T_Expire  */
+    T_Extra = 289,                 /* T_Extra  */
+    T_Ellipsis = 290,              /* T_Ellipsis  */
+    T_Enable = 291,                /* T_Enable  */
+    T_End = 292,                   /* T_End  */
+    T_False = 293,                 /* T_False  */
+    T_File = 294,                  /* T_File  */
+    T_Filegen = 295,               /* T_Filegen  */
+    T_Filenum = 296,               /* T_Filenum  */
+    T_Flag1 = 297,                 /* T_Flag1  */
+    T_Flag2 = 298,                 /* T_Flag2  */
+    T_Flag3 = 299,                 /* T_Flag3  */
+    T_Flag4 = 300,                 /* T_Flag4  */
+    T_Flake = 301,                 /* T_Flake  */
+    T_Floor = 302,                 /* T_Floor  */
+    T_Freq = 303,                  /* T_Freq  */
+    T_Fudge = 304,                 /* T_Fudge  */
+    T_Huffpuff = 305,              /* T_Huffpuff  */
+    T_Iburst = 306,                /* T_Iburst  */
+    T_Ifdeltas = 307,              /* T_Ifdeltas  */
+    T_Ignore = 308,                /* T_Ignore  */
+    T_Incalloc = 309,              /* T_Incalloc  */
+    T_Incmem = 310,                /* T_Incmem  */
+    T_Initalloc = 311,             /* T_Initalloc  */
+    T_Initmem = 312,               /* T_Initmem  */
+    T_Includefile = 313,           /* T_Includefile  */
+    T_Integer = 314,               /* T_Integer  */
+    T_Interface = 315,             /* T_Interface  */
+    T_Intrange = 316,              /* T_Intrange  */
+    T_Io = 317,                    /* T_Io  */
+    T_Iocpu = 318,                 /* T_Iocpu  */
+    T_Ipv4 = 319,                  /* T_Ipv4  */
+    T_Ipv4_flag = 320,             /* T_Ipv4_flag  */
+    T_Ipv6 = 321,                  /* T_Ipv6  */
+    T_Ipv6_flag = 322,             /* T_Ipv6_flag  */
+    T_Kelimit = 323,               /* T_Kelimit  */
+    T_Kernel = 324,                /* T_Kernel  */
+    T_Ketimeout = 325,             /* T_Ketimeout  */
+    T_Keworkers = 326,             /* T_Keworkers  */
+    T_Key = 327,                   /* T_Key  */
+    T_Keys = 328,                  /* T_Keys  */
+    T_Kod = 329,                   /* T_Kod  */
+    T_Mssntp = 330,                /* T_Mssntp  */
+    T_Leapfile = 331,              /* T_Leapfile  */
+    T_Leapsmearinterval = 332,     /* T_Leapsmearinterval  */
+    T_Limit = 333,                 /* T_Limit  */
+    T_Limited = 334,               /* T_Limited  */
+    T_Link = 335,                  /* T_Link  */
+    T_Listen = 336,                /* T_Listen  */
+    T_Logconfig = 337,             /* T_Logconfig  */
+    T_Logfile = 338,               /* T_Logfile  */
+    T_Loopstats = 339,             /* T_Loopstats  */
+    T_Mask = 340,                  /* T_Mask  */
+    T_Maxage = 341,                /* T_Maxage  */
+    T_Maxclock = 342,              /* T_Maxclock  */
+    T_Maxdepth = 343,              /* T_Maxdepth  */
+    T_Maxdisp = 344,               /* T_Maxdisp  */
+    T_Maxdist = 345,               /* T_Maxdist  */
+    T_Maxmem = 346,                /* T_Maxmem  */
+    T_Maxpoll = 347,               /* T_Maxpoll  */
+    T_Maxtls = 348,                /* T_Maxtls  */
+    T_Mdnstries = 349,             /* T_Mdnstries  */
+    T_Mem = 350,                   /* T_Mem  */
+    T_Memlock = 351,               /* T_Memlock  */
+    T_Minage = 352,                /* T_Minage  */
+    T_Minclock = 353,              /* T_Minclock  */
+    T_Mindepth = 354,              /* T_Mindepth  */
+    T_Mindist = 355,               /* T_Mindist  */
+    T_Minpoll = 356,               /* T_Minpoll  */
+    T_Minsane = 357,               /* T_Minsane  */
+    T_Mintls = 358,                /* T_Mintls  */
+    T_Mode = 359,                  /* T_Mode  */
+    T_Monitor = 360,               /* T_Monitor  */
+    T_Month = 361,                 /* T_Month  */
+    T_Mru = 362,                   /* T_Mru  */
+    T_Nic = 363,                   /* T_Nic  */
+    T_Nolink = 364,                /* T_Nolink  */
+    T_Nomodify = 365,              /* T_Nomodify  */
+    T_Nomrulist = 366,             /* T_Nomrulist  */
+    T_None = 367,                  /* T_None  */
+    T_Nonvolatile = 368,           /* T_Nonvolatile  */
+    T_Nopeer = 369,                /* T_Nopeer  */
+    T_Noquery = 370,               /* T_Noquery  */
+    T_Noselect = 371,              /* T_Noselect  */
+    T_Noserve = 372,               /* T_Noserve  */
+    T_Notrap = 373,                /* T_Notrap  */
+    T_Notrust = 374,               /* T_Notrust  */
+    T_Noval = 375,                 /* T_Noval  */
+    T_Ntp = 376,                   /* T_Ntp  */
+    T_Ntpport = 377,               /* T_Ntpport  */
+    T_NtpSignDsocket = 378,        /* T_NtpSignDsocket  */
+    T_Nts = 379,                   /* T_Nts  */
+    T_Ntsstats = 380,              /* T_Ntsstats  */
+    T_Ntskestats = 381,            /* T_Ntskestats  */
+    T_Orphan = 382,                /* T_Orphan  */
+    T_Orphanwait = 383,            /* T_Orphanwait  */
+    T_Panic = 384,                 /* T_Panic  */
+    T_Path = 385,                  /* T_Path  */
+    T_Peer = 386,                  /* T_Peer  */
+    T_Peerstats = 387,             /* T_Peerstats  */
+    T_Phone = 388,                 /* T_Phone  */
+    T_Pid = 389,                   /* T_Pid  */
+    T_Pidfile = 390,               /* T_Pidfile  */
+    T_Pool = 391,                  /* T_Pool  */
+    T_Port = 392,                  /* T_Port  */
+    T_Ppspath = 393,               /* T_Ppspath  */
+    T_Prefer = 394,                /* T_Prefer  */
+    T_Prefixaverage = 395,         /* T_Prefixaverage  */
+    T_Prefixkod = 396,             /* T_Prefixkod  */
+    T_Prefixv4 = 397,              /* T_Prefixv4  */
+    T_Prefixv6 = 398,              /* T_Prefixv6  */
+    T_Protostats = 399,            /* T_Protostats  */
+    T_Rawstats = 400,              /* T_Rawstats  */
+    T_Refclock = 401,              /* T_Refclock  */
+    T_Refid = 402,                 /* T_Refid  */
+    T_Requestkey = 403,            /* T_Requestkey  */
+    T_Require = 404,               /* T_Require  */
+    T_Recvbatch = 405,             /* T_Recvbatch  */
+    T_Reset = 406,                 /* T_Reset  */
+    T_Restrict = 407,              /* T_Restrict  */
+    T_Rlimit = 408,                /* T_Rlimit  */
+    T_Saveconfigdir = 409,         /* T_Saveconfigdir  */
+    T_Server = 410,                /* T_Server  */
+    T_Setvar = 411,                /* T_Setvar  */
+    T_Source = 412,                /* T_Source  */
+    T_Stacksize = 413,             /* T_Stacksize  */
+    T_Stagestats = 414,            /* T_Stagestats  */
+    T_Stagetime = 415,             /* T_Stagetime  */
+    T_Statistics = 416,            /* T_Statistics  */
+    T_Stats = 417,                 /* T_Stats  */
+    T_Statsdir = 418,              /* T_Statsdir  */
+    T_Step = 419,                  /* T_Step  */
+    T_Stepback = 420,              /* T_Stepback  */
+    T_Stepfwd = 421,               /* T_Stepfwd  */
+    T_Stepout = 422,               /* T_Stepout  */
+    T_Stratum = 423,               /* T_Stratum  */
+    T_Subtype = 424,               /* T_Subtype  */
+    T_String = 425,                /* T_String  */
+    T_Sys = 426,                   /* T_Sys  */
+    T_Sysstats = 427,              /* T_Sysstats  */
+    T_Tick = 428,                  /* T_Tick  */
+    T_Time1 = 429,                 /* T_Time1  */
+    T_Time2 = 430,                 /* T_Time2  */
+    T_Timer = 431,                 /* T_Timer  */
+    T_Tinker = 432,                /* T_Tinker  */
+    T_Tlsciphersuites = 433,       /* T_Tlsciphersuites  */
+    T_Tlsecdhcurves = 434,         /* T_Tlsecdhcurves  */
+    T_Tlscipherserverpreference = 435, /* T_Tlscipherserverpreference  */
+    T_Tos = 436,                   /* T_Tos  */
+    T_True = 437,                  /* T_True  */
+    T_Trustedkey = 438,            /* T_Trustedkey  */
+    T_Txstamps = 439,              /* T_Txstamps  */
+    T_Type = 440,                  /* T_Type  */
+    T_U_int = 441,                 /* T_U_int  */
+    T_Unit = 442,                  /* T_Unit  */
+    T_Unconfig = 443,              /* T_Unconfig  */
+    T_Unpeer = 444,                /* T_Unpeer  */
+    T_Unrestrict = 445,            /* T_Unrestrict  */
+    T_Uring = 446,                 /* T_Uring  */
+    T_Usestats = 447,              /* T_Usestats  */
+    T_Version = 448,               /* T_Version  */
+    T_WanderThreshold = 449,       /* T_WanderThreshold  */
+    T_Week = 450,                  /* T_Week  */
+    T_Wildcard = 451,              /* T_Wildcard  */
+    T_Workers = 452,               /* T_Workers  */
+    T_Year = 453,                  /* T_Year  */
+    T_Flag = 454,                  /* T_Flag  */
+    T_EOC = 455                    /* T_EOC  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 37 "/root/repo/ntpd/ntp_parser.y"
+
+	char *			String;
+	double			Double;
+	int			Integer;
+	unsigned		U_int;
+	gen_fifo *		Generic_fifo;
+	attr_val *		Attr_val;
+	attr_val_fifo *		Attr_val_fifo;
+	int_fifo *		Int_fifo;
+	string_fifo *		String_fifo;
+	address_node *		Address_node;
+	address_fifo *		Address_fifo;
+	setvar_node *		Set_var;
+
+#line 279 "ntp_parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_NTP_PARSER_TAB_H_INCLUDED  */
@@ -156,6 +156,7 @@ typedef struct netendpt {
 	bool		ignore_packets; /* listen-read-drop this? */
 	struct peer *	peers;		/* list of peers using endpt */
 	unsigned int	peercnt;	/* count of same */
+	struct txstamps *txs;		/* TX timestamps, NULL if off */
 } endpt;
 
 /*
@@ -305,6 +306,7 @@ struct peer {
 	l_fp	dst;		/* destination timestamp */
 	l_fp	org_ts;		/* origin real-timestamp */
 	l_fp	org_rand;	/* origin pseudo-timestamp */
+	l_fp	org_tx;		/* kernel transmit time, 0 if unknown */
 	double	offset;		/* peer clock offset */
 	double	delay;		/* peer roundtrip delay */
 	double	jitter;		/* peer jitter (squares) */
@@ -609,20 +611,27 @@ struct pkt {
 
 /*
  * Structure used optionally for monitoring when this is turned on.
+ * Entries sit in one array in ntp_monitor.c and move when others are
+ * removed, so only hold a pointer to one while the table is quiet.
+ * The remote address is kept in pieces; mon_get_addr() puts it back
+ * together.  64 bytes, one cache line.
  */
 typedef struct mon_data	mon_entry;
 struct mon_data {
-	mon_entry *	hash_next;	/* next structure in hash list */
-	DECL_DLIST_LINK(mon_entry, mru);/* MRU list link pointers */
-	endpt *		lcladr;		/* address on which this arrived */
 	l_fp		first;		/* first time seen */
 	l_fp		last;		/* last time seen */
 	int		count;		/* total packet count */
 	unsigned int	dropped;	/* packets dropped */
 	float		score;		/* recent packets/second */
+	uint32_t	ifnum;		/* ifnum of the local address */
+	uint32_t	scope;		/* IPv6 scope of remote address */
 	unsigned short	flags;		/* restrict flags */
+	uint16_t	port;		/* remote port, network order */
 	uint8_t		vn_mode;	/* packet mode & version */
-	sockaddr_u	rmtadr;		/* address of remote host */
+	uint8_t		family;		/* AF_INET, AF_INET6 */
+	uint8_t		ref;		/* seen since the clock hand passed */
+	uint8_t		prefixed;	/* flags set by the prefix limit */
+	uint8_t		addr[16];	/* remote address */
 };
 
 /*
@@ -658,6 +667,7 @@ typedef struct res_addr6_tag {
 typedef struct restrict_u_tag	restrict_u;
 struct restrict_u_tag {
 	restrict_u *		link;	/* link to next entry */
+	restrict_u *		nlink;	/* next with same addr/mask */
 	uint64_t		hitcount;	/* number of packets matched */
 	unsigned short		flags;	/* accesslist flags */
 	unsigned short		mflags;	/* match flags */
@@ -701,6 +711,7 @@ struct restrict_u_tag {
 /*
  * Match flags
  */
+#define	RESM_FILE		0x0800	/* from "restrict file" */
 #define	RESM_INTERFACE		0x1000	/* this is an interface */
 #define	RESM_NTPONLY		0x2000	/* match source port 123 */
 #define RESM_SOURCE		0x4000	/* from "restrict source" */
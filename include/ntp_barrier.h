@@ -0,0 +1,24 @@
+/*
+ * ntp_barrier.h - a full memory barrier, for the seqlocks and
+ * lock-free lists shared with other threads and processes
+ */
+#ifndef GUARD_NTP_BARRIER_H
+#define GUARD_NTP_BARRIER_H
+
+#include "config.h"
+
+#if defined(HAVE_STDATOMIC_H) && !defined(__COVERITY__)
+# include <stdatomic.h>
+#endif /* HAVE_STDATOMIC_H */
+
+static inline void memory_barrier(void) {
+#if defined(HAVE_STDATOMIC_H) && !defined(__COVERITY__)
+	atomic_thread_fence(memory_order_seq_cst);
+#elif defined(__GNUC__)
+	__sync_synchronize();
+#else
+# error "No memory barrier on this compiler"
+#endif /* HAVE_STDATOMIC_H */
+}
+
+#endif	/* GUARD_NTP_BARRIER_H */
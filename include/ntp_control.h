@@ -164,7 +164,7 @@ struct ntp_control {
  * IFSTATS_FIELDS is the number of fields ntpd supplies for each ifstats
  * row.  Similarly RESLIST_FIELDS for reslist.
  */
-#define	IFSTATS_FIELDS	9
+#define	IFSTATS_FIELDS	10
 #define	RESLIST_FIELDS	4
 
 /*
@@ -0,0 +1,42 @@
+/*
+ * ntp_hist.h - power-of-two latency histograms
+ *
+ * Bucket 0 counts samples under 2^LAT_HIST_SHIFT nanoseconds, bucket
+ * n counts [2^(LAT_HIST_SHIFT+n-1), 2^(LAT_HIST_SHIFT+n)) ns and the
+ * last bucket takes everything longer.  With the defaults that is
+ * under 256 ns up to 4.2 ms and over.
+ */
+#ifndef GUARD_NTP_HIST_H
+#define GUARD_NTP_HIST_H
+
+#include <stdint.h>
+
+#define LAT_HIST_BUCKETS	16
+#define LAT_HIST_SHIFT		8
+
+struct lat_hist {
+	uint64_t	count;
+	uint64_t	bucket[LAT_HIST_BUCKETS];
+};
+
+static inline void
+lat_hist_add(
+	struct lat_hist *	h,
+	uint64_t		ns
+	)
+{
+	uint64_t	v = ns >> LAT_HIST_SHIFT;
+	unsigned int	b = 0;
+
+	while (v != 0 && b < LAT_HIST_BUCKETS - 1) {
+		v >>= 1;
+		b++;
+	}
+	h->bucket[b]++;
+	h->count++;
+}
+
+/* space separated bucket counts, in a static buffer (ntp_util.c) */
+extern const char *	lat_hist_str(const struct lat_hist *);
+
+#endif	/* GUARD_NTP_HIST_H */
@@ -0,0 +1,51 @@
+/*
+ * ntp_uring.h - io_uring receive and send path for the NTP sockets
+ */
+#ifndef GUARD_NTP_URING_H
+#define GUARD_NTP_URING_H
+
+#include "ntp.h"
+
+/*
+ * Multishot recvmsg() and provided buffer rings arrived together in
+ * the Linux 6.0 headers; older kernels are turned away at run time.
+ */
+#ifdef HAVE_LINUX_IO_URING_H
+# include <sys/syscall.h>
+# include <linux/io_uring.h>
+# if defined(__NR_io_uring_setup) && defined(IORING_RECV_MULTISHOT)
+#  define USE_IO_URING
+# endif
+#endif
+
+#define URING_MIN	8	/* fewest ring entries and buffers */
+#define URING_MAX	4096	/* most */
+
+#ifdef USE_IO_URING
+extern unsigned int	io_uring_entries;	/* 0 => not used */
+
+/*
+ * Take over reading an endpoint's socket.  Returns false if the
+ * ring is off or unusable, in which case io_handler() keeps
+ * watching the socket as before.
+ */
+extern bool	uring_add_endpt(endpt *, SOCKET);
+extern void	uring_drop_endpt(endpt *);
+
+/* the ring's descriptor, for io_handler() to wait on */
+extern int	uring_fd(void);
+
+/* reap completions; called when the ring's descriptor is readable */
+extern void	uring_input(void);
+
+/*
+ * Queue a packet for sending with the other replies to the batch
+ * being processed.  Returns false when not inside uring_input() or
+ * out of send slots; the caller then sends it itself.
+ */
+extern bool	uring_sendpkt(sockaddr_u *, endpt *, void *, unsigned int);
+
+extern uint64_t	uring_pkts_count(void);
+#endif	/* USE_IO_URING */
+
+#endif	/* GUARD_NTP_URING_H */
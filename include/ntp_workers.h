@@ -0,0 +1,47 @@
+/*
+ * ntp_workers.h - optional threads answering client requests
+ */
+#ifndef GUARD_NTP_WORKERS_H
+#define GUARD_NTP_WORKERS_H
+
+#include <sys/socket.h>
+
+#include "ntp.h"
+
+/*
+ * The workers need epoll and a kernel that spreads datagrams over
+ * several SO_REUSEPORT sockets bound to the same address.
+ */
+#if defined(HAVE_EPOLL_CREATE1) && defined(SO_REUSEPORT)
+# define USE_WORKERS
+#endif
+
+#define WORKERS_MAX	64	/* most server worker threads */
+
+#ifdef USE_WORKERS
+extern unsigned int	io_workers;	/* 0 => everything on main thread */
+
+/* start the threads, call once the sandbox is up */
+extern void	workers_start(void);
+
+/* open or retire each worker's socket for a local endpoint */
+extern void	workers_add_endpt(endpt *);
+extern void	workers_drop_endpt(endpt *);
+
+/*
+ * Workers hand what they don't answer themselves to the main thread,
+ * and ring workers_wake_fd() when they do.  workers_input() runs it
+ * all through receive().
+ */
+extern SOCKET	workers_wake_fd(void);
+extern void	workers_input(void);
+
+/* add the workers' counts to the totals, once a second */
+extern void	workers_collect(void);
+
+extern uint64_t	workers_replies_count(void);
+extern uint64_t	workers_passed_count(void);
+extern uint64_t	workers_socket_drops(void);
+#endif	/* USE_WORKERS */
+
+#endif	/* GUARD_NTP_WORKERS_H */
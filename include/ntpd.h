@@ -19,6 +19,7 @@
 #include "ntp_refclock.h"
 #include "ntp_control.h"
 #include "recvbuff.h"
+#include "ntp_hist.h"
 
 /*
  * First half: ntpd types, functions, macros
@@ -90,6 +91,13 @@ extern	void	set_var (struct ctl_var **, const char *, unsigned long, unsigned sh
 extern	void	set_sys_var (const char *, unsigned long, unsigned short);
 extern	const char *	get_ext_sys_var(const char *tag);
 
+/* ntp_destcache.c */
+extern	bool	dest_cache_find		(const sockaddr_u *, endpt **);
+extern	void	dest_cache_store	(const sockaddr_u *, endpt *);
+extern	void	dest_cache_flush	(void);
+extern	void	dest_cache_drop		(const endpt *);
+extern	void	dest_cache_drop_unbound	(void);
+
 /* ntp_io.c */
 typedef struct interface_info {
 	endpt *	ep;
@@ -109,20 +117,59 @@ extern	void	init_io		(void);
 extern	void	io_open_sockets	(void);
 extern	void	io_clr_stats	(void);
 extern	void	sendpkt		(sockaddr_u *, endpt *, void *, unsigned int);
+extern	void	sendpkt_timed	(sockaddr_u *, endpt *, void *, unsigned int,
+				 const l_fp *, associd_t);
 extern const char * latoa(endpt *);
 extern  uint64_t dropped_count(void);
 extern  uint64_t ignored_count(void);
+extern  uint64_t drop_nobuf_count(void);
+extern  uint64_t drop_spoofed_count(void);
+extern  uint64_t drop_reads_count(void);
+extern  uint64_t dest_hits_count(void);
+extern  uint64_t dest_misses_count(void);
+extern  uint64_t socket_drops(SOCKET);
+extern  uint64_t kernel_drops_count(void);
 extern  uint64_t received_count(void);
 extern  void     inc_received_count(void);
+extern  void     io_count_received(endpt *, unsigned long);
+extern  void     io_count_spoofed(unsigned long);
+extern  void     io_count_sent(endpt *, unsigned long, unsigned long);
+extern  void     io_count_dropped(endpt *, unsigned long);
+extern  void     io_count_batch(uint64_t);
+extern  void     io_count_batch_send(void);
+extern  void     io_watch_fd(SOCKET, bool);
+extern  void     deliver_network_packet(SOCKET, endpt *, struct recvbuf *,
+					struct msghdr *);
+extern  bool     is_spoofed_loopback(const endpt *, const sockaddr_u *);
+extern  bool     drop_spoofed_loopback(endpt *, sockaddr_u *);
+extern  SOCKET   open_worker_socket(endpt *);
 extern  uint64_t sent_count(void);
 extern  uint64_t notsent_count(void);
 extern  uint64_t handler_calls_count(void);
 extern  uint64_t handler_pkts_count(void);
+extern  uint64_t batch_reads_count(void);
+extern  uint64_t batch_pkts_count(void);
+extern  uint64_t batch_peak_count(void);
+extern  uint64_t batch_sends_count(void);
 #ifdef REFCLOCK
 extern  uint64_t handler_refrds_count(void);
 #endif
 extern  uptime_t io_timereset;
 extern  uint16_t extra_port;
+extern  unsigned int io_recvbatch;
+
+/* netlink address deltas instead of rescans, with "extra ifdeltas" */
+#if defined(HAVE_NET_ROUTE_H) && defined(HAVE_LINUX_RTNETLINK_H)
+# define USE_IFDELTAS
+#endif
+extern  bool io_ifdeltas;
+
+/* low-latency receive, "extra busypoll" and "extra iocpu" */
+#define BUSYPOLL_MAX	10000	/* microseconds */
+extern  unsigned int io_busypoll;	/* 0 => block at once */
+extern  int io_cpu;			/* -1 => not pinned */
+extern  void io_pin_thread(void);
+extern  const char *rxlat_hist(void);
 
 /* ntp_loopfilter.c */
 extern	void	init_loopfilter(void);
@@ -138,13 +185,21 @@ extern	int	freq_cnt;
 extern	void	init_mon(void);
 extern	void	mon_setup(int);
 extern	void	mon_setdown(int);
+extern	void	mon_set_threads(unsigned int);
 extern	void	mon_start(void);
 extern	void	mon_stop(void);
+extern	void	mon_sum_stats(void);
+extern	void	mon_lock_all(void);
+extern	void	mon_unlock_all(void);
 extern	void	mon_timer(void);
 extern	unsigned short	ntp_monitor	(struct recvbuf *, unsigned short);
 extern	void	mon_clearinterface(endpt *interface);
 extern  int	mon_get_oldest_age(l_fp);
 extern  mon_entry *mon_get_slot(sockaddr_u *);
+extern	void	mon_get_addr(const mon_entry *, sockaddr_u *);
+extern	void	mon_walk_start(const mon_entry *);
+extern	mon_entry *mon_walk_next(void);
+extern	float	mon_decay(l_fp);
 
 /* ntp_peer.c */
 extern	void	init_peer	(void);
@@ -200,10 +255,53 @@ extern uptime_t stat_total_stattime(void);
 extern uptime_t stat_stattime(void);
 
 extern void increment_restricted(void);
+struct statistics_counters;
+extern struct statistics_counters *stat_proto_new(void);
+extern void stat_proto_fold(struct statistics_counters *);
 extern uptime_t stat_use_stattime(void);
 extern void set_use_stattime(uptime_t stattime);
 extern uptime_t	use_stattime;		/* time since usestats reset */
 
+/*
+ * Receive path stage timing.  With "extra stagetime N" one packet in
+ * N has each stage it passes through timed on CLOCK_MONOTONIC_RAW.
+ */
+enum rx_stage {
+	STAGE_RESTRICT,		/* restrictions() */
+	STAGE_MONITOR,		/* ntp_monitor() */
+	STAGE_PARSE,		/* parse_packet() */
+	STAGE_AUTH,		/* authlookup() and authdecrypt() */
+	STAGE_EXTENS,		/* extens_server_recv() */
+	STAGE_REPLY,		/* fast_xmit() building and signing */
+	STAGE_SEND,		/* sendpkt(), only queueing when batched */
+	RX_STAGES
+};
+struct stage_stat {
+	uint64_t	ns;		/* total time in the stage */
+	struct lat_hist	hist;
+};
+#define STAGETIME_MAX	1000000
+extern unsigned int	stage_sample;		/* 0 => off */
+extern struct stage_stat stage_stats[RX_STAGES];
+extern const char * const stage_names[RX_STAGES];
+extern void	stage_pick(void);
+extern void	stage_clr_stats(void);
+extern void	stage_hour_mark(void);
+extern void	stage_since(enum rx_stage, struct stage_stat *);
+extern void	stage_hour(enum rx_stage, struct stage_stat *);
+
+#define stage_form(name)\
+extern const char *stage_##name##_hist(void);\
+extern uint64_t stage_##name##_ns(void)
+stage_form(restrict);
+stage_form(monitor);
+stage_form(parse);
+stage_form(auth);
+stage_form(extens);
+stage_form(reply);
+stage_form(send);
+#undef stage_form
+
 extern	void	poll_update	(struct peer *, uint8_t);
 
 extern	void	clock_filter	(struct peer *, double, double, double);
@@ -218,6 +316,13 @@ extern	void	hack_restrict	(int, sockaddr_u *, sockaddr_u *,
 				 unsigned short, unsigned short);
 extern	void	restrict_source		(struct peer *);
 extern	void	unrestrict_source	(struct peer *);
+extern	void	restrict_file		(const char *, unsigned short,
+					 unsigned short);
+extern	void	check_restrict_file	(bool);
+extern	void	restrict_readers	(unsigned int);
+extern	void	restrict_online		(unsigned int);
+extern	void	restrict_offline	(unsigned int);
+extern	restrict_u *	restrict_file_list	(bool);
 
 /* ntp_timer.c */
 extern	void	init_timer	(void);
@@ -269,6 +374,23 @@ extern	void	check_cert_file	(void);
 extern void	enable_packetstamps(int, sockaddr_u *);
 extern l_fp	fetch_packetstamp(struct msghdr *);
 
+/*
+ * Software transmit timestamps read back from the socket error
+ * queue, with "extra txstamps".
+ */
+#if defined(HAVE_LINUX_NET_TSTAMP_H) && defined(HAVE_LINUX_ERRQUEUE_H)
+# define USE_TXSTAMPS
+#endif
+extern bool	io_txstamps;
+extern void	enable_txstamps(endpt *, SOCKET);
+extern void	disable_txstamps(endpt *);
+extern void	note_txstamp(endpt *, const l_fp *, associd_t);
+extern void	read_txstamps(endpt *);
+extern const char *txstamp_hist(const endpt *);
+extern const char *txstamp_hist_all(void);
+extern uint64_t	txstamp_matched_count(void);
+extern uint64_t	txstamp_lost_count(void);
+
 /*
  * Signals we catch for debugging.
  */
@@ -349,18 +471,15 @@ extern struct clock_state_machine clkstate;
 
 /* ntp_monitor.c */
 struct monitor_data {
-	uint8_t	mon_hash_bits;		/* log2 size of hash table */
 	/*
-	 * Pointers to the hash table and the MRU list.  Memory for the hash
-	 * table is allocated only if monitoring is enabled.
+	 * The entries themselves live in ntp_monitor.c, allocated only
+	 * if monitoring is enabled.
 	 * Total size can easily exceed 32 bits (4 GB)
 	 * Total count is unlikely to exceed 32 bits in 2017
 	 *   but memories keep growing.
 	 */
-	mon_entry ** mon_hash;		/* MRU hash table */
-	mon_entry mon_mru_list;		/* mru listhead */
 	uint64_t	mru_entries;		/* mru list count */
-	uint64_t	mru_hashslots;		/* hash slots in use */
+	uint64_t	mru_hashslots;		/* size of the hash index */
 	/*
 	 * Initialization state.  We may be monitoring, we may not.  If
 	 * we aren't, we may not even have allocated any memory yet.
@@ -386,6 +505,17 @@ struct monitor_data {
 	float		rate_limit;   /* responses per second */
 	float		decay_time;   /* seconds, exponential decay time */
 	float		kod_limit ;   /* KoDs per second */
+/* rate limiting by source prefix, off while both lengths are 0 */
+	int		prefix_v4;		/* IPv4 prefix length */
+	int		prefix_v6;		/* IPv6 prefix length */
+	float		prefix_limit;		/* responses/second/prefix */
+	float		prefix_kod;		/* KoDs/second/prefix */
+	uint64_t	prefix_slots;		/* size of the prefix table */
+	uint64_t	prefix_used;		/* prefixes in it */
+	uint64_t	prefix_new;		/* prefix added */
+	uint64_t	prefix_recycled;	/* ... in place of another */
+	uint64_t	prefix_limited;		/* packets over prefix limit */
+	uint64_t	prefix_kods;		/* ... answered with a KoD */
 };
 extern struct monitor_data mon_data;
 
@@ -416,6 +546,31 @@ struct system_variables {
 };
 extern struct system_variables sys_vars;
 
+/*
+ * The part of the system variables fast_xmit() puts in a reply,
+ * kept as the wire-format start of a server reply, li_vn_mode up to
+ * reftime.  Only the version and poll need patching per request.
+ * publish_server_state() rebuilds it whenever the discipline
+ * changes them, and read_server_state() hands out a consistent copy
+ * without locking, so server threads never look at sys_vars.
+ */
+#define	LEN_REPLY_PREFIX	offsetof(struct pkt, org)
+struct server_state {
+	uint8_t	prefix[LEN_REPLY_PREFIX];	/* smeared if smearing */
+#ifdef ENABLE_LEAP_SMEAR
+	bool	smearing;		/* leap_smear.in_progress */
+	l_fp	smear_offset;		/* leap_smear.offset */
+#endif
+};
+extern	void	publish_server_state	(void);
+extern	void	read_server_state	(struct server_state *);
+extern	bool	is_simple_request	(struct recvbuf const *);
+extern	bool	receive_simple	(struct recvbuf *, int *,
+					 struct statistics_counters *);
+extern	l_fp	fill_server_reply	(struct recvbuf const *,
+					 struct server_state const *, int,
+					 struct pkt *);
+
 /*
  * Nonspecified system state variables.
  */
@@ -500,6 +655,7 @@ void nts_init(void);   /* Before sandbox() */
 void nts_init2(void);  /* After sandbox() */
 bool nts_probe(struct peer *peer);
 bool nts_check(struct peer *peer);
+void nts_free_session(struct peer *peer);
 void nts_timer(void);
 
 /* ntp_sandbox.c */
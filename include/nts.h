@@ -21,6 +21,13 @@
 #define NTS_KE_PORTA		"4460"
 
 #define NTS_KE_TIMEOUT		3
+#define NTS_KE_TIMEOUT_MAX	60
+
+/* server side: threads, and connections open at once per address */
+#define NTS_KE_WORKERS		2
+#define NTS_KE_WORKERS_MAX	64
+#define NTS_KE_LIMIT		8
+#define NTS_KE_LIMIT_MAX	1024
 
 bool nts_server_init(void);
 bool nts_client_init(void);
@@ -38,10 +45,21 @@ bool nts_write_cookie_keys(void);
 int nts_make_cookie(uint8_t *cookie,
   uint16_t aead,
   uint8_t *c2s, uint8_t *s2c, int keylen);
+int nts_make_cookies(uint8_t *cookies, size_t stride, int count,
+  uint16_t aead,
+  uint8_t *c2s, uint8_t *s2c, int keylen);
+void nts_nonce(uint8_t *nonce);
 bool nts_unpack_cookie(uint8_t *cookie, int cookielen,
   uint16_t *aead,
   uint8_t *c2s, uint8_t *s2c, int *keylen);
 
+/* NTS-KE session ticket keys, derived from the cookie keys */
+#define NTS_TICKET_NAME_LEN	16
+#define NTS_TICKET_KEY_LEN	32
+#define NTS_TICKET_LIFETIME	(2*24*60*60)	/* seconds */
+int nts_ticket_key(const uint8_t *find, uint8_t *name,
+  uint8_t *aes, uint8_t *hmac);
+
 /* working finger into a buffer - updated by append/unpack routines */
 struct BufCtl_t {
     uint8_t *next;  /* pointer to next data/space */
@@ -132,6 +150,8 @@ struct ntsclient_t {
 	int count;			/* -1 if not in NTS mode */
 	int cookielen;
 	uint8_t cookies[NTS_MAX_COOKIES][NTS_MAX_COOKIELEN];
+	/* TLS session from the last NTS-KE, to resume the next */
+	struct ssl_session_st *session;
 };
 
 /* Server-side state per packet */
@@ -159,6 +179,9 @@ struct ntsconfig_t {
 	const char *ca;		/* root cert dir/file */
 	const char *aead;	/* AEAD algorithms on wire */
 	bool tlscipherserverpreference;  /* OpenSSL 3.0 default is client */
+	int keworkers;		/* NTS-KE server threads */
+	int kelimit;		/* connections per client address, 0 => any */
+	int ketimeout;		/* seconds allowed for a whole exchange */
 };
 
 
@@ -268,8 +291,12 @@ struct ntske_counters {
   uint64_t serves_bad;
   l_fp     serves_bad_wall;
   l_fp     serves_bad_cpu;
+  uint64_t serves_limited;	/* turned away by kelimit */
+  uint64_t serves_full;		/* full TLS handshakes */
+  uint64_t serves_resumed;	/* handshakes resumed from a ticket */
   uint64_t probes_good;
   uint64_t probes_bad;
+  uint64_t probes_resumed;	/* probes that resumed a session */
 };
 extern struct nts_counters nts_cnt, old_nts_cnt;
 extern struct ntske_counters ntske_cnt, old_ntske_cnt;
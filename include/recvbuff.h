@@ -6,6 +6,8 @@
 #include "ntp_lists.h"
 #include "nts.h"
 
+#include <sys/uio.h>
+
 /*
  * recvbuf memory management
  */
@@ -13,6 +15,7 @@
 #define RECV_LOWAT	3	/* when we're down to three buffers get more */
 #define RECV_INC	5	/* get 5 more at a time */
 #define RECV_TOOMANY	40	/* this is way too many buffers */
+#define RECV_BATCH_MAX	64	/* most datagrams per batched read */
 
 /*
  * Format of a recvbuf.  Back when ntpd did true asynchronous
@@ -30,23 +33,38 @@
  */
 #define	RX_BUFF_SIZE	(LEN_PKT_NOMAC + MAX_MAC_LEN + MAX_EXT_LEN)
 
+/*
+ * Nearly all traffic is bare or MAC'd requests, which fit in
+ * RX_SMALL_SIZE octets kept in the recvbuf itself.  A longer datagram
+ * lands in a jumbo slot of RX_BUFF_SIZE from a separate pool, which
+ * also carries the NTS state.  So ntspacket is NULL for small ones.
+ */
+#define	RX_SMALL_SIZE	(LEN_PKT_NOMAC + MAX_MAC_LEN)
+
+/* more jumbo slots than this are never needed at once */
+#define	RECV_JUMBO_MAX	(RECV_BATCH_MAX + RECV_INIT)
+
 
 typedef struct recvbuf recvbuf_t;
 
 struct recvbuf {
+	/* filled in by the read */
 	recvbuf_t *	link;		/* next in list */
-	sockaddr_u	recv_srcadr;	/* where packet came from */
+	uint8_t *	recv_buffer;	/* recv_space or a jumbo slot */
+	size_t		recv_length;	/* number of octets received */
+	l_fp		recv_time;	/* time of arrival */
 	struct netendpt *	dstadr;	/* address pkt arrived on */
 	SOCKET		fd;		/* fd on which it was received */
-	l_fp		recv_time;	/* time of arrival */
-	size_t		recv_length;	/* number of octets received */
-	uint8_t		recv_buffer[RX_BUFF_SIZE];
+	uint8_t		recv_space[RX_SMALL_SIZE];
+	sockaddr_u	recv_srcadr;	/* where packet came from */
+	/* filled in by parse_packet() */
 	struct parsed_pkt pkt;  /* host-order copy of data from wire */
 	bool keyid_present;
 	keyid_t keyid;
 	int mac_len;
 	bool extens_present;
-	struct ntspacket_t ntspacket;
+	struct ntspacket_t *ntspacket;	/* in the jumbo slot, or NULL */
+	struct rx_jumbo *jumbo;		/* attached jumbo slot, or NULL */
 #ifdef REFCLOCK
 	struct peer *	recv_peer;
 #endif /* REFCLOCK */
@@ -54,6 +72,9 @@ struct recvbuf {
 
 extern	void	init_recvbuff(unsigned int); /* not really pure */
 
+/* expand_recvbuff - grow the pool to at least this many buffers */
+extern	void	expand_recvbuff(unsigned int);
+
 /* freerecvbuf - make a single recvbuf available for reuse
  */
 extern	void	freerecvbuf(struct recvbuf *);
@@ -63,15 +84,30 @@ extern	void	freerecvbuf(struct recvbuf *);
  *
  *  The buffer is removed from the free list. Make sure
  *  you put it back with freerecvbuf() or
+ *
+ *  Its recv_buffer holds RX_BUFF_SIZE octets.
  */
 
 /* signal safe - no malloc */
 extern	struct recvbuf *get_free_recv_buffer(void);
 
+/*
+ * For reading a datagram off a socket: a buffer with iov[0] on its
+ * own small space and iov[1] on a shared spill area for anything
+ * longer.  Call recvbuf_settle() with the iov and the length read;
+ * it takes a jumbo slot only for a datagram that needs one, and
+ * returns false, the datagram lost, when none is free.
+ */
+extern	struct recvbuf *get_free_recv_buffer_iov(struct iovec *);
+extern	bool	recvbuf_settle(struct recvbuf *, const struct iovec *, size_t);
+
+/* a full size buffer outside the pool, for a thread of its own */
+extern	struct recvbuf *new_private_recv_buffer(void);
 
 /* number of recvbufs on freelist */
 extern unsigned long free_recvbuffs(void);    /* not really pure */
 extern unsigned long total_recvbuffs(void);   /* not really pure */
 extern unsigned long lowater_additions(void); /* not really pure */
+extern unsigned long free_jumbo_buffs(void);  /* not really pure */
 
 #endif	/* GUARD_RECVBUFF_H */
@@ -166,6 +166,7 @@ static const struct codestring res_match_bits[] = {
 	{ RESM_NTPONLY,			"ntpport" },
 	{ RESM_INTERFACE,		"interface" },
 	{ RESM_SOURCE,			"source" },
+	{ RESM_FILE,			"file" },
 	/* not used with getcode(), no terminating entry needed */
 };
 
@@ -1575,6 +1575,7 @@ usage: kerninfo
             ("ss_badformat", "bad length or format: ", NTP_PACKETS),
             ("ss_badauth",   "authentication failed:", NTP_PACKETS),
             ("ss_declined",  "declined:             ", NTP_PACKETS),
+            ("ss_kerneldrop", "dropped by kernel:    ", NTP_PACKETS),
             ("ss_restricted","restricted:           ", NTP_PACKETS),
             ("ss_limited",   "rate limited:         ", NTP_PACKETS),
             ("ss_kodsent",   "KoD responses:        ", NTP_PACKETS),
@@ -1587,6 +1588,35 @@ usage: kerninfo
         self.say("""\
 function: display system uptime and packet counts
 usage: sysstats
+""")
+
+    def do_stagestats(self, _line):
+        "display receive path stage timing"
+        stagestats = (
+            ("ss_reset",       "time since reset:     ", NTP_UPTIME),
+            ("st_sample",      "timing one in:        ", NTP_INT),
+            ("st_restrict",    "restrict histogram:   ", NTP_STR),
+            ("st_restrict_ns", "restrict total ns:    ", NTP_INT),
+            ("st_monitor",     "monitor histogram:    ", NTP_STR),
+            ("st_monitor_ns",  "monitor total ns:     ", NTP_INT),
+            ("st_parse",       "parse histogram:      ", NTP_STR),
+            ("st_parse_ns",    "parse total ns:       ", NTP_INT),
+            ("st_auth",        "auth histogram:       ", NTP_STR),
+            ("st_auth_ns",     "auth total ns:        ", NTP_INT),
+            ("st_extens",      "extens histogram:     ", NTP_STR),
+            ("st_extens_ns",   "extens total ns:      ", NTP_INT),
+            ("st_reply",       "reply histogram:      ", NTP_STR),
+            ("st_reply_ns",    "reply total ns:       ", NTP_INT),
+            ("st_send",        "send histogram:       ", NTP_STR),
+            ("st_send_ns",     "send total ns:        ", NTP_INT),
+        )
+        self.collect_display(associd=0, variables=stagestats,
+                             decodestatus=False)
+
+    def help_stagestats(self):
+        self.say("""\
+function: display receive path stage timing
+usage: stagestats
 """)
 
 # FIXME: This table should move to ntpd
@@ -1595,7 +1625,7 @@ usage: sysstats
         "display monitor (mrulist) counters and limits"
         monstats = (
             ("mru_enabled",     "enabled:              ", NTP_INT),
-            ("mru_hashslots",   "hash slots in use:    ", NTP_INT),
+            ("mru_hashslots",   "hash slots:           ", NTP_INT),
             ("mru_depth",       "addresses in use:     ", NTP_INT),
             ("mru_deepest",     "peak addresses:       ", NTP_INT),
             ("mru_maxdepth",    "maximum addresses:    ", NTP_INT),
@@ -1610,6 +1640,14 @@ usage: sysstats
             ("mru_recyclefull", "alloc: recycle full:  ", NTP_INT),
             ("mru_none",        "alloc: none:          ", NTP_INT),
             ("mru_oldest_age",  "age of oldest slot:   ", NTP_UPTIME),
+            ("mru_prefixv4",    "IPv4 prefix length:   ", NTP_INT),
+            ("mru_prefixv6",    "IPv6 prefix length:   ", NTP_INT),
+            ("mru_prefixslots", "prefix slots:         ", NTP_INT),
+            ("mru_prefixused",  "prefixes in use:      ", NTP_INT),
+            ("mru_prefixnew",   "prefix: new:          ", NTP_INT),
+            ("mru_prefixrecycled", "prefix: recycled:     ", NTP_INT),
+            ("mru_prefixlimited", "prefix: limited:      ", NTP_INT),
+            ("mru_prefixkod",   "prefix: KoD:          ", NTP_INT),
         )
         self.collect_display(associd=0, variables=monstats, decodestatus=False)
 
@@ -1681,8 +1719,12 @@ usage: authinfo
    ("nts_ke_serves_bad",         "NTS KE serves bad:          ", NTP_UINT),
    ("nts_ke_serves_bad_wall",    "NTS KE serves bad wall:     ", NTP_FLOAT),
    ("nts_ke_serves_bad_cpu",     "NTS KE serves bad CPU:      ", NTP_FLOAT),
+   ("nts_ke_serves_limited",     "NTS KE serves limited:      ", NTP_UINT),
+   ("nts_ke_serves_full",        "NTS KE serves full TLS:     ", NTP_UINT),
+   ("nts_ke_serves_resumed",     "NTS KE serves resumed TLS:  ", NTP_UINT),
    ("nts_ke_probes_good",        "NTS KE client probes good:  ", NTP_UINT),
    ("nts_ke_probes_bad",         "NTS KE client probes bad:   ", NTP_UINT),
+   ("nts_ke_probes_resumed",     "NTS KE client resumed:      ", NTP_UINT),
   )
         self.collect_display(associd=0, variables=ntsinfo, decodestatus=False)
         self.collect_display(associd=0, variables=ntskeinfo, decodestatus=False)
@@ -1727,12 +1769,28 @@ usage: mssntpinfo
             ("used_rbuf", "used receive buffers: ", NTP_INT),
             ("rbuf_lowater", "low water refills:    ", NTP_INT),
             ("io_dropped", "dropped packets:      ", NTP_PACKETS),
+            ("io_drop_nobuf", "  no buffer:          ", NTP_PACKETS),
+            ("io_drop_spoofed", "  spoofed loopback:   ", NTP_PACKETS),
             ("io_ignored", "ignored packets:      ", NTP_PACKETS),
+            ("io_drop_reads", "discarding reads:     ", NTP_INT),
             ("io_received", "received packets:     ", NTP_PACKETS),
             ("io_sent", "packets sent:         ", NTP_PACKETS),
             ("io_sendfailed", "packet send failures: ", NTP_PACKETS),
             ("io_wakeups", "input wakeups:        ", NTP_INT),
             ("io_goodwakeups", "useful input wakeups: ", NTP_INT),
+            ("io_batch_reads", "batched reads:        ", NTP_INT),
+            ("io_batch_pkts", "batched packets:      ", NTP_PACKETS),
+            ("io_batch_peak", "largest batch:        ", NTP_INT),
+            ("io_batch_sends", "batched sends:        ", NTP_INT),
+            ("io_dest_hits", "route cache hits:     ", NTP_INT),
+            ("io_dest_misses", "route cache misses:   ", NTP_INT),
+            ("io_rxlat", "RX latency histogram: ", NTP_STR),
+            ("io_txstamps", "TX timestamps:        ", NTP_INT),
+            ("io_txstamp_lost", "TX timestamps lost:   ", NTP_INT),
+            ("io_txlat", "TX latency histogram: ", NTP_STR),
+            ("io_uring_pkts", "io_uring packets:     ", NTP_PACKETS),
+            ("io_worker_replies", "worker replies:       ", NTP_PACKETS),
+            ("io_worker_passed", "worker passed:        ", NTP_PACKETS),
         )
         self.collect_display(associd=0, variables=iostats, decodestatus=False)
 
@@ -51,6 +51,14 @@ struct key_tok ntp_keywords[] = {
 { "pidfile",		T_Pidfile,		FOLLBY_STRING },
 { "pool",		T_Pool,			FOLLBY_STRING },
 { "port",		T_Port,			FOLLBY_TOKEN },
+{ "busypoll",		T_Busypoll,		FOLLBY_TOKEN },
+{ "ifdeltas",		T_Ifdeltas,		FOLLBY_TOKEN },
+{ "iocpu",		T_Iocpu,		FOLLBY_TOKEN },
+{ "recvbatch",		T_Recvbatch,		FOLLBY_TOKEN },
+{ "stagetime",		T_Stagetime,		FOLLBY_TOKEN },
+{ "txstamps",		T_Txstamps,		FOLLBY_TOKEN },
+{ "uring",		T_Uring,		FOLLBY_TOKEN },
+{ "workers",		T_Workers,		FOLLBY_TOKEN },
 { "ppspath",		T_Ppspath,		FOLLBY_STRING },
 { "reset",		T_Reset,		FOLLBY_TOKEN },
 { "restrict",		T_Restrict,		FOLLBY_TOKEN },
@@ -102,6 +110,7 @@ struct key_tok ntp_keywords[] = {
 { "usestats",		T_Usestats,		FOLLBY_TOKEN },
 { "ntsstats",		T_Ntsstats,		FOLLBY_TOKEN },
 { "ntskestats",		T_Ntskestats,		FOLLBY_TOKEN },
+{ "stagestats",		T_Stagestats,		FOLLBY_TOKEN },
 /* filegen_option */
 { "file",		T_File,			FOLLBY_STRING },
 { "link",		T_Link,			FOLLBY_TOKEN },
@@ -148,6 +157,10 @@ struct key_tok ntp_keywords[] = {
 { "ntpport",		T_Ntpport,		FOLLBY_TOKEN },
 /* limit_option */
 { "average",		T_Average,		FOLLBY_TOKEN },
+{ "prefixaverage",	T_Prefixaverage,	FOLLBY_TOKEN },
+{ "prefixkod",		T_Prefixkod,		FOLLBY_TOKEN },
+{ "prefixv4",		T_Prefixv4,		FOLLBY_TOKEN },
+{ "prefixv6",		T_Prefixv6,		FOLLBY_TOKEN },
 { "monitor",		T_Monitor,		FOLLBY_TOKEN },
 /* mru_option */
 { "incalloc",		T_Incalloc,		FOLLBY_TOKEN },
@@ -209,6 +222,9 @@ struct key_tok ntp_keywords[] = {
 { "tlsciphersuites",	T_Tlsciphersuites,	FOLLBY_STRING },
 { "tlsecdhcurves",	T_Tlsecdhcurves,	FOLLBY_STRING },
 { "tlscipherserverpreference",	T_Tlscipherserverpreference,	FOLLBY_TOKEN },
+{ "kelimit",		T_Kelimit,		FOLLBY_TOKEN },
+{ "ketimeout",		T_Ketimeout,		FOLLBY_TOKEN },
+{ "keworkers",		T_Keworkers,		FOLLBY_TOKEN },
 };
 
 typedef struct big_scan_state_tag {
@@ -17,6 +17,9 @@
 #include <ctype.h>
 #include <signal.h>
 #include <sys/wait.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+# include <sched.h>
+#endif
 
 #include "isc_netaddr.h"
 
@@ -29,6 +32,8 @@
 #include "lib_strbuf.h"
 #include "ntp_assert.h"
 #include "ntp_dns.h"
+#include "ntp_workers.h"
+#include "ntp_uring.h"
 #include "ntp_auth.h"
 
 /*
@@ -1463,6 +1468,7 @@ config_access(
 	struct addrinfo *	pai;
 	int			rc;
 	bool			restrict_default;
+	bool			from_file;
 	unsigned short		flags;
 	unsigned short		mflags;
 	bool			range_err;
@@ -1575,6 +1581,32 @@ config_access(
 			mon_data.kod_limit = my_opt->value.d;
 			break;
 
+		case T_Prefixaverage:
+			mon_data.prefix_limit = my_opt->value.d;
+			break;
+
+		case T_Prefixkod:
+			mon_data.prefix_kod = my_opt->value.d;
+			break;
+
+		case T_Prefixv4:
+			if (0 <= my_opt->value.d && my_opt->value.d <= 32)
+				mon_data.prefix_v4 = (int)my_opt->value.d;
+			else
+				msyslog(LOG_ERR,
+					"CONFIG: limit prefixv4 %g out of range 0..32, ignored",
+					my_opt->value.d);
+			break;
+
+		case T_Prefixv6:
+			if (0 <= my_opt->value.d && my_opt->value.d <= 128)
+				mon_data.prefix_v6 = (int)my_opt->value.d;
+			else
+				msyslog(LOG_ERR,
+					"CONFIG: limit prefixv6 %g out of range 0..128, ignored",
+					my_opt->value.d);
+			break;
+
 		}
 	}
 
@@ -1590,6 +1622,7 @@ config_access(
 		/* Parse the flags */
 		flags = 0;
 		mflags = 0;
+		from_file = false;
 
 		curr_flag = HEAD_PFIFO(my_node->flags);
 		for (; curr_flag != NULL; curr_flag = curr_flag->link) {
@@ -1607,6 +1640,10 @@ config_access(
 				mflags |= RESM_SOURCE;
 				break;
 
+			case T_File:
+				from_file = true;
+				break;
+
 			case T_Flake:
 				flags |= RES_FLAKE;
 				break;
@@ -1680,6 +1717,17 @@ config_access(
 			msyslog(LOG_WARNING, "CONFIG: restrict %s: %s", kod_where, kod_warn);
 		}
 
+		if (from_file) {
+			if (T_Restrict == my_node->mode)
+				restrict_file(my_node->addr->address,
+					      mflags, flags);
+			else
+				msyslog(LOG_ERR,
+					"CONFIG: unrestrict file not supported, ignoring line %d.",
+					my_node->line_no);
+			continue;
+		}
+
 		ZERO_SOCK(&addr);
 		pai = NULL;
 		restrict_default = false;
@@ -1876,9 +1924,127 @@ config_extra(
 			INSIST(0);
 			break;
 
+		case T_Busypoll:
+			if (extra->value.i < 0 ||
+			    extra->value.i > BUSYPOLL_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: busypoll %d out of range 0..%d, ignored",
+					extra->value.i, BUSYPOLL_MAX);
+				break;
+			}
+			io_busypoll = (unsigned int)extra->value.i;
+#ifndef SO_BUSY_POLL
+			if (io_busypoll > 0)
+				msyslog(LOG_ERR,
+					"CONFIG: busypoll: no SO_BUSY_POLL, spinning only");
+#endif
+			break;
+
+		case T_Ifdeltas:
+#ifdef USE_IFDELTAS
+			io_ifdeltas = (0 != extra->value.i);
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: ifdeltas needs Linux netlink, ignored");
+#endif
+			break;
+
+		case T_Iocpu:
+#ifdef HAVE_SCHED_SETAFFINITY
+			if (extra->value.i < 0 ||
+			    extra->value.i >= CPU_SETSIZE) {
+				msyslog(LOG_ERR,
+					"CONFIG: iocpu %d out of range 0..%d, ignored",
+					extra->value.i, CPU_SETSIZE - 1);
+				break;
+			}
+			io_cpu = extra->value.i;
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: iocpu needs sched_setaffinity(), ignored");
+#endif
+			break;
+
 		case T_Port:
 			extra_port = extra->value.i;
 			break;
+
+		case T_Recvbatch:
+			if (extra->value.i < 1 ||
+			    extra->value.i > RECV_BATCH_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: recvbatch %d out of range 1..%d, ignored",
+					extra->value.i, RECV_BATCH_MAX);
+				break;
+			}
+#ifdef HAVE_RECVMMSG
+			io_recvbatch = (unsigned int)extra->value.i;
+			expand_recvbuff(io_recvbatch + RECV_LOWAT);
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: recvbatch needs recvmmsg(), ignored");
+#endif
+			break;
+
+		case T_Stagetime:
+			if (extra->value.i < 0 ||
+			    extra->value.i > STAGETIME_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: stagetime %d out of range 0..%d, ignored",
+					extra->value.i, STAGETIME_MAX);
+				break;
+			}
+			stage_sample = (unsigned int)extra->value.i;
+			break;
+
+		case T_Txstamps:
+#ifdef USE_TXSTAMPS
+			io_txstamps = (0 != extra->value.i);
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: txstamps needs Linux SO_TIMESTAMPING, ignored");
+#endif
+			break;
+
+		case T_Uring:
+			if (extra->value.i != 0 &&
+			    (extra->value.i < URING_MIN ||
+			     extra->value.i > URING_MAX)) {
+				msyslog(LOG_ERR,
+					"CONFIG: uring %d out of range 0 or %d..%d, ignored",
+					extra->value.i, URING_MIN, URING_MAX);
+				break;
+			}
+#ifdef USE_IO_URING
+			/* the rings want a power of two */
+			io_uring_entries = 0;
+			if (extra->value.i > 0)
+				for (io_uring_entries = URING_MIN;
+				     io_uring_entries < (unsigned int)extra->value.i;
+				     io_uring_entries *= 2)
+					continue;
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: uring needs io_uring support, ignored");
+#endif
+			break;
+
+		case T_Workers:
+			if (extra->value.i < 0 ||
+			    extra->value.i > WORKERS_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: workers %d out of range 0..%d, ignored",
+					extra->value.i, WORKERS_MAX);
+				break;
+			}
+#ifdef USE_WORKERS
+			io_workers = (unsigned int)extra->value.i;
+			mon_set_threads(io_workers);
+#else
+			msyslog(LOG_ERR,
+				"CONFIG: workers needs epoll and SO_REUSEPORT, ignored");
+#endif
+			break;
 		}
 	}
 }
@@ -1982,6 +2148,39 @@ config_nts(
 			ntsconfig.ntsenable = true;
 			break;
 
+		case T_Kelimit:
+			if (nts->value.i < 0 ||
+			    nts->value.i > NTS_KE_LIMIT_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: nts kelimit %d out of range 0..%d, ignored",
+					nts->value.i, NTS_KE_LIMIT_MAX);
+				break;
+			}
+			ntsconfig.kelimit = nts->value.i;
+			break;
+
+		case T_Ketimeout:
+			if (nts->value.i < 1 ||
+			    nts->value.i > NTS_KE_TIMEOUT_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: nts ketimeout %d out of range 1..%d, ignored",
+					nts->value.i, NTS_KE_TIMEOUT_MAX);
+				break;
+			}
+			ntsconfig.ketimeout = nts->value.i;
+			break;
+
+		case T_Keworkers:
+			if (nts->value.i < 1 ||
+			    nts->value.i > NTS_KE_WORKERS_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: nts keworkers %d out of range 1..%d, ignored",
+					nts->value.i, NTS_KE_WORKERS_MAX);
+				break;
+			}
+			ntsconfig.keworkers = nts->value.i;
+			break;
+
 		case T_Key:
 			ntsconfig.key = estrdup(nts->value.s);
 			break;
@@ -3003,6 +3202,7 @@ config_reset_counters(
 
 		case T_Sys:
 			proto_clr_stats();
+			stage_clr_stats();
 			break;
 
 		case T_Timer:
@@ -27,6 +27,8 @@
 #include "lib_strbuf.h"
 #include "ntp_syscall.h"
 #include "ntp_auth.h"
+#include "ntp_workers.h"
+#include "ntp_uring.h"
 #include "nts.h"
 #include "timespecops.h"
 
@@ -316,6 +318,14 @@ static const struct var sys_var[] = {
   Var_u64("mru_recyclefull", RO, mon_data.mru_recyclefull),
   Var_u64("mru_none", RO, mon_data.mru_none),
   Var_special("mru_oldest_age", RO, vs_mruoldest),
+  Var_int("mru_prefixv4", RO, mon_data.prefix_v4),
+  Var_int("mru_prefixv6", RO, mon_data.prefix_v6),
+  Var_u64("mru_prefixslots", RO, mon_data.prefix_slots),
+  Var_u64("mru_prefixused", RO, mon_data.prefix_used),
+  Var_u64("mru_prefixnew", RO, mon_data.prefix_new),
+  Var_u64("mru_prefixrecycled", RO, mon_data.prefix_recycled),
+  Var_u64("mru_prefixlimited", RO, mon_data.prefix_limited),
+  Var_u64("mru_prefixkod", RO, mon_data.prefix_kods),
 
 #define Var_Pair(name, location) \
   Var_u64P(name, RO, stat_##location), \
@@ -334,12 +344,27 @@ static const struct var sys_var[] = {
   Var_Pair("ss_badformat", badlength),
   Var_Pair("ss_badauth", badauth),
   Var_Pair("ss_declined", declined),
+  Var_u64P("ss_kerneldrop", RO, kernel_drops_count),
   Var_Pair("ss_restricted", restricted),
   Var_Pair("ss_limited", limitrejected),
   Var_Pair("ss_kodsent", kodsent),
   Var_Pair("ss_processed", processed),
 #undef Var_Pair
 
+#define Var_Stage(name, location) \
+  Var_strP("st_" name, RO, stage_##location##_hist), \
+  Var_u64P("st_" name "_ns", RO, stage_##location##_ns)
+
+  Var_u32("st_sample", RO, stage_sample),
+  Var_Stage("restrict", restrict),
+  Var_Stage("monitor", monitor),
+  Var_Stage("parse", parse),
+  Var_Stage("auth", auth),
+  Var_Stage("extens", extens),
+  Var_Stage("reply", reply),
+  Var_Stage("send", send),
+#undef Var_Stage
+
 /* We own this one.  See above.  No proc mode.
  * Note that lots of others are not (yet?) in this table.  */
   Var_u64("ss_numctlreq", RO, numctlreq),
@@ -386,11 +411,31 @@ static const struct var sys_var[] = {
   Var_since("iostats_reset", RO, io_timereset),
   Var_u64P("io_dropped", RO, dropped_count),
   Var_u64P("io_ignored", RO, ignored_count),
+  Var_u64P("io_drop_nobuf", RO, drop_nobuf_count),
+  Var_u64P("io_drop_spoofed", RO, drop_spoofed_count),
+  Var_u64P("io_drop_reads", RO, drop_reads_count),
   Var_u64P("io_received", RO, received_count),
   Var_u64P("io_sent", RO, sent_count),
   Var_u64P("io_sendfailed", RO, notsent_count),
   Var_u64P("io_wakeups", RO, handler_calls_count),
   Var_u64P("io_pkt_reads", RO, handler_pkts_count),
+  Var_u64P("io_batch_reads", RO, batch_reads_count),
+  Var_u64P("io_batch_pkts", RO, batch_pkts_count),
+  Var_u64P("io_batch_peak", RO, batch_peak_count),
+  Var_u64P("io_batch_sends", RO, batch_sends_count),
+  Var_u64P("io_dest_hits", RO, dest_hits_count),
+  Var_u64P("io_dest_misses", RO, dest_misses_count),
+  Var_strP("io_rxlat", RO, rxlat_hist),
+  Var_u64P("io_txstamps", RO, txstamp_matched_count),
+  Var_u64P("io_txstamp_lost", RO, txstamp_lost_count),
+  Var_strP("io_txlat", RO, txstamp_hist_all),
+#ifdef USE_IO_URING
+  Var_u64P("io_uring_pkts", RO, uring_pkts_count),
+#endif
+#ifdef USE_WORKERS
+  Var_u64P("io_worker_replies", RO, workers_replies_count),
+  Var_u64P("io_worker_passed", RO, workers_passed_count),
+#endif
 #ifdef REFCLOCK
   Var_u64P("io_ref_reads", RO, handler_refrds_count),
 #endif
@@ -449,8 +494,12 @@ static const struct var sys_var[] = {
   Var_Pair("nts_ke_serves_bad", ntske_cnt.serves_bad),
   Var_PairF("nts_ke_serves_bad_wall", ntske_cnt.serves_bad_wall),
   Var_PairF("nts_ke_serves_bad_cpu", ntske_cnt.serves_bad_cpu),
+  Var_Pair("nts_ke_serves_limited", ntske_cnt.serves_limited),
+  Var_Pair("nts_ke_serves_full", ntske_cnt.serves_full),
+  Var_Pair("nts_ke_serves_resumed", ntske_cnt.serves_resumed),
   Var_Pair("nts_ke_probes_good", ntske_cnt.probes_good),
   Var_Pair("nts_ke_probes_bad", ntske_cnt.probes_bad),
+  Var_Pair("nts_ke_probes_resumed", ntske_cnt.probes_resumed),
 #undef Var_Pair
 #undef Var_PairF
 #endif
@@ -2742,12 +2791,14 @@ send_mru_entry(
 	const char rs_fmt[] =		"rs.%d";
 	const char sc_fmt[] =		"sc.%d";
 	const char dr_fmt[] =		"dr.%d";
+	const char pf_fmt[] =		"pf.%d";
 	char	tag[32];
-	bool	sent[8]; /* 8 tag=value pairs */
+	bool	sent[9]; /* 9 tag=value pairs */
 	uint32_t noise;
 	unsigned int	which = 0;
 	unsigned int	remaining;
 	const char * pch;
+	sockaddr_u	rmtadr;
 
 	remaining = COUNTOF(sent);
 	ZERO(sent);
@@ -2765,7 +2816,8 @@ send_mru_entry(
 
 		case 0:
 			snprintf(tag, sizeof(tag), addr_fmt, count);
-			pch = sockporttoa(&mon->rmtadr);
+			mon_get_addr(mon, &rmtadr);
+			pch = sockporttoa(&rmtadr);
 			ctl_putunqstr(tag, pch, strlen(pch));
 			break;
 
@@ -2804,6 +2856,11 @@ send_mru_entry(
 			ctl_putuint(tag, mon->dropped);
 			break;
 
+		case 8:
+			snprintf(tag, sizeof(tag), pf_fmt, count);
+			ctl_putuint(tag, mon->prefixed);
+			break;
+
 		default:
 			/* huh? */
 			break;
@@ -2988,6 +3045,7 @@ static void read_mru_list(
 	int			priors;
 	mon_entry *		mon;
 	mon_entry *		prior_mon;
+	sockaddr_u		rmtadr;
 	l_fp			now;
 
 	if (RES_NOMRULIST & restrict_mask) {
@@ -3147,6 +3205,9 @@ static void read_mru_list(
 	} else if (0 != limit && 0 == frags)
 		frags = MRU_FRAGS_LIMIT;
 
+	/* the workers must not move entries while we look at them */
+	mon_sum_stats();
+	mon_lock_all();
 	mon = NULL;
 	if (limit == 1) {
 		for (i = 0; i < COUNTOF(last); i++) {
@@ -3155,6 +3216,7 @@ static void read_mru_list(
 				send_mru_entry(mon, i);
 			}
 		}
+		mon_unlock_all();
 		generate_nonce(rbufp, buf, sizeof(buf));
 		ctl_putunqstr("nonce", buf, strlen(buf));
 		get_systime(&now);
@@ -3179,12 +3241,14 @@ static void read_mru_list(
 		/* and none could be found unmodified... */
 		if (NULL == mon) {
 			/* tell ntpq to try again with older entries */
+			mon_unlock_all();
 			ctl_error(CERR_UNKNOWNVAR);
 			return;
 		}
 		/* confirm the prior entry used as starting point */
 		ctl_putts("last.older", mon->last);
-		pch = sockporttoa(&mon->rmtadr);
+		mon_get_addr(mon, &rmtadr);
+		pch = sockporttoa(&rmtadr);
 		ctl_putunqstr("addr.older", pch, strlen(pch));
 
 		/*
@@ -3192,10 +3256,12 @@ static void read_mru_list(
 		 * except in the special case of a limit of one.  In
 		 * that case return the starting point entry.
 		 */
+		mon_walk_start(mon);
 		if (limit > 1)
-			mon = PREV_DLIST(mon_data.mon_mru_list, mon, mru);
+			mon = mon_walk_next();
 	} else {	/* start with the oldest */
-		mon = TAIL_DLIST(mon_data.mon_mru_list, mru);
+		mon_walk_start(NULL);
+		mon = mon_walk_next();
 		countdown = mon_data.mru_entries;
 	}
 
@@ -3208,7 +3274,7 @@ static void read_mru_list(
 	prior_mon = NULL;
 	for (count = 0;
 	     mon != NULL && res_frags < frags && count < limit;
-	     mon = PREV_DLIST(mon_data.mon_mru_list, mon, mru)) {
+	     mon = mon_walk_next()) {
 
 		if (mon->count < mincount)
 			continue;
@@ -3226,7 +3292,7 @@ static void read_mru_list(
 		if (minlstint > 0 && lfpuint(now) - lfpuint(mon->last) <
 		    minlstint)
 			continue;
-		if (lcladr != NULL && mon->lcladr != lcladr)
+		if (lcladr != NULL && mon->ifnum != lcladr->ifnum)
 			continue;
 		if (recent != 0 && countdown-- > recent)
 			continue;
@@ -3254,6 +3320,7 @@ static void read_mru_list(
 		if (prior_mon != NULL)
 			ctl_putts("last.newest", prior_mon->last);
 	}
+	mon_unlock_all();
 	ctl_flushpkt(0);
 }
 
@@ -3280,8 +3347,9 @@ send_ifstats_entry(
 	const char txerr_fmt[] =	"txerr.%u";
 	const char pc_fmt[] =		"pc.%u";	/* peer count */
 	const char up_fmt[] =		"up.%u";	/* uptime */
+	const char txlat_fmt[] =	"txlat.%u";	/* TX latency */
 	char	tag[32];
-	uint8_t	sent[IFSTATS_FIELDS]; /* 9 tag=value pairs */
+	uint8_t	sent[IFSTATS_FIELDS]; /* 10 tag=value pairs */
 	int	noisebits;
 	uint32_t noise;
 	unsigned int	which = 0;
@@ -3355,6 +3423,14 @@ send_ifstats_entry(
 			ctl_putuint(tag, current_time - la->starttime);
 			break;
 
+		case 9:
+			pch = txstamp_hist(la);
+			if (NULL == pch)
+				break;	/* no "extra txstamps" */
+			snprintf(tag, sizeof(tag), txlat_fmt, ifnum);
+			ctl_putstr(tag, pch, strlen(pch));
+			break;
+
 		default:
 			/* Get here if IFSTATS_FIELDS is too big. */
 			break;
@@ -3551,7 +3627,9 @@ read_addr_restrictions(
 
 	idx = 0;
 	send_restrict_list(rstrct.restrictlist4, false, &idx);
+	send_restrict_list(restrict_file_list(false), false, &idx);
 	send_restrict_list(rstrct.restrictlist6, true, &idx);
+	send_restrict_list(restrict_file_list(true), true, &idx);
 	ctl_flushpkt(0);
 }
 
@@ -0,0 +1,129 @@
+/*
+ * ntp_destcache.c - remember which endpoint reaches a destination
+ *
+ * Each findlocalinterface() costs a socket(), connect() and
+ * getsockname(), and a miss walks every endpoint as well, so the
+ * answer is remembered per destination address.  Collisions simply
+ * replace the older entry.
+ *
+ * Most interface changes leave most answers alone, so they are
+ * forgotten selectively: an endpoint going away takes only the
+ * entries that point at it, and a new one only the entries that
+ * found no usable address or settled for a wildcard.  Route changes
+ * can move anything, and bump dest_cache_gen, which invalidates
+ * every entry at once.
+ */
+#include "config.h"
+
+#include "ntp_stdlib.h"
+#include "ntpd.h"
+
+#define DEST_CACHE_SIZE	1024		/* entries, a power of two */
+
+static struct dest_entry {
+	sockaddr_u	dest;		/* port cleared */
+	endpt *		ep;		/* NULL => no usable address */
+	unsigned int	gen;
+} dest_cache[DEST_CACHE_SIZE];
+
+static unsigned int	dest_cache_gen = 1;	/* 0 => never filled */
+
+
+static struct dest_entry *
+dest_slot(
+	const sockaddr_u *	addr,
+	sockaddr_u *		dest
+	)
+{
+	*dest = *addr;
+	SET_PORT(dest, 0);
+	return &dest_cache[sock_hash(dest) & (DEST_CACHE_SIZE - 1)];
+}
+
+
+/*
+ * dest_cache_find - the cached endpoint for addr, false if none
+ */
+bool
+dest_cache_find(
+	const sockaddr_u *	addr,
+	endpt **		ep
+	)
+{
+	struct dest_entry *	de;
+	sockaddr_u		dest;
+
+	de = dest_slot(addr, &dest);
+	if (dest_cache_gen != de->gen || !SOCK_EQ(&de->dest, &dest))
+		return false;
+	*ep = de->ep;
+	return true;
+}
+
+
+/*
+ * dest_cache_store - remember the endpoint found for addr
+ */
+void
+dest_cache_store(
+	const sockaddr_u *	addr,
+	endpt *			ep
+	)
+{
+	struct dest_entry *	de;
+	sockaddr_u		dest;
+
+	de = dest_slot(addr, &dest);
+	de->dest = dest;
+	de->ep = ep;
+	de->gen = dest_cache_gen;
+}
+
+
+/*
+ * dest_cache_flush - forget every cached local address choice
+ */
+void
+dest_cache_flush(void)
+{
+	if (0 == ++dest_cache_gen) {
+		ZERO(dest_cache);
+		dest_cache_gen = 1;
+	}
+}
+
+
+/*
+ * dest_cache_drop - forget the choices of an endpoint going away
+ */
+void
+dest_cache_drop(
+	const endpt *	ep
+	)
+{
+	unsigned int i;
+
+	/* stale entries too, so none is left pointing at freed memory */
+	for (i = 0; i < DEST_CACHE_SIZE; i++)
+		if (ep == dest_cache[i].ep) {
+			dest_cache[i].ep = NULL;
+			dest_cache[i].gen = 0;
+		}
+}
+
+
+/*
+ * dest_cache_drop_unbound - forget the destinations that got no
+ * endpoint or only a wildcard, as a new endpoint may suit them
+ */
+void
+dest_cache_drop_unbound(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < DEST_CACHE_SIZE; i++)
+		if (dest_cache_gen == dest_cache[i].gen &&
+		    (NULL == dest_cache[i].ep ||
+		     (INT_WILDCARD & dest_cache[i].ep->flags)))
+			dest_cache[i].gen = 0;
+}
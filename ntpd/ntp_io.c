@@ -20,6 +20,9 @@
 #include "ntp_stdlib.h"
 #include "ntp_assert.h"
 #include "ntp_dns.h"
+#include "ntp_hist.h"
+#include "ntp_workers.h"
+#include "ntp_uring.h"
 #include "timespecops.h"
 
 #include "isc_interfaceiter.h"
@@ -33,6 +36,30 @@
 # endif
 #endif
 
+#ifdef USE_IFDELTAS
+# include <net/if.h>
+# include <sys/ioctl.h>
+#endif
+
+#ifdef HAVE_SCHED_SETAFFINITY
+# include <sched.h>
+#endif
+
+#ifdef HAVE_EPOLL_CREATE1
+# define USE_EPOLL
+# include <sys/epoll.h>
+#endif
+
+#if defined(HAVE_LINUX_FILTER_H) && defined(SO_ATTACH_FILTER)
+# define USE_SOCKET_FILTER
+# include <linux/filter.h>
+#endif
+
+#if defined(HAVE_LINUX_SOCK_DIAG_H) && defined(SO_MEMINFO)
+# define USE_SOCKET_MEMINFO
+# include <linux/sock_diag.h>
+#endif
+
 /* From ntp_request.h - after nuking ntpdc */
 #define IFS_EXISTS      1       /* just exists */
 #define IFS_CREATED     2       /* was just created */
@@ -46,6 +73,57 @@ int qos = IPTOS_DSCP_EF;	/* QoS RFC 3246 */
 
 uint16_t extra_port = 0;	/* 0 => not used */
 
+/*
+ * Number of datagrams to pull off a ready socket with one recvmmsg().
+ * 1 keeps the classic one recvmsg() per packet.
+ */
+unsigned int io_recvbatch = 1;
+
+/*
+ * Apply address changes from the routing socket one by one instead
+ * of rescanning every interface.  Only possible with netlink.
+ */
+bool io_ifdeltas = false;
+
+/*
+ * Low-latency receive for dedicated hosts.  With "extra busypoll N"
+ * the sockets get SO_BUSY_POLL N, so the kernel polls the device
+ * rather than waiting for an interrupt, and io_handler() keeps
+ * checking for input for N microseconds before it goes to sleep.
+ * "extra iocpu" pins the main thread to one CPU.  rxlat is the time
+ * from the kernel's receive timestamp to receive() being called,
+ * kept only while busy polling, as it costs a clock read per packet.
+ */
+unsigned int io_busypoll = 0;
+int io_cpu = -1;
+static struct lat_hist rxlat;
+
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+/*
+ * Replies generated while a receive batch is being processed are
+ * parked here and pushed out with one sendmmsg() once the batch is
+ * done.  Only packets leaving through the endpoint being read are
+ * queued; anything else goes straight out via sendto().  There are
+ * recvbatch slots, allocated when the first batch is read.
+ */
+struct xmit_slot {
+	struct pkt	pkt;
+	sockaddr_u	dest;
+	unsigned int	len;
+	l_fp		xmt;		/* for note_txstamp() */
+	associd_t	assoc;
+};
+
+static struct xmit_queue {
+	endpt *		ep;		/* NULL => not batching */
+	unsigned int	count;
+	unsigned int	size;		/* slots allocated */
+	struct xmit_slot *slot;
+} xmit_queue;
+
+static void	flush_xmit_queue	(void);
+#endif
+
 /*
  * NIC rule entry
  */
@@ -91,6 +169,9 @@ static nic_rule *nic_rule_list;
 struct packet_counters {
 	uint64_t dropped;	/* # packets dropped on reception */
 	uint64_t ignored;	/* received on wild card interface */
+	uint64_t drop_nobuf;	/* dropped, no receive buffer */
+	uint64_t drop_spoofed;	/* dropped, spoofed loopback source */
+	uint64_t drop_reads;	/* reads spent discarding packets */
 	uint64_t received;	/* total number of packets received */
 	uint64_t sent;		/* total number of packets sent */
 	uint64_t notsent;	/* total number of packets which couldn't be sent */
@@ -98,6 +179,14 @@ struct packet_counters {
 	uint64_t handler_calls; /* wakeups -- may batch packets */
 	uint64_t handler_pkts;  /* input packets -- redundant */
 
+	uint64_t batch_reads;	/* recvmmsg() calls that returned data */
+	uint64_t batch_pkts;	/* packets returned by those calls */
+	uint64_t batch_peak;	/* most packets returned by one call */
+	uint64_t batch_sends;	/* sendmmsg() calls flushing replies */
+
+	uint64_t dest_hits;	/* findinterface() answered from cache */
+	uint64_t dest_misses;	/* ... and by asking the kernel */
+
 #ifdef REFCLOCK
 	uint64_t handler_refrds;/* refclock reads */
 #endif
@@ -113,6 +202,11 @@ struct ntp_io_data io_data;
 static int ninterfaces;			/* total # of interfaces */
 
 static  SOCKET  open_socket     (sockaddr_u *, bool, endpt *);
+static  SOCKET  make_socket     (sockaddr_u *, bool, endpt *);
+#ifdef USE_SOCKET_FILTER
+static	void	attach_ntp_filter	(SOCKET, sockaddr_u *);
+#endif
+static	uint64_t kernel_drops_retired;	/* from sockets since closed */
 
 static bool
 netaddr_eqprefix(const isc_netaddr_t *, const isc_netaddr_t *,
@@ -147,10 +241,33 @@ static	struct refclockio *refio;
 static fd_set activefds;
 static int maxactivefd;
 
+#ifdef USE_EPOLL
+/*
+ * With epoll each registered descriptor carries a pointer to its
+ * vsock, so a wakeup dispatches straight to the ready handlers
+ * instead of walking every endpoint with FD_ISSET.  If the epoll
+ * instance can't be created we fall back to pselect().
+ */
+#define EPOLL_MAXEVENTS	64
+static int io_epfd = -1;	/* -1 => use pselect() */
+#endif
+
+#ifdef USE_IO_URING
+/* the io_uring ring, once it reads any endpoint */
+static SOCKET uring_watch_fd = INVALID_SOCKET;
+#endif
+
+#ifdef USE_WORKERS
+/* the workers' doorbell, once they have any socket */
+static SOCKET workers_watch_fd = INVALID_SOCKET;
+#endif
+
 static void	add_interface(endpt *);
 static bool	update_interfaces(void);
 static void	update_interfaces_phase0(void);
 static bool	update_interfaces_phase1(uint16_t port);
+static bool	consider_address(isc_interface_t *, uint16_t);
+static void	drop_interface(endpt *);
 static void	update_interfaces_phase2(void);
 static void	update_interfaces_phase3(void);
 static void	remove_interface(endpt *);
@@ -175,11 +292,15 @@ static void print_interface	(const endpt *, const char *, const char *);
 
 typedef struct vsock vsock_t;
 enum desc_type { FD_TYPE_SOCKET, FD_TYPE_FILE };
+enum desc_owner { FD_OWNER_ENDPT, FD_OWNER_REFCLOCK, FD_OWNER_ASYNCIO,
+		  FD_OWNER_URING, FD_OWNER_WORKERS };
 
 struct vsock {
 	vsock_t	*	link;
 	SOCKET		fd;
 	enum desc_type	type;
+	enum desc_owner	otype;		/* what owner points at */
+	void *		owner;		/* endpt, refclockio or reader */
 };
 
 static vsock_t	*fd_list;
@@ -209,6 +330,7 @@ static void remove_asyncio_reader (struct asyncio_reader *);
 #endif /* defined(USE_ROUTING_SOCKET) */
 
 static void init_async_notifications (void);
+static bool route_watch;	/* the routing socket reports route changes */
 
 static	bool	addr_eqprefix	(const sockaddr_u *, const sockaddr_u *,
 				 int);
@@ -223,17 +345,33 @@ struct remaddr {
 	endpt *			ep;
 };
 
-static remaddr_t * remoteaddr_list;
+/*
+ * Local addresses are hashed on address and port so that the lookups
+ * made for each interface found by a scan, and for each peer when
+ * routes change, do not walk a list as long as the address count.
+ * The table doubles once it holds twice as many entries as buckets.
+ */
+#define ADDR_HASH_INIT	64		/* buckets, a power of two */
+
+static remaddr_t **	addr_hash;
+static unsigned int	addr_hash_size;		/* buckets */
+static unsigned int	addr_hash_count;	/* entries */
+
+#define ADDR_HASH(a)	(sock_hash(a) & (addr_hash_size - 1))
 
 static const int accept_wildcard_if_for_winnt = false;
 
-static void	add_fd_to_list		(SOCKET, enum desc_type);
+static void	watch_vsock		(vsock_t *);
+static void	add_fd_to_list		(SOCKET, enum desc_type,
+					 enum desc_owner, void *);
 static endpt *	find_addr_in_list	(sockaddr_u *);
 static void	delete_interface_from_list(endpt *);
 static void	close_and_delete_fd_from_list(SOCKET);
 static void	add_addr_to_list	(sockaddr_u *, endpt *);
+static void	grow_addr_hash		(void);
 static void	create_wildcards	(unsigned short);
 static endpt *	findlocalinterface	(sockaddr_u *);
+static endpt *	cached_localinterface	(sockaddr_u *);
 static endpt *	findclosestinterface	(sockaddr_u *, int);
 
 #ifdef DEBUG
@@ -253,9 +391,18 @@ static void		maintain_activefds(int fd, bool closing);
  * Routines to read the ntp packets
  */
 static int	read_network_packet	(SOCKET, endpt *);
+static int	discard_network_input	(SOCKET, endpt *);
+#ifdef HAVE_RECVMMSG
+static int	read_network_batch	(SOCKET, endpt *);
+#endif
 static void input_handler (fd_set *);
+static size_t	read_endpoint_input	(endpt *);
+#ifdef USE_EPOLL
+static void	epoll_input_handler	(struct epoll_event *, int);
+#endif
 #ifdef REFCLOCK
 static int	read_refclock_packet	(SOCKET, struct refclockio *);
+static size_t	read_refclock_input	(struct refclockio *);
 #endif
 
 /*
@@ -275,6 +422,17 @@ maintain_activefds(
 	bool closing
 	)
 {
+#ifdef USE_EPOLL
+	if (io_epfd >= 0) {
+		/* ENOENT here just means it was already taken out */
+		if (closing)
+			(void)epoll_ctl(io_epfd, EPOLL_CTL_DEL, fd, NULL);
+		/* only the pselect() fallback is bound by FD_SETSIZE */
+		if (fd >= (int)FD_SETSIZE)
+			return;
+	}
+#endif
+
 	if (fd < 0 || fd >= (int)FD_SETSIZE) {
 		msyslog(LOG_ERR,
 			"IO: Too many sockets in use, FD_SETSIZE %d exceeded by fd %d",
@@ -353,6 +511,13 @@ init_io(void)
 	sigaddset(&blockMask, SIGTERM);
 	sigaddset(&blockMask, SIGHUP);
 
+#ifdef USE_EPOLL
+	io_epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (io_epfd < 0)
+		msyslog(LOG_WARNING,
+			"IO: epoll_create1() failed, using pselect(): %s",
+			strerror(errno));
+#endif
 }
 
 
@@ -482,7 +647,7 @@ add_asyncio_reader(
 	enum desc_type		type)
 {
 	LINK_SLIST(asyncio_reader_list, reader, link);
-	add_fd_to_list(reader->fd, type);
+	add_fd_to_list(reader->fd, type, FD_OWNER_ASYNCIO, reader);
 }
 
 /*
@@ -746,6 +911,7 @@ add_interface(
 	/* link at tail so ntpq -c ifstats index increases each row */
 	LINK_TAIL_SLIST(io_data.ep_list, ep, elink, endpt);
 	ninterfaces++;
+	dest_cache_drop_unbound();
 }
 
 
@@ -763,6 +929,7 @@ remove_interface(
 
 	UNLINK_SLIST(unlinked, io_data.ep_list, ep, elink, endpt);
 	delete_interface_from_list(ep);
+	dest_cache_drop(ep);
 
 	if (ep->fd != INVALID_SOCKET) {
 		msyslog(LOG_INFO,
@@ -777,9 +944,17 @@ remove_interface(
 			ep->sent,
 			ep->notsent,
 			current_time - ep->starttime);
+#ifdef USE_WORKERS
+		workers_drop_endpt(ep);
+#endif
+#ifdef USE_IO_URING
+		uring_drop_endpt(ep);
+#endif
+		kernel_drops_retired += socket_drops(ep->fd);
 		close_and_delete_fd_from_list(ep->fd);
 		ep->fd = INVALID_SOCKET;
 	}
+	disable_txstamps(ep);
 
 	ninterfaces--;
 	mon_clearinterface(ep);
@@ -1195,6 +1370,10 @@ refresh_interface(
 {
 #ifdef  OS_MISSES_SPECIFIC_ROUTE_UPDATES
 	if (interface->fd != INVALID_SOCKET) {
+#ifdef USE_WORKERS
+		workers_drop_endpt(interface);
+#endif
+		kernel_drops_retired += socket_drops(interface->fd);
 		close_and_delete_fd_from_list(interface->fd);
 
 		/* create new socket picking up a new first hop binding
@@ -1401,211 +1580,229 @@ void update_interfaces_phase0(void)
   }
 }
 
+/*
+ * consider_address - check an address found by a scan or announced
+ * by the routing socket against the nic rules, and refresh or create
+ * its endpoint.  Returns true if a new endpoint was created.
+ */
 static bool
-update_interfaces_phase1(uint16_t port)
+consider_address(
+	isc_interface_t *	isc_if,
+	uint16_t		port
+	)
 {
-	isc_mem_t *		mctx = (void *)-1;
-	isc_interfaceiter_t *	iter;
-	bool			result;
-	isc_interface_t		isc_if;
-	int			new_interface_found;
 	unsigned int		family;
 	endpt			enumep;
 	endpt *			ep;
 
-	DPRINT(3, ("\n\nupdate_interfaces(%d)\n", port));
+	/* See if we have a valid family to use */
+	family = isc_if->address.family;
+	if (AF_INET != family && AF_INET6 != family)
+		return false;
+	if (AF_INET == family && !ipv4_works)
+		return false;
+	if (AF_INET6 == family && !ipv6_works)
+		return false;
+
+	/* create prototype */
+	init_interface(&enumep);
+
+	convert_isc_if(isc_if, &enumep, port);
+
+	DPRINT_INTERFACE(4, (&enumep, "examining ", "\n"));
 
 	/*
-	 * phase one - scan interfaces
-	 * - create those that are not found
-	 * - update those that are found
+	 * Check if and how we are going to use the interface.
 	 */
+	switch (interface_action(enumep.name, &enumep.sin,
+				 enumep.flags)) {
 
-	new_interface_found = false;
-	iter = NULL;
-	result = isc_interfaceiter_create_bool(mctx, &iter);
-
-	if (!result)
+	default:
+	case ACTION_IGNORE:
+		DPRINT(4, ("ignoring interface %s (%s) - by nic rules\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
 		return false;
 
-	for (result = isc_interfaceiter_first_bool(iter);
-	     result;
-	     result = isc_interfaceiter_next_bool(iter)) {
+	case ACTION_LISTEN:
+		DPRINT(4, ("listen interface %s (%s) - by nic rules\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		enumep.ignore_packets = false;
+		break;
 
-		result = isc_interfaceiter_current_bool(iter, &isc_if);
+	case ACTION_DROP:
+		DPRINT(4, ("drop on interface %s (%s) - by nic rules\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		enumep.ignore_packets = true;
+		break;
+	}
 
-		if (!result)
-			break;
+	 /* interfaces must be UP to be usable */
+	if (!(enumep.flags & INT_UP)) {
+		DPRINT(4, ("skipping interface %s (%s) - DOWN\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		return false;
+	}
 
-		/* See if we have a valid family to use */
-		family = isc_if.address.family;
-		if (AF_INET != family && AF_INET6 != family)
-			continue;
-		if (AF_INET == family && !ipv4_works)
-			continue;
-		if (AF_INET6 == family && !ipv6_works)
-			continue;
+	/*
+	 * skip any interfaces UP and bound to a wildcard
+	 * address - some dhcp clients produce that in the
+	 * wild
+	 */
+	if (is_wildcard_addr(&enumep.sin)) {
+		DPRINT(4, ("skipping interface %s (%s) - WILD\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		return false;
+		}
+
+	if (is_anycast(&enumep.sin, isc_if->name)) {
+		DPRINT(4, ("skipping interface %s (%s) - ANYCAST\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		return false;
+		}
 
-		/* create prototype */
-		init_interface(&enumep);
+	/*
+	 * skip any address that is an invalid state to be used
+	 */
+	if (!is_valid(&enumep.sin, isc_if->name)) {
+		DPRINT(4, ("skipping interface %s (%s) - ~VALID\n",
+			   enumep.name, sockporttoa(&enumep.sin)));
+		return false;
+		}
 
-		convert_isc_if(&isc_if, &enumep, port);
 
-		DPRINT_INTERFACE(4, (&enumep, "examining ", "\n"));
+	/*
+	 * map to local *address* in order to map all duplicate
+	 * interfaces to an endpt structure with the appropriate
+	 * socket.  Our name space is (ip-address+port), NOT
+	 * (interface name, ip-address).
+	 */
+	ep = getinterface(&enumep.sin, INT_WILDCARD);
 
+	if (ep != NULL && SRCPORT(&ep->sin)==port && refresh_interface(ep)) {
 		/*
-		 * Check if and how we are going to use the interface.
+		 * found existing and up to date interface -
+		 * mark present.
 		 */
-		switch (interface_action(enumep.name, &enumep.sin,
-					 enumep.flags)) {
+		if (!ep->inuse) {
+			/*
+			 * On a new round we reset the name so
+			 * the interface name shows up again if
+			 * this address is no longer shared.
+			 * We reset ignore_packets from the
+			 * new prototype to respect any runtime
+			 * changes to the nic rules.
+			 */
+			strlcpy(ep->name, enumep.name,
+				sizeof(ep->name));
+			ep->ignore_packets =
+				    enumep.ignore_packets;
+		} else {
+			/* name collision - rename interface */
+			strlcpy(ep->name, "*multiple*",
+				sizeof(ep->name));
+		}
 
-		default:
-		case ACTION_IGNORE:
-			DPRINT(4, ("ignoring interface %s (%s) - by nic rules\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			continue;
+		DPRINT_INTERFACE(4, (ep, "updating ",
+				     " present\n"));
 
-		case ACTION_LISTEN:
-			DPRINT(4, ("listen interface %s (%s) - by nic rules\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			enumep.ignore_packets = false;
-			break;
+		if (ep->ignore_packets !=
+		    enumep.ignore_packets) {
+			/*
+			 * We have conflicting configurations
+			 * for the interface address. This is
+			 * caused by using -I <interfacename>
+			 * for an interface that shares its
+			 * address with other interfaces. We
+			 * can not disambiguate incoming
+			 * packets delivered to this socket
+			 * without extra syscalls/features.
+			 * These are not (commonly) available.
+			 * Note this is a more unusual
+			 * configuration where several
+			 * interfaces share an address but
+			 * filtering via interface name is
+			 * attempted.  We resolve the
+			 * configuration conflict by disabling
+			 * the processing of received packets.
+			 * This leads to no service on the
+			 * interface address where the conflict
+			 * occurs.
+			 */
+			msyslog(LOG_ERR,
+				"CONFIG: WARNING: conflicting enable configuration for interfaces %s and %s for address %s - unsupported configuration - address DISABLED",
+				enumep.name, ep->name,
+				socktoa(&enumep.sin));
 
-		case ACTION_DROP:
-			DPRINT(4, ("drop on interface %s (%s) - by nic rules\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			enumep.ignore_packets = true;
-			break;
+			ep->ignore_packets = true;
 		}
 
-		 /* interfaces must be UP to be usable */
-		if (!(enumep.flags & INT_UP)) {
-			DPRINT(4, ("skipping interface %s (%s) - DOWN\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			continue;
-		}
+		ep->inuse = true;
+		return false;
 
+	} else {
 		/*
-		 * skip any interfaces UP and bound to a wildcard
-		 * address - some dhcp clients produce that in the
-		 * wild
+		 * This is new or refreshing failed - add to
+		 * our interface list.  If refreshing failed we
+		 * will delete the interface structure in phase
+		 * 2 as the interface was not marked current.
+		 * We can bind to the address as the refresh
+		 * code already closed the offending socket
 		 */
-		if (is_wildcard_addr(&enumep.sin)) {
-			DPRINT(4, ("skipping interface %s (%s) - WILD\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			continue;
-			}
+		ep = create_interface(port, &enumep);
 
-		if (is_anycast(&enumep.sin, isc_if.name)) {
-			DPRINT(4, ("skipping interface %s (%s) - ANYCAST\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			continue;
-			}
+		if (ep == NULL) {
+			DPRINT_INTERFACE(3,
+				(&enumep, "updating ",
+				 " new - creation FAILED"));
+			msyslog(LOG_INFO,
+				"IO: failed to init interface for %s",
+				sockporttoa(&enumep.sin));
+			return false;
+		}
 
-		/*
-		 * skip any address that is an invalid state to be used
-		 */
-		if (!is_valid(&enumep.sin, isc_if.name)) {
-			DPRINT(4, ("skipping interface %s (%s) - ~VALID\n",
-				   enumep.name, sockporttoa(&enumep.sin)));
-			continue;
-			}
+		ep->inuse = true;
+		DPRINT_INTERFACE(3,
+			(ep, "updating ", " new - created\n"));
+	}
+	return true;
+}
 
 
-		/*
-		 * map to local *address* in order to map all duplicate
-		 * interfaces to an endpt structure with the appropriate
-		 * socket.  Our name space is (ip-address+port), NOT
-		 * (interface name, ip-address).
-		 */
-		ep = getinterface(&enumep.sin, INT_WILDCARD);
+static bool
+update_interfaces_phase1(uint16_t port)
+{
+	isc_mem_t *		mctx = (void *)-1;
+	isc_interfaceiter_t *	iter;
+	bool			result;
+	isc_interface_t		isc_if;
+	int			new_interface_found;
 
-		if (ep != NULL && SRCPORT(&ep->sin)==port && refresh_interface(ep)) {
-			/*
-			 * found existing and up to date interface -
-			 * mark present.
-			 */
-			if (!ep->inuse) {
-				/*
-				 * On a new round we reset the name so
-				 * the interface name shows up again if
-				 * this address is no longer shared.
-				 * We reset ignore_packets from the
-				 * new prototype to respect any runtime
-				 * changes to the nic rules.
-				 */
-				strlcpy(ep->name, enumep.name,
-					sizeof(ep->name));
-				ep->ignore_packets =
-					    enumep.ignore_packets;
-			} else {
-				/* name collision - rename interface */
-				strlcpy(ep->name, "*multiple*",
-					sizeof(ep->name));
-			}
+	DPRINT(3, ("\n\nupdate_interfaces(%d)\n", port));
 
-			DPRINT_INTERFACE(4, (ep, "updating ",
-					     " present\n"));
-
-			if (ep->ignore_packets !=
-			    enumep.ignore_packets) {
-				/*
-				 * We have conflicting configurations
-				 * for the interface address. This is
-				 * caused by using -I <interfacename>
-				 * for an interface that shares its
-				 * address with other interfaces. We
-				 * can not disambiguate incoming
-				 * packets delivered to this socket
-				 * without extra syscalls/features.
-				 * These are not (commonly) available.
-				 * Note this is a more unusual
-				 * configuration where several
-				 * interfaces share an address but
-				 * filtering via interface name is
-				 * attempted.  We resolve the
-				 * configuration conflict by disabling
-				 * the processing of received packets.
-				 * This leads to no service on the
-				 * interface address where the conflict
-				 * occurs.
-				 */
-				msyslog(LOG_ERR,
-					"CONFIG: WARNING: conflicting enable configuration for interfaces %s and %s for address %s - unsupported configuration - address DISABLED",
-					enumep.name, ep->name,
-					socktoa(&enumep.sin));
-
-				ep->ignore_packets = true;
-			}
+	/*
+	 * phase one - scan interfaces
+	 * - create those that are not found
+	 * - update those that are found
+	 */
+
+	new_interface_found = false;
+	iter = NULL;
+	result = isc_interfaceiter_create_bool(mctx, &iter);
 
-			ep->inuse = true;
+	if (!result)
+		return false;
 
-		} else {
-			/*
-			 * This is new or refreshing failed - add to
-			 * our interface list.  If refreshing failed we
-			 * will delete the interface structure in phase
-			 * 2 as the interface was not marked current.
-			 * We can bind to the address as the refresh
-			 * code already closed the offending socket
-			 */
-			ep = create_interface(port, &enumep);
-
-			if (ep == NULL) {
-				DPRINT_INTERFACE(3,
-					(&enumep, "updating ",
-					 " new - creation FAILED"));
-				msyslog(LOG_INFO,
-					"IO: failed to init interface for %s",
-					sockporttoa(&enumep.sin));
-				continue;
-			}
+	for (result = isc_interfaceiter_first_bool(iter);
+	     result;
+	     result = isc_interfaceiter_next_bool(iter)) {
+
+		result = isc_interfaceiter_current_bool(iter, &isc_if);
+
+		if (!result)
+			break;
 
+		if (consider_address(&isc_if, port))
 			new_interface_found = true;
-			ep->inuse = true;
-			DPRINT_INTERFACE(3,
-				(ep, "updating ", " new - created\n"));
-		}
 	}
 
 	isc_interfaceiter_destroy(&iter);
@@ -1636,21 +1833,33 @@ void update_interfaces_phase2(void)
 
 		DPRINT_INTERFACE(3, (ep, "updating ",
 				     "GONE - deleting\n"));
-		remove_interface(ep);
+		drop_interface(ep);
+	}
+}
 
-		/* disconnect peers from deleted endpt. */
-		while (ep->peers != NULL)
-			set_peerdstadr(ep->peers, NULL);
+/*
+ * drop_interface - close and free an endpoint whose address is gone,
+ * disconnecting its peers
+ */
+static void
+drop_interface(
+	endpt *	ep
+	)
+{
+	remove_interface(ep);
 
-		/*
-		 * update globals in case we lose
-		 * a loopback interface
-		 */
-		if (ep == io_data.loopback_interface)
-			io_data.loopback_interface = NULL;
+	/* disconnect peers from deleted endpt. */
+	while (ep->peers != NULL)
+		set_peerdstadr(ep->peers, NULL);
 
-		delete_interface(ep);
-	}
+	/*
+	 * update globals in case we lose
+	 * a loopback interface
+	 */
+	if (ep == io_data.loopback_interface)
+		io_data.loopback_interface = NULL;
+
+	delete_interface(ep);
 }
 
 /*
@@ -1661,6 +1870,8 @@ void update_interfaces_phase2(void)
  */
 void update_interfaces_phase3(void)
 {
+	if (!route_watch)
+		dest_cache_flush();	/* routes may have changed */
 	refresh_all_peerinterfaces();
 }
 
@@ -1815,7 +2026,7 @@ set_reuseaddr(
  * open_socket - open a socket, returning the file descriptor
  */
 
-SOCKET
+static SOCKET
 open_socket(
 	sockaddr_u *	addr,
 	bool		turn_on_reuse,
@@ -1823,6 +2034,137 @@ open_socket(
 	)
 {
 	SOCKET	fd;
+
+	fd = make_socket(addr, turn_on_reuse, interf);
+	if (INVALID_SOCKET == fd)
+		return fd;
+
+	add_fd_to_list(fd, FD_TYPE_SOCKET, FD_OWNER_ENDPT, interf);
+	if (io_txstamps)
+		enable_txstamps(interf, fd);
+#ifdef USE_IO_URING
+	if (uring_add_endpt(interf, fd)) {
+		/* the ring reads it now, wait on the ring instead */
+		if (INVALID_SOCKET == uring_watch_fd) {
+			uring_watch_fd = uring_fd();
+			add_fd_to_list(uring_watch_fd, FD_TYPE_FILE,
+				       FD_OWNER_URING, NULL);
+		}
+		io_watch_fd(fd, false);
+	}
+#endif
+
+#ifdef F_GETFL
+	/* F_GETFL may not be defined if the underlying OS isn't really Unix */
+	DPRINT(4, ("flags for fd %d: 0x%x\n", fd,
+		   (unsigned)fcntl(fd, F_GETFL, 0)));
+#endif
+
+#ifdef USE_WORKERS
+	workers_add_endpt(interf);
+	if (INVALID_SOCKET == workers_watch_fd &&
+	    INVALID_SOCKET != workers_wake_fd()) {
+		workers_watch_fd = workers_wake_fd();
+		add_fd_to_list(workers_watch_fd, FD_TYPE_FILE,
+			       FD_OWNER_WORKERS, NULL);
+	}
+#endif
+
+	return fd;
+}
+
+
+#ifdef USE_WORKERS
+/*
+ * open_worker_socket - open another socket on an endpoint's address
+ * for a server worker thread.  It joins the SO_REUSEPORT group of
+ * the endpoint's own socket but is not watched by the main thread.
+ */
+SOCKET
+open_worker_socket(
+	endpt *	ep
+	)
+{
+	return make_socket(&ep->sin, true, ep);
+}
+#endif
+
+
+#ifdef USE_SOCKET_FILTER
+/*
+ * attach_ntp_filter - have the kernel drop what receive() would
+ * reject before looking at it: anything too short for a mode 6
+ * header, versions outside NTP_OLDVERSION..NTP_VERSION, modes other
+ * than client, server and control, and client or server packets
+ * shorter than LEN_PKT_NOMAC.  48-byte NTPv1 packets in mode 0 or 1
+ * are let through for the fixup in receive().
+ *
+ * A socket filter sees the datagram from the UDP header on, so the
+ * NTP packet starts at byte 8 and the length includes those 8 bytes.
+ */
+#define UDP_HDR_LEN	8
+static struct sock_filter ntp_filter_insns[] = {
+	/*  0 */ BPF_STMT(BPF_LD|BPF_W|BPF_LEN, 0),
+	/*  1 */ BPF_JUMP(BPF_JMP|BPF_JGE|BPF_K, UDP_HDR_LEN + 12, 0, 20),
+	/*  2 */ BPF_STMT(BPF_LD|BPF_B|BPF_ABS, UDP_HDR_LEN),
+	/*  3 */ BPF_STMT(BPF_MISC|BPF_TAX, 0),
+	/*  4 */ BPF_STMT(BPF_ALU|BPF_AND|BPF_K, 0x07),
+	/*  5 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, MODE_CONTROL, 11, 0),
+	/*  6 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, MODE_CLIENT, 8, 0),
+	/*  7 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, MODE_SERVER, 7, 0),
+	/*  8 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, MODE_UNSPEC, 1, 0),
+	/*  9 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, MODE_ACTIVEx, 0, 12),
+	/* 10: NTPv1 fixup candidate, 48 bytes exactly */
+	/* 10 */ BPF_STMT(BPF_MISC|BPF_TXA, 0),
+	/* 11 */ BPF_STMT(BPF_ALU|BPF_AND|BPF_K, 0x38),
+	/* 12 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, NTPv1 << 3, 0, 9),
+	/* 13 */ BPF_STMT(BPF_LD|BPF_W|BPF_LEN, 0),
+	/* 14 */ BPF_JUMP(BPF_JMP|BPF_JEQ|BPF_K, UDP_HDR_LEN + LEN_PKT_NOMAC,
+			  6, 7),
+	/* 15: client or server, needs a full header */
+	/* 15 */ BPF_STMT(BPF_LD|BPF_W|BPF_LEN, 0),
+	/* 16 */ BPF_JUMP(BPF_JMP|BPF_JGE|BPF_K, UDP_HDR_LEN + LEN_PKT_NOMAC,
+			  0, 5),
+	/* 17: version check, shared with control */
+	/* 17 */ BPF_STMT(BPF_MISC|BPF_TXA, 0),
+	/* 18 */ BPF_STMT(BPF_ALU|BPF_AND|BPF_K, 0x38),
+	/* 19 */ BPF_JUMP(BPF_JMP|BPF_JGE|BPF_K, NTP_OLDVERSION << 3, 0, 2),
+	/* 20 */ BPF_JUMP(BPF_JMP|BPF_JGT|BPF_K, NTP_VERSION << 3, 1, 0),
+	/* 21 */ BPF_STMT(BPF_RET|BPF_K, 0xffffffff),	/* accept */
+	/* 22 */ BPF_STMT(BPF_RET|BPF_K, 0),		/* drop */
+};
+#undef UDP_HDR_LEN
+
+static void
+attach_ntp_filter(
+	SOCKET		fd,
+	sockaddr_u *	addr
+	)
+{
+	struct sock_fprog prog;
+
+	prog.len = COUNTOF(ntp_filter_insns);
+	prog.filter = ntp_filter_insns;
+	if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog,
+		       sizeof(prog)))
+		msyslog(LOG_ERR,
+			"IO: setsockopt SO_ATTACH_FILTER fails on address %s: %s",
+			socktoa(addr), strerror(errno));
+}
+#endif	/* USE_SOCKET_FILTER */
+
+/*
+ * make_socket - create, configure and bind a socket for an endpoint
+ */
+
+static SOCKET
+make_socket(
+	sockaddr_u *	addr,
+	bool		turn_on_reuse,
+	endpt *		interf
+	)
+{
+	SOCKET	fd;
 	int	errval;
 	/*
 	 * int is OK for REUSEADR per
@@ -1881,6 +2223,20 @@ open_socket(
 		close(fd);
 		return INVALID_SOCKET;
 	}
+
+#ifdef USE_WORKERS
+	/*
+	 * The worker threads bind their own sockets to the same
+	 * address; every socket in the group needs SO_REUSEPORT.
+	 */
+	if (io_workers > 0 && !(interf->flags & INT_WILDCARD) &&
+	    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (const void *)&on,
+		       sizeof(on)))
+		msyslog(LOG_ERR,
+			"IO: setsockopt SO_REUSEPORT fails for address %s: %s",
+			socktoa(addr), strerror(errno));
+#endif
+
 #ifdef SO_EXCLUSIVEADDRUSE  /* Windows */
 	/*
 	 * setting SO_EXCLUSIVEADDRUSE on the wildcard we open
@@ -1921,10 +2277,27 @@ open_socket(
 				socktoa(addr), strerror(errno));
 	}
 
-#ifdef NEED_REUSEADDR_FOR_IFADDRBIND
-	/*
-	 * some OSes don't allow binding to more specific
-	 * addresses if a wildcard address already bound
+#ifdef USE_SOCKET_FILTER
+	/* before bind(), so nothing is queued unfiltered */
+	attach_ntp_filter(fd, addr);
+#endif
+
+#ifdef SO_BUSY_POLL
+	if (io_busypoll > 0) {
+		int usec = (int)io_busypoll;
+
+		if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+			       (const void *)&usec, sizeof(usec)))
+			msyslog(LOG_ERR,
+				"IO: setsockopt SO_BUSY_POLL (%d) fails on address %s: %s",
+				usec, socktoa(addr), strerror(errno));
+	}
+#endif
+
+#ifdef NEED_REUSEADDR_FOR_IFADDRBIND
+	/*
+	 * some OSes don't allow binding to more specific
+	 * addresses if a wildcard address already bound
 	 * to the port and SO_REUSEADDR is not set
 	 */
 	if (!is_wildcard_addr(addr))
@@ -1961,14 +2334,6 @@ open_socket(
 
 	make_socket_nonblocking(fd);
 
-	add_fd_to_list(fd, FD_TYPE_SOCKET);
-
-#ifdef F_GETFL
-	/* F_GETFL may not be defined if the underlying OS isn't really Unix */
-	DPRINT(4, ("flags for fd %d: 0x%x\n", fd,
-		   (unsigned)fcntl(fd, F_GETFL, 0)));
-#endif
-
 	return fd;
 }
 
@@ -1983,6 +2348,26 @@ sendpkt(
 	void *			pkt,
 	unsigned int		len
 	)
+{
+	sendpkt_timed(dest, src, pkt, len, NULL, 0);
+}
+
+
+/*
+ * sendpkt_timed - sendpkt() for a packet carrying a transmit time.
+ * xmt is the local time it was taken, or NULL, and assoc the sending
+ * association or 0; both are kept to match the kernel's transmit
+ * timestamp against, see read_txstamps().
+ */
+void
+sendpkt_timed(
+	sockaddr_u *		dest,
+	endpt *			src,
+	void *			pkt,
+	unsigned int		len,
+	const l_fp *		xmt,
+	associd_t		assoc
+	)
 {
 	ssize_t	cc;
 
@@ -2004,6 +2389,28 @@ sendpkt(
 	DPRINT(2, ("sendpkt(%d, dst=%s, src=%s, len=%u)\n",
 		   src->fd, socktoa(dest), socktoa(&src->sin), len));
 
+#ifdef USE_IO_URING
+	/* no transmit timestamps with the ring, so xmt is not needed */
+	if (uring_sendpkt(dest, src, pkt, len))
+		return;
+#endif
+
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+	if (src == xmit_queue.ep) {
+		struct xmit_slot *slot;
+
+		if (xmit_queue.size == xmit_queue.count)
+			flush_xmit_queue();
+		slot = &xmit_queue.slot[xmit_queue.count++];
+		memcpy(&slot->pkt, pkt, len);
+		slot->dest = *dest;
+		slot->len = len;
+		slot->xmt = (NULL != xmt) ? *xmt : 0;
+		slot->assoc = assoc;
+		return;
+	}
+#endif
+
 	cc = sendto(src->fd, pkt, (unsigned int)len, 0,
 		    &dest->sa, SOCKLEN(dest));
 	if (cc == -1) {
@@ -2012,8 +2419,85 @@ sendpkt(
 	} else	{
 		src->sent++;
 		pkt_count.sent++;
+		note_txstamp(src, xmt, assoc);
+	}
+}
+
+
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+/*
+ * flush_xmit_queue - send everything parked by sendpkt() with as few
+ * sendmmsg() calls as the kernel allows.  A message the kernel
+ * refuses is counted as notsent and skipped, as sendto() would.
+ *
+ * A reply may have waited here for the rest of the batch.  Plain
+ * server replies, with no MAC or extensions and no association, get
+ * their transmit time moved on by the wait, so the client doesn't
+ * see it; any leap smear in the timestamp is kept.  An authenticated
+ * reply can't be changed, so its wait shows up as the difference
+ * between its transmit time and its kernel transmit timestamp.
+ */
+static void
+flush_xmit_queue(void)
+{
+	struct mmsghdr	msgv[RECV_BATCH_MAX];
+	struct iovec	iovv[RECV_BATCH_MAX];
+	endpt *		src = xmit_queue.ep;
+	struct xmit_slot *slot;
+	unsigned int	i, j;
+	int		cc;
+	l_fp		now, xmt;
+
+	if (0 == xmit_queue.count)
+		return;
+
+	get_systime(&now);
+	memset(msgv, '\0', xmit_queue.count * sizeof(msgv[0]));
+	for (i = 0; i < xmit_queue.count; i++) {
+		slot = &xmit_queue.slot[i];
+		if (LEN_PKT_NOMAC == slot->len && 0 == slot->assoc
+		    && 0 != slot->xmt) {
+			xmt = lfpinit_u(ntohl(slot->pkt.xmt.l_ui),
+					ntohl(slot->pkt.xmt.l_uf));
+			xmt += now - slot->xmt;
+			slot->pkt.xmt.l_ui = htonl(lfpuint(xmt));
+			slot->pkt.xmt.l_uf = htonl(lfpfrac(xmt));
+			slot->xmt = now;
+		}
+		iovv[i].iov_base		= &slot->pkt;
+		iovv[i].iov_len			= slot->len;
+		msgv[i].msg_hdr.msg_name	= &slot->dest.sa;
+		msgv[i].msg_hdr.msg_namelen	= SOCKLEN(&slot->dest);
+		msgv[i].msg_hdr.msg_iov		= &iovv[i];
+		msgv[i].msg_hdr.msg_iovlen	= 1;
 	}
+
+	for (i = 0; i < xmit_queue.count; ) {
+		cc = sendmmsg(src->fd, &msgv[i], xmit_queue.count - i, 0);
+		pkt_count.batch_sends++;
+		if (cc <= 0) {
+			/* first message in the run failed, skip it */
+			src->notsent++;
+			pkt_count.notsent++;
+			i++;
+		} else {
+			src->sent += cc;
+			pkt_count.sent += (uint64_t)cc;
+			for (j = i; j < i + (unsigned int)cc; j++) {
+				slot = &xmit_queue.slot[j];
+				note_txstamp(src, (0 != slot->xmt)
+					     ? &slot->xmt : NULL,
+					     slot->assoc);
+			}
+			i += (unsigned int)cc;
+		}
+	}
+
+	DPRINT(3, ("flush_xmit_queue: fd=%d sent %u\n",
+		   src->fd, xmit_queue.count));
+	xmit_queue.count = 0;
 }
+#endif
 
 
 
@@ -2054,15 +2538,16 @@ read_refclock_packet(
 
 		buflen = read(fd, buf, sizeof buf);
 		pkt_count.dropped++;
+		pkt_count.drop_nobuf++;
 		return (buflen);
 	}
 
 	i = (rp->datalen == 0
-	     || rp->datalen > sizeof(rb->recv_buffer))
-		? sizeof(rb->recv_buffer)
+	     || rp->datalen > RX_BUFF_SIZE)
+		? RX_BUFF_SIZE
 		: rp->datalen;
 	do {
-		buflen = read(fd, (char *)&rb->recv_buffer, i);
+		buflen = read(fd, (char *)rb->recv_buffer, i);
 	} while (buflen < 0 && EINTR == errno);
 
 	if (buflen <= 0) {
@@ -2093,6 +2578,69 @@ read_refclock_packet(
 }
 #endif	/* REFCLOCK */
 
+/*
+ * discard_network_input - throw away what is queued on a socket that
+ * is being ignored, or while we are out of receive buffers.  Where
+ * recvmmsg() exists a whole batch is read in one call, every datagram
+ * truncated into the same small scratch area, so a flood costs one
+ * syscall per RECV_BATCH_MAX packets rather than one per packet.
+ * Returns the number of datagrams discarded, or what the read returned
+ * when there was nothing to discard.
+ */
+static int
+discard_network_input(
+	SOCKET		fd,
+	endpt *		itf
+	)
+{
+	static uint8_t	scratch[LEN_PKT_NOMAC];
+	static struct iovec scratch_iov = { scratch, sizeof(scratch) };
+	int		ndrop;
+#ifdef HAVE_RECVMMSG
+	static struct mmsghdr	dropv[RECV_BATCH_MAX];
+	static sockaddr_u	fromv[RECV_BATCH_MAX];
+	int		i;
+
+	for (i = 0; i < RECV_BATCH_MAX; i++) {
+		dropv[i].msg_hdr.msg_name = &fromv[i];
+		dropv[i].msg_hdr.msg_namelen = sizeof(fromv[i]);
+		dropv[i].msg_hdr.msg_iov = &scratch_iov;
+		dropv[i].msg_hdr.msg_iovlen = 1;
+	}
+	ndrop = recvmmsg(fd, dropv, RECV_BATCH_MAX, MSG_DONTWAIT, NULL);
+	pkt_count.drop_reads++;
+	if (ndrop <= 0)
+		return ndrop;
+#  ifdef DEBUG
+	for (i = 0; i < ndrop; i++)
+		DPRINT(4, ("%s on (%lu) fd=%d from %s\n",
+			   (itf->ignore_packets) ? "ignore" : "drop",
+			   free_recvbuffs(), fd, socktoa(&fromv[i])));
+#  endif
+#else
+	sockaddr_u	from;
+	socklen_t	fromlen = sizeof(from);
+
+	ndrop = (int)recvfrom(fd, scratch_iov.iov_base, scratch_iov.iov_len,
+			      0, &from.sa, &fromlen);
+	pkt_count.drop_reads++;
+	if (ndrop < 0)
+		return ndrop;
+	DPRINT(4, ("%s on (%lu) fd=%d from %s\n",
+		   (itf->ignore_packets) ? "ignore" : "drop",
+		   free_recvbuffs(), fd, socktoa(&from)));
+	ndrop = 1;
+#endif
+
+	if (itf->ignore_packets) {
+		pkt_count.ignored += (uint64_t)ndrop;
+	} else {
+		pkt_count.dropped += (uint64_t)ndrop;
+		pkt_count.drop_nobuf += (uint64_t)ndrop;
+	}
+	return ndrop;
+}
+
 /*
  * Routine to read the network NTP packets for a specific interface
  * Return the number of bytes read. That way we know if we should
@@ -2108,7 +2656,7 @@ read_network_packet(
 	ssize_t buflen;
 	struct recvbuf *rb;
 	struct msghdr msghdr;
-	struct iovec iovec;
+	struct iovec iov[2];
 	char control[100];   /* FIXME: Need space for time stamp plus overhead */
 
 	/*
@@ -2118,39 +2666,19 @@ read_network_packet(
 	 * packet.
 	 */
 
-	rb = get_free_recv_buffer();
-	if (NULL == rb || itf->ignore_packets) {
-		char buf[RX_BUFF_SIZE];
-		sockaddr_u from;
-
-		if (rb != NULL) {
-			freerecvbuf(rb);
-		}
-
-		fromlen = sizeof(from);
-		buflen = recvfrom(fd, buf, sizeof(buf), 0,
-				       &from.sa, &fromlen);
-		DPRINT(4, ("%s on (%lu) fd=%d from %s\n",
-			(itf->ignore_packets)
-			    ? "ignore"
-			    : "drop",
-			free_recvbuffs(), fd, socktoa(&from)));
-		if (itf->ignore_packets)
-			pkt_count.ignored++;
-		else
-			pkt_count.dropped++;
-		return (buflen);
-	}
+	if (itf->ignore_packets)
+		return discard_network_input(fd, itf);
+	rb = get_free_recv_buffer_iov(iov);
+	if (NULL == rb)
+		return discard_network_input(fd, itf);
 
 	fromlen = sizeof(rb->recv_srcadr);
 
-	iovec.iov_base		= &rb->recv_buffer;
-	iovec.iov_len		= sizeof(rb->recv_buffer);
 	memset(&msghdr, '\0', sizeof(msghdr));
 	msghdr.msg_name		= &rb->recv_srcadr;
 	msghdr.msg_namelen	= fromlen;
-	msghdr.msg_iov		= &iovec;
-	msghdr.msg_iovlen	= 1;
+	msghdr.msg_iov		= iov;
+	msghdr.msg_iovlen	= COUNTOF(iov);
 	msghdr.msg_flags	= 0;
 	msghdr.msg_control	= (void *)&control;
 	msghdr.msg_controllen	= sizeof(control);
@@ -2176,6 +2704,175 @@ read_network_packet(
 	DPRINT(3, ("read_network_packet: fd=%d length %d from %s\n",
 		   fd, (int)buflen, socktoa(&rb->recv_srcadr)));
 
+	if (!recvbuf_settle(rb, iov, (size_t)buflen)) {
+		DPRINT(4, ("read_network_packet: fd=%d dropped (no jumbo)\n",
+			   fd));
+		io_count_dropped(itf, 1);
+		freerecvbuf(rb);
+		return (buflen);
+	}
+	deliver_network_packet(fd, itf, rb, &msghdr);
+	return (buflen);
+}
+
+#ifdef HAVE_RECVMMSG
+/*
+ * Batched variant of read_network_packet.  Pull up to io_recvbatch
+ * datagrams off the socket with one recvmmsg(), then run each of
+ * them through receive().  Returns the number of datagrams read,
+ * so the caller keeps draining while it is positive.
+ */
+static int
+read_network_batch(
+	SOCKET			fd,
+	endpt *	itf
+	)
+{
+	struct recvbuf *rbv[RECV_BATCH_MAX];
+	struct mmsghdr	msgv[RECV_BATCH_MAX];
+	struct iovec	iovv[RECV_BATCH_MAX][2];
+	char		controlv[RECV_BATCH_MAX][100];  /* as read_network_packet */
+	unsigned int	nbufs;
+	unsigned int	i;
+	int		nread;
+	int		saved_errno;
+
+	for (nbufs = 0; nbufs < io_recvbatch; nbufs++) {
+		rbv[nbufs] = get_free_recv_buffer_iov(iovv[nbufs]);
+		if (NULL == rbv[nbufs])
+			break;
+	}
+	if (0 == nbufs) {
+		/* out of buffers, let the classic path count the drop */
+		return read_network_packet(fd, itf);
+	}
+
+	memset(msgv, '\0', nbufs * sizeof(msgv[0]));
+	for (i = 0; i < nbufs; i++) {
+		msgv[i].msg_hdr.msg_name	= &rbv[i]->recv_srcadr;
+		msgv[i].msg_hdr.msg_namelen	= sizeof(rbv[i]->recv_srcadr);
+		msgv[i].msg_hdr.msg_iov		= iovv[i];
+		msgv[i].msg_hdr.msg_iovlen	= COUNTOF(iovv[i]);
+		msgv[i].msg_hdr.msg_control	= (void *)controlv[i];
+		msgv[i].msg_hdr.msg_controllen	= sizeof(controlv[i]);
+	}
+
+	nread = recvmmsg(fd, msgv, nbufs, MSG_DONTWAIT, NULL);
+	if (nread <= 0) {
+		saved_errno = errno;
+		for (i = 0; i < nbufs; i++)
+			freerecvbuf(rbv[i]);
+		if (nread < 0 && EWOULDBLOCK != saved_errno
+		    && EAGAIN != saved_errno && EINTR != saved_errno)
+			msyslog(LOG_ERR, "IO: recvmmsg() fd=%d: %s",
+				fd, strerror(saved_errno));
+		errno = saved_errno;
+		return nread;
+	}
+
+	pkt_count.handler_pkts += (uint64_t)nread;
+	pkt_count.batch_reads++;
+	pkt_count.batch_pkts += (uint64_t)nread;
+	if ((uint64_t)nread > pkt_count.batch_peak)
+		pkt_count.batch_peak = (uint64_t)nread;
+
+	for (i = (unsigned int)nread; i < nbufs; i++)
+		freerecvbuf(rbv[i]);
+
+	DPRINT(3, ("read_network_batch: fd=%d got %d of %u\n",
+		   fd, nread, nbufs));
+
+#ifdef HAVE_SENDMMSG
+	if (xmit_queue.size < io_recvbatch) {
+		xmit_queue.slot = ereallocarray(xmit_queue.slot, io_recvbatch,
+						sizeof(*xmit_queue.slot));
+		xmit_queue.size = io_recvbatch;
+	}
+	xmit_queue.ep = itf;
+#endif
+	for (i = 0; i < (unsigned int)nread; i++) {
+		if (0 == msgv[i].msg_len) {
+			/* as read_network_packet(), nothing to deliver */
+			freerecvbuf(rbv[i]);
+			continue;
+		}
+		rbv[i]->recv_length = msgv[i].msg_len;
+		if (!recvbuf_settle(rbv[i], iovv[i], rbv[i]->recv_length)) {
+			io_count_dropped(itf, 1);
+			freerecvbuf(rbv[i]);
+			continue;
+		}
+		deliver_network_packet(fd, itf, rbv[i], &msgv[i].msg_hdr);
+	}
+#ifdef HAVE_SENDMMSG
+	flush_xmit_queue();
+	xmit_queue.ep = NULL;
+#endif
+
+	return nread;
+}
+#endif	/* HAVE_RECVMMSG */
+
+/*
+ * is_spoofed_loopback - Classic Bug 2672: Some OSes (MacOSX, Linux)
+ * don't block spoofed ::1.  True for a loopback source arriving on a
+ * non-loopback IPv6 endpoint.
+ */
+bool
+is_spoofed_loopback(
+	const endpt *		itf,
+	const sockaddr_u *	src
+	)
+{
+	return AF_INET6 == itf->family &&
+	    IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(src)) &&
+	    !IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&itf->sin));
+}
+
+/*
+ * drop_spoofed_loopback - is_spoofed_loopback(), counting the drop
+ */
+bool
+drop_spoofed_loopback(
+	endpt *		itf,
+	sockaddr_u *	src
+	)
+{
+	if (AF_INET6 != itf->family)
+		return false;
+
+	DPRINT(2, ("Got an IPv6 packet, from <%s> (%d) to <%s> (%d)\n",
+		   socktoa(src),
+		   IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(src)),
+		   socktoa(&itf->sin),
+		   !IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&itf->sin))
+		   ));
+
+	if (is_spoofed_loopback(itf, src)) {
+		pkt_count.dropped++;
+		pkt_count.drop_spoofed++;
+		DPRINT(2, ("DROPPING that packet\n"));
+		return true;
+	}
+	DPRINT(2, ("processing that packet\n"));
+	return false;
+}
+
+/*
+ * deliver_network_packet - finish off one received datagram: screen
+ * it, stamp it, hand it to receive() and recycle the buffer.
+ */
+void
+deliver_network_packet(
+	SOCKET		fd,
+	endpt *		itf,
+	struct recvbuf *rb,
+	struct msghdr *	msghdr
+	)
+{
+	struct timespec	now;
+	l_fp		dispatch;
+
 	/*
 	 * We used to drop network packets with addresses matching the magic
 	 * refclock format here. Now we do the check in the protocol machine,
@@ -2186,23 +2883,9 @@ read_network_packet(
 	** Classic Bug 2672: Some OSes (MacOSX, Linux) don't block spoofed ::1
 	*/
 
-	if (AF_INET6 == itf->family) {
-		DPRINT(2, ("Got an IPv6 packet, from <%s> (%d) to <%s> (%d)\n",
-			   socktoa(&rb->recv_srcadr),
-			   IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&rb->recv_srcadr)),
-			   socktoa(&itf->sin),
-			   !IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&itf->sin))
-			   ));
-
-		if (   IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&rb->recv_srcadr))
-		    && !IN6_IS_ADDR_LOOPBACK(PSOCK_ADDR6(&itf->sin))
-		   ) {
-			pkt_count.dropped++;
-			DPRINT(2, ("DROPPING that packet\n"));
-			freerecvbuf(rb);
-			return buflen;
-		}
-		DPRINT(2, ("processing that packet\n"));
+	if (drop_spoofed_loopback(itf, &rb->recv_srcadr)) {
+		freerecvbuf(rb);
+		return;
 	}
 
 	/*
@@ -2211,14 +2894,20 @@ read_network_packet(
 	 */
 	rb->dstadr = itf;
 	rb->fd = fd;
-	rb->recv_time = fetch_packetstamp(&msghdr);
+	rb->recv_time = fetch_packetstamp(msghdr);
+	if (io_busypoll > 0) {
+		clock_gettime(CLOCK_REALTIME, &now);
+		dispatch = tspec_stamp_to_lfp(now);
+		if (dispatch >= rb->recv_time)
+			lat_hist_add(&rxlat,
+			    ((dispatch - rb->recv_time) * NS_PER_S) >> 32);
+	}
 
 	receive(rb);
 	freerecvbuf(rb);
 
 	itf->received++;
 	pkt_count.received++;
-	return (buflen);
 }
 
 /*
@@ -2231,18 +2920,59 @@ io_handler(void)
 	sigset_t runMask;
 	fd_set rdfdes;
 	int nfound;
+	struct timespec spin_end, spin_now;
+	const struct timespec spin_zero = { 0, 0 };
+#ifdef USE_EPOLL
+	struct epoll_event events[EPOLL_MAXEVENTS];
+#endif
 
 	/*
 	 * Use select() on all input fd's for unlimited
 	 * time.  select() will terminate on SIGALARM or on the
-	 * reception of input.
+	 * reception of input.  epoll_pwait() unblocks the same
+	 * signals atomically, so the two behave alike.
 	 */
 	pthread_sigmask(SIG_BLOCK, &blockMask, &runMask);
 	flag = sig_flags.sawALRM || sig_flags.sawQuit || sig_flags.sawHUP || \
 	  sig_flags.sawDNS;
 	if (!flag) {
-	  rdfdes = activefds;
-	  nfound = pselect(maxactivefd+1, &rdfdes, NULL, NULL, NULL, &runMask);
+	  nfound = 0;
+	  if (io_busypoll > 0) {
+	    /*
+	     * Spin with signals still blocked: no mask swap per
+	     * check, and a signal waits at most io_busypoll usec.
+	     */
+	    clock_gettime(CLOCK_MONOTONIC, &spin_end);
+	    spin_end = add_tspec_ns(spin_end, (long)io_busypoll * 1000);
+	    do {
+#ifdef USE_EPOLL
+	      if (io_epfd >= 0) {
+		nfound = epoll_wait(io_epfd, events, EPOLL_MAXEVENTS, 0);
+	      } else
+#endif
+	      {
+		rdfdes = activefds;
+		nfound = pselect(maxactivefd+1, &rdfdes, NULL, NULL,
+				 &spin_zero, NULL);
+	      }
+	      if (0 != nfound)
+		break;
+	      clock_gettime(CLOCK_MONOTONIC, &spin_now);
+	    } while (cmp_tspec(spin_now, spin_end) < 0);
+	  }
+	  if (0 == nfound) {
+#ifdef USE_EPOLL
+	    if (io_epfd >= 0) {
+	      nfound = epoll_pwait(io_epfd, events, EPOLL_MAXEVENTS, -1,
+				   &runMask);
+	    } else
+#endif
+	    {
+	      rdfdes = activefds;
+	      nfound = pselect(maxactivefd+1, &rdfdes, NULL, NULL, NULL,
+			       &runMask);
+	    }
+	  }
 	} else {
 	  nfound = -1;
 	  errno = EINTR;
@@ -2250,7 +2980,12 @@ io_handler(void)
 	pthread_sigmask(SIG_SETMASK, &runMask, NULL);
 
 	if (nfound > 0) {
-		input_handler(&rdfdes);
+#ifdef USE_EPOLL
+		if (io_epfd >= 0)
+			epoll_input_handler(events, nfound);
+		else
+#endif
+			input_handler(&rdfdes);
 	} else if (nfound == -1 && errno != EINTR) {
 		msyslog(LOG_ERR, "IO: select() error: %s", strerror(errno));
 	}
@@ -2271,14 +3006,10 @@ input_handler(
 	fd_set *	fds
 	)
 {
-	int		buflen;
-	SOCKET		fd;
 	size_t		select_count;
 	endpt *		ep;
 #ifdef REFCLOCK
 	struct refclockio *rp;
-	int		saved_errno;
-	const char *	clk;
 #endif
 #ifdef USE_ROUTING_SOCKET
 	struct asyncio_reader *	asyncio_reader;
@@ -2300,37 +3031,8 @@ input_handler(
 	 */
 
 	for (rp = refio; rp != NULL; rp = rp->next) {
-		fd = rp->fd;
-
-		if (!FD_ISSET(fd, fds))
-			continue;
-		++select_count;
-		buflen = read_refclock_packet(fd, rp);
-		/*
-		 * The first read must succeed after select()
-		 * indicates readability, or we've reached
-		 * a permanent EOF.  http://bugs.ntp.org/1732
-		 * reported ntpd munching CPU after a USB GPS
-		 * was unplugged because select was indicating
-		 * EOF but ntpd didn't remove the descriptor
-		 * from the activefds set.
-		 */
-		if (buflen < 0 && EAGAIN != errno) {
-			saved_errno = errno;
-			clk = refclock_name(rp->srcclock);
-			errno = saved_errno;
-			msyslog(LOG_ERR, "IO: %s read: %s", clk, strerror(errno));
-			maintain_activefds(fd, true);
-		} else if (0 == buflen) {
-			clk = refclock_name(rp->srcclock);
-			msyslog(LOG_ERR, "IO: %s read EOF", clk);
-			maintain_activefds(fd, true);
-		} else {
-			/* drain any remaining refclock input */
-			do {
-				buflen = read_refclock_packet(fd, rp);
-			} while (buflen > 0);
-		}
+		if (FD_ISSET(rp->fd, fds))
+			select_count += read_refclock_input(rp);
 	}
 #endif /* REFCLOCK */
 
@@ -2338,14 +3040,22 @@ input_handler(
 	 * Loop through the interfaces looking for data to read.
 	 */
 	for (ep = io_data.ep_list; ep != NULL; ep = ep->elink) {
-		fd = ep->fd;
-		if (FD_ISSET(fd, fds))
-			do {
-				++select_count;
-				++pkt_count.handler_pkts;
-				buflen = read_network_packet(fd, ep);
-			} while (buflen > 0);
+		if (FD_ISSET(ep->fd, fds))
+			select_count += read_endpoint_input(ep);
+	}
+#ifdef USE_IO_URING
+	if (INVALID_SOCKET != uring_watch_fd && FD_ISSET(uring_watch_fd, fds)) {
+		++select_count;
+		uring_input();
+	}
+#endif
+#ifdef USE_WORKERS
+	if (INVALID_SOCKET != workers_watch_fd &&
+	    FD_ISSET(workers_watch_fd, fds)) {
+		++select_count;
+		workers_input();
 	}
+#endif
 
 #ifdef USE_ROUTING_SOCKET
 	/*
@@ -2382,6 +3092,152 @@ input_handler(
 }
 
 
+#ifdef USE_EPOLL
+/*
+ * epoll_input_handler - dispatch only the descriptors epoll reported
+ */
+static void
+epoll_input_handler(
+	struct epoll_event *	events,
+	int			nevents
+	)
+{
+	vsock_t *	lsock;
+	int		i;
+#ifdef USE_ROUTING_SOCKET
+	struct asyncio_reader *	reader;
+#endif
+
+	pkt_count.handler_calls++;
+
+	for (i = 0; i < nevents; i++) {
+		lsock = events[i].data.ptr;
+		switch (lsock->otype) {
+		case FD_OWNER_ENDPT:
+			read_endpoint_input(lsock->owner);
+			break;
+#ifdef REFCLOCK
+		case FD_OWNER_REFCLOCK:
+			read_refclock_input(lsock->owner);
+			break;
+#endif
+#ifdef USE_IO_URING
+		case FD_OWNER_URING:
+			uring_input();
+			break;
+#endif
+#ifdef USE_WORKERS
+		case FD_OWNER_WORKERS:
+			workers_input();
+			break;
+#endif
+		default:
+			break;
+		}
+	}
+
+#ifdef USE_ROUTING_SOCKET
+	/*
+	 * A routing message can drop interfaces and free vsocks that
+	 * are still in events[], so these go last, and only the first:
+	 * events[] can't be trusted after it.  epoll reports any other
+	 * reader again next time.
+	 */
+	for (i = 0; i < nevents; i++) {
+		lsock = events[i].data.ptr;
+		if (FD_OWNER_ASYNCIO != lsock->otype)
+			continue;
+		/* callback may unlink and free the reader and lsock */
+		reader = lsock->owner;
+		(*reader->receiver)(reader);
+		break;
+	}
+#endif /* USE_ROUTING_SOCKET */
+}
+#endif	/* USE_EPOLL */
+
+
+/*
+ * read_endpoint_input - drain a readable network socket.
+ * Returns the number of reads made.
+ */
+static size_t
+read_endpoint_input(
+	endpt *	ep
+	)
+{
+	size_t	count = 0;
+	int	buflen;
+
+	/* a pending transmit timestamp also makes the socket readable */
+	if (NULL != ep->txs)
+		read_txstamps(ep);
+
+#ifdef HAVE_RECVMMSG
+	if (io_recvbatch > 1 && !ep->ignore_packets) {
+		do {
+			++count;
+			buflen = read_network_batch(ep->fd, ep);
+		} while (buflen > 0);
+		return count;
+	}
+#endif
+	do {
+		++count;
+		++pkt_count.handler_pkts;
+		buflen = read_network_packet(ep->fd, ep);
+	} while (buflen > 0);
+	return count;
+}
+
+
+#ifdef REFCLOCK
+/*
+ * read_refclock_input - drain a readable refclock descriptor.
+ * Returns the number of reads made.
+ */
+static size_t
+read_refclock_input(
+	struct refclockio *	rp
+	)
+{
+	SOCKET		fd = rp->fd;
+	size_t		count = 1;
+	int		buflen;
+	int		saved_errno;
+	const char *	clk;
+
+	buflen = read_refclock_packet(fd, rp);
+	/*
+	 * The first read must succeed after select()
+	 * indicates readability, or we've reached
+	 * a permanent EOF.  http://bugs.ntp.org/1732
+	 * reported ntpd munching CPU after a USB GPS
+	 * was unplugged because select was indicating
+	 * EOF but ntpd didn't remove the descriptor
+	 * from the activefds set.
+	 */
+	if (buflen < 0 && EAGAIN != errno) {
+		saved_errno = errno;
+		clk = refclock_name(rp->srcclock);
+		errno = saved_errno;
+		msyslog(LOG_ERR, "IO: %s read: %s", clk, strerror(errno));
+		maintain_activefds(fd, true);
+	} else if (0 == buflen) {
+		clk = refclock_name(rp->srcclock);
+		msyslog(LOG_ERR, "IO: %s read EOF", clk);
+		maintain_activefds(fd, true);
+	} else {
+		/* drain any remaining refclock input */
+		do {
+			buflen = read_refclock_packet(fd, rp);
+		} while (buflen > 0);
+	}
+	return count;
+}
+#endif /* REFCLOCK */
+
+
 /*
  * find an interface suitable for the src address
  * Called by newpeer() and peer_refresh_interface()
@@ -2481,7 +3337,7 @@ findinterface(
 {
 	endpt *iface;
 
-	iface = findlocalinterface(addr);
+	iface = cached_localinterface(addr);
 
 	if (NULL == iface) {
 		DPRINT(4, ("Found no interface for address %s - returning wildcard\n",
@@ -2495,6 +3351,28 @@ findinterface(
 	return iface;
 }
 
+/*
+ * cached_localinterface - findlocalinterface() through the cache
+ */
+static endpt *
+cached_localinterface(
+	sockaddr_u *	addr
+	)
+{
+	endpt *	ep;
+
+	if (dest_cache_find(addr, &ep)) {
+		pkt_count.dest_hits++;
+		return ep;
+	}
+
+	pkt_count.dest_misses++;
+	ep = findlocalinterface(addr);
+	dest_cache_store(addr, ep);
+	return ep;
+}
+
+
 /*
  * findlocalinterface - find local interface corresponding to addr
  *
@@ -2736,12 +3614,23 @@ io_clr_stats(void)
 {
 	pkt_count.dropped = 0;
 	pkt_count.ignored = 0;
+	pkt_count.drop_nobuf = 0;
+	pkt_count.drop_spoofed = 0;
+	pkt_count.drop_reads = 0;
 	pkt_count.received = 0;
 	pkt_count.sent = 0;
 	pkt_count.notsent = 0;
 
 	pkt_count.handler_calls = 0;
 	pkt_count.handler_pkts = 0;
+
+	pkt_count.batch_reads = 0;
+	pkt_count.batch_pkts = 0;
+	pkt_count.batch_peak = 0;
+	pkt_count.batch_sends = 0;
+	pkt_count.dest_hits = 0;
+	pkt_count.dest_misses = 0;
+	ZERO(rxlat);
 #ifdef REFCLOCK
 	pkt_count.handler_refrds = 0;
 #endif
@@ -2763,12 +3652,119 @@ uint64_t ignored_count(void) {
 }
 
 /*
- * received_count - return the number of received packets
+ * socket_drops - datagrams the kernel dropped on a socket, whether
+ * refused by the socket filter or for a full receive queue
  */
-uint64_t received_count(void) {
-  return pkt_count.received;
-}
-
+uint64_t
+socket_drops(
+	SOCKET	fd
+	)
+{
+#ifdef USE_SOCKET_MEMINFO
+	uint32_t	meminfo[SK_MEMINFO_VARS];
+	socklen_t	len = sizeof(meminfo);
+
+	if (INVALID_SOCKET == fd ||
+	    getsockopt(fd, SOL_SOCKET, SO_MEMINFO, meminfo, &len) ||
+	    len <= SK_MEMINFO_DROPS * sizeof(meminfo[0]))
+		return 0;
+	return meminfo[SK_MEMINFO_DROPS];
+#else
+	UNUSED_ARG(fd);
+	return 0;
+#endif
+}
+
+/*
+ * kernel_drops_count - datagrams the kernel dropped on all our
+ * NTP sockets since startup
+ */
+uint64_t kernel_drops_count(void) {
+  uint64_t drops = kernel_drops_retired;
+  endpt *ep;
+
+  for (ep = io_data.ep_list; ep != NULL; ep = ep->elink)
+	drops += socket_drops(ep->fd);
+#ifdef USE_WORKERS
+  drops += workers_socket_drops();
+#endif
+  return drops;
+}
+
+/*
+ * drop_nobuf_count - packets dropped for want of a receive buffer
+ */
+uint64_t drop_nobuf_count(void) {
+  return pkt_count.drop_nobuf;
+}
+
+/*
+ * drop_spoofed_count - packets dropped for a spoofed loopback source
+ */
+uint64_t drop_spoofed_count(void) {
+  return pkt_count.drop_spoofed;
+}
+
+/*
+ * drop_reads_count - reads made only to discard packets
+ */
+uint64_t drop_reads_count(void) {
+  return pkt_count.drop_reads;
+}
+
+/*
+ * rxlat_hist - kernel receive timestamp to dispatch, main thread
+ */
+const char *
+rxlat_hist(void)
+{
+	return lat_hist_str(&rxlat);
+}
+
+/*
+ * io_pin_thread - keep the calling thread on the "extra iocpu" CPU.
+ * Called from the main thread once the workers are running, so they
+ * are not pinned along with it.
+ */
+void
+io_pin_thread(void)
+{
+#ifdef HAVE_SCHED_SETAFFINITY
+	cpu_set_t	set;
+
+	if (io_cpu < 0)
+		return;
+	CPU_ZERO(&set);
+	CPU_SET(io_cpu, &set);
+	if (sched_setaffinity(0, sizeof(set), &set))
+		msyslog(LOG_ERR, "IO: sched_setaffinity(CPU %d): %s",
+			io_cpu, strerror(errno));
+	else
+		msyslog(LOG_INFO, "IO: I/O thread pinned to CPU %d", io_cpu);
+#endif
+}
+
+/*
+ * dest_hits_count - local address lookups answered from the cache
+ */
+uint64_t dest_hits_count(void) {
+  return pkt_count.dest_hits;
+}
+
+/*
+ * dest_misses_count - local address lookups that asked the kernel
+ */
+uint64_t dest_misses_count(void) {
+  return pkt_count.dest_misses;
+}
+
+/*
+ * received_count - return the number of received packets
+ */
+uint64_t received_count(void) {
+  return pkt_count.received;
+}
+
 /*
  * inc_recieved_count - increment the number of received packets
  * required so that refclock_generic.c can track its packets
@@ -2777,6 +3773,68 @@ void inc_received_count(void) {
   pkt_count.received++;
 }
 
+/*
+ * io_count_received - fold in packets a server worker thread
+ * received on an endpoint
+ */
+void io_count_received(endpt *ep, unsigned long count) {
+  ep->received += (long)count;
+  pkt_count.received += count;
+}
+
+/*
+ * io_count_spoofed - fold in spoofed loopback packets a server
+ * worker thread dropped
+ */
+void io_count_spoofed(unsigned long count) {
+  pkt_count.dropped += count;
+  pkt_count.drop_spoofed += count;
+}
+
+/*
+ * io_count_dropped - count packets read elsewhere and thrown away,
+ * as ignored or for want of a receive buffer
+ */
+void io_count_dropped(endpt *ep, unsigned long count) {
+  if (ep->ignore_packets) {
+    pkt_count.ignored += count;
+  } else {
+    pkt_count.dropped += count;
+    pkt_count.drop_nobuf += count;
+  }
+}
+
+/*
+ * io_count_batch - count a batch of packets read elsewhere
+ */
+void io_count_batch(uint64_t count) {
+  pkt_count.handler_pkts += count;
+  pkt_count.batch_reads++;
+  pkt_count.batch_pkts += count;
+  if (count > pkt_count.batch_peak)
+    pkt_count.batch_peak = count;
+}
+
+/*
+ * io_count_batch_send - count replies sent together from elsewhere
+ */
+void io_count_batch_send(void) {
+  pkt_count.batch_sends++;
+}
+
+/*
+ * io_count_sent - fold in sends made outside sendpkt(); ep may be
+ * NULL if the endpoint has gone away since
+ */
+void io_count_sent(endpt *ep, unsigned long sent, unsigned long notsent) {
+  if (NULL != ep) {
+    ep->sent += (long)sent;
+    ep->notsent += (long)notsent;
+  }
+  pkt_count.sent += sent;
+  pkt_count.notsent += notsent;
+}
+
 /*
  * sent_count - return the number of sent packets
  */
@@ -2804,6 +3862,34 @@ uint64_t handler_pkts_count(void) {
   return pkt_count.handler_pkts;
 }
 
+/*
+ * batch_reads_count - return the number of productive recvmmsg() calls
+ */
+uint64_t batch_reads_count(void) {
+  return pkt_count.batch_reads;
+}
+
+/*
+ * batch_pkts_count - return the number of packets read in batches
+ */
+uint64_t batch_pkts_count(void) {
+  return pkt_count.batch_pkts;
+}
+
+/*
+ * batch_peak_count - return the largest batch read so far
+ */
+uint64_t batch_peak_count(void) {
+  return pkt_count.batch_peak;
+}
+
+/*
+ * batch_sends_count - return the number of sendmmsg() flushes
+ */
+uint64_t batch_sends_count(void) {
+  return pkt_count.batch_sends;
+}
+
 #ifdef REFCLOCK
 /*
  * handler_pkts_refrds - return the number of refclock reads
@@ -2838,7 +3924,7 @@ io_addclock(
 	/*
 	 * register fd
 	 */
-	add_fd_to_list(rio->fd, FD_TYPE_FILE);
+	add_fd_to_list(rio->fd, FD_TYPE_FILE, FD_OWNER_REFCLOCK, rio);
 
 	return true;
 }
@@ -2876,16 +3962,71 @@ io_closeclock(
 static void
 add_fd_to_list(
 	SOCKET fd,
-	enum desc_type type
+	enum desc_type type,
+	enum desc_owner otype,
+	void *owner
 	)
 {
 	vsock_t *lsock = emalloc(sizeof(*lsock));
 
 	lsock->fd = fd;
 	lsock->type = type;
+	lsock->otype = otype;
+	lsock->owner = owner;
 
 	LINK_SLIST(fd_list, lsock, link);
-	maintain_activefds(fd, false);
+	watch_vsock(lsock);
+}
+
+
+/*
+ * watch_vsock - have io_handler() wait for input on a descriptor
+ */
+static void
+watch_vsock(
+	vsock_t *	lsock
+	)
+{
+	maintain_activefds(lsock->fd, false);
+
+#ifdef USE_EPOLL
+	if (io_epfd >= 0) {
+		struct epoll_event ev;
+
+		ZERO(ev);
+		ev.events = EPOLLIN;
+		ev.data.ptr = lsock;
+		if (epoll_ctl(io_epfd, EPOLL_CTL_ADD, lsock->fd, &ev) < 0) {
+			msyslog(LOG_ERR, "IO: epoll_ctl(ADD, %d): %s",
+				lsock->fd, strerror(errno));
+			exit(1);
+		}
+	}
+#endif
+}
+
+
+/*
+ * io_watch_fd - start or stop waiting for input on a descriptor that
+ * stays open.  io_uring reads the sockets it takes over itself.
+ */
+void
+io_watch_fd(
+	SOCKET	fd,
+	bool	watch
+	)
+{
+	vsock_t *lsock;
+
+	for (lsock = fd_list; lsock != NULL; lsock = lsock->link)
+		if (fd == lsock->fd)
+			break;
+	if (NULL == lsock)
+		return;
+	if (watch)
+		watch_vsock(lsock);
+	else
+		maintain_activefds(fd, true);
 }
 
 
@@ -2940,11 +4081,14 @@ add_addr_to_list(
 	if (find_addr_in_list(addr) == NULL) {
 #endif
 		/* not there yet - add to list */
+		if (addr_hash_count >= 2 * addr_hash_size)
+			grow_addr_hash();
 		laddr = emalloc(sizeof(*laddr));
 		laddr->addr = *addr;
 		laddr->ep = ep;
 
-		LINK_SLIST(remoteaddr_list, laddr, link);
+		LINK_SLIST(addr_hash[ADDR_HASH(addr)], laddr, link);
+		addr_hash_count++;
 
 		DPRINT(4, ("Added addr %s to list of addresses\n",
 			   socktoa(addr)));
@@ -2956,21 +4100,57 @@ add_addr_to_list(
 }
 
 
+/*
+ * grow_addr_hash - double the address hash table, or create it
+ */
+static void
+grow_addr_hash(void)
+{
+	remaddr_t **	old_hash = addr_hash;
+	unsigned int	old_size = addr_hash_size;
+	remaddr_t *	entry;
+	unsigned int	i;
+
+	addr_hash_size = (0 == old_size) ? ADDR_HASH_INIT : 2 * old_size;
+	addr_hash = emalloc_zero(addr_hash_size * sizeof(*addr_hash));
+	for (i = 0; i < old_size; i++) {
+		while (NULL != (entry = old_hash[i])) {
+			old_hash[i] = entry->link;
+			LINK_SLIST(addr_hash[ADDR_HASH(&entry->addr)],
+				   entry, link);
+		}
+	}
+	free(old_hash);
+	DPRINT(2, ("address hash now %u buckets for %u addresses\n",
+		   addr_hash_size, addr_hash_count));
+}
+
+
+/*
+ * delete_interface_from_list - forget an endpoint's address.  It was
+ * added under the endpoint's own address, so only that bucket needs
+ * searching.
+ */
 static void
 delete_interface_from_list(
 	endpt *iface
 	)
 {
+	remaddr_t **ppentry;
 	remaddr_t *unlinked;
 
-	for (;;) {
-		UNLINK_EXPR_SLIST(unlinked, remoteaddr_list, iface ==
-		    UNLINK_EXPR_SLIST_CURRENT()->ep, link,
-		    remaddr_t);
+	if (0 == addr_hash_size)
+		return;
 
-		if (unlinked == NULL) {
-			break;
+	/* buckets may end up empty, which UNLINK_EXPR_SLIST can't take */
+	ppentry = &addr_hash[ADDR_HASH(&iface->sin)];
+	while (NULL != (unlinked = *ppentry)) {
+		if (unlinked->ep != iface) {
+			ppentry = &unlinked->link;
+			continue;
 		}
+		*ppentry = unlinked->link;
+		addr_hash_count--;
 		DPRINT(4, ("Deleted addr %s for interface #%u %s "
 			   "from list of addresses\n",
 			   socktoa(&unlinked->addr), iface->ifnum,
@@ -2990,7 +4170,12 @@ find_addr_in_list(
 	DPRINT(4, ("Searching for addr %s in list of addresses - ",
 		   socktoa(addr)));
 
-	for (entry = remoteaddr_list;
+	if (0 == addr_hash_size) {
+		DPRINT(4, ("NOT FOUND\n"));
+		return NULL;
+	}
+
+	for (entry = addr_hash[ADDR_HASH(addr)];
 	     entry != NULL;
 	     entry = entry->link) {
 		if (ADDR_PORT_EQ(&entry->addr, addr)) {
@@ -3019,6 +4204,313 @@ latoa(
 #  define UPDATE_GRACE	2	/* wait UPDATE_GRACE seconds before scanning */
 # endif
 
+#ifdef USE_IFDELTAS
+/*
+ * With "extra ifdeltas" each RTM_NEWADDR or RTM_DELADDR creates or
+ * removes just the endpoints for that address, and a link going down
+ * removes those on that link.  A link coming up asks the kernel for
+ * its address list, which comes back as RTM_NEWADDR messages on the
+ * same socket.  Anything these cannot account for, such as an
+ * address shared by two interfaces or lost messages, falls back to
+ * a full scan, as does the periodic interface update.
+ */
+
+/* what a batch of routing messages calls for */
+#define DELTA_REFRESH	0x1	/* re-select the peers' interfaces */
+#define DELTA_NEW	0x2	/* new endpoint, wake the resolver */
+#define DELTA_RESCAN	0x4	/* schedule a full scan */
+#define DELTA_ROUTE	0x8	/* routes changed, forget cached choices */
+
+static bool	addr_dump_pending;	/* RTM_GETADDR reply under way */
+static bool	addr_dump_again;	/* another link came up meanwhile */
+
+/*
+ * request_addr_dump - ask for every address, so those on a link that
+ * just came up are announced
+ */
+static int
+request_addr_dump(
+	int	fd
+	)
+{
+	struct {
+		struct nlmsghdr		nh;
+		struct ifaddrmsg	ifa;
+	} req;
+	struct sockaddr_nl	kernel;
+
+	if (addr_dump_pending) {
+		addr_dump_again = true;
+		return 0;
+	}
+
+	ZERO(req);
+	req.nh.nlmsg_len = NLMSG_LENGTH(sizeof(req.ifa));
+	req.nh.nlmsg_type = RTM_GETADDR;
+	req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	req.ifa.ifa_family = AF_UNSPEC;
+	ZERO(kernel);
+	kernel.nl_family = AF_NETLINK;
+	if (sendto(fd, &req, req.nh.nlmsg_len, 0,
+		   (struct sockaddr *)&kernel, sizeof(kernel)) < 0) {
+		DPRINT(2, ("RTM_GETADDR request failed: %s\n",
+			   strerror(errno)));
+		return DELTA_RESCAN;
+	}
+	addr_dump_pending = true;
+	addr_dump_again = false;
+	return 0;
+}
+
+
+/*
+ * addr_delta - apply one RTM_NEWADDR or RTM_DELADDR
+ */
+static int
+addr_delta(
+	struct nlmsghdr *	nh,
+	int			fd
+	)
+{
+	struct ifaddrmsg *	ifa = NLMSG_DATA(nh);
+	struct rtattr *		rta;
+	int			len;
+	const void *		addr = NULL;
+	const char *		label = NULL;
+	size_t			addrlen;
+	char			ifname[IF_NAMESIZE];
+	struct ifreq		ifr;
+	isc_interface_t		isc_if;
+	sockaddr_u		sin;
+	endpt *			ep;
+	uint16_t		ports[2];
+	unsigned int		i;
+	int			todo = 0;
+
+	if (nh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifa)))
+		return DELTA_RESCAN;
+	if (AF_INET == ifa->ifa_family)
+		addrlen = sizeof(struct in_addr);
+	else if (AF_INET6 == ifa->ifa_family)
+		addrlen = sizeof(struct in6_addr);
+	else
+		return 0;
+
+	/* IFA_LOCAL is ours, IFA_ADDRESS may be the far end of a link */
+	len = (int)IFA_PAYLOAD(nh);
+	for (rta = IFA_RTA(ifa); RTA_OK(rta, len); rta = RTA_NEXT(rta, len)) {
+		if (IFA_LOCAL == rta->rta_type &&
+		    RTA_PAYLOAD(rta) >= addrlen)
+			addr = RTA_DATA(rta);
+		else if (IFA_ADDRESS == rta->rta_type && NULL == addr &&
+			 RTA_PAYLOAD(rta) >= addrlen)
+			addr = RTA_DATA(rta);
+		else if (IFA_LABEL == rta->rta_type)
+			label = RTA_DATA(rta);
+	}
+	if (NULL == addr)
+		return DELTA_RESCAN;
+
+	ZERO(isc_if);
+	isc_if.af = ifa->ifa_family;
+	isc_if.address.family = ifa->ifa_family;
+	isc_if.ifindex = ifa->ifa_index;
+	if (AF_INET == ifa->ifa_family) {
+		memcpy(&isc_if.address.type.in, addr, addrlen);
+	} else {
+		memcpy(&isc_if.address.type.in6, addr, addrlen);
+		if (IN6_IS_ADDR_LINKLOCAL(&isc_if.address.type.in6))
+			isc_if.address.zone = ifa->ifa_index;
+	}
+
+	/* as the scan would, skip links that are down or not running */
+	if (RTM_NEWADDR == nh->nlmsg_type) {
+		if (ifa->ifa_flags & (IFA_F_TENTATIVE | IFA_F_DADFAILED))
+			return 0;	/* announced again once usable */
+		if (NULL == if_indextoname(ifa->ifa_index, ifname))
+			return DELTA_RESCAN;
+		strlcpy(isc_if.name, (label != NULL) ? label : ifname,
+			sizeof(isc_if.name));
+		ZERO(ifr);
+		strlcpy(ifr.ifr_name, ifname, sizeof(ifr.ifr_name));
+		if (ioctl(fd, SIOCGIFFLAGS, &ifr) < 0)
+			return DELTA_RESCAN;
+		if (!(ifr.ifr_flags & IFF_RUNNING))
+			return 0;
+		if (ifr.ifr_flags & IFF_UP)
+			isc_if.flags |= INTERFACE_F_UP;
+		if (ifr.ifr_flags & IFF_LOOPBACK)
+			isc_if.flags |= INTERFACE_F_LOOPBACK;
+	}
+
+	/* extra_port first, as in update_interfaces() */
+	ports[0] = extra_port;
+	ports[1] = NTP_PORT;
+	for (i = 0; i < COUNTOF(ports); i++) {
+		if (0 == ports[i])
+			continue;
+		ZERO_SOCK(&sin);
+		AF(&sin) = (sa_family_t)ifa->ifa_family;
+		SET_PORT(&sin, ports[i]);
+		if (AF_INET == ifa->ifa_family) {
+			NSRCADR(&sin) = isc_if.address.type.in.s_addr;
+		} else {
+			SET_ADDR6N(&sin, isc_if.address.type.in6);
+			SET_SCOPE(&sin, isc_if.address.zone);
+		}
+		ep = getinterface(&sin, INT_WILDCARD);
+
+		if (RTM_DELADDR == nh->nlmsg_type) {
+			if (NULL == ep)
+				continue;
+			if (ep->ifindex != ifa->ifa_index ||
+			    !strcmp(ep->name, "*multiple*")) {
+				/* still on another interface? */
+				todo |= DELTA_RESCAN;
+				continue;
+			}
+			DPRINT_INTERFACE(3, (ep, "delta ", "GONE - deleting\n"));
+			drop_interface(ep);
+			todo |= DELTA_REFRESH;
+		} else if (ep != NULL) {
+			if (ep->ifindex != ifa->ifa_index)
+				strlcpy(ep->name, "*multiple*",
+					sizeof(ep->name));
+		} else {
+			if (consider_address(&isc_if, ports[i]))
+				todo |= DELTA_REFRESH | DELTA_NEW;
+		}
+	}
+	return todo;
+}
+
+
+/*
+ * link_delta - a link came up, went down or was removed
+ */
+static int
+link_delta(
+	struct nlmsghdr *	nh,
+	int			fd
+	)
+{
+	struct ifinfomsg *	ifi = NLMSG_DATA(nh);
+	endpt *			ep;
+	endpt *			next_ep;
+	bool			down;
+	bool			known = false;
+	int			todo = 0;
+
+	if (nh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifi)))
+		return DELTA_RESCAN;
+
+	down = RTM_DELLINK == nh->nlmsg_type ||
+	       (ifi->ifi_flags & (IFF_UP | IFF_RUNNING)) !=
+			(IFF_UP | IFF_RUNNING);
+
+	for (ep = io_data.ep_list; ep != NULL; ep = next_ep) {
+		next_ep = ep->elink;
+		if ((INT_WILDCARD & ep->flags) ||
+		    ep->ifindex != (unsigned int)ifi->ifi_index)
+			continue;
+		known = true;
+		if (!down)
+			break;
+		if (!strcmp(ep->name, "*multiple*")) {
+			todo |= DELTA_RESCAN;
+			continue;
+		}
+		DPRINT_INTERFACE(3, (ep, "delta ", "DOWN - deleting\n"));
+		drop_interface(ep);
+		todo |= DELTA_REFRESH;
+	}
+
+	/* up with nothing listening yet: learn its addresses */
+	if (!down && !known)
+		todo |= request_addr_dump(fd);
+	return todo;
+}
+
+
+/*
+ * apply_routing_deltas - act on one read from the routing socket
+ */
+static void
+apply_routing_deltas(
+	int		fd,
+	char *		buffer,
+	ssize_t		cnt
+	)
+{
+	struct nlmsghdr *	nh;
+	struct nlmsgerr *	err;
+	int			todo = 0;
+
+	for (nh = (struct nlmsghdr *)buffer;
+	     NLMSG_OK(nh, (unsigned) cnt);
+	     nh = NLMSG_NEXT(nh, cnt)) {
+		switch (nh->nlmsg_type) {
+		case RTM_NEWADDR:
+		case RTM_DELADDR:
+			todo |= addr_delta(nh, fd);
+			break;
+		case RTM_NEWLINK:
+		case RTM_DELLINK:
+			todo |= link_delta(nh, fd);
+			break;
+		case RTM_NEWROUTE:
+		case RTM_DELROUTE:
+			todo |= DELTA_ROUTE | DELTA_REFRESH;
+			break;
+		case NLMSG_DONE:
+			/* end of our RTM_GETADDR reply */
+			addr_dump_pending = false;
+			if (addr_dump_again)
+				todo |= request_addr_dump(fd);
+			break;
+		case NLMSG_ERROR:
+			err = NLMSG_DATA(nh);
+			if (nh->nlmsg_len >= NLMSG_LENGTH(sizeof(*err)) &&
+			    0 == err->error)
+				break;
+			addr_dump_pending = false;
+			todo |= DELTA_RESCAN;
+			break;
+		default:
+			break;
+		}
+	}
+
+	DPRINT(3, ("routing deltas:%s%s%s%s\n",
+		   (DELTA_REFRESH & todo) ? " refresh" : "",
+		   (DELTA_NEW & todo) ? " new" : "",
+		   (DELTA_RESCAN & todo) ? " rescan" : "",
+		   (DELTA_ROUTE & todo) ? " route" : ""));
+	if (DELTA_RESCAN & todo)
+		timer_interfacetimeout(current_time + UPDATE_GRACE);
+	if (DELTA_ROUTE & todo)
+		dest_cache_flush();
+	if (DELTA_REFRESH & todo)
+		refresh_all_peerinterfaces();
+	if (DELTA_NEW & todo)
+		dns_try_again();
+}
+#endif	/* USE_IFDELTAS */
+
+
+/*
+ * stop_route_watch - give up on the routing socket, and fall back on
+ * the periodic interface update to catch route changes
+ */
+static void
+stop_route_watch(struct asyncio_reader *reader)
+{
+	remove_asyncio_reader(reader);
+	delete_asyncio_reader(reader);
+	route_watch = false;
+}
+
+
 static void
 process_routing_msgs(struct asyncio_reader *reader)
 {
@@ -3037,8 +4529,7 @@ process_routing_msgs(struct asyncio_reader *reader)
 		 * discard ourselves if we are not needed anymore
 		 * usually happens when running unprivileged
 		 */
-		remove_asyncio_reader(reader);
-		delete_asyncio_reader(reader);
+		stop_route_watch(reader);
 		return;
 	}
 
@@ -3048,15 +4539,23 @@ process_routing_msgs(struct asyncio_reader *reader)
 		if (errno == ENOBUFS) {
 			msyslog(LOG_ERR,
 				"IO: routing socket reports: %s", strerror(errno));
+			/* messages were lost, find out what changed */
+			timer_interfacetimeout(current_time + UPDATE_GRACE);
 		} else {
 			msyslog(LOG_ERR,
 				"IO: routing socket reports: %s - disabling", strerror(errno));
-			remove_asyncio_reader(reader);
-			delete_asyncio_reader(reader);
+			stop_route_watch(reader);
 		}
 		return;
 	}
 
+#ifdef USE_IFDELTAS
+	if (io_ifdeltas) {
+		apply_routing_deltas(reader->fd, buffer, cnt);
+		return;
+	}
+#endif
+
 	/*
 	 * process routing message
 	 */
@@ -3075,19 +4574,12 @@ process_routing_msgs(struct asyncio_reader *reader)
 				"IO: version mismatch (got %d - expected %d) on routing socket - disabling",
 				rtm.rtm_version, RTM_VERSION);
 
-			remove_asyncio_reader(reader);
-			delete_asyncio_reader(reader);
+			stop_route_watch(reader);
 			return;
 		}
 		msg_type = rtm.rtm_type;
 #endif
 		switch (msg_type) {
-#ifdef RTM_NEWADDR
-		case RTM_NEWADDR:
-#endif
-#ifdef RTM_DELADDR
-		case RTM_DELADDR:
-#endif
 #ifdef RTM_ADD
 		case RTM_ADD:
 #endif
@@ -3103,6 +4595,24 @@ process_routing_msgs(struct asyncio_reader *reader)
 #ifdef RTM_LOSING
 		case RTM_LOSING:
 #endif
+#ifdef RTM_NEWROUTE
+		case RTM_NEWROUTE:
+#endif
+#ifdef RTM_DELROUTE
+		case RTM_DELROUTE:
+#endif
+			/* any cached local address choice may be wrong now */
+			DPRINT(3, ("routing message op = %d: forgetting routes\n",
+				   msg_type));
+			dest_cache_flush();
+			timer_interfacetimeout(current_time + UPDATE_GRACE);
+			break;
+#ifdef RTM_NEWADDR
+		case RTM_NEWADDR:
+#endif
+#ifdef RTM_DELADDR
+		case RTM_DELADDR:
+#endif
 #ifdef RTM_IFINFO
 		case RTM_IFINFO:
 #endif
@@ -3114,12 +4624,6 @@ process_routing_msgs(struct asyncio_reader *reader)
 #endif
 #ifdef RTM_DELLINK
 		case RTM_DELLINK:
-#endif
-#ifdef RTM_NEWROUTE
-		case RTM_NEWROUTE:
-#endif
-#ifdef RTM_DELROUTE
-		case RTM_DELROUTE:
 #endif
 			/*
 			 * we are keen on new and deleted addresses and
@@ -3187,6 +4691,7 @@ init_async_notifications(void)
 	reader->receiver = process_routing_msgs;
 
 	add_asyncio_reader(reader, FD_TYPE_SOCKET);
+	route_watch = true;
 	msyslog(LOG_INFO,
 		"IO: Listening on routing socket on fd #%d for interface updates",
 		fd);
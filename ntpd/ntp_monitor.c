@@ -5,11 +5,11 @@
 #include "config.h"
 
 #include <math.h>
+#include <pthread.h>
 #include <stdlib.h>
 
 #include "ntpd.h"
 #include "ntp_io.h"
-#include "ntp_lists.h"
 #include "ntp_stdlib.h"
 #include "timespecops.h"
 
@@ -19,18 +19,50 @@
  * anything else. While at it, implement rate controls for inbound
  * traffic.
  *
- * Each entry is doubly linked into two lists, a hash table and a most-
- * recently-used (MRU) list. When a packet arrives it is looked up in
- * the hash table. If found, the statistics are updated and the entry
- * relinked at the head of the MRU list. If not found, a new entry is
- * allocated, initialized and linked into both the hash table and at the
- * head of the MRU list.
+ * The entries are packed into one array, the pool, in no particular
+ * order.  They are found through a separate open-addressed hash
+ * index of (hash, entry) pairs, kept at most half full, so a lookup
+ * probes a cache line or two of the index and touches only the entry
+ * that matches.  When a packet arrives from a known address its entry
+ * is updated in place and marked referenced; nothing is relinked.
  *
- * Memory is usually allocated by grabbing a big chunk of new memory and
- * cutting it up into littler pieces. The exception to this when we hit
- * the memory limit. Then we free memory by grabbing entries off the
- * tail for the MRU list, unlinking from the hash table, and
- * reinitializing.
+ * When a slot has to be recycled, a CLOCK hand sweeps the array,
+ * clearing reference marks, and offers the first entry that has not
+ * been heard from since the hand last passed.  That entry stands in
+ * for the tail of a strict MRU list in the mindepth/maxage/minage/
+ * maxdepth rules of ntp_monitor().  Removing an entry moves the last
+ * one into its place, so the array stays dense.
+ *
+ * The array grows by mru_incalloc entries or by half, whichever is
+ * more, and never shrinks.  The index is rebuilt at double the size
+ * when the array outgrows half of it.
+ *
+ * The entries sit in a pool allocated on a cache line boundary, so
+ * each 64-byte entry occupies exactly one line.
+ *
+ * Server worker threads call ntp_monitor() too, so the table is split
+ * into shards by the top bits of the address hash.  Each shard has
+ * its own entries, index, CLOCK hand, counters and lock, and takes an
+ * even share of mru_mindepth, mru_maxdepth and the allocation sizes;
+ * an entry is only ever recycled for a newcomer to its own shard.
+ * Without workers there is a single shard.  mon_sum_stats() adds up
+ * the counters in mon_data.  The prefix table's sets are split among
+ * the shards the same way, by the low bits of their index, and each
+ * shard has a second lock for its sets, taken after any shard's own
+ * lock.  The prefix counters are bumped atomically in mon_data.
+ *
+ * ntpq's mrulist wants the entries oldest first.  mon_walk_start()
+ * takes a sorted snapshot of the next WALK_MARKS (last, address)
+ * pairs and mon_walk_next() walks it, skipping entries that have
+ * changed since, then snapshots the next batch after the last one.
+ *
+ * With "limit prefixv4" or "prefixv6", every packet also scores its
+ * source's address prefix, so clients spread over a /24 or rotating
+ * through a /64 are limited together.  The prefixes live in a table
+ * of PREFIX_WAYS-entry sets sized once, when first needed, to an
+ * eighth of mru_maxdepth.  The seeded hash of the masked address picks
+ * the set; a new prefix takes the place of the one in its set heard
+ * from longest ago.  Either way, a packet costs one set of lookups.
  *
  * INC_MONLIST is the default allocation granularity in entries.
  * INIT_MONLIST is the default initial allocation in entries.
@@ -45,9 +77,11 @@
 # define MRU_MAXDEPTH_DEF	(1024 * 1024 / sizeof(mon_entry))
 #endif
 
-#define MON_HASH_SLOTS          (1U << mon_data.mon_hash_bits)
-#define MON_HASH_MASK           (MON_HASH_SLOTS - 1)
-#define MON_HASH(addr)          (sock_hash(addr) & MON_HASH_MASK)
+/* index entries are 32 bits, leave room to double */
+#define MON_ENTRIES_MAX		(UINT32_MAX / 4)
+#define MON_INDEX_MIN		16
+#define MON_ALIGN		64	/* cache line, sizeof(mon_entry) */
+#define MON_INDEX_MASK(sh)	((sh)->slots - 1)
 
 
 struct monitor_data mon_data = {
@@ -68,21 +102,100 @@ struct monitor_data mon_data = {
 	.rate_limit = 1.0,	/* responses per second */
 	.decay_time = 20,	/* seconds, exponential decay time */
 	.kod_limit = 0.5,	/* KoDs per second */
+	.prefix_v4 = 0,		/* prefix limit off */
+	.prefix_v6 = 0,
+	.prefix_limit = 16.0,	/* responses per second per prefix */
+	.prefix_kod = 0.5,	/* KoDs per second per prefix */
+};
+
+/* one slot of the hash index */
+struct mon_slot {
+	uint32_t	hash;		/* mon_hash() of the entry */
+	uint32_t	entry;		/* mon_pool index + 1, 0 if empty */
+};
+
+/*
+ * One shard: the entries, the first entries of them in use, and the
+ * index.  The counters are those of mon_data, for this shard.
+ */
+struct mon_shard {
+	pthread_mutex_t	lock;
+	pthread_mutex_t	prefix_lock;	/* its share of mon_prefixes */
+	mon_entry *	pool;
+	uint64_t	alloc;		/* entries in pool */
+	uint64_t	entries;	/* in use */
+	struct mon_slot *index;
+	uint64_t	slots;		/* size of index */
+	uint64_t	hand;		/* CLOCK hand into pool */
+	uint64_t	mem_increments;	/* times called malloc() */
+	uint64_t	exists;
+	uint64_t	new;
+	uint64_t	recycleold;
+	uint64_t	recyclefull;
+	uint64_t	none;
+};
+
+#define MON_SHARDS_MAX		64
+
+static	struct mon_shard **mon_shards;		/* mon_nshards of them */
+static	unsigned int	mon_nshards = 1;	/* a power of two */
+static	unsigned int	mon_shard_shift = 32;	/* hash bits below it */
+static	uint32_t	mon_seed;		/* keys mon_hash() */
+
+/* one source prefix being rate limited */
+struct mon_prefix {
+	l_fp		last;		/* last time seen, 0 if unused */
+	float		score;		/* recent packets/second */
+	uint8_t		family;		/* AF_INET, AF_INET6 */
+	uint8_t		addr[16];	/* masked address */
+};
+
+#define PREFIX_WAYS		4	/* entries per set */
+#define PREFIX_SETS_MIN		64
+#define PREFIX_SLOTS_MAX	(256 * 1024)
+
+static	struct mon_prefix *mon_prefixes;	/* prefix_slots of them */
 
+#define PREFIX_COUNT(c)	__atomic_fetch_add(&(c), 1, __ATOMIC_RELAXED)
+
+/* a position in the mrulist walk, in walk order */
+struct mon_mark {
+	l_fp		last;
+	uint32_t	scope;
+	uint8_t		family;
+	uint8_t		addr[16];
 };
 
+#define WALK_MARKS		512	/* entries per snapshot */
+
+static	struct mon_mark	walk_marks[WALK_MARKS];	/* sorted snapshot */
+static	size_t		walk_count;
+static	size_t		walk_pos;
+static	struct mon_mark	walk_from;	/* snapshot holds what sorts after */
+
 /*
- * List of free structures, and counters of in-use and total
- * structures. The free structures are linked with the hash_next field.
+ * Score decay, exp(-t/decay_time) for t seconds since the last packet.
+ * mon_decay() multiplies three table entries picked by bits of t in
+ * units of 1/65536 s: the whole seconds, up to DECAY_SECS, and the
+ * two bytes of the fraction.  Longer gaps are not where the packets
+ * come from, so they are left to expf().
  */
-static  mon_entry *mon_free;		/* free list or null if none */
-static	uint64_t mru_alloc;		/* mru list + free list count */
-static	uint64_t mon_mem_increments;	/* times called malloc() */
+#define DECAY_SECS		256
+
+static	float	decay_sec[DECAY_SECS];
+static	float	decay_frac_hi[256];	/* 1/256 s steps */
+static	float	decay_frac_lo[256];	/* 1/65536 s steps */
+static	double	decay_add;		/* 1/decay_time */
+static	bool	decay_ready;
 
-static	void	mon_getmoremem(void);
-static	void	remove_from_hash(mon_entry *);
-static	void	mon_free_entry(mon_entry *);
-static	void	mon_reclaim_entry(mon_entry *);
+static	void	mon_getmoremem(struct mon_shard *);
+static	void	mon_reindex(struct mon_shard *);
+static	uint64_t mon_probe(const struct mon_shard *, const mon_entry *,
+			   uint32_t);
+static	void	mon_remove(struct mon_shard *, mon_entry *);
+static	void	walk_build(const struct mon_mark *);
+static	void	mon_prefix_lock_all(void);
+static	void	mon_prefix_unlock_all(void);
 
 
 /*
@@ -95,87 +208,335 @@ init_mon(void)
 	 * Don't do much of anything here.  We don't allocate memory
 	 * until mon_start().
 	 */
-	INIT_DLIST(mon_data.mon_mru_list, mru);
 }
 
 
 /*
- * remove_from_hash - removes an entry from the address hash table and
- *		      decrements mru_entries.
+ * mon_set_key - fill in the fields of an entry that identify an
+ *		 address, zeroing the rest.
  */
 static void
-remove_from_hash(
-	mon_entry *mon
+mon_set_key(
+	mon_entry *		key,
+	const sockaddr_u *	addr
+	)
+{
+	ZERO(*key);
+	key->family = (uint8_t)AF(addr);
+	if (IS_IPV6(addr)) {
+		memcpy(key->addr, PSOCK_ADDR6(addr), sizeof(key->addr));
+		key->scope = SCOPE_VAR(addr);
+	} else {
+		memcpy(key->addr, &NSRCADR(addr), sizeof(NSRCADR(addr)));
+	}
+	key->port = NSRCPORT(addr);
+}
+
+
+/*
+ * mon_key_eq - do two entries have the same address?  Like SOCK_EQ(),
+ *		the port does not count.
+ */
+static inline bool
+mon_key_eq(
+	const mon_entry *	a,
+	const mon_entry *	b
+	)
+{
+	return a->family == b->family && a->scope == b->scope &&
+	       !memcmp(a->addr, b->addr, sizeof(a->addr));
+}
+
+
+/*
+ * mon_hash - hash an address.  Seeded, since the addresses are
+ *	      picked by whoever sends us packets.
+ */
+static uint32_t
+mon_hash(
+	const mon_entry *key
 	)
 {
-	unsigned int hash;
-	mon_entry *punlinked;
+	uint32_t	h;
+	uint32_t	w;
+	size_t		i;
 
-	mon_data.mru_entries--;
-	hash = MON_HASH(&mon->rmtadr);
-	UNLINK_SLIST(punlinked, mon_data.mon_hash[hash], mon, hash_next,
-		     mon_entry);
-	ENSURE(punlinked == mon);
-	if (NULL == mon_data.mon_hash[hash])
-		mon_data.mru_hashslots--;
+	h = mon_seed ^ key->family;
+	for (i = 0; i < sizeof(key->addr); i += sizeof(w)) {
+		memcpy(&w, &key->addr[i], sizeof(w));
+		h = (h ^ w) * 0x9e3779b1U;
+		h ^= h >> 15;
+	}
+	h = (h ^ key->scope) * 0x85ebca6bU;
+	return h ^ (h >> 16);
 }
 
 
+/*
+ * mon_shard_of - the shard of an address, by the top bits of its hash
+ */
+static inline struct mon_shard *
+mon_shard_of(
+	uint32_t	hash
+	)
+{
+	return mon_shards[(mon_shard_shift < 32) ? hash >> mon_shard_shift : 0];
+}
+
+
+/*
+ * mon_share - one shard's share of a table-wide number of entries
+ */
+static uint64_t
+mon_share(
+	uint64_t	total
+	)
+{
+	return total / mon_nshards + (0 != total % mon_nshards);
+}
+
+
+/*
+ * mon_probe - find the index slot holding an address, or the empty
+ *	       slot where it would go.
+ */
+static uint64_t
+mon_probe(
+	const struct mon_shard *sh,
+	const mon_entry *	key,
+	uint32_t		hash
+	)
+{
+	uint64_t	i;
+
+	for (i = hash & MON_INDEX_MASK(sh); ;
+	     i = (i + 1) & MON_INDEX_MASK(sh)) {
+		if (0 == sh->index[i].entry)
+			return i;
+		if (hash == sh->index[i].hash &&
+		    mon_key_eq(&sh->pool[sh->index[i].entry - 1], key))
+			return i;
+	}
+}
+
+
+/*
+ * mon_unindex - empty an index slot, shifting back the entries after
+ *		 it which would otherwise no longer be found.
+ */
 static void
-mon_free_entry(
-	mon_entry *m
+mon_unindex(
+	struct mon_shard *	sh,
+	uint64_t		hole
 	)
 {
-	ZERO(*m);
-	LINK_SLIST(mon_free, m, hash_next);
+	uint64_t	i;
+	uint64_t	home;
+
+	for (i = (hole + 1) & MON_INDEX_MASK(sh);
+	     sh->index[i].entry != 0;
+	     i = (i + 1) & MON_INDEX_MASK(sh)) {
+		home = sh->index[i].hash & MON_INDEX_MASK(sh);
+		/* leave it if its home is cyclically in (hole, i] */
+		if (hole <= i
+		    ? (hole < home && home <= i)
+		    : (hole < home || home <= i))
+			continue;
+		sh->index[hole] = sh->index[i];
+		hole = i;
+	}
+	sh->index[hole].entry = 0;
 }
 
 
 /*
- * mon_reclaim_entry - Remove an entry from the MRU list and from the
- *		       hash array, then zero-initialize it.  Indirectly
- *		       decrements mru_entries.
+ * mon_reindex - size a shard's index for its pool and fill it
+ */
+static void
+mon_reindex(
+	struct mon_shard *sh
+	)
+{
+	uint64_t	slots;
+	uint64_t	i;
+	uint64_t	s;
+	uint32_t	hash;
 
- * The entry is prepared to be reused.  Before return, in
- * remove_from_hash(), mru_entries is decremented.  It is the caller's
- * responsibility to increment it again.
+	for (slots = MON_INDEX_MIN; slots < 2 * sh->alloc; slots <<= 1)
+		continue;
+	free(sh->index);
+	sh->index = emalloc_zero(slots * sizeof(*sh->index));
+	sh->slots = slots;
+	for (i = 0; i < sh->entries; i++) {
+		hash = mon_hash(&sh->pool[i]);
+		s = mon_probe(sh, &sh->pool[i], hash);
+		sh->index[s].hash = hash;
+		sh->index[s].entry = (uint32_t)(i + 1);
+	}
+}
+
+
+/*
+ * mon_aligned - memory on a cache line boundary.  Belch if none.
+ */
+static void *
+mon_aligned(
+	size_t	size
+	)
+{
+	void *	mem;
+
+	if (0 != posix_memalign(&mem, MON_ALIGN, size)) {
+		msyslog(LOG_ERR, "MON: fatal out of memory (%zu bytes)",
+			size);
+		exit(1);
+	}
+	return mem;
+}
+
+
+/*
+ * mon_getmoremem - grow a shard's entry array, and its index if need
+ *		    be
  */
 static void
-mon_reclaim_entry(
-	mon_entry *m
+mon_getmoremem(
+	struct mon_shard *sh
 	)
 {
-	INSIST(NULL != m);
+	uint64_t	entries;
+	uint64_t	maxdepth;
+	mon_entry *	pool;
 
-	UNLINK_DLIST(m, mru);
-	remove_from_hash(m);
-	ZERO(*m);
+	maxdepth = mon_share(mon_data.mru_maxdepth);
+	entries = (0 == sh->mem_increments)
+		      ? mon_share(mon_data.mru_initalloc)
+		      : max(mon_share(mon_data.mru_incalloc), sh->alloc / 2);
+	if (sh->alloc < maxdepth)
+		entries = min(entries, maxdepth - sh->alloc);
+	entries = min(max(entries, 1), MON_ENTRIES_MAX - sh->alloc);
+
+	/* realloc() keeps no alignment, so move the entries by hand */
+	pool = mon_aligned((sh->alloc + entries) * sizeof(*pool));
+	if (NULL != sh->pool) {
+		memcpy(pool, sh->pool, sh->entries * sizeof(*pool));
+		free(sh->pool);
+	}
+	sh->pool = pool;
+	sh->alloc += entries;
+	sh->mem_increments++;
+	if (sh->slots < 2 * sh->alloc)
+		mon_reindex(sh);
 }
 
 
 /*
- * mon_getmoremem - get more memory and put it on the free list
+ * mon_remove - take an entry out of its shard's index and fill its
+ *		place in the array with the last entry
  */
 static void
-mon_getmoremem(void)
+mon_remove(
+	struct mon_shard *	sh,
+	mon_entry *		mon
+	)
 {
-	mon_entry *chunk;
-	unsigned int entries;
+	mon_entry *	tail;
+	uint64_t	pos;
+	uint64_t	slot;
+
+	pos = (uint64_t)(mon - sh->pool);
+	slot = mon_probe(sh, mon, mon_hash(mon));
+	INSIST(pos + 1 == sh->index[slot].entry);
+	mon_unindex(sh, slot);
+
+	tail = &sh->pool[--sh->entries];
+	if (tail != mon) {
+		slot = mon_probe(sh, tail, mon_hash(tail));
+		sh->index[slot].entry = (uint32_t)(pos + 1);
+		*mon = *tail;
+	}
+}
+
 
-	entries = (0 == mon_mem_increments)
-		      ? mon_data.mru_initalloc
-		      : mon_data.mru_incalloc;
+/*
+ * mon_age - seconds since an entry was last heard from, rounded
+ */
+static int
+mon_age(
+	const mon_entry *	mon,
+	l_fp			now
+	)
+{
+	now -= mon->last;
+	/* add one-half second to round up */
+	now += 0x80000000;
+	return lfpsint(now);
+}
 
-	if (entries) {
-		chunk = eallocarray(entries, sizeof(*chunk));
-		mru_alloc += entries;
-		for (chunk += entries; entries; entries--)
-			mon_free_entry(--chunk);
 
-		mon_mem_increments++;
+/*
+ * mon_victim - advance a shard's CLOCK hand to an entry not
+ *		referenced since it last came by.  There must be at
+ *		least one entry.
+ */
+static mon_entry *
+mon_victim(
+	struct mon_shard *sh
+	)
+{
+	mon_entry *mon;
+
+	for (;;) {
+		if (sh->hand >= sh->entries)
+			sh->hand = 0;
+		mon = &sh->pool[sh->hand];
+		if (!mon->ref)
+			return mon;
+		mon->ref = 0;
+		sh->hand++;
 	}
-        /* chunk not free()ed, chunk added to free list */
-	/* coverity[leaked_storage] */
+}
+
+
+/*
+ * mon_decay_init - fill the decay tables for the current decay_time.
+ * mon_start() calls it after the configuration has been read.
+ */
+static void
+mon_decay_init(void)
+{
+	double	tau = mon_data.decay_time;
+	int	i;
+
+	for (i = 0; i < DECAY_SECS; i++)
+		decay_sec[i] = (float)exp(-i / tau);
+	for (i = 0; i < 256; i++) {
+		decay_frac_hi[i] = (float)exp(-(i / 256.0) / tau);
+		decay_frac_lo[i] = (float)exp(-(i / 65536.0) / tau);
+	}
+	decay_add = 1.0 / mon_data.decay_time;
+	decay_ready = true;
+}
+
+
+/*
+ * mon_decay - how much a score decays over an interval
+ */
+float
+mon_decay(
+	l_fp interval
+	)
+{
+	uint64_t t;
+
+	if (!decay_ready)
+		mon_decay_init();
+	if (interval >= ((uint64_t)DECAY_SECS << 32) - 0x8000)
+		return expf(-ldexpf(interval, -32) / mon_data.decay_time);
+
+	t = (interval + 0x8000) >> 16;		/* rounded */
+	return decay_sec[t >> 16] * decay_frac_hi[(t >> 8) & 0xff] *
+	       decay_frac_lo[t & 0xff];
 }
 
 
@@ -191,35 +552,66 @@ mon_setdown(int mode)
 	mon_data.mon_enabled &= ~mode;
 }
 
+/*
+ * mon_set_threads - n threads besides the main one will call
+ *		     ntp_monitor().  Picks the number of shards, so it
+ *		     only counts before the first mon_start().
+ */
+void
+mon_set_threads(
+	unsigned int	n
+	)
+{
+	if (NULL != mon_shards)
+		return;
+	mon_nshards = 1;
+	mon_shard_shift = 32;
+	if (0 == n)
+		return;
+	while (mon_nshards < 4 * (n + 1) && mon_nshards < MON_SHARDS_MAX) {
+		mon_nshards <<= 1;
+		mon_shard_shift--;
+	}
+}
+
+
 /*
  * mon_start - start up the monitoring software
  */
 void
 mon_start(void)
 {
-	size_t octets;
-	unsigned int min_hash_slots;
+	struct mon_shard *sh;
+	uint64_t	bytes;
+	unsigned int	i;
 
 	if (MON_OFF == mon_data.mon_enabled)
 		return;
-	if (0 == mon_mem_increments)
-		mon_getmoremem();
-	/* There used to be a 16 bit limit to mon_hash_bits.
-	 * and a target of 8 entries per hash slot.
-	 * That was not good with large MRU lists.
-	 * There was also a startup timing bug that got 13 bits.
-	 */
-	min_hash_slots = mon_data.mru_maxdepth;  /* 1 hash slot per entry */
-	mon_data.mon_hash_bits = 0;
-	while (min_hash_slots >>= 1)
-		mon_data.mon_hash_bits++;
-	mon_data.mon_hash_bits = max(4, mon_data.mon_hash_bits);
-	mon_data.mon_hash_bits = min(24, mon_data.mon_hash_bits);
-	octets = sizeof(*mon_data.mon_hash) * MON_HASH_SLOTS;
-	msyslog(LOG_INFO, "INIT: MRU %llu entries, %d hash bits, %llu bytes",
-		(unsigned long long)mon_data.mru_maxdepth,
-		mon_data.mon_hash_bits, (unsigned long long)octets);
-	mon_data.mon_hash = erealloc_zero(mon_data.mon_hash, octets, 0);
+	mon_decay_init();
+	if (NULL == mon_shards) {
+		ntp_RAND_bytes((unsigned char *)&mon_seed, sizeof(mon_seed));
+		mon_shards = emalloc_zero(mon_nshards * sizeof(*mon_shards));
+		for (i = 0; i < mon_nshards; i++) {
+			/* whole lines, so shards don't share one */
+			sh = mon_aligned((sizeof(*sh) + MON_ALIGN - 1) &
+					 ~(size_t)(MON_ALIGN - 1));
+			ZERO(*sh);
+			pthread_mutex_init(&sh->lock, NULL);
+			pthread_mutex_init(&sh->prefix_lock, NULL);
+			mon_getmoremem(sh);
+			mon_shards[i] = sh;
+		}
+	}
+	mon_sum_stats();
+	bytes = 0;
+	for (i = 0; i < mon_nshards; i++)
+		bytes += mon_shards[i]->alloc * sizeof(mon_entry) +
+			 mon_shards[i]->slots * sizeof(struct mon_slot);
+	msyslog(LOG_INFO,
+		"INIT: MRU %llu entries in %u shards, %llu hash slots, %llu bytes",
+		(unsigned long long)mon_data.mru_maxdepth, mon_nshards,
+		(unsigned long long)mon_data.mru_hashslots,
+		(unsigned long long)bytes);
 }
 
 
@@ -229,25 +621,117 @@ mon_start(void)
 void
 mon_stop(void)
 {
-	mon_entry *mon;
+	struct mon_shard *sh;
+	unsigned int	i;
 
-	if (MON_OFF == mon_data.mon_enabled)
+	if (MON_OFF == mon_data.mon_enabled || NULL == mon_shards)
 		return;
 
-	/*
-	 * Move everything on the MRU list to the free list quickly,
-	 * without bothering to remove each from either the MRU list or
-	 * the hash table.
-	 */
-	ITER_DLIST_BEGIN(mon_data.mon_mru_list, mon, mru, mon_entry)
-		mon_free_entry(mon);
-	ITER_DLIST_END()
+	/* keep the memory, forget the entries */
+	for (i = 0; i < mon_nshards; i++) {
+		sh = mon_shards[i];
+		pthread_mutex_lock(&sh->lock);
+		sh->entries = 0;
+		sh->hand = 0;
+		memset(sh->index, '\0', sh->slots * sizeof(*sh->index));
+		pthread_mutex_unlock(&sh->lock);
+	}
+	mon_prefix_lock_all();
+	if (NULL != mon_prefixes)
+		memset(mon_prefixes, '\0',
+		       sizeof(*mon_prefixes) * mon_data.prefix_slots);
+	mon_data.prefix_used = 0;
+	mon_prefix_unlock_all();
+	walk_count = walk_pos = 0;
+	mon_sum_stats();
+}
+
+
+/*
+ * mon_sum_stats - add up the shards' counts in mon_data.  Called
+ *		   from timer() and before they are reported.
+ */
+void
+mon_sum_stats(void)
+{
+	struct mon_shard *sh;
+	uint64_t	entries = 0;
+	uint64_t	slots = 0;
+	uint64_t	exists = 0;
+	uint64_t	fresh = 0;
+	uint64_t	recycleold = 0;
+	uint64_t	recyclefull = 0;
+	uint64_t	none = 0;
+	unsigned int	i;
+
+	if (NULL == mon_shards)
+		return;
+	for (i = 0; i < mon_nshards; i++) {
+		sh = mon_shards[i];
+		pthread_mutex_lock(&sh->lock);
+		entries += sh->entries;
+		slots += sh->slots;
+		exists += sh->exists;
+		fresh += sh->new;
+		recycleold += sh->recycleold;
+		recyclefull += sh->recyclefull;
+		none += sh->none;
+		pthread_mutex_unlock(&sh->lock);
+	}
+	mon_data.mru_entries = entries;
+	mon_data.mru_hashslots = slots;
+	mon_data.mru_peakentries = max(mon_data.mru_peakentries, entries);
+	mon_data.mru_exists = exists;
+	mon_data.mru_new = fresh;
+	mon_data.mru_recycleold = recycleold;
+	mon_data.mru_recyclefull = recyclefull;
+	mon_data.mru_none = none;
+}
+
+
+/*
+ * mon_lock_all - keep other threads out of the whole table, so the
+ *		  entries mon_get_slot() and the mrulist walk return
+ *		  stay put.  Shards are always locked in order.
+ */
+void
+mon_lock_all(void)
+{
+	unsigned int	i;
 
-	/* empty the MRU list and hash table. */
-	mon_data.mru_entries = 0;
-	mon_data.mru_hashslots = 0;
-	INIT_DLIST(mon_data.mon_mru_list, mru);
-	memset(mon_data.mon_hash, '\0', sizeof(*mon_data.mon_hash) * MON_HASH_SLOTS);
+	for (i = 0; mon_shards != NULL && i < mon_nshards; i++)
+		pthread_mutex_lock(&mon_shards[i]->lock);
+}
+
+void
+mon_unlock_all(void)
+{
+	unsigned int	i;
+
+	for (i = 0; mon_shards != NULL && i < mon_nshards; i++)
+		pthread_mutex_unlock(&mon_shards[i]->lock);
+}
+
+
+/*
+ * mon_prefix_lock_all - the same for the whole prefix table
+ */
+static void
+mon_prefix_lock_all(void)
+{
+	unsigned int	i;
+
+	for (i = 0; i < mon_nshards; i++)
+		pthread_mutex_lock(&mon_shards[i]->prefix_lock);
+}
+
+static void
+mon_prefix_unlock_all(void)
+{
+	unsigned int	i;
+
+	for (i = 0; i < mon_nshards; i++)
+		pthread_mutex_unlock(&mon_shards[i]->prefix_lock);
 }
 
 
@@ -260,55 +744,444 @@ mon_clearinterface(
 	endpt *lcladr
 	)
 {
-	mon_entry *mon;
+	struct mon_shard *sh;
+	unsigned int	s;
+	uint64_t	i;
 
-	/* iterate mon over mon_mru_list */
-	ITER_DLIST_BEGIN(mon_data.mon_mru_list, mon, mru, mon_entry)
-		if (mon->lcladr == lcladr) {
-			/* remove from mru list */
-			UNLINK_DLIST(mon, mru);
-			/* remove from hash list, adjust mru_entries */
-			remove_from_hash(mon);
-			/* put on free list */
-			mon_free_entry(mon);
-		}
-	ITER_DLIST_END()
+	for (s = 0; mon_shards != NULL && s < mon_nshards; s++) {
+		sh = mon_shards[s];
+		pthread_mutex_lock(&sh->lock);
+		/* mon_remove() refills slot i, so look at it again */
+		for (i = 0; i < sh->entries; )
+			if (sh->pool[i].ifnum == lcladr->ifnum)
+				mon_remove(sh, &sh->pool[i]);
+			else
+				i++;
+		pthread_mutex_unlock(&sh->lock);
+	}
 }
 
+/*
+ * mon_get_slot - the entry of an address, or NULL.  Other threads
+ *		  must be kept out with mon_lock_all().
+ */
 mon_entry *mon_get_slot(sockaddr_u *addr)
 {
-	mon_entry *mon;
+	struct mon_shard *sh;
+	mon_entry	key;
+	uint32_t	hash;
+	uint64_t	slot;
 
-	mon = mon_data.mon_hash[MON_HASH(addr)];
-	for (; mon != NULL; mon = mon->hash_next)
-		if (SOCK_EQ(&mon->rmtadr, addr))
-			break;
-	return mon;
+	if (NULL == mon_shards)
+		return NULL;
+	mon_set_key(&key, addr);
+	hash = mon_hash(&key);
+	sh = mon_shard_of(hash);
+	if (0 == sh->entries)
+		return NULL;
+	slot = mon_probe(sh, &key, hash);
+	if (0 == sh->index[slot].entry)
+		return NULL;
+	return &sh->pool[sh->index[slot].entry - 1];
+}
+
+/*
+ * mon_get_addr - the remote address and last port of an entry
+ */
+void mon_get_addr(const mon_entry *mon, sockaddr_u *addr)
+{
+	ZERO(*addr);
+	SET_AF(addr, mon->family);
+	if (IS_IPV6(addr)) {
+		memcpy(PSOCK_ADDR6(addr), mon->addr, sizeof(mon->addr));
+		SCOPE_VAR(addr) = mon->scope;
+	} else {
+		memcpy(&NSRCADR(addr), mon->addr, sizeof(NSRCADR(addr)));
+	}
+	SET_NSRCPORT(addr, mon->port);
 }
 
+/*
+ * mon_get_oldest_age - age of the entry a CLOCK hand would offer
+ *			next, which stands in for the MRU list tail.
+ *			Only MON_PEEK entries past each shard's hand are
+ *			looked at and their marks are left alone.
+ */
+#define MON_PEEK		16
+
 int mon_get_oldest_age(l_fp now)
 {
-    mon_entry *	oldest;
-    if (mon_data.mru_entries == 0)
+	struct mon_shard *sh;
+	const mon_entry *mon;
+	uint64_t	pos;
+	unsigned int	s;
+	unsigned int	i;
+	int		age;
+	int		tail;
+	int		oldest = 0;
+
+	for (s = 0; mon_shards != NULL && s < mon_nshards; s++) {
+		sh = mon_shards[s];
+		pthread_mutex_lock(&sh->lock);
+		tail = 0;
+		pos = sh->hand;
+		for (i = 0; i < MON_PEEK && i < sh->entries; i++, pos++) {
+			if (pos >= sh->entries)
+				pos = 0;
+			mon = &sh->pool[pos];
+			age = mon_age(mon, now);
+			if (!mon->ref) {
+				tail = age;
+				break;
+			}
+			if (age > tail)
+				tail = age;
+		}
+		pthread_mutex_unlock(&sh->lock);
+		if (tail > oldest)
+			oldest = tail;
+	}
+	return oldest;
+}
+
+
+/*
+ * The mrulist walk.  Entries come out ordered by last, then address,
+ * as they would have come off the tail of a strict MRU list.  Other
+ * threads must be kept out with mon_lock_all() while it runs.
+ */
+static int
+mark_cmp(
+	const struct mon_mark *	a,
+	const struct mon_mark *	b
+	)
+{
+	int r;
+
+	if (a->last != b->last)
+		return (a->last < b->last) ? -1 : 1;
+	if (a->family != b->family)
+		return (a->family < b->family) ? -1 : 1;
+	r = memcmp(a->addr, b->addr, sizeof(a->addr));
+	if (r != 0)
+		return r;
+	if (a->scope != b->scope)
+		return (a->scope < b->scope) ? -1 : 1;
 	return 0;
-    oldest = TAIL_DLIST(mon_data.mon_mru_list, mru);
-    if (1) {
-      /* FIXME -fanalyze
-       * Hack to keep compiler -fanalyze happy
-       * If mru_entries !=0, the list is not empty
-       * and TAIL_DLIST will return a valid pointer
-       */
-	if (NULL == oldest) {
-		msyslog(LOG_ERR, "MON: Bug in mon_get_oldest_age");
-		exit(3);
-        }
-    }
-    now -= oldest->last;
-    /* add one-half second to round up */
-    now += 0x80000000;
-    return lfpsint(now);
+}
+
+static int
+mark_qcmp(
+	const void *	a,
+	const void *	b
+	)
+{
+	return mark_cmp(a, b);
+}
+
+static void
+mark_of(
+	const mon_entry *	mon,
+	struct mon_mark *	mark
+	)
+{
+	ZERO(*mark);
+	mark->last = mon->last;
+	mark->scope = mon->scope;
+	mark->family = mon->family;
+	memcpy(mark->addr, mon->addr, sizeof(mark->addr));
 }
 
+/*
+ * walk_heap_down - restore the max-heap of the walk_count marks
+ *		    after walk_marks[0] was replaced
+ */
+static void
+walk_heap_down(void)
+{
+	struct mon_mark	tmp;
+	size_t		i;
+	size_t		c;
+
+	for (i = 0; (c = 2 * i + 1) < walk_count; i = c) {
+		if (c + 1 < walk_count &&
+		    mark_cmp(&walk_marks[c + 1], &walk_marks[c]) > 0)
+			c++;
+		if (mark_cmp(&walk_marks[c], &walk_marks[i]) <= 0)
+			break;
+		tmp = walk_marks[i];
+		walk_marks[i] = walk_marks[c];
+		walk_marks[c] = tmp;
+	}
+}
+
+/*
+ * walk_heap_up - sift the last of the walk_count marks into the heap
+ */
+static void
+walk_heap_up(void)
+{
+	struct mon_mark	tmp;
+	size_t		i;
+	size_t		p;
+
+	for (i = walk_count - 1; i > 0; i = p) {
+		p = (i - 1) / 2;
+		if (mark_cmp(&walk_marks[i], &walk_marks[p]) <= 0)
+			break;
+		tmp = walk_marks[i];
+		walk_marks[i] = walk_marks[p];
+		walk_marks[p] = tmp;
+	}
+}
+
+/*
+ * walk_build - snapshot the first WALK_MARKS entries which sort after
+ *		from.  A max-heap holds the least seen so far, so one
+ *		pass finds them without copying the table.
+ */
+static void
+walk_build(
+	const struct mon_mark *from
+	)
+{
+	struct mon_shard *sh;
+	struct mon_mark	mark;
+	unsigned int	s;
+	uint64_t	i;
+
+	walk_count = walk_pos = 0;
+	walk_from = *from;
+
+	for (s = 0; mon_shards != NULL && s < mon_nshards; s++) {
+		sh = mon_shards[s];
+		for (i = 0; i < sh->entries; i++) {
+			mark_of(&sh->pool[i], &mark);
+			if (mark_cmp(&mark, from) <= 0)
+				continue;
+			if (walk_count < WALK_MARKS) {
+				walk_marks[walk_count++] = mark;
+				walk_heap_up();
+			} else if (mark_cmp(&mark, &walk_marks[0]) < 0) {
+				walk_marks[0] = mark;
+				walk_heap_down();
+			}
+		}
+	}
+	qsort(walk_marks, walk_count, sizeof(*walk_marks), mark_qcmp);
+}
+
+/*
+ * mon_walk_start - start an mrulist walk just after an entry, or at
+ *		    the oldest when it is NULL.  The current snapshot
+ *		    is reused when it covers the starting point.
+ */
+void
+mon_walk_start(
+	const mon_entry *after
+	)
+{
+	struct mon_mark	from;
+	size_t		lo;
+	size_t		hi;
+	size_t		mid;
+
+	if (NULL == after)
+		ZERO(from);	/* sorts before every entry */
+	else
+		mark_of(after, &from);
+
+	if (0 == walk_count || mark_cmp(&from, &walk_from) < 0 ||
+	    mark_cmp(&from, &walk_marks[walk_count - 1]) >= 0) {
+		walk_build(&from);
+		return;
+	}
+	lo = 0;
+	hi = walk_count;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (mark_cmp(&walk_marks[mid], &from) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	walk_pos = lo;
+}
+
+/*
+ * mon_walk_next - the next entry of the walk, or NULL at the end
+ */
+mon_entry *
+mon_walk_next(void)
+{
+	const struct mon_mark *	mark;
+	struct mon_mark		from;
+	struct mon_shard *	sh;
+	mon_entry		key;
+	mon_entry *		mon;
+	uint32_t		hash;
+	uint64_t		slot;
+
+	while (0 != walk_count) {
+		while (walk_pos < walk_count) {
+			mark = &walk_marks[walk_pos++];
+			ZERO(key);
+			key.family = mark->family;
+			key.scope = mark->scope;
+			memcpy(key.addr, mark->addr, sizeof(key.addr));
+			hash = mon_hash(&key);
+			sh = mon_shard_of(hash);
+			slot = mon_probe(sh, &key, hash);
+			if (0 == sh->index[slot].entry)
+				continue;	/* gone */
+			mon = &sh->pool[sh->index[slot].entry - 1];
+			if (mon->last != mark->last)
+				continue;	/* heard from since */
+			return mon;
+		}
+
+		/*
+		 * The rest, and whatever changed while we walked,
+		 * sorts after the last mark.
+		 */
+		from = walk_marks[walk_count - 1];
+		walk_build(&from);
+	}
+	return NULL;
+}
+
+/*
+ * mon_prefix_alloc - size and allocate the prefix table the first
+ *		      time it is needed, with every set locked
+ */
+static void
+mon_prefix_alloc(void)
+{
+	struct mon_prefix *	table;
+	uint64_t		sets;
+
+	if (NULL != __atomic_load_n(&mon_prefixes, __ATOMIC_ACQUIRE))
+		return;
+	mon_prefix_lock_all();
+	if (NULL == mon_prefixes) {
+		for (sets = PREFIX_SETS_MIN;
+		     sets * PREFIX_WAYS * 8 < mon_data.mru_maxdepth &&
+		     sets * PREFIX_WAYS < PREFIX_SLOTS_MAX;
+		     sets <<= 1)
+			continue;
+		mon_data.prefix_slots = sets * PREFIX_WAYS;
+		table = emalloc_zero(mon_data.prefix_slots *
+				     sizeof(*mon_prefixes));
+		__atomic_store_n(&mon_prefixes, table, __ATOMIC_RELEASE);
+	}
+	mon_prefix_unlock_all();
+}
+
+
+/*
+ * mon_prefix_find - the prefix table entry of a masked address in
+ *		     set number setno, taking over the stalest of the
+ *		     set if need be.  Called with the set's lock held.
+ */
+static struct mon_prefix *
+mon_prefix_find(
+	const mon_entry *	key,
+	uint64_t		setno
+	)
+{
+	struct mon_prefix *	set;
+	struct mon_prefix *	oldest;
+	unsigned int		i;
+
+	set = &mon_prefixes[setno * PREFIX_WAYS];
+	oldest = set;
+	for (i = 0; i < PREFIX_WAYS; i++) {
+		if (set[i].family == key->family &&
+		    !memcmp(set[i].addr, key->addr, sizeof(key->addr)))
+			return &set[i];
+		if (set[i].last < oldest->last)
+			oldest = &set[i];
+	}
+
+	PREFIX_COUNT(mon_data.prefix_new);
+	if (0 != oldest->last)
+		PREFIX_COUNT(mon_data.prefix_recycled);
+	else
+		PREFIX_COUNT(mon_data.prefix_used);
+	ZERO(*oldest);
+	oldest->family = key->family;
+	memcpy(oldest->addr, key->addr, sizeof(oldest->addr));
+	return oldest;
+}
+
+
+/*
+ * mon_prefix_limit - score a packet against its source prefix.
+ *
+ * Takes the restrict flags and the flags left by the per-address
+ * limit.  If the address itself is within its limit but its prefix
+ * is not, returns the flags that limit it for the prefix, with the
+ * prefix's own KoD rule, and sets *prefixed.
+ */
+static unsigned short
+mon_prefix_limit(
+	const mon_entry *	addr,
+	l_fp			now,
+	unsigned short		flags,
+	unsigned short		restrict_mask,
+	uint8_t *		prefixed
+	)
+{
+	struct mon_prefix *	pfx;
+	pthread_mutex_t *	lock;
+	mon_entry		key;
+	uint64_t		setno;
+	int			bits;
+	size_t			i;
+
+	*prefixed = 0;
+	bits = (AF_INET6 == addr->family)
+		   ? mon_data.prefix_v6
+		   : mon_data.prefix_v4;
+	if (0 == bits)
+		return restrict_mask;
+
+	ZERO(key);
+	key.family = addr->family;
+	for (i = 0; bits >= 8; i++, bits -= 8)
+		key.addr[i] = addr->addr[i];
+	if (bits > 0)
+		key.addr[i] = addr->addr[i] & (uint8_t)(0xff00 >> bits);
+
+	mon_prefix_alloc();
+	setno = mon_hash(&key) & (mon_data.prefix_slots / PREFIX_WAYS - 1);
+	lock = &mon_shards[setno & (mon_nshards - 1)]->prefix_lock;
+	pthread_mutex_lock(lock);
+	pfx = mon_prefix_find(&key, setno);
+	if (0 != pfx->last)
+		pfx->score *= mon_decay(now - pfx->last);
+	pfx->score += decay_add;
+	pfx->last = now;
+
+	if (!(RES_LIMITED & flags) || (RES_LIMITED & restrict_mask) ||
+	    pfx->score < mon_data.prefix_limit) {
+		pthread_mutex_unlock(lock);
+		return restrict_mask;
+	}
+
+	PREFIX_COUNT(mon_data.prefix_limited);
+	restrict_mask = flags;
+	/* as for addresses, no KoDs for big bursts */
+	if (pfx->score > mon_data.prefix_kod + mon_data.prefix_limit)
+		restrict_mask &= ~RES_KOD;
+	if (RES_KOD & restrict_mask)
+		PREFIX_COUNT(mon_data.prefix_kods);
+	pthread_mutex_unlock(lock);
+	*prefixed = 1;
+	return restrict_mask;
+}
+
+
 /*
  * ntp_monitor - record stats about this packet
  *
@@ -323,6 +1196,13 @@ int mon_get_oldest_age(l_fp now)
  * such responses.  ntpq -c reslist lets you see whether RES_LIMITED
  * or RES_KOD is lit for a particular address before ntp_monitor()'s
  * typical dousing.
+ *
+ * With prefix limits on, a packet whose own address is within its
+ * limit may still be limited because of its source prefix; see
+ * mon_prefix_limit().
+ *
+ * Worker threads call this too; everything below happens under the
+ * lock of the source's shard.
  */
 unsigned short
 ntp_monitor(
@@ -330,61 +1210,59 @@ ntp_monitor(
 	unsigned short	flags
 	)
 {
+	struct mon_shard *sh;
 	l_fp		delta_fp;
+	mon_entry	key;
 	mon_entry *	mon;
 	mon_entry *	oldest;
 	int		oldest_age;
-	unsigned int	hash;
+	uint32_t	hash;
+	uint64_t	slot;
+	uint64_t	mindepth;
+	uint64_t	maxdepth;
 	unsigned short	restrict_mask;
 	uint8_t		mode;
 	uint8_t		version;
 	uint8_t		li_vn_mode;
-	float		since_last;	/* seconds since last packet */
 
-	if (mon_data.mon_enabled == MON_OFF)
+	if (mon_data.mon_enabled == MON_OFF || NULL == mon_shards)
 		return ~(RES_LIMITED | RES_KOD) & flags;
 
-	hash = MON_HASH(&rbufp->recv_srcadr);
 	li_vn_mode = rbufp->recv_buffer[0];
 	mode = PKT_MODE(li_vn_mode);
 	version = PKT_VERSION(li_vn_mode);
-	mon = mon_data.mon_hash[hash];
 	/*
 	 * We keep track of all traffic for a given IP in one entry,
 	 * otherwise cron'ed ntpdate or similar evades RES_LIMITED.
 	 */
+	mon_set_key(&key, &rbufp->recv_srcadr);
+	hash = mon_hash(&key);
+	sh = mon_shard_of(hash);
+	pthread_mutex_lock(&sh->lock);
+	slot = mon_probe(sh, &key, hash);
 
-	for (; mon != NULL; mon = mon->hash_next)
-		if (SOCK_EQ(&mon->rmtadr, &rbufp->recv_srcadr))
-			break;
-
-	if (mon != NULL) {
-		mon_data.mru_exists++;
+	if (sh->index[slot].entry != 0) {
+		mon = &sh->pool[sh->index[slot].entry - 1];
+		sh->exists++;
 		delta_fp = rbufp->recv_time-mon->last;
 		mon->last = rbufp->recv_time;
-		NSRCPORT(&mon->rmtadr) = NSRCPORT(&rbufp->recv_srcadr);
+		mon->port = key.port;
 		mon->count++;
 		restrict_mask = flags;
 		mon->vn_mode = VN_MODE(version, mode);
-
-		/* Shuffle to the head of the MRU list. */
-		UNLINK_DLIST(mon, mru);
-		LINK_DLIST(mon_data.mon_mru_list, mon, mru);
+		mon->ref = 1;
 
 		/* Keep score:
 		 * if packets arrive at 1/second,
 		 * score will build up to (almost) 1.0
 		 */
-		since_last = ldexpf(delta_fp, -32);
-		mon->score *= expf(-since_last/mon_data.decay_time);
-		mon->score += 1.0/mon_data.decay_time;
+		mon->score *= mon_decay(delta_fp);
+		mon->score += decay_add;
 
 		if (mon->score < mon_data.rate_limit) {
 			/* low score, turn off reject bits */
 			restrict_mask &= ~(RES_LIMITED | RES_KOD);
 		}
-		if (RES_LIMITED & restrict_mask)
-			mon->dropped++;
 
 		/* HACK: Much abusive traffic is big bursts.
 		 * Don't send KoDs for them or we can be used
@@ -393,14 +1271,21 @@ ntp_monitor(
 			restrict_mask &= ~RES_KOD;
 		}
 
+		restrict_mask = mon_prefix_limit(mon, rbufp->recv_time,
+						 flags, restrict_mask,
+						 &mon->prefixed);
+		if (RES_LIMITED & restrict_mask)
+			mon->dropped++;
+
 		mon->flags = restrict_mask;
-		return mon->flags;
+		pthread_mutex_unlock(&sh->lock);
+		return restrict_mask;
 	}
 
 	/*
 	 * If we got here, this is the first we've heard of this
-	 * guy.  Get him some memory, either from the free list
-	 * or from the tail of the MRU list.
+	 * guy.  Get him a new slot at the end of the array, or
+	 * recycle the one the CLOCK hand offers.
 	 *
 	 * The following ntp.conf "mru" knobs come into play determining
 	 * the depth (or count) of the MRU list:
@@ -422,69 +1307,80 @@ ntp_monitor(
 	 *   initial allocation of MRU entries.
 	 * - "mru initmem" sets mru_initalloc in units of kilobytes.
 	 *   The default is 4.
-	 * - mru_incalloc ("mru incalloc" sets the number of entries to
-	 *   allocate on-demand each time the free list is empty.
+	 * - mru_incalloc ("mru incalloc" sets the least number of
+	 *   entries to add each time the array is full.
 	 * - "mru incmem" sets mru_incalloc in units of kilobytes.
 	 *   The default is 4.
 	 * Whichever of "mru maxmem" or "mru maxdepth" occurs last in
 	 * ntp.conf controls.  Similarly for "mru initalloc" and "mru
 	 * initmem", and for "mru incalloc" and "mru incmem".
+	 * Each shard applies its share of the depths to its entries.
 	 */
-	if (mon_data.mru_entries < mon_data.mru_mindepth) {
-		mon_data.mru_new++;
-		if (NULL == mon_free)
-			mon_getmoremem();
-		UNLINK_HEAD_SLIST(mon, mon_free, hash_next);
+	mindepth = mon_share(mon_data.mru_mindepth);
+	maxdepth = mon_share(mon_data.mru_maxdepth);
+	if (sh->entries < mindepth && sh->entries < MON_ENTRIES_MAX) {
+		sh->new++;
+	} else if (0 == sh->entries) {
+		/* mindepth 0, nothing to recycle */
+		sh->new++;
 	} else {
-		oldest = TAIL_DLIST(mon_data.mon_mru_list, mru);
-		oldest_age = mon_get_oldest_age(rbufp->recv_time);
+		oldest = mon_victim(sh);
+		oldest_age = mon_age(oldest, rbufp->recv_time);
 		if (mon_data.mru_maxage < oldest_age) {
-			mon_data.mru_recycleold++;
-			mon_reclaim_entry(oldest);
-			mon = oldest;
-		} else if (mon_free != NULL || mru_alloc < mon_data.mru_maxdepth) {
-			mon_data.mru_new++;
-			if (NULL == mon_free)
-				mon_getmoremem();
-			UNLINK_HEAD_SLIST(mon, mon_free, hash_next);
+			sh->recycleold++;
+			mon_remove(sh, oldest);
+		} else if (sh->entries < maxdepth &&
+			   sh->entries < MON_ENTRIES_MAX) {
+			sh->new++;
 		} else if (oldest_age < mon_data.mru_minage) {
-			mon_data.mru_none++;
-			return ~(RES_LIMITED | RES_KOD) & flags;
+			sh->none++;
+			/* offer another one next time */
+			sh->hand++;
+			restrict_mask = mon_prefix_limit(&key,
+						rbufp->recv_time, flags,
+						~(RES_LIMITED | RES_KOD) & flags,
+						&key.prefixed);
+			pthread_mutex_unlock(&sh->lock);
+			return restrict_mask;
 		} else {
-			mon_data.mru_recyclefull++;
-			/* coverity[var_deref_model] */
-			mon_reclaim_entry(oldest);
-			mon = oldest;
+			sh->recyclefull++;
+			mon_remove(sh, oldest);
 		}
 	}
 
 	/*
 	 * Got one, initialize it
 	 */
-	REQUIRE(mon != NULL);
-	mon_data.mru_entries++;
-	mon_data.mru_peakentries = max(mon_data.mru_peakentries,
-								   mon_data.mru_entries);
+	if (sh->entries == sh->alloc)
+		mon_getmoremem(sh);
+	mon = &sh->pool[sh->entries++];
 	mon->last = rbufp->recv_time;
 	mon->first = mon->last;
 	mon->count = 1;
-	mon->dropped = 0;
 	mon->score = 1.0/mon_data.decay_time;
-	mon->flags = ~(RES_LIMITED | RES_KOD) & flags;
-	memcpy(&mon->rmtadr, &rbufp->recv_srcadr, sizeof(mon->rmtadr));
+	mon->flags = mon_prefix_limit(&key, rbufp->recv_time, flags,
+				      ~(RES_LIMITED | RES_KOD) & flags,
+				      &mon->prefixed);
+	mon->dropped = (RES_LIMITED & mon->flags) ? 1 : 0;
 	mon->vn_mode = VN_MODE(version, mode);
-	mon->lcladr = rbufp->dstadr;
+	mon->ifnum = rbufp->dstadr->ifnum;
+	mon->scope = key.scope;
+	mon->port = key.port;
+	mon->family = key.family;
+	mon->ref = 1;
+	memcpy(mon->addr, key.addr, sizeof(mon->addr));
 
 	/*
-	 * Drop him into front of the hash table. Also put him on top of
-	 * the MRU list.
+	 * Index him.  Anything removed or grown above moved the
+	 * slot, so look again.
 	 */
-	if (NULL == mon_data.mon_hash[hash])
-		mon_data.mru_hashslots++;
-	LINK_SLIST(mon_data.mon_hash[hash], mon, hash_next);
-	LINK_DLIST(mon_data.mon_mru_list, mon, mru);
+	slot = mon_probe(sh, &key, hash);
+	sh->index[slot].hash = hash;
+	sh->index[slot].entry = (uint32_t)sh->entries;
+	restrict_mask = mon->flags;
+	pthread_mutex_unlock(&sh->lock);
 
-	return mon->flags;
+	return restrict_mask;
 }
 
 /* This is a hack to sanity check the MRU list
@@ -501,51 +1397,38 @@ ntp_monitor(
 void mon_timer(void) {
 #if 0
 	long int count = 0, hits = 0;
-	l_fp when = 0;
+	unsigned int s;
+	uint64_t i;
 	mon_entry *mon, *slot;
+	sockaddr_u addr;
 	struct timespec start, finish;
 	float scan_time;
 
 	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (	mon = TAIL_DLIST(mon_data.mon_mru_list, mru);
-		mon != NULL;
-		mon = PREV_DLIST(mon_data.mon_mru_list, mon, mru)) {
+	mon_lock_all();
+	for (s = 0; s < mon_nshards; s++)
+	for (i = 0; i < mon_shards[s]->entries; i++) {
+	  mon = &mon_shards[s]->pool[i];
 	  count++;
 	  /* check if lookup of addr gets this slot */
-	  slot = mon_get_slot(&mon->rmtadr);
+	  mon_get_addr(mon, &addr);
+	  slot = mon_get_slot(&addr);
 	  if (mon != slot) {
 	    if (10 > hits++) {
 	      if (NULL == slot)
 	        msyslog(LOG_INFO, "MON: Can't find %ld, %s",
-		  count, sockporttoa(&mon->rmtadr));
+		  count, sockporttoa(&addr));
 	      else
 	        msyslog(LOG_INFO, "MON: Wrong find %ld, %s",
-		  count, sockporttoa(&mon->rmtadr));
+		  count, sockporttoa(&addr));
 	    }
 	  }
-	  /* check if time stamps are ordered */
-	  if (when > mon->last) {
-	    if (10 > hits++) {
-	      if (NULL == slot)
-	        msyslog(LOG_INFO, "MON: backwards %ld, 0x%08x.%08x 0x%08x.%08x %s",
-		  count,
-		  (unsigned int)lfpuint(mon->last),
-		  (unsigned int)lfpfrac(mon->last),
-		  (unsigned int)lfpuint(when),
-		  (unsigned int)lfpfrac(when),
-		  sockporttoa(&mon->rmtadr) );
-	    }
-	  }
-	  when = mon->last;
 	}
+	mon_unlock_all();
 	clock_gettime(CLOCK_MONOTONIC, &finish);
 	scan_time = tspec_to_d(sub_tspec(finish, start));
-	if (count == (long)mon_data.mru_entries)
-	    msyslog(LOG_INFO, "MON: Scanned %ld slots in %.3f",
+	msyslog(LOG_INFO, "MON: Scanned %ld slots in %.3f",
 		count, scan_time);
-	else
-	    msyslog(LOG_ERR, "MON: Scan found %ld slots, expected %ld",
-		count, (long)mon_data.mru_entries);
 #endif
 }
 
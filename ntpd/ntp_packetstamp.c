@@ -11,9 +11,15 @@
 #endif
 
 #include "ntpd.h"
+#include "ntp_hist.h"
 #include "ntp_stdlib.h"
 #include "timespecops.h"
 
+#ifdef USE_TXSTAMPS
+# include <linux/errqueue.h>
+# include <linux/net_tstamp.h>
+#endif
+
 /* We handle 3 flavors of timestamp:
  * SO_TIMESTAMPNS/SCM_TIMESTAMPNS  Linux (maybe others)
  * SO_TS_CLOCK/SCM_REALTIME        FreeBSD
@@ -111,8 +117,15 @@ fetch_packetstamp(
 #endif
 	l_fp			nts = 0;  /* network time stamp */
 
-/* There should be only one cmsg. */
+/*
+ * There should be only one cmsg, but with "extra txstamps" Linux may
+ * add an SCM_TIMESTAMPING one as well, so skip anything else.
+ */
 	cmsghdr = CMSG_FIRSTHDR(msghdr);
+#if defined(SO_TIMESTAMPNS)
+	while (NULL != cmsghdr && SCM_TIMESTAMPNS != cmsghdr->cmsg_type)
+		cmsghdr = CMSG_NXTHDR(msghdr, cmsghdr);
+#endif
 	if (NULL == cmsghdr) {
 		DPRINT(4, ("fetch_timestamp: can't find timestamp\n"));
 		msyslog(LOG_ERR, "ERR: fetch_timestamp: no msghdrs");
@@ -159,4 +172,259 @@ fetch_packetstamp(
 	return nts;
 }
 
+
+/*
+ * Transmit timestamps.  With "extra txstamps" every endpoint socket
+ * asks the kernel for a software timestamp of each datagram as it
+ * goes to the driver.  These come back on the socket's error queue,
+ * tagged with a per-socket datagram count (SOF_TIMESTAMPING_OPT_ID).
+ * note_txstamp() records, under the same count, the local time the
+ * datagram's transmit timestamp was taken; read_txstamps() pairs the
+ * two up.  The difference is what the crypto, the syscall and the
+ * stack added after we stamped the packet.  For a client request the
+ * kernel time also replaces org_ts in the offset and delay sums.
+ *
+ * Only datagrams the kernel took are noted.  A send can still fail
+ * after the kernel gave it a key, which leaves the kernel's count
+ * ahead of ours; the first key seen from past our count puts us back
+ * in step, losing the datagrams noted in between.
+ */
+bool	io_txstamps = false;
+
+#define TXSTAMP_RING	256	/* datagrams in flight per socket */
+#define TXSTAMP_SANE	((l_fp)1 << 32)	/* 1 s; longer is a mismatch */
+
+struct txpending {
+	uint32_t	key;		/* kernel's datagram count */
+	associd_t	assoc;		/* sending association or 0 */
+	l_fp		xmt;		/* local transmit time, or 0 */
+};
+
+struct txstamps {
+	uint32_t	next;		/* key of the next datagram */
+	struct txpending ring[TXSTAMP_RING];
+	struct lat_hist	hist;
+};
+
+static struct lat_hist	txstamp_total;
+static uint64_t		txstamp_matched;
+static uint64_t		txstamp_lost;
+
+
+/*
+ * enable_txstamps - ask for transmit timestamps on an endpoint's
+ * newly opened socket
+ */
+void
+enable_txstamps(
+	endpt *	ep,
+	SOCKET	fd
+	)
+{
+#ifdef USE_TXSTAMPS
+	int	flags = SOF_TIMESTAMPING_TX_SOFTWARE |
+			SOF_TIMESTAMPING_SOFTWARE |
+			SOF_TIMESTAMPING_OPT_ID |
+			SOF_TIMESTAMPING_OPT_TSONLY;
+
+# ifdef SOF_TIMESTAMPING_OPT_RX_FILTER
+	/* receive stamps keep coming from SO_TIMESTAMPNS */
+	flags |= SOF_TIMESTAMPING_OPT_RX_FILTER;
+# endif
+	if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+		       sizeof(flags))) {
+		msyslog(LOG_ERR,
+			"IO: setsockopt SO_TIMESTAMPING fails on address %s: %s",
+			socktoa(&ep->sin), strerror(errno));
+		disable_txstamps(ep);
+		return;
+	}
+	/* a new socket counts its datagrams from 0 */
+	if (NULL == ep->txs)
+		ep->txs = emalloc_zero(sizeof(*ep->txs));
+	ep->txs->next = 0;
+	memset(ep->txs->ring, '\0', sizeof(ep->txs->ring));
+#else
+	UNUSED_ARG(ep);
+	UNUSED_ARG(fd);
+#endif
+}
+
+
+/*
+ * disable_txstamps - forget an endpoint's transmit timestamps
+ */
+void
+disable_txstamps(
+	endpt *	ep
+	)
+{
+	free(ep->txs);
+	ep->txs = NULL;
+}
+
+
+/*
+ * note_txstamp - record a datagram just handed to the kernel
+ */
+void
+note_txstamp(
+	endpt *		ep,
+	const l_fp *	xmt,
+	associd_t	assoc
+	)
+{
+	struct txpending *tp;
+
+	if (NULL == ep->txs)
+		return;
+	tp = &ep->txs->ring[ep->txs->next % TXSTAMP_RING];
+	tp->key = ep->txs->next++;
+	tp->assoc = assoc;
+	tp->xmt = (NULL != xmt) ? *xmt : 0;
+}
+
+
+#ifdef USE_TXSTAMPS
+/*
+ * match_txstamp - pair one kernel timestamp with its datagram
+ */
+static void
+match_txstamp(
+	struct txstamps *	txs,
+	uint32_t		key,
+	l_fp			kernel
+	)
+{
+	struct txpending *tp = &txs->ring[key % TXSTAMP_RING];
+	struct peer *	peer;
+	l_fp		delay;
+	uint64_t	ns;
+
+	if (tp->key != key) {
+		txstamp_lost++;		/* overwritten or never noted */
+		if ((int32_t)(key - txs->next) >= 0)
+			txs->next = key + 1;	/* kernel counted more */
+		return;
+	}
+	if (0 == tp->xmt)
+		return;			/* nothing to compare with */
+	if (kernel < tp->xmt || kernel - tp->xmt >= TXSTAMP_SANE) {
+		txstamp_lost++;
+		return;
+	}
+	delay = kernel - tp->xmt;
+	ns = (delay * NS_PER_S) >> 32;
+	lat_hist_add(&txs->hist, ns);
+	lat_hist_add(&txstamp_total, ns);
+	txstamp_matched++;
+
+	if (0 != tp->assoc) {
+		peer = findpeerbyassoc(tp->assoc);
+		if (NULL != peer && peer->org_ts == tp->xmt)
+			peer->org_tx = kernel;
+	}
+	tp->xmt = 0;
+}
+#endif
+
+
+/*
+ * read_txstamps - drain an endpoint socket's error queue
+ */
+void
+read_txstamps(
+	endpt *	ep
+	)
+{
+#ifdef USE_TXSTAMPS
+	struct msghdr	msghdr;
+	struct cmsghdr *cmsghdr;
+	struct sock_extended_err *serr;
+	struct scm_timestamping *tss;
+	char		control[256];
+	l_fp		kernel;
+	bool		have_key;
+	uint32_t	key;
+
+	for (;;) {
+		ZERO(msghdr);
+		msghdr.msg_control = control;
+		msghdr.msg_controllen = sizeof(control);
+		if (recvmsg(ep->fd, &msghdr, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+			return;		/* EAGAIN: drained */
+
+		kernel = 0;
+		have_key = false;
+		key = 0;
+		for (cmsghdr = CMSG_FIRSTHDR(&msghdr); NULL != cmsghdr;
+		     cmsghdr = CMSG_NXTHDR(&msghdr, cmsghdr)) {
+			if (SOL_SOCKET == cmsghdr->cmsg_level &&
+			    SCM_TIMESTAMPING == cmsghdr->cmsg_type) {
+				tss = (struct scm_timestamping *)
+					CMSG_DATA(cmsghdr);
+				kernel = tspec_stamp_to_lfp(tss->ts[0]);
+			} else if ((SOL_IP == cmsghdr->cmsg_level &&
+				    IP_RECVERR == cmsghdr->cmsg_type) ||
+				   (SOL_IPV6 == cmsghdr->cmsg_level &&
+				    IPV6_RECVERR == cmsghdr->cmsg_type)) {
+				serr = (struct sock_extended_err *)
+					CMSG_DATA(cmsghdr);
+				if (ENOMSG == serr->ee_errno &&
+				    SO_EE_ORIGIN_TIMESTAMPING ==
+				    serr->ee_origin) {
+					key = serr->ee_data;
+					have_key = true;
+				}
+			}
+		}
+		if (NULL != ep->txs && have_key && 0 != kernel)
+			match_txstamp(ep->txs, key, kernel);
+	}
+#else
+	UNUSED_ARG(ep);
+#endif
+}
+
+
+/*
+ * txstamp_hist - an endpoint's transmit latency histogram, or NULL
+ */
+const char *
+txstamp_hist(
+	const endpt *	ep
+	)
+{
+	if (NULL == ep->txs)
+		return NULL;
+	return lat_hist_str(&ep->txs->hist);
+}
+
+/*
+ * txstamp_hist_all - transmit latency over all endpoints
+ */
+const char *
+txstamp_hist_all(void)
+{
+	return lat_hist_str(&txstamp_total);
+}
+
+/*
+ * txstamp_matched_count - kernel timestamps paired with a datagram
+ */
+uint64_t
+txstamp_matched_count(void)
+{
+	return txstamp_matched;
+}
+
+/*
+ * txstamp_lost_count - kernel timestamps that could not be paired
+ */
+uint64_t
+txstamp_lost_count(void)
+{
+	return txstamp_lost;
+}
+
 // end
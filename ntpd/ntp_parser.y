@@ -61,6 +61,7 @@
 %token	<Integer>	T_Baud
 %token	<Integer>	T_Bias
 %token	<Integer>	T_Burst
+%token	<Integer>	T_Busypoll
 %token	<Integer>	T_Calibrate
 %token	<Integer>	T_Ca
 %token	<Integer>	T_Ceiling
@@ -98,6 +99,7 @@
 %token	<Integer>	T_Fudge
 %token	<Integer>	T_Huffpuff
 %token	<Integer>	T_Iburst
+%token	<Integer>	T_Ifdeltas
 %token	<Integer>	T_Ignore
 %token	<Integer>	T_Incalloc
 %token	<Integer>	T_Incmem
@@ -108,11 +110,15 @@
 %token	<Integer>	T_Interface
 %token	<Integer>	T_Intrange		/* Not a token, used as tag */
 %token	<Integer>	T_Io
+%token	<Integer>	T_Iocpu
 %token	<Integer>	T_Ipv4
 %token	<Integer>	T_Ipv4_flag
 %token	<Integer>	T_Ipv6
 %token	<Integer>	T_Ipv6_flag
+%token	<Integer>	T_Kelimit
 %token	<Integer>	T_Kernel
+%token	<Integer>	T_Ketimeout
+%token	<Integer>	T_Keworkers
 %token	<Integer>	T_Key
 %token	<Integer>	T_Keys
 %token	<Integer>	T_Kod
@@ -181,12 +187,17 @@
 %token	<Integer>	T_Port
 %token	<Integer>	T_Ppspath
 %token	<Integer>	T_Prefer
+%token	<Integer>	T_Prefixaverage
+%token	<Integer>	T_Prefixkod
+%token	<Integer>	T_Prefixv4
+%token	<Integer>	T_Prefixv6
 %token	<Integer>	T_Protostats
 %token	<Integer>	T_Rawstats
 %token	<Integer>	T_Refclock
 %token	<Integer>	T_Refid
 %token	<Integer>	T_Requestkey
 %token	<Integer>	T_Require
+%token	<Integer>	T_Recvbatch
 %token	<Integer>	T_Reset
 %token	<Integer>	T_Restrict
 %token	<Integer>	T_Rlimit
@@ -195,6 +206,8 @@
 %token	<Integer>	T_Setvar
 %token	<Integer>	T_Source
 %token	<Integer>	T_Stacksize
+%token	<Integer>	T_Stagestats
+%token	<Integer>	T_Stagetime
 %token	<Integer>	T_Statistics
 %token	<Integer>	T_Stats
 %token	<Integer>	T_Statsdir
@@ -218,17 +231,20 @@
 %token	<Integer>	T_Tos
 %token	<Integer>	T_True
 %token	<Integer>	T_Trustedkey
+%token	<Integer>	T_Txstamps
 %token	<Integer>	T_Type
 %token	<Integer>	T_U_int			/* Not a token */
 %token	<Integer>	T_Unit
 %token	<Integer>	T_Unconfig
 %token	<Integer>	T_Unpeer
 %token	<Integer>	T_Unrestrict
+%token	<Integer>	T_Uring
 %token	<Integer>	T_Usestats
 %token	<Integer>	T_Version
 %token	<Integer>	T_WanderThreshold	/* Not a token, used as tag */
 %token	<Integer>	T_Week
 %token	<Integer>	T_Wildcard
+%token	<Integer>	T_Workers
 %token	<Integer>	T_Year
 %token	<Integer>	T_Flag			/* Not a token, used as tag */
 %token	<Integer>	T_EOC
@@ -664,6 +680,7 @@ stat
 	|	T_Usestats
 	|	T_Ntsstats
 	|	T_Ntskestats
+	|	T_Stagestats
 	;
 
 filegen_option_list
@@ -817,6 +834,16 @@ access_control_command
 				$1, NULL, NULL, $3, lex_current()->curpos.nline);
 			APPEND_G_FIFO(cfgt.restrict_opts, rn);
 		}
+	|	restrict_prefix T_File T_String ac_flag_list
+		{
+			restrict_node *	rn;
+
+			APPEND_G_FIFO($4, create_int_node($2));
+			rn = create_restrict_node($1,
+				create_address_node($3, AF_UNSPEC),
+				NULL, $4, lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
 	;
 
 ac_flag_list
@@ -868,6 +895,10 @@ limit_option_keyword
 	:	T_Average
 	|	T_Burst
 	|	T_Kod
+	|	T_Prefixaverage
+	|	T_Prefixkod
+	|	T_Prefixv4
+	|	T_Prefixv6
 	;
 
 mru_option_list
@@ -1097,7 +1128,15 @@ extra_option
 	;
 
 extra_option_keyword
-	:	T_Port
+	:	T_Busypoll
+	|	T_Ifdeltas
+	|	T_Iocpu
+	|	T_Port
+	|	T_Recvbatch
+	|	T_Stagetime
+	|	T_Txstamps
+	|	T_Uring
+	|	T_Workers
 	;
 
 
@@ -1193,7 +1232,10 @@ nts_string_option_keyword
 	;
 
 nts_number_option_keyword
-	:	T_Port
+	:	T_Kelimit
+	|	T_Ketimeout
+	|	T_Keworkers
+	|	T_Port
 	;
 
 /* Miscellaneous Commands
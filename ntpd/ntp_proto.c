@@ -19,6 +19,7 @@
 #include <libscf.h>
 #endif
 #include <unistd.h>
+#include "ntp_barrier.h"
 
 #define MSSNTP_QUERY_MAC_LEN 16
 
@@ -103,6 +104,14 @@ struct leap_smear_info leap_smear;
 #endif
 bool leap_sec_in_progress;
 
+/*
+ * Reply fields as of the last publish_server_state().  Only the main
+ * thread writes them.  The count is odd while it does; readers retry
+ * until they see the same even count on both sides of their copy.
+ */
+static volatile struct server_state server_state;
+static volatile unsigned int server_state_seq;
+
 /*
  * Rate controls. Leaky buckets are used to throttle the packet
  * transmission rates in order to protect busy servers such as at NIST
@@ -201,6 +210,40 @@ void increment_restricted(void)
   stat_proto_total.sys_restricted++;
 }
 
+/*
+ * stat_proto_new - a set of counters for a server worker thread,
+ * which receive_simple() bumps instead of the totals
+ */
+struct statistics_counters *stat_proto_new(void)
+{
+  return emalloc_zero(sizeof(struct statistics_counters));
+}
+
+/*
+ * stat_proto_fold - add a worker's counters to the totals and start
+ * them over.  The caller keeps the worker out meanwhile.
+ */
+void stat_proto_fold(struct statistics_counters *from)
+{
+#define fold(member)   stat_proto_total.sys_##member += from->sys_##member
+  fold(received);
+  fold(processed);
+  fold(restricted);
+  fold(newversion);
+  fold(oldversion);
+  fold(version1);
+  fold(version1client);
+  fold(version1zero);
+  fold(version1symm);
+  fold(badlength);
+  fold(badauth);
+  fold(declined);
+  fold(limitrejected);
+  fold(kodsent);
+#undef fold
+  memset(from, '\0', sizeof(*from));
+}
+
 uptime_t stat_use_stattime(void)
 {
   return current_time - use_stattime;
@@ -210,6 +253,194 @@ void set_use_stattime(uptime_t stattime) {
   use_stattime = stattime;
 }
 
+/*
+ * Receive path stage timing, "extra stagetime N".  One packet in N
+ * is picked once, by stage_pick() as it enters receive(), and each
+ * stage it goes through is timed.  Only the main thread's packets
+ * are timed, so one set of statics does.  The stagestats file
+ * counts from stage_hourago,
+ * which it moves on each hour; mode 6 counts from stage_reset,
+ * which only "reset sys" moves.
+ */
+unsigned int		stage_sample = 0;
+struct stage_stat	stage_stats[RX_STAGES];
+static struct stage_stat stage_hourago[RX_STAGES];
+static struct stage_stat stage_reset[RX_STAGES];
+const char * const	stage_names[RX_STAGES] = {
+	"restrict", "monitor", "parse", "auth", "extens", "reply", "send"
+};
+static unsigned int	stage_countdown;
+static bool		stage_timing;	/* this packet is being timed */
+static struct timespec	stage_start;
+
+static void stage_end(enum rx_stage);
+
+/* time a stage if timed, which is stage_timing on the main thread */
+static inline void
+stage_begin(
+	bool	timed
+	)
+{
+	if (timed)
+		clock_gettime(CLOCK_MONOTONIC_RAW, &stage_start);
+}
+
+static inline void
+stage_finish(
+	bool		timed,
+	enum rx_stage	stage
+	)
+{
+	if (timed)
+		stage_end(stage);
+}
+
+#define STAGE_BEGIN()		stage_begin(stage_timing)
+#define STAGE_END(stage)	stage_finish(stage_timing, stage)
+
+void
+stage_pick(void)
+{
+	stage_timing = false;
+	if (0 == stage_sample)
+		return;
+	if (stage_countdown > 1) {
+		stage_countdown--;
+		return;
+	}
+	stage_countdown = stage_sample;
+	stage_timing = true;
+}
+
+static void
+stage_end(
+	enum rx_stage	stage
+	)
+{
+	struct timespec	finish;
+	uint64_t	ns;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &finish);
+	finish = sub_tspec(finish, stage_start);
+	ns = (uint64_t)finish.tv_sec * NS_PER_S + (uint64_t)finish.tv_nsec;
+	stage_stats[stage].ns += ns;
+	lat_hist_add(&stage_stats[stage].hist, ns);
+}
+
+/*
+ * timed_restrictions, timed_monitor - the first two stages, shared
+ * by receive() and receive_simple()
+ */
+static unsigned short
+timed_restrictions(
+	struct recvbuf *rbufp,
+	bool		timed
+	)
+{
+	unsigned short	restrict_mask;
+
+	stage_begin(timed);
+	restrict_mask = restrictions(&rbufp->recv_srcadr);
+	stage_finish(timed, STAGE_RESTRICT);
+	return restrict_mask;
+}
+
+static unsigned short
+timed_monitor(
+	struct recvbuf *rbufp,
+	unsigned short	restrict_mask,
+	bool		timed
+	)
+{
+	stage_begin(timed);
+	restrict_mask = ntp_monitor(rbufp, restrict_mask);
+	stage_finish(timed, STAGE_MONITOR);
+	return restrict_mask;
+}
+
+/*
+ * stage_clr_stats - start the mode 6 stage counts over
+ */
+void
+stage_clr_stats(void)
+{
+	memcpy(stage_reset, stage_stats, sizeof(stage_reset));
+}
+
+/*
+ * stage_hour_mark - start the stagestats file counts over
+ */
+void
+stage_hour_mark(void)
+{
+	memcpy(stage_hourago, stage_stats, sizeof(stage_hourago));
+}
+
+static void
+stage_diff(
+	enum rx_stage			stage,
+	const struct stage_stat *	base,
+	struct stage_stat *		out
+	)
+{
+	const struct stage_stat *now = &stage_stats[stage];
+	const struct stage_stat *then = &base[stage];
+	int	i;
+
+	out->ns = now->ns - then->ns;
+	out->hist.count = now->hist.count - then->hist.count;
+	for (i = 0; i < LAT_HIST_BUCKETS; i++)
+		out->hist.bucket[i] = now->hist.bucket[i] -
+		    then->hist.bucket[i];
+}
+
+/*
+ * stage_since - a stage's counts since stage_clr_stats(), for mode 6
+ */
+void
+stage_since(
+	enum rx_stage		stage,
+	struct stage_stat *	out
+	)
+{
+	stage_diff(stage, stage_reset, out);
+}
+
+/*
+ * stage_hour - a stage's counts since stage_hour_mark(), for the
+ * stagestats file
+ */
+void
+stage_hour(
+	enum rx_stage		stage,
+	struct stage_stat *	out
+	)
+{
+	stage_diff(stage, stage_hourago, out);
+}
+
+#define stage_dumps(name, stage)\
+const char *stage_##name##_hist(void) {\
+  struct stage_stat st;\
+  stage_since(stage, &st);\
+  return lat_hist_str(&st.hist);\
+}\
+uint64_t stage_##name##_ns(void) {\
+  struct stage_stat st;\
+  stage_since(stage, &st);\
+  return st.ns;\
+}
+
+stage_dumps(restrict, STAGE_RESTRICT)
+stage_dumps(monitor, STAGE_MONITOR)
+stage_dumps(parse, STAGE_PARSE)
+stage_dumps(auth, STAGE_AUTH)
+stage_dumps(extens, STAGE_EXTENS)
+stage_dumps(reply, STAGE_REPLY)
+stage_dumps(send, STAGE_SEND)
+
+#undef stage_dumps
+
 
 static	void	clock_combine	(peer_select *, int, int);
 static	void	clock_select	(void);
@@ -250,6 +481,72 @@ set_sys_leap(unsigned char new_sys_leap) {
 		}
 #endif	/* ENABLE_LEAP_SMEAR */
 	}
+	publish_server_state();
+}
+
+/*
+ * publish_server_state - refresh the copy of the system variables
+ * used to build server replies.  Call after changing any of them.
+ */
+void
+publish_server_state(void)
+{
+	struct server_state fresh;
+	struct pkt head;
+	l_fp reftime = sys_vars.sys_reftime;
+
+	/* the version is patched in from each request */
+	head.li_vn_mode = PKT_LI_VN_MODE(xmt_leap, 0, MODE_SERVER);
+	head.stratum = STRATUM_TO_PKT(sys_vars.sys_stratum);
+	head.ppoll = 0;
+	head.precision = sys_vars.sys_precision;
+	head.rootdelay = HTONS_FP(DTOUFP(sys_vars.sys_rootdelay));
+	head.rootdisp = HTONS_FP(DTOUFP(sys_vars.sys_rootdisp));
+	head.refid = sys_vars.sys_refid;
+#ifdef ENABLE_LEAP_SMEAR
+	/*
+	 * Inside the leap smear interval the reftime gets the current
+	 * smear offset so it isn't later than the smeared receive and
+	 * transmit times, and the refid carries the offset.
+	 */
+	fresh.smearing = leap_smear.in_progress;
+	fresh.smear_offset = leap_smear.offset;
+	if (fresh.smearing) {
+		reftime += leap_smear.offset;
+		head.refid = convertLFPToRefID(leap_smear.offset);
+		DPRINT(2, ("publish_server_state: smearing: refid %8x, smear %s\n",
+			ntohl(head.refid), lfptoa(leap_smear.offset, 8)));
+	}
+#endif
+	head.reftime = htonl_fp(reftime);
+	memcpy(fresh.prefix, &head, sizeof(fresh.prefix));
+
+	server_state_seq++;
+	memory_barrier();
+	server_state = fresh;
+	memory_barrier();
+	server_state_seq++;
+}
+
+/*
+ * read_server_state - take a consistent copy of the reply fields.
+ * Needs no lock, so any thread may call it.
+ */
+void
+read_server_state(
+	struct server_state *state
+	)
+{
+	unsigned int seq;
+
+	for (;;) {
+		seq = server_state_seq;
+		memory_barrier();
+		*state = server_state;
+		memory_barrier();
+		if (0 == (seq & 1) && seq == server_state_seq)
+			return;
+	}
 }
 
 /* Returns false for packets we want to reject out of hand: those with an
@@ -315,7 +612,8 @@ parse_packet(
 	rbufp->mac_len = 0;
 
 	rbufp->extens_present = false;
-	rbufp->ntspacket.valid = false;
+	if (NULL != rbufp->ntspacket)
+		rbufp->ntspacket->valid = false;
 
 	if(PKT_VERSION(pkt->li_vn_mode) > NTP_VERSION) {
 		/* Unsupported version */
@@ -581,10 +879,13 @@ handle_procpkt(
 	    (rbufp->pkt.xmt >= rbufp->recv_time) ?
 	    scalbn((double)(rbufp->pkt.xmt - rbufp->recv_time), -32) :
 	    -scalbn((double)(rbufp->recv_time - rbufp->pkt.xmt), -32);
+	/* The kernel's transmit time, when we have it, leaves out the
+	   crypto and the syscall that follow org_ts. */
+	const l_fp t1 = (0 != peer->org_tx) ? peer->org_tx : peer->org_ts;
 	const double t21 =
-	    (rbufp->pkt.rec >= peer->org_ts) ?
-	    scalbn((double)(rbufp->pkt.rec - peer->org_ts), -32) :
-	    -scalbn((double)(peer->org_ts - rbufp->pkt.rec), -32);
+	    (rbufp->pkt.rec >= t1) ?
+	    scalbn((double)(rbufp->pkt.rec - t1), -32) :
+	    -scalbn((double)(t1 - rbufp->pkt.rec), -32);
 	const double theta = (t21 + t34) / 2.;
 	const double delta = fabs(t21 - t34);
 	const double epsilon = LOGTOD(sys_vars.sys_precision) +
@@ -659,12 +960,23 @@ receive(
 	unsigned short restrict_mask;
 	auth_info* auth = NULL;  /* !NULL if authenticated */
 	int mode;
+	bool parsed;
 
 #ifdef ENABLE_MSSNTP
 	uint8_t zero_key[MSSNTP_QUERY_MAC_LEN];
 	memset(&zero_key, 0, MSSNTP_QUERY_MAC_LEN);
 #endif /* ENABLE_MSSNTP */
 
+	stage_pick();
+	if (is_simple_request(rbufp)) {
+		/* Plain client request, skip the full treatment */
+		int flags;
+
+		if (receive_simple(rbufp, &flags, NULL))
+			fast_xmit(rbufp, NULL, flags);
+		return;
+	}
+
 	stat_proto_total.sys_received++;
 
 #ifdef NTPv1
@@ -705,14 +1017,14 @@ receive(
 
 	/* FIXME: This is lots more cleanup to do in this area. */
 
-	restrict_mask = restrictions(&rbufp->recv_srcadr);
+	restrict_mask = timed_restrictions(rbufp, stage_timing);
 
 	if(check_early_restrictions(rbufp, restrict_mask)) {
 		stat_proto_total.sys_restricted++;
 		return;
 	}
 
-	restrict_mask = ntp_monitor(rbufp, restrict_mask);
+	restrict_mask = timed_monitor(rbufp, restrict_mask, stage_timing);
 	if (restrict_mask & RES_LIMITED) {
 		stat_proto_total.sys_limitrejected++;
 		if(!(restrict_mask & RES_KOD)) { return; }
@@ -741,7 +1053,10 @@ receive(
 	}
 	}
 
-	if (!parse_packet(rbufp)) {
+	STAGE_BEGIN();
+	parsed = parse_packet(rbufp);
+	STAGE_END(STAGE_PARSE);
+	if (!parsed) {
 		stat_proto_total.sys_badlength++;
 		return;
 	}
@@ -777,6 +1092,7 @@ receive(
 	if(i_require_authentication(peer, restrict_mask) ||
 	    /* He wants authentication */
 	    rbufp->keyid_present) {
+		STAGE_BEGIN();
 		auth = authlookup(rbufp->keyid, true);
 		if (0) msyslog(LOG_INFO, "DEBUG: receive: key %u %s%s, length %d, %s",
 		    rbufp->keyid,
@@ -802,6 +1118,7 @@ receive(
 				 (int)(rbufp->recv_length - (rbufp->mac_len + 4)),
 				 (int)(rbufp->mac_len + 4))) {
 
+			STAGE_END(STAGE_AUTH);
 			stat_proto_total.sys_badauth++;
 			if(peer != NULL) {
 				peer->badauth++;
@@ -810,20 +1127,29 @@ receive(
 			}
 			return;
 		}
+		STAGE_END(STAGE_AUTH);
 	}
 
 	switch (mode) {
 	    case MODE_CLIENT:  /* Request for us as a server. */
-		if (rbufp->extens_present
+		if (rbufp->extens_present) {
+			bool extens_ok = false;
+
+			STAGE_BEGIN();
 #ifndef DISABLE_NTS
-		    && !extens_server_recv(&rbufp->ntspacket,
-			  rbufp->recv_buffer, rbufp->recv_length)
+			extens_ok = NULL != rbufp->ntspacket
+			    && extens_server_recv(rbufp->ntspacket,
+				  rbufp->recv_buffer, rbufp->recv_length);
 #endif
-) {
-			stat_proto_total.sys_declined++;
-			maybe_log_junk("EX-REQ", rbufp);
-			break;
+			STAGE_END(STAGE_EXTENS);
+			if (!extens_ok) {
+				stat_proto_total.sys_declined++;
+				maybe_log_junk("EX-REQ", rbufp);
+				break;
+			}
 		}
+		if (restrict_mask & RES_KOD)
+			stat_proto_total.sys_kodsent++;
 		fast_xmit(rbufp, auth, restrict_mask);
 		stat_proto_total.sys_processed++;
 		break;
@@ -858,6 +1184,97 @@ receive(
 
 }
 
+/*
+ * is_simple_request - true for a bare 48-byte client request, the
+ * only kind the server worker threads answer on their own.
+ * Everything else has to go through receive().
+ */
+bool
+is_simple_request(
+	struct recvbuf const *rbufp
+	)
+{
+	return rbufp->recv_length == LEN_PKT_NOMAC &&
+	    PKT_MODE(rbufp->recv_buffer[0]) == MODE_CLIENT &&
+	    PKT_VERSION(rbufp->recv_buffer[0]) > NTPv1 &&
+	    PKT_VERSION(rbufp->recv_buffer[0]) <= NTP_VERSION;
+}
+
+/*
+ * receive_simple - the part of receive() that answers a packet that
+ * passed is_simple_request(), on the main thread or a server worker
+ * thread.  Does the same screening and bookkeeping, counting in
+ * stats, or in the totals if that is NULL.  Only the main thread's
+ * packets are timed.  Returns true if the request should be
+ * answered; the restrict mask is handed back so the caller can build
+ * and send the reply.
+ */
+bool
+receive_simple(
+	struct recvbuf *rbufp,
+	int *flags,
+	struct statistics_counters *stats
+	)
+{
+	volatile struct statistics_counters *sc = stats;
+	unsigned short restrict_mask;
+	uint8_t hisversion;
+	bool timed = false;
+
+	if (NULL == sc) {
+		sc = &stat_proto_total;
+		timed = stage_timing;
+	}
+	sc->sys_received++;
+
+	restrict_mask = timed_restrictions(rbufp, timed);
+	if (check_early_restrictions(rbufp, restrict_mask)) {
+		sc->sys_restricted++;
+		return false;
+	}
+
+	restrict_mask = timed_monitor(rbufp, restrict_mask, timed);
+	if (restrict_mask & RES_LIMITED) {
+		sc->sys_limitrejected++;
+		if (!(restrict_mask & RES_KOD))
+			return false;
+	}
+
+	hisversion = PKT_VERSION(rbufp->recv_buffer[0]);
+	if (hisversion == NTP_VERSION) {
+		sc->sys_newversion++;
+	} else if (!(restrict_mask & RES_VERSION)) {
+		sc->sys_oldversion++;
+	} else {
+		sc->sys_badlength++;
+		return false;
+	}
+
+	/*
+	 * fill_server_reply() works from the raw request, so skip
+	 * parse_packet().  A bare 48-byte packet always passes it.
+	 */
+	rbufp->keyid_present = false;
+	rbufp->extens_present = false;
+	if (NULL != rbufp->ntspacket)
+		rbufp->ntspacket->valid = false;
+
+	/* No MAC here, so anything demanding one fails */
+	if (i_require_authentication(NULL, restrict_mask)) {
+		sc->sys_badauth++;
+		return false;
+	}
+#ifdef ENABLE_MSSNTP
+	restrict_mask &= ~RES_MSSNTP;
+#endif /* ENABLE_MSSNTP */
+
+	if (restrict_mask & RES_KOD)
+		sc->sys_kodsent++;
+	sc->sys_processed++;
+	*flags = restrict_mask;
+	return true;
+}
+
 /*
  * transmit - transmit procedure called by poll timeout
  */
@@ -1180,6 +1597,7 @@ clock_update(
 	default:
 		break;
 	}
+	publish_server_state();
 }
 
 
@@ -1574,6 +1992,7 @@ clock_select(void)
 		set_sys_leap(LEAP_NOTINSYNC);
 		sys_vars.sys_stratum = STRATUM_UNSPEC;
 		memcpy(&sys_vars.sys_refid, "DOWN", REFIDLEN);
+		publish_server_state();
 	}
 
 	/*
@@ -2227,7 +2646,10 @@ peer_xmit(
 		sendlen += authencrypt(auth, (uint32_t *)&xpkt, sendlen);
 	}
 
-	sendpkt(&peer->srcadr, peer->dstadr, &xpkt, sendlen);
+	/* read_txstamps() fills in org_tx once the kernel reports it */
+	peer->org_tx = 0;
+	sendpkt_timed(&peer->srcadr, peer->dstadr, &xpkt, sendlen,
+		      &peer->org_ts, peer->associd);
 
 	peer->sent++;
         peer->outcount++;
@@ -2241,136 +2663,108 @@ peer_xmit(
 }
 
 
-#ifdef ENABLE_LEAP_SMEAR
-
-static void
-leap_smear_add_offs(l_fp *t) {
-	*t += leap_smear.offset;
-}
-
-#endif	/* ENABLE_LEAP_SMEAR */
-
 /*
- * fast_xmit - Send packet for nonpersistent association. Note that
- * neither the source or destination can be a broadcast address.
+ * fill_server_reply - build the 48-byte header of the reply to a
+ * client request from a copy of the server state.  Safe to call
+ * from any thread.  Returns the local time put in the
+ * transmit timestamp, before any smear, or 0 for a KoD.
  */
-static void
-fast_xmit(
-	struct recvbuf *rbufp,	/* receive packet pointer */
-	auth_info *auth,	/* !NULL for authentication */
-	int	flags		/* restrict mask */
+l_fp
+fill_server_reply(
+	struct recvbuf const *rbufp,	/* receive packet pointer */
+	struct server_state const *state,
+	int	flags,			/* restrict mask */
+	struct pkt *xpkt		/* reply to fill in */
 	)
 {
-	struct pkt xpkt;	/* transmit packet structure */
+	uint8_t const *req = rbufp->recv_buffer;
 	l_fp	xmt_tx;
-	struct timespec	start, finish;
-	size_t	sendlen;
 
 	/*
-	 * Initialize transmit packet header fields from the receive
-	 * buffer provided. We leave the fields intact as received, but
-	 * set the peer poll at the maximum of the receive peer poll and
-	 * the system minimum poll (ntp_minpoll). This is for KoD rate
-	 * control and not strictly specification compliant, but doesn't
-	 * break anything.
+	 * Everything comes straight from the raw request, so the
+	 * request needn't have been through parse_packet().  The
+	 * version is copied from the request.  We set the peer poll at
+	 * the maximum of the receive peer poll and the system minimum
+	 * poll (ntp_minpoll). This is for KoD rate control and not
+	 * strictly specification compliant, but doesn't break anything.
 	 */
 
 	/*
 	 * If this is a kiss-o'-death (KoD) packet, show leap
 	 * unsynchronized, stratum zero, reference ID the four-character
-	 * kiss code and system root delay. Note we don't reveal the
-	 * local time, so these packets can't be used for
+	 * kiss code and echo the rest of the request.  Note we don't
+	 * reveal the local time, so these packets can't be used for
 	 * synchronization.
 	 */
 	if (flags & RES_KOD) {
-		stat_proto_total.sys_kodsent++;
-		xpkt.li_vn_mode = PKT_LI_VN_MODE(LEAP_NOTINSYNC,
-		    PKT_VERSION(rbufp->pkt.li_vn_mode), MODE_SERVER);
-		xpkt.stratum = STRATUM_PKT_UNSPEC;
-		xpkt.ppoll = max(rbufp->pkt.ppoll, rstrct.ntp_minpoll);
-		xpkt.precision = rbufp->pkt.precision;
-		memcpy(&xpkt.refid, "RATE", REFIDLEN);
-		xpkt.rootdelay = htonl(rbufp->pkt.rootdelay);
-		xpkt.rootdisp = htonl(rbufp->pkt.rootdisp);
-		xpkt.reftime.l_ui = htonl(rbufp->pkt.reftime >> 32);
-		xpkt.reftime.l_uf = htonl(rbufp->pkt.reftime & 0xFFFFFFFF);
-		xpkt.org.l_ui = htonl(rbufp->pkt.xmt >> 32);
-		xpkt.org.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
-		xpkt.rec.l_ui = htonl(rbufp->pkt.xmt >> 32);
-		xpkt.rec.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
-		xpkt.xmt.l_ui = htonl(rbufp->pkt.xmt >> 32);
-		xpkt.xmt.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
+		memcpy(xpkt, req, LEN_REPLY_PREFIX);
+		xpkt->li_vn_mode = PKT_LI_VN_MODE(LEAP_NOTINSYNC,
+		    PKT_VERSION(req[0]), MODE_SERVER);
+		xpkt->stratum = STRATUM_PKT_UNSPEC;
+		xpkt->ppoll = max(req[2], rstrct.ntp_minpoll);
+		memcpy(&xpkt->refid, "RATE", REFIDLEN);
+		memcpy(&xpkt->org, req + 40, sizeof(xpkt->org));
+		xpkt->rec = xpkt->org;
+		xpkt->xmt = xpkt->org;
+		return 0;
+	}
 
 	/*
-	 * This is a normal packet. Use the system variables.
+	 * This is a normal packet.  The published prefix has the
+	 * system variables in wire format; patch in the version and
+	 * poll, and copy the client's transmit time as it came.
+	 *
+	 * Note: This returns the same data for all versions.
+	 * Currently, the mode is always Server.
+	 * There are minor differences between v3 and v4.
+	 * So far, nobody cares.
+	 * Note: There is significant NTPv1 traffic.  See #707
 	 */
-	} else {
-#ifdef ENABLE_LEAP_SMEAR
-		/*
-		 * Make copies of the variables which can be affected by smearing.
-		 */
-		l_fp this_ref_time;
-		l_fp this_recv_time;
-#endif
-
-		/*
-		 * If we are inside the leap smear interval we add the
-		 * current smear offset to the packet receive time, to
-		 * the packet transmit time, and eventually to the
-		 * reftime to make sure the reftime isn't later than
-		 * the transmit/receive times.
-		 */
-		/* Note: This returns the same data for all versions.
-		 * Currently, the mode is always Server.
-		 * The version is copied from the request.
-		 * There are minor differences between v3 and v4.
-		 * So far, nobody cares.
-		 * Note: There is significant NTPv1 traffic.  See #707
-		 */
-		xpkt.li_vn_mode = PKT_LI_VN_MODE(xmt_leap,
-		    PKT_VERSION(rbufp->pkt.li_vn_mode), MODE_SERVER);
-		xpkt.stratum = STRATUM_TO_PKT(sys_vars.sys_stratum);
-		xpkt.ppoll = max(rbufp->pkt.ppoll, rstrct.ntp_minpoll);
-		xpkt.precision = sys_vars.sys_precision;
-		xpkt.refid = sys_vars.sys_refid;
-		xpkt.rootdelay = HTONS_FP(DTOUFP(sys_vars.sys_rootdelay));
-		xpkt.rootdisp = HTONS_FP(DTOUFP(sys_vars.sys_rootdisp));
+	memcpy(xpkt, state->prefix, LEN_REPLY_PREFIX);
+	xpkt->li_vn_mode |= PKT_LI_VN_MODE(0, PKT_VERSION(req[0]), 0);
+	xpkt->ppoll = max(req[2], rstrct.ntp_minpoll);
+	memcpy(&xpkt->org, req + 40, sizeof(xpkt->org));
 
+	/*
+	 * If we are inside the leap smear interval we add the
+	 * current smear offset to the packet receive time and to
+	 * the packet transmit time.  The published reftime and refid
+	 * already have it.
+	 */
+	get_systime(&xmt_tx);
 #ifdef ENABLE_LEAP_SMEAR
-		this_ref_time = sys_vars.sys_reftime;
-		if (leap_smear.in_progress) {
-			leap_smear_add_offs(&this_ref_time);
-			xpkt.refid = convertLFPToRefID(leap_smear.offset);
-			DPRINT(2, ("fast_xmit: leap_smear.in_progress: refid %8x, smear %s\n",
-				ntohl(xpkt.refid),
-				lfptoa(leap_smear.offset, 8)
-				));
-		}
-		xpkt.reftime = htonl_fp(this_ref_time);
-#else
-		xpkt.reftime = htonl_fp(sys_vars.sys_reftime);
+	if (state->smearing) {
+		xpkt->rec = htonl_fp(rbufp->recv_time + state->smear_offset);
+		xpkt->xmt = htonl_fp(xmt_tx + state->smear_offset);
+		return xmt_tx;
+	}
 #endif
+	xpkt->rec = htonl_fp(rbufp->recv_time);
+	xpkt->xmt = htonl_fp(xmt_tx);
+	return xmt_tx;
+}
 
-		xpkt.org.l_ui = htonl(rbufp->pkt.xmt >> 32);
-		xpkt.org.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
-
-#ifdef ENABLE_LEAP_SMEAR
-		this_recv_time = rbufp->recv_time;
-		if (leap_smear.in_progress)
-			leap_smear_add_offs(&this_recv_time);
-		xpkt.rec = htonl_fp(this_recv_time);
-#else
-		xpkt.rec = htonl_fp(rbufp->recv_time);
-#endif
 
-		get_systime(&xmt_tx);
-#ifdef ENABLE_LEAP_SMEAR
-		if (leap_smear.in_progress)
-			leap_smear_add_offs(&xmt_tx);
-#endif
-		xpkt.xmt = htonl_fp(xmt_tx);
-	}
+/*
+ * fast_xmit - Send packet for nonpersistent association. Note that
+ * neither the source or destination can be a broadcast address.
+ */
+static void
+fast_xmit(
+	struct recvbuf *rbufp,	/* receive packet pointer */
+	auth_info *auth,	/* !NULL for authentication */
+	int	flags		/* restrict mask */
+	)
+{
+	struct pkt xpkt;	/* transmit packet structure */
+	struct server_state state;
+	struct timespec	start, finish;
+	size_t	sendlen;
+	l_fp	xmt_tx;
 
+	STAGE_BEGIN();
+	read_server_state(&state);
+	xmt_tx = fill_server_reply(rbufp, &state, flags, &xpkt);
 
 #ifdef ENABLE_MSSNTP
 	if (flags & RES_MSSNTP) {
@@ -2387,9 +2781,9 @@ fast_xmit(
 	 */
 	sendlen = LEN_PKT_NOMAC;
 	clock_gettime(CLOCK_MONOTONIC, &start);
-	if (rbufp->ntspacket.valid) {
+	if (NULL != rbufp->ntspacket && rbufp->ntspacket->valid) {
 #ifndef DISABLE_NTS
-	  sendlen += extens_server_send(&rbufp->ntspacket, &xpkt);
+	  sendlen += extens_server_send(rbufp->ntspacket, &xpkt);
 #endif
         } else if (NULL != auth) {
 	  sendlen += (size_t)authencrypt(auth, (uint32_t *)&xpkt, (int)sendlen);
@@ -2402,7 +2796,12 @@ fast_xmit(
 	  maybe_log_junk("DDoS", rbufp);	/* needs a counter */
 	  return;
 	}
-	sendpkt(&rbufp->recv_srcadr, rbufp->dstadr, &xpkt, (int)sendlen);
+	STAGE_END(STAGE_REPLY);
+	/* with batched sends this only times the copy into the queue */
+	STAGE_BEGIN();
+	sendpkt_timed(&rbufp->recv_srcadr, rbufp->dstadr, &xpkt,
+		      (unsigned int)sendlen, (0 != xmt_tx) ? &xmt_tx : NULL, 0);
+	STAGE_END(STAGE_SEND);
 	clock_gettime(CLOCK_MONOTONIC, &finish);
 	sys_authdelay = tspec_intv_to_lfp(sub_tspec(finish, start));
 	/* Previous versions of this code had separate DPRINT-s so it
@@ -2727,6 +3126,7 @@ init_proto(const bool verbose)
 	clkstate.sys_jitter = 0;
 	UNUSED_ARG(verbose);
 	sys_vars.sys_precision = -30; /* ns */  // FIXME FUZZ
+	publish_server_state();
 	get_systime(&dummy);
 	sys_survivors = 0;
 	sys_stattime = current_time;
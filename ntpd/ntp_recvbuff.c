@@ -1,6 +1,8 @@
 #include "config.h"
 
+#include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "ntp_assert.h"
 #include "ntp_syslog.h"
@@ -8,16 +10,53 @@
 #include "ntp_lists.h"
 #include "recvbuff.h"
 
+#include <sys/mman.h>
+
 
 /*
  * Memory allocation.
+ *
+ * The recvbufs, the jumbo slots and the spill areas are fixed slots
+ * cut from an arena: one anonymous mapping of RX_ARENA_SIZE, aligned
+ * so it can be backed by a single huge page, and asked to be.  At the
+ * default sizes everything fits in the first arena; another is mapped
+ * only when a larger "extra recvbatch" runs it out.  Each call takes
+ * a run of slots of one kind, so the recvbufs that see all the
+ * traffic stay packed together, apart from the jumbo slots.
+ *
+ * A read does not borrow a jumbo slot up front.  The tail of each
+ * scattered read lands in one of RECV_BATCH_MAX spill areas, and only
+ * a datagram that reached it takes a jumbo slot when it is settled.
  */
+struct rx_jumbo {
+	uint8_t			data[RX_BUFF_SIZE];
+	struct ntspacket_t	nts;
+	struct rx_jumbo *	link;		/* next free */
+};
+
+#define	RX_ARENA_SIZE	(2 * 1024 * 1024)	/* a huge page on x86 */
+
+typedef struct rx_arena rx_arena;
+struct rx_arena {
+	rx_arena *	link;
+	size_t		size;		/* of the whole mapping */
+	size_t		used;		/* handed out, from the start */
+};
+
 static unsigned long free_recvbufs;	/* recvbufs on free_recv_list */
 static unsigned long total_recvbufs;	/* total recvbufs currently in use */
 static unsigned long lowater_adds;	/* # of times we have added memory */
 static unsigned long buffer_shortfall;	/* # of missed free receive buffers
 					   between replenishments */
 static recvbuf_t *		   free_recv_list;
+static unsigned long free_jumbos;	/* on free_jumbo_list */
+static unsigned long total_jumbos;
+static struct rx_jumbo *	   free_jumbo_list;
+static rx_arena *		   arenas;
+
+#define	RX_SPILL_SIZE	(RX_BUFF_SIZE - RX_SMALL_SIZE)
+static uint8_t *		   rx_spill;	/* RECV_BATCH_MAX areas */
+static unsigned int		   spill_next;
 
 #ifdef DEBUG
 static void uninit_recvbuff(void);
@@ -42,41 +81,112 @@ lowater_additions(void)
 	return lowater_adds;
 }
 
+unsigned long
+free_jumbo_buffs(void)
+{
+	return free_jumbos;
+}
+
 static inline void
 initialise_buffer(recvbuf_t *buff)
 {
 	ZERO(*buff);
+	buff->recv_buffer = buff->recv_space;
+}
+
+/*
+ * new_arena - map an arena of at least len octets, in whole
+ * RX_ARENA_SIZE units on an RX_ARENA_SIZE boundary
+ */
+static rx_arena *
+new_arena(
+	size_t len
+	)
+{
+	rx_arena *	arena;
+	uintptr_t	start;
+	uintptr_t	aligned;
+	size_t		lead;
+	char *		p;
+
+	len = (len + RX_ARENA_SIZE - 1) & ~(size_t)(RX_ARENA_SIZE - 1);
+	/* map one unit extra, then trim to the boundary */
+	p = mmap(NULL, len + RX_ARENA_SIZE, PROT_READ | PROT_WRITE,
+		 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED == p) {
+		msyslog(LOG_ERR, "ERR: recvbuf arena of %zu bytes: %s",
+			len, strerror(errno));
+		exit(1);
+	}
+	start = (uintptr_t)p;
+	aligned = (start + RX_ARENA_SIZE - 1) &
+		  ~(uintptr_t)(RX_ARENA_SIZE - 1);
+	lead = (size_t)(aligned - start);
+	if (lead > 0)
+		munmap(p, lead);
+	munmap(p + lead + len, RX_ARENA_SIZE - lead);
+	p += lead;
+#ifdef MADV_HUGEPAGE
+	(void)madvise(p, len, MADV_HUGEPAGE);
+#endif
+	arena = (rx_arena *)p;
+	arena->size = len;
+	arena->used = (sizeof(*arena) + 63) & ~(size_t)63;
+	LINK_SLIST(arenas, arena, link);
+	return arena;
+}
+
+/*
+ * arena_slots - room for count slots of size octets each, from the
+ * newest arena if it has it, and return the first slot
+ */
+static void *
+arena_slots(
+	size_t count,
+	size_t size
+	)
+{
+	rx_arena *	arena = arenas;
+	size_t		len = (count * size + 63) & ~(size_t)63;
+	void *		p;
+
+	if (NULL == arena || arena->size - arena->used < len)
+		arena = new_arena(((sizeof(*arena) + 63) & ~(size_t)63) +
+				  len);
+	p = (char *)arena + arena->used;
+	arena->used += len;
+	return p;
 }
 
 static void
 create_buffers(unsigned int nbufs)
 {
 	recvbuf_t *bufp;
-	unsigned int i, abuf;
+	struct rx_jumbo *jumbo;
+	unsigned int i, abuf, ajumbo;
 
 	abuf = nbufs + buffer_shortfall;
 	buffer_shortfall = 0;
 
-#ifndef DEBUG
-	bufp = emalloc_zero(abuf * sizeof(*bufp));
-#endif
-
+	bufp = arena_slots(abuf, sizeof(*bufp));
 	for (i = 0; i < abuf; i++) {
-#ifdef DEBUG
-		/*
-		 * Allocate each buffer individually so they can be
-		 * free()d during ntpd shutdown on DEBUG builds to
-		 * keep them out of heap leak reports.
-		 */
-		bufp = emalloc_zero(sizeof(*bufp));
-#endif
 		LINK_SLIST(free_recv_list, bufp, link);
 		bufp++;
 		free_recvbufs++;
 		total_recvbufs++;
 	}
+
+	ajumbo = (unsigned int)min(abuf, RECV_JUMBO_MAX - total_jumbos);
+	if (ajumbo > 0) {
+		jumbo = arena_slots(ajumbo, sizeof(*jumbo));
+		for (i = 0; i < ajumbo; i++) {
+			LINK_SLIST(free_jumbo_list, jumbo, link);
+			jumbo++;
+			free_jumbos++;
+			total_jumbos++;
+		}
+	}
 	lowater_adds++;
-	/* coverity[leaked_storage] */
 }
 
 void
@@ -89,6 +199,8 @@ init_recvbuff(unsigned int nbufs)
 	free_recvbufs = total_recvbufs = lowater_adds = 0;
 
 	create_buffers(nbufs);
+	if (NULL == rx_spill)
+		rx_spill = arena_slots(RECV_BATCH_MAX, RX_SPILL_SIZE);
 
 #ifdef DEBUG
 	atexit(&uninit_recvbuff);
@@ -96,22 +208,67 @@ init_recvbuff(unsigned int nbufs)
 }
 
 
+/*
+ * expand_recvbuff - make sure at least nbufs buffers exist, so that
+ * a batched read can fill a whole vector without running dry.
+ */
+void
+expand_recvbuff(unsigned int nbufs)
+{
+	if (total_recvbufs < nbufs)
+		create_buffers((unsigned int)(nbufs - total_recvbufs));
+}
+
+
 #ifdef DEBUG
 static void
 uninit_recvbuff(void)
 {
-	recvbuf_t *rbunlinked;
+	rx_arena *arena;
 
-	for (;;) {
-		UNLINK_HEAD_SLIST(rbunlinked, free_recv_list, link);
-		if (rbunlinked == NULL)
-			break;
-		free(rbunlinked);
+	/* unmap the arenas to keep them out of heap leak reports */
+	while (NULL != (arena = arenas)) {
+		arenas = arena->link;
+		munmap(arena, arena->size);
 	}
+	free_recv_list = NULL;
+	free_jumbo_list = NULL;
+	rx_spill = NULL;
 }
 #endif	/* DEBUG */
 
 
+/*
+ * attach_jumbo - give a buffer a jumbo slot, false if none are free
+ */
+static bool
+attach_jumbo(
+	recvbuf_t *	rb
+	)
+{
+	struct rx_jumbo *jumbo;
+
+	UNLINK_HEAD_SLIST(jumbo, free_jumbo_list, link);
+	if (NULL == jumbo)
+		return false;
+	free_jumbos--;
+	rb->jumbo = jumbo;
+	return true;
+}
+
+static void
+release_jumbo(
+	recvbuf_t *	rb
+	)
+{
+	LINK_SLIST(free_jumbo_list, rb->jumbo, link);
+	free_jumbos++;
+	rb->jumbo = NULL;
+	rb->ntspacket = NULL;
+	rb->recv_buffer = rb->recv_space;
+}
+
+
 recvbuf_t *
 get_free_recv_buffer(void)
 {
@@ -121,6 +278,13 @@ get_free_recv_buffer(void)
         if (buffer != NULL) {
                 free_recvbufs--;
                 initialise_buffer(buffer);
+                if (!attach_jumbo(buffer)) {
+                        freerecvbuf(buffer);
+                        buffer_shortfall++;
+                        return NULL;
+                }
+                buffer->recv_buffer = buffer->jumbo->data;
+                buffer->ntspacket = &buffer->jumbo->nts;
         } else {
                 buffer_shortfall++;
         }
@@ -128,6 +292,76 @@ get_free_recv_buffer(void)
         return buffer;
 }
 
+
+/*
+ * get_free_recv_buffer_iov - a buffer set up for a scattered read
+ *
+ * The spill areas are handed out in turn, so no more than
+ * RECV_BATCH_MAX buffers may be waiting on recvbuf_settle() at once.
+ */
+recvbuf_t *
+get_free_recv_buffer_iov(
+	struct iovec *	iov
+	)
+{
+	recvbuf_t *buffer;
+
+	UNLINK_HEAD_SLIST(buffer, free_recv_list, link);
+	if (NULL == buffer) {
+		buffer_shortfall++;
+		return NULL;
+	}
+	free_recvbufs--;
+	initialise_buffer(buffer);
+
+	iov[0].iov_base = buffer->recv_space;
+	iov[0].iov_len = sizeof(buffer->recv_space);
+	iov[1].iov_base = rx_spill + spill_next * RX_SPILL_SIZE;
+	iov[1].iov_len = RX_SPILL_SIZE;
+	spill_next = (spill_next + 1) % RECV_BATCH_MAX;
+	return buffer;
+}
+
+
+/*
+ * recvbuf_settle - after a scattered read of length octets through
+ * iov, move a datagram that spilled past the buffer into a jumbo
+ * slot.  False, and the buffer should be dropped, if none is free.
+ */
+bool
+recvbuf_settle(
+	recvbuf_t *		rb,
+	const struct iovec *	iov,
+	size_t			length
+	)
+{
+	if (length <= iov[0].iov_len)
+		return true;
+	if (!attach_jumbo(rb)) {
+		buffer_shortfall++;
+		return false;
+	}
+	memcpy(rb->jumbo->data, rb->recv_space, sizeof(rb->recv_space));
+	memcpy(rb->jumbo->data + sizeof(rb->recv_space), iov[1].iov_base,
+	       min(length, RX_BUFF_SIZE) - sizeof(rb->recv_space));
+	rb->recv_buffer = rb->jumbo->data;
+	rb->ntspacket = &rb->jumbo->nts;
+	return true;
+}
+
+
+recvbuf_t *
+new_private_recv_buffer(void)
+{
+	recvbuf_t *rb;
+
+	rb = emalloc_zero(sizeof(*rb));
+	rb->jumbo = emalloc_zero(sizeof(*rb->jumbo));
+	rb->recv_buffer = rb->jumbo->data;
+	rb->ntspacket = &rb->jumbo->nts;
+	return rb;
+}
+
 /*
  * freerecvbuf - make a single recvbuf available for reuse
  */
@@ -139,6 +373,8 @@ freerecvbuf(recvbuf_t *rb)
 		return;
 	}
 
+	if (rb->jumbo != NULL)
+		release_jumbo(rb);
 	LINK_SLIST(free_recv_list, rb, link);
 	free_recvbufs++;
 }
@@ -6,6 +6,8 @@
 
 #include <stdio.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include "ntp_barrier.h"
 
 #include "ntpd.h"
 #include "ntp_lists.h"
@@ -35,6 +37,33 @@
  * to keep a misbehaving host or two from abusing your primary clock. It
  * has been expanded, however, to suit the needs of those with more
  * restrictive access policies.
+ *
+ * With tens of thousands of entries the list walk got too slow for
+ * the receive path, so lookups now go through a path-compressed
+ * binary (Patricia) trie per address family.  For a mask made of
+ * leading ones, the first matching entry on the sorted list is the
+ * one with the longest prefix, so a longest-prefix match gives the
+ * same answer.  Entries with the same address and mask hang off one
+ * trie node in list order, which keeps RESM_NTPONLY working.  The
+ * sorted lists are still kept for enumeration, and for lookups while
+ * any entry has a mask the trie can't represent.
+ *
+ * Entries from the restrict file don't go on those lists.  They live
+ * in a table of their own, built to one side on each load and put in
+ * place with a single pointer store, so a lookup sees either the old
+ * set or the new one, never a mix.  A lookup checks both and takes
+ * whichever entry would come first on one merged list.
+ *
+ * Server worker threads look up restrictions without a lock, while
+ * the main thread changes them.  Changes are made so a lookup finds
+ * either the old state or the new one: a node or entry is filled in
+ * before the store that links it, and whatever is unlinked stays
+ * intact until no lookup can still be in it.  Each worker marks
+ * itself online while it handles packets (restrict_online()) and
+ * offline while it waits (restrict_offline()).  Unlinked memory goes
+ * into limbo and is freed once every worker has been offline since,
+ * checked along with the restrict file.  Without workers it is freed
+ * at once.
  */
 /*
  * We will use two lists, one for IPv4 addresses and one for IPv6
@@ -50,6 +79,46 @@
 		}							\
 	} while (0)
 
+/*
+ * A trie node covers the addresses that match the first plen bits of
+ * key.  Nodes without entries only join two subtries.
+ */
+#define	RES_KEYLEN	16		/* bytes, enough for IPv6 */
+
+typedef struct res_node_tag res_node;
+struct res_node_tag {
+	res_node *	child[2];	/* by the bit after the prefix */
+	restrict_u *	entries;	/* this prefix, in list order */
+	unsigned int	plen;		/* prefix length in bits */
+	uint8_t		key[RES_KEYLEN];	/* network order */
+};
+
+/*
+ * A restrict file load: a trie and a sorted list per address family
+ * (IPv4, IPv6), all entries with a leading-ones mask.
+ */
+typedef struct res_table_tag res_table;
+struct res_table_tag {
+	res_node *	trie[2];
+	restrict_u *	list[2];
+	restrict_u *	entries[2];	/* the arrays under the lists */
+	int		count;
+	int		limited;	/* entries with RES_LIMITED */
+};
+
+/* memory unlinked while lookups may still be in it */
+typedef struct res_limbo_tag res_limbo;
+struct res_limbo_tag {
+	res_limbo *	link;
+	void *		mem;
+	int		kind;		/* LIMBO_* */
+};
+
+#define	LIMBO_NODE	0		/* a res_node */
+#define	LIMBO_RES4	1		/* an IPv4 restrict_u */
+#define	LIMBO_RES6	2		/* an IPv6 restrict_u */
+#define	LIMBO_TABLE	3		/* a restrict file res_table */
+
 /*
  * We allocate INC_RESLIST{4|6} entries to the free list whenever empty.
  * Auto-tune these to be just less than 1KB (leaving at least 16 bytes
@@ -81,9 +150,15 @@ static int restrictcount;	/* count in the restrict lists */
 static restrict_u *resfree4;	/* available entries (free list) */
 static restrict_u *resfree6;
 
-static unsigned long res_calls;
-static unsigned long res_found;
-static unsigned long res_not_found;
+/*
+ * The lookup tries, and how many entries each family has with a mask
+ * that isn't all leading ones.  While there are any, lookups in that
+ * family walk the list as they used to.
+ */
+static res_node *	restrict_trie4;
+static res_node *	restrict_trie6;
+static int		res_oddmasks4;
+static int		res_oddmasks6;
 
 /*
  * Count number of restriction entries referring to RES_LIMITED, to
@@ -104,6 +179,52 @@ static	bool		restrict_source_enabled = false;
 static	unsigned short	restrict_source_flags;
 static	unsigned short	restrict_source_mflags;
 
+/*
+ * "restrict file ..." name, last seen status, and the bits added to
+ * every entry loaded from it.
+ */
+static	char *		restrict_file_name;
+static	struct stat	restrict_file_stat;
+static	unsigned short	restrict_file_flags;
+static	unsigned short	restrict_file_mflags;
+
+/* the table lookups use */
+static	res_table * volatile	restrict_file_table;
+
+#define	RESFILE_MAXLINE	256
+#define	RESFILE_MAXBAD	5	/* complaints per load */
+
+/*
+ * The lookup threads besides the main one.  A reader's count is odd
+ * while it is online.  limbo_wait is freed once every reader odd in
+ * limbo_seen has moved on from it.
+ */
+static	unsigned int		res_readers;
+static	volatile unsigned long *res_reader_count;
+static	unsigned long *		limbo_seen;
+static	res_limbo *		limbo_new;	/* unlinked since the snapshot */
+static	res_limbo *		limbo_wait;	/* unlinked before it */
+
+/* flag keywords allowed in a restrict file, as in ntp.conf */
+static const struct {
+	const char *	name;
+	unsigned short	flag;
+	bool		mflag;	/* a match flag */
+} restrict_file_keys[] = {
+	{ "flake",	RES_FLAKE,	false },
+	{ "ignore",	RES_IGNORE,	false },
+	{ "kod",	RES_KOD,	false },
+	{ "limited",	RES_LIMITED,	false },
+	{ "mssntp",	RES_MSSNTP,	false },
+	{ "nomodify",	RES_NOMODIFY,	false },
+	{ "nomrulist",	RES_NOMRULIST,	false },
+	{ "noquery",	RES_NOQUERY,	false },
+	{ "noserve",	RES_NOSERVE,	false },
+	{ "notrust",	RES_NOTRUST,	false },
+	{ "ntpport",	RESM_NTPONLY,	true },
+	{ "version",	RES_VERSION,	false },
+};
+
 /*
  * private functions
  */
@@ -118,6 +239,29 @@ static restrict_u *	match_restrict6_addr(const struct in6_addr *,
 static restrict_u *	match_restrict_entry(const restrict_u *, int);
 static int		res_sorts_before4(restrict_u *, restrict_u *);
 static int		res_sorts_before6(restrict_u *, restrict_u *);
+static int		res_key		(const restrict_u *, bool,
+					 uint8_t *);
+static bool		key_match	(const uint8_t *, const uint8_t *,
+					 unsigned int);
+static void		trie_free	(res_node *);
+static void		trie_insert	(res_node **, restrict_u *, bool);
+static void		trie_remove	(res_node **, restrict_u *, bool);
+static restrict_u *	trie_lookup	(const res_node *, const uint8_t *,
+					 unsigned int, unsigned short);
+static restrict_u *	trie_exact	(const res_node *, const uint8_t *,
+					 unsigned int, unsigned short);
+static int		parse_restrict_line(char *, restrict_u *, bool *);
+static int		res_cmp4	(const void *, const void *);
+static int		res_cmp6	(const void *, const void *);
+static restrict_u *	prefer_file_entry(restrict_u *, const uint8_t *,
+					  unsigned int, unsigned short, bool);
+static res_table *	build_file_table(restrict_u **, size_t *);
+static void		publish_file_table(res_table *);
+static void		free_file_table(res_table *);
+static void		res_retire(void *, int);
+static void		res_reap(void);
+static bool		load_restrict_file(void);
+
 
 
 /*
@@ -155,10 +299,17 @@ init_restrict(void)
 	 *
 	 */
 
+	trie_free(restrict_trie4);
+	trie_free(restrict_trie6);
+	restrict_trie4 = restrict_trie6 = NULL;
+	res_oddmasks4 = res_oddmasks6 = 0;
+
 	LINK_SLIST(rstrct.restrictlist4, &restrict_def4, link);
 	LINK_SLIST(rstrct.restrictlist6, &restrict_def6, link);
 	restrict_def4.flags = RES_Default;
 	restrict_def6.flags = RES_Default;
+	trie_insert(&restrict_trie4, &restrict_def4, false);
+	trie_insert(&restrict_trie6, &restrict_def6, true);
 	if (RES_Default & RES_LIMITED) {
 		inc_res_limited();  /* IPv4 */
 		inc_res_limited();  /* IPv6 */
@@ -230,21 +381,17 @@ free_res(
 	if (RES_LIMITED & res->flags)
 		dec_res_limited();
 
-	if (v6)
+	if (v6) {
 		plisthead = &rstrct.restrictlist6;
-	else
+		trie_remove(&restrict_trie6, res, true);
+	} else {
 		plisthead = &rstrct.restrictlist4;
+		trie_remove(&restrict_trie4, res, false);
+	}
 	UNLINK_SLIST(unlinked, *plisthead, res, link, restrict_u);
 	INSIST(unlinked == res);
 
-	if (v6) {
-		memset(res, '\0', V6_SIZEOF_RESTRICT_U);
-		plisthead = &resfree6;
-	} else {
-		memset(res, '\0', V4_SIZEOF_RESTRICT_U);
-		plisthead = &resfree4;
-	}
-	LINK_SLIST(*plisthead, res, link);
+	res_retire(res, v6 ? LIMBO_RES6 : LIMBO_RES4);
 }
 
 
@@ -274,15 +421,23 @@ match_restrict4_addr(
 {
 	restrict_u *	res;
 	restrict_u *	next;
+	uint8_t		key[RES_KEYLEN];
+	uint32_t	naddr = htonl(addr);
 
-	for (res = rstrct.restrictlist4; res != NULL; res = next) {
-		next = res->link;
-		if (res->u.v4.addr == (addr & res->u.v4.mask)
-		    && (!(RESM_NTPONLY & res->mflags)
-			|| NTP_PORT == port))
-			break;
+	memcpy(key, &naddr, sizeof(naddr));
+	if (0 == res_oddmasks4) {
+		res = trie_lookup(restrict_trie4, key, 32, port);
+	} else {
+		for (res = rstrct.restrictlist4; res != NULL; res = next) {
+			next = res->link;
+			if (res->u.v4.addr == (addr & res->u.v4.mask)
+			    && (!(RESM_NTPONLY & res->mflags)
+				|| NTP_PORT == port))
+				break;
+		}
 	}
-	return res;
+	INSIST(NULL != res);	/* the default entry always matches */
+	return prefer_file_entry(res, key, 32, port, false);
 }
 
 
@@ -296,15 +451,46 @@ match_restrict6_addr(
 	restrict_u *	next;
 	struct in6_addr	masked;
 
-	for (res = rstrct.restrictlist6; res != NULL; res = next) {
-		next = res->link;
-		INSIST(next != res);
-		MASK_IPV6_ADDR(&masked, addr, &res->u.v6.mask);
-		if (ADDR6_EQ(&masked, &res->u.v6.addr)
-		    && (!(RESM_NTPONLY & res->mflags)
-			|| NTP_PORT == (int)port))
-			break;
+	if (0 == res_oddmasks6) {
+		res = trie_lookup(restrict_trie6, addr->s6_addr, 128, port);
+	} else {
+		for (res = rstrct.restrictlist6; res != NULL; res = next) {
+			next = res->link;
+			INSIST(next != res);
+			MASK_IPV6_ADDR(&masked, addr, &res->u.v6.mask);
+			if (ADDR6_EQ(&masked, &res->u.v6.addr)
+			    && (!(RESM_NTPONLY & res->mflags)
+				|| NTP_PORT == (int)port))
+				break;
+		}
 	}
+	INSIST(NULL != res);	/* the default entry always matches */
+	return prefer_file_entry(res, addr->s6_addr, 128, port, true);
+}
+
+
+/*
+ * prefer_file_entry - the restrict file's entry for a key in place
+ * of res, if it would come before res on one merged list
+ */
+static restrict_u *
+prefer_file_entry(
+	restrict_u *		res,
+	const uint8_t *		key,
+	unsigned int		bits,
+	unsigned short		port,
+	bool			v6
+	)
+{
+	res_table *	table = restrict_file_table;
+	restrict_u *	fres;
+
+	if (NULL == table)
+		return res;
+	fres = trie_lookup(table->trie[v6], key, bits, port);
+	if (NULL != fres &&
+	    (v6 ? res_sorts_before6(fres, res) : res_sorts_before4(fres, res)))
+		return fres;
 	return res;
 }
 
@@ -327,6 +513,13 @@ match_restrict_entry(
 	restrict_u *res;
 	restrict_u *rlist;
 	size_t cb;
+	uint8_t key[RES_KEYLEN];
+	int plen;
+
+	plen = res_key(pmatch, v6, key);
+	if (plen >= 0)
+		return trie_exact(v6 ? restrict_trie6 : restrict_trie4,
+				  key, (unsigned int)plen, pmatch->mflags);
 
 	if (v6) {
 		rlist = rstrct.restrictlist6;
@@ -413,6 +606,293 @@ res_sorts_before6(
 }
 
 
+/*
+ * res_key - get the address of an entry as a trie key.  Returns the
+ * prefix length, or -1 if the mask isn't all leading ones.
+ */
+static int
+res_key(
+	const restrict_u *	res,
+	bool			v6,
+	uint8_t *		key
+	)
+{
+	uint8_t		mask[RES_KEYLEN];
+	uint32_t	word;
+	size_t		len;
+	int		plen;
+	size_t		i;
+
+	if (v6) {
+		len = sizeof(res->u.v6.addr.s6_addr);
+		memcpy(key, res->u.v6.addr.s6_addr, len);
+		memcpy(mask, res->u.v6.mask.s6_addr, len);
+	} else {
+		len = sizeof(word);
+		word = htonl(res->u.v4.addr);
+		memcpy(key, &word, len);
+		word = htonl(res->u.v4.mask);
+		memcpy(mask, &word, len);
+	}
+
+	plen = 0;
+	for (i = 0; i < len && 0xff == mask[i]; i++)
+		plen += 8;
+	if (i < len) {
+		/* a partial byte must be leading ones, then all zeros */
+		if ((uint8_t)(mask[i] | (mask[i] - 1)) != 0xff)
+			return -1;
+		for (word = mask[i]; word & 0x80; word = (word << 1) & 0xff)
+			plen++;
+		for (i++; i < len; i++)
+			if (mask[i])
+				return -1;
+	}
+	return plen;
+}
+
+
+/*
+ * key_match - true if the first plen bits of two keys are equal
+ */
+static bool
+key_match(
+	const uint8_t *	a,
+	const uint8_t *	b,
+	unsigned int	plen
+	)
+{
+	unsigned int	bytes = plen / 8;
+	unsigned int	bits = plen % 8;
+
+	if (memcmp(a, b, bytes))
+		return false;
+	return 0 == bits ||
+	    0 == ((a[bytes] ^ b[bytes]) & (0xff00 >> bits));
+}
+
+#define	KEY_BIT(key, bit)	(((key)[(bit) / 8] >> (7 - (bit) % 8)) & 1)
+
+
+static void
+trie_free(
+	res_node *	node
+	)
+{
+	if (NULL == node)
+		return;
+	trie_free(node->child[0]);
+	trie_free(node->child[1]);
+	free(node);
+}
+
+
+static res_node *
+new_res_node(
+	const uint8_t *	key,
+	unsigned int	plen
+	)
+{
+	res_node *	node;
+
+	node = emalloc_zero(sizeof(*node));
+	memcpy(node->key, key, sizeof(node->key));
+	node->plen = plen;
+	return node;
+}
+
+
+/*
+ * trie_insert - add an entry with a trie-friendly mask to a trie, or
+ * just count it if the mask won't do.  Lookups may be running, so
+ * each node and the entry are complete before they are linked.
+ */
+static void
+trie_insert(
+	res_node **	proot,
+	restrict_u *	res,
+	bool		v6
+	)
+{
+	res_node **	pnode;
+	res_node *	node;
+	res_node *	fork;
+	restrict_u **	pres;
+	uint8_t		key[RES_KEYLEN];
+	unsigned int	plen;
+	unsigned int	common;
+	int		rc;
+
+	ZERO(key);
+	rc = res_key(res, v6, key);
+	if (rc < 0) {
+		if (v6)
+			res_oddmasks6++;
+		else
+			res_oddmasks4++;
+		return;
+	}
+	plen = (unsigned int)rc;
+
+	for (pnode = proot; NULL != (node = *pnode); ) {
+		/* how much of this node's prefix do we share? */
+		for (common = 0; common < min(node->plen, plen) &&
+		     KEY_BIT(key, common) == KEY_BIT(node->key, common);
+		     common++)
+			/* nothing */;
+
+		if (common == node->plen) {
+			if (plen == node->plen)
+				break;		/* found our node */
+			pnode = &node->child[KEY_BIT(key, node->plen)];
+			continue;
+		}
+
+		/* we part ways inside this node's prefix */
+		if (common == plen) {
+			fork = new_res_node(key, plen);
+			fork->child[KEY_BIT(node->key, plen)] = node;
+			node = fork;
+		} else {
+			fork = new_res_node(key, common);
+			fork->child[KEY_BIT(node->key, common)] = node;
+			node = new_res_node(key, plen);
+			fork->child[KEY_BIT(key, common)] = node;
+		}
+		memory_barrier();
+		*pnode = fork;
+		break;
+	}
+	if (NULL == node) {
+		node = new_res_node(key, plen);
+		memory_barrier();
+		*pnode = node;
+	}
+
+	/* same order as the list, RESM_NTPONLY first */
+	for (pres = &node->entries;
+	     NULL != *pres && (*pres)->mflags >= res->mflags;
+	     pres = &(*pres)->nlink)
+		/* nothing */;
+	res->nlink = *pres;
+	memory_barrier();
+	*pres = res;
+}
+
+
+/*
+ * trie_remove - take an entry out of a trie, dropping nodes that are
+ * no longer needed
+ */
+static void
+trie_remove(
+	res_node **	proot,
+	restrict_u *	res,
+	bool		v6
+	)
+{
+	res_node **	pnode;
+	res_node **	pparent;
+	res_node *	node;
+	restrict_u *	unlinked;
+	uint8_t		key[RES_KEYLEN];
+	int		rc;
+
+	ZERO(key);
+	rc = res_key(res, v6, key);
+	if (rc < 0) {
+		if (v6)
+			res_oddmasks6--;
+		else
+			res_oddmasks4--;
+		return;
+	}
+
+	pparent = NULL;
+	for (pnode = proot; NULL != (node = *pnode); ) {
+		if (node->plen >= (unsigned int)rc)
+			break;
+		pparent = pnode;
+		pnode = &node->child[KEY_BIT(key, node->plen)];
+	}
+	INSIST(NULL != node && node->plen == (unsigned int)rc);
+	UNLINK_SLIST(unlinked, node->entries, res, nlink, restrict_u);
+	INSIST(unlinked == res);
+	if (NULL != node->entries)
+		return;
+
+	/* prune the node, and its parent if that is now a bare fork */
+	while (NULL == node->entries) {
+		if (NULL != node->child[0] && NULL != node->child[1])
+			break;
+		*pnode = (NULL != node->child[0])
+			     ? node->child[0]
+			     : node->child[1];
+		res_retire(node, LIMBO_NODE);
+		if (NULL == pparent || NULL != *pnode)
+			break;
+		pnode = pparent;
+		pparent = NULL;
+		node = *pnode;
+	}
+}
+
+
+/*
+ * trie_lookup - find the entry for an address, as the list walk in
+ * match_restrict{4|6}_addr() would, or NULL if none matches
+ */
+static restrict_u *
+trie_lookup(
+	const res_node *	node,
+	const uint8_t *		key,
+	unsigned int		bits,
+	unsigned short		port
+	)
+{
+	restrict_u *	match = NULL;
+	restrict_u *	res;
+
+	while (NULL != node && key_match(key, node->key, node->plen)) {
+		for (res = node->entries; res != NULL; res = res->nlink)
+			if (!(RESM_NTPONLY & res->mflags) ||
+			    NTP_PORT == (int)port) {
+				match = res;
+				break;
+			}
+		if (node->plen >= bits)
+			break;
+		node = node->child[KEY_BIT(key, node->plen)];
+	}
+	return match;
+}
+
+
+/*
+ * trie_exact - find the entry with exactly this prefix and mflags
+ */
+static restrict_u *
+trie_exact(
+	const res_node *	node,
+	const uint8_t *		key,
+	unsigned int		plen,
+	unsigned short		mflags
+	)
+{
+	restrict_u *	res;
+
+	while (NULL != node && node->plen < plen)
+		node = node->child[KEY_BIT(key, node->plen)];
+	if (NULL == node || node->plen != plen ||
+	    !key_match(key, node->key, plen))
+		return NULL;
+	for (res = node->entries; res != NULL; res = res->nlink)
+		if (res->mflags == mflags)
+			return res;
+	return NULL;
+}
+
+
 /*
  * restrictions - return restrictions for this host
  */
@@ -425,7 +905,6 @@ restrictions(
 	struct in6_addr *pin6;
 	unsigned short flags;
 
-	res_calls++;
 	flags = 0;
 	/* IPv4 source address */
 	if (IS_IPV4(srcadr)) {
@@ -439,16 +918,8 @@ restrictions(
 
 		match = match_restrict4_addr(SRCADR(srcadr),
 					     SRCPORT(srcadr));
+		/* workers bump it too, it may miss the odd hit */
 		match->hitcount++;
-		/*
-		 * res_not_found counts only use of the final default
-		 * entry, not any "restrict default ntpport ...", which
-		 * would be just before the final default.
-		 */
-		if (&restrict_def4 == match)
-			res_not_found++;
-		else
-			res_found++;
 		flags = match->flags;
 	}
 
@@ -466,10 +937,6 @@ restrictions(
 
 		match = match_restrict6_addr(pin6, SRCPORT(srcadr));
 		match->hitcount++;
-		if (&restrict_def6 == match)
-			res_not_found++;
-		else
-			res_found++;
 		flags = match->flags;
 	}
 	return (flags);
@@ -557,12 +1024,16 @@ hack_restrict(
 				       V4_SIZEOF_RESTRICT_U);
 				plisthead = &rstrct.restrictlist4;
 			}
-			LINK_SORT_SLIST(
-				*plisthead, res,
-				(v6)
-				  ? res_sorts_before6(res, L_S_S_CUR())
-				  : res_sorts_before4(res, L_S_S_CUR()),
-				link, restrict_u);
+			/* complete before lookups can reach it */
+			while (NULL != *plisthead &&
+			       !(v6 ? res_sorts_before6(res, *plisthead)
+				    : res_sorts_before4(res, *plisthead)))
+				plisthead = &(*plisthead)->link;
+			res->link = *plisthead;
+			memory_barrier();
+			*plisthead = res;
+			trie_insert(v6 ? &restrict_trie6 : &restrict_trie4,
+				    res, v6);
 			restrictcount++;
 			if (RES_LIMITED & flags)
 				inc_res_limited();
@@ -712,3 +1183,500 @@ unrestrict_source(
 }
 
 
+/*
+ * parse_restrict_line - read "address[/prefixlen] [flag ...]" from a
+ * restrict file into an entry.  Returns 1 for an entry, 0 for a blank
+ * or comment line, -1 if the line is unusable.
+ */
+static int
+parse_restrict_line(
+	char *		line,
+	restrict_u *	res,
+	bool *		v6
+	)
+{
+	char *		tok;
+	char *		save;
+	char *		slash;
+	char *		end;
+	struct in_addr	a4;
+	long		plen;
+	int		i;
+	size_t		k;
+
+	line[strcspn(line, "#\r\n")] = '\0';
+	tok = strtok_r(line, " \t", &save);
+	if (NULL == tok)
+		return 0;
+
+	ZERO(*res);
+	plen = -1;
+	slash = strchr(tok, '/');
+	if (NULL != slash) {
+		*slash++ = '\0';
+		plen = strtol(slash, &end, 10);
+		if ('\0' == *slash || '\0' != *end || plen < 0)
+			return -1;
+	}
+	if (1 == inet_pton(AF_INET, tok, &a4)) {
+		*v6 = false;
+		if (plen > 32)
+			return -1;
+		if (plen < 0)
+			plen = 32;
+		res->u.v4.mask = (0 == plen) ? 0 : ~(uint32_t)0 << (32 - plen);
+		res->u.v4.addr = ntohl(a4.s_addr) & res->u.v4.mask;
+	} else if (1 == inet_pton(AF_INET6, tok, &res->u.v6.addr)) {
+		*v6 = true;
+		if (plen > 128)
+			return -1;
+		if (plen < 0)
+			plen = 128;
+		for (i = 0; i < 16; i++, plen -= 8)
+			res->u.v6.mask.s6_addr[i] = (plen >= 8)
+			    ? 0xff
+			    : (plen > 0) ? (uint8_t)(0xff00 >> plen) : 0;
+		MASK_IPV6_ADDR(&res->u.v6.addr, &res->u.v6.addr,
+			       &res->u.v6.mask);
+	} else {
+		return -1;
+	}
+
+	res->flags = restrict_file_flags;
+	res->mflags = restrict_file_mflags | RESM_FILE;
+	while (NULL != (tok = strtok_r(NULL, " \t", &save))) {
+		for (k = 0; k < COUNTOF(restrict_file_keys); k++)
+			if (!strcmp(tok, restrict_file_keys[k].name))
+				break;
+		if (k == COUNTOF(restrict_file_keys))
+			return -1;
+		if (restrict_file_keys[k].mflag)
+			res->mflags |= restrict_file_keys[k].flag;
+		else
+			res->flags |= restrict_file_keys[k].flag;
+	}
+	return 1;
+}
+
+
+/* qsort() into list order */
+static int
+res_cmp4(
+	const void *	a,
+	const void *	b
+	)
+{
+	restrict_u *	r1 = (restrict_u *)(uintptr_t)a;
+	restrict_u *	r2 = (restrict_u *)(uintptr_t)b;
+
+	if (res_sorts_before4(r1, r2))
+		return -1;
+	return res_sorts_before4(r2, r1);
+}
+
+
+static int
+res_cmp6(
+	const void *	a,
+	const void *	b
+	)
+{
+	restrict_u *	r1 = (restrict_u *)(uintptr_t)a;
+	restrict_u *	r2 = (restrict_u *)(uintptr_t)b;
+
+	if (res_sorts_before6(r1, r2))
+		return -1;
+	return res_sorts_before6(r2, r1);
+}
+
+
+/*
+ * build_file_table - make a lookup table of sorted entries from the
+ * restrict file, merging the flags of repeated prefixes
+ */
+static res_table *
+build_file_table(
+	restrict_u **	fresh,
+	size_t *	count
+	)
+{
+	res_table *	table;
+	restrict_u *	res;
+	restrict_u *	prev;
+	restrict_u **	pptail;
+	size_t		cb;
+	size_t		i;
+	int		v6;
+
+	table = emalloc_zero(sizeof(*table));
+	for (v6 = 0; v6 < 2; v6++) {
+		if (0 == count[v6])
+			continue;
+		cb = v6 ? V6_SIZEOF_RESTRICT_U : V4_SIZEOF_RESTRICT_U;
+		table->entries[v6] = emalloc_zero(count[v6] * sizeof(*res));
+		res = table->entries[v6];
+		pptail = &table->list[v6];
+		prev = NULL;
+		for (i = 0; i < count[v6]; i++) {
+			if (NULL != prev && prev->mflags == fresh[v6][i].mflags &&
+			    !memcmp(&prev->u, &fresh[v6][i].u,
+				    cb - offsetof(restrict_u, u))) {
+				/* repeated prefix, merge the flags */
+				if ((RES_LIMITED & fresh[v6][i].flags) &&
+				    !(RES_LIMITED & prev->flags))
+					table->limited++;
+				prev->flags |= fresh[v6][i].flags;
+				continue;
+			}
+			*res = fresh[v6][i];
+			*pptail = res;
+			pptail = &res->link;
+			trie_insert(&table->trie[v6], res, v6);
+			table->count++;
+			if (RES_LIMITED & res->flags)
+				table->limited++;
+			prev = res++;
+		}
+	}
+	return table;
+}
+
+
+/*
+ * publish_file_table - make a new restrict file table, or none, the
+ * one lookups use, and retire the old one
+ */
+static void
+publish_file_table(
+	res_table *	table
+	)
+{
+	res_table *	old = restrict_file_table;
+	int		i;
+
+	if (NULL != table) {
+		for (i = 0; i < table->limited; i++)
+			inc_res_limited();
+		restrictcount += table->count;
+	}
+	memory_barrier();
+	restrict_file_table = table;
+	if (NULL == old)
+		return;
+	for (i = 0; i < old->limited; i++)
+		dec_res_limited();
+	restrictcount -= old->count;
+	res_retire(old, LIMBO_TABLE);
+}
+
+
+/*
+ * free_file_table - free a restrict file table and its tries
+ */
+static void
+free_file_table(
+	res_table *	table
+	)
+{
+	int		v6;
+
+	for (v6 = 0; v6 < 2; v6++) {
+		trie_free(table->trie[v6]);
+		free(table->entries[v6]);
+	}
+	free(table);
+}
+
+
+/*
+ * limbo_free - free what a lookup can no longer be in.  Entries go
+ * back on their free list.
+ */
+static void
+limbo_free(
+	void *	mem,
+	int	kind
+	)
+{
+	restrict_u *	res = mem;
+
+	switch (kind) {
+
+	case LIMBO_NODE:
+		free(mem);
+		break;
+
+	case LIMBO_RES4:
+		memset(res, '\0', V4_SIZEOF_RESTRICT_U);
+		LINK_SLIST(resfree4, res, link);
+		break;
+
+	case LIMBO_RES6:
+		memset(res, '\0', V6_SIZEOF_RESTRICT_U);
+		LINK_SLIST(resfree6, res, link);
+		break;
+
+	case LIMBO_TABLE:
+		free_file_table(mem);
+		break;
+
+	default:
+		INSIST(0);
+		break;
+	}
+}
+
+
+/*
+ * res_retire - free memory just unlinked from what lookups see, once
+ * no lookup can still be in it
+ */
+static void
+res_retire(
+	void *	mem,
+	int	kind
+	)
+{
+	res_limbo *	lim;
+
+	if (0 == res_readers) {
+		limbo_free(mem, kind);
+		return;
+	}
+	lim = emalloc_zero(sizeof(*lim));
+	lim->mem = mem;
+	lim->kind = kind;
+	LINK_SLIST(limbo_new, lim, link);
+}
+
+
+/*
+ * res_reap - free limbo_wait if every reader has been offline since
+ * it was snapshotted, then snapshot what was retired after it
+ */
+static void
+res_reap(void)
+{
+	res_limbo *	lim;
+	unsigned int	i;
+
+	if (NULL != limbo_wait) {
+		memory_barrier();
+		for (i = 0; i < res_readers; i++)
+			if ((1 & limbo_seen[i]) &&
+			    limbo_seen[i] == res_reader_count[i])
+				return;
+		while (NULL != (lim = limbo_wait)) {
+			limbo_wait = lim->link;
+			limbo_free(lim->mem, lim->kind);
+			free(lim);
+		}
+	}
+	if (NULL == limbo_new)
+		return;
+	limbo_wait = limbo_new;
+	limbo_new = NULL;
+	memory_barrier();
+	for (i = 0; i < res_readers; i++)
+		limbo_seen[i] = res_reader_count[i];
+}
+
+
+/*
+ * restrict_readers - make room for n threads besides the main one to
+ * look up restrictions.  Called while none are running.
+ */
+void
+restrict_readers(
+	unsigned int	n
+	)
+{
+	REQUIRE(NULL == limbo_new && NULL == limbo_wait);
+	free((void *)(uintptr_t)res_reader_count);
+	free(limbo_seen);
+	res_reader_count = NULL;
+	limbo_seen = NULL;
+	if (n > 0) {
+		res_reader_count = emalloc_zero(n * sizeof(*res_reader_count));
+		limbo_seen = emalloc_zero(n * sizeof(*limbo_seen));
+	}
+	res_readers = n;
+}
+
+
+/*
+ * restrict_online - reader i may look up restrictions from now on
+ */
+void
+restrict_online(
+	unsigned int	i
+	)
+{
+	res_reader_count[i]++;
+	memory_barrier();
+}
+
+
+/*
+ * restrict_offline - reader i holds nothing it looked up
+ */
+void
+restrict_offline(
+	unsigned int	i
+	)
+{
+	memory_barrier();
+	res_reader_count[i]++;
+}
+
+
+/*
+ * restrict_file_list - the entries from the restrict file, in list
+ * order, for enumeration from the main thread
+ */
+restrict_u *
+restrict_file_list(
+	bool	v6
+	)
+{
+	res_table *	table = restrict_file_table;
+
+	return (NULL != table) ? table->list[v6] : NULL;
+}
+
+
+/*
+ * load_restrict_file - read the whole restrict file into a new table,
+ * then put it in place of the one from the last load.  Nothing
+ * changes if the file can't be read.
+ */
+static bool
+load_restrict_file(void)
+{
+	FILE *		fp;
+	char		line[RESFILE_MAXLINE];
+	restrict_u	res;
+	restrict_u *	fresh[2] = { NULL, NULL };
+	size_t		count[2] = { 0, 0 };
+	size_t		alloc[2] = { 0, 0 };
+	int		lineno = 0;
+	int		bad = 0;
+	bool		v6;
+
+	fp = fopen(restrict_file_name, "r");
+	if (NULL == fp) {
+		msyslog(LOG_ERR, "RESTRICT: restrict file %s: open failed: %s",
+			restrict_file_name, strerror(errno));
+		return false;
+	}
+	while (NULL != fgets(line, sizeof(line), fp)) {
+		lineno++;
+		switch (parse_restrict_line(line, &res, &v6)) {
+		case 0:
+			continue;
+		case 1:
+			break;
+		default:
+			if (++bad <= RESFILE_MAXBAD)
+				msyslog(LOG_ERR,
+					"RESTRICT: restrict file %s: ignoring line %d",
+					restrict_file_name, lineno);
+			continue;
+		}
+		if (count[v6] == alloc[v6]) {
+			alloc[v6] = alloc[v6] ? 2 * alloc[v6] : 1024;
+			fresh[v6] = erealloc(fresh[v6],
+					     alloc[v6] * sizeof(res));
+		}
+		fresh[v6][count[v6]++] = res;
+	}
+	if (ferror(fp)) {
+		msyslog(LOG_ERR, "RESTRICT: restrict file %s: read failed",
+			restrict_file_name);
+		fclose(fp);
+		free(fresh[0]);
+		free(fresh[1]);
+		return false;
+	}
+	fclose(fp);
+
+	if (count[0])
+		qsort(fresh[0], count[0], sizeof(res), res_cmp4);
+	if (count[1])
+		qsort(fresh[1], count[1], sizeof(res), res_cmp6);
+	publish_file_table(build_file_table(fresh, count));
+	free(fresh[0]);
+	free(fresh[1]);
+
+	msyslog(LOG_INFO,
+		"RESTRICT: loaded %zu IPv4 and %zu IPv6 entries from %s%s",
+		count[0], count[1], restrict_file_name,
+		bad ? ", with errors" : "");
+	return true;
+}
+
+
+/*
+ * restrict_file - set up "restrict file <name> [flag ...]".  The flags
+ * are added to the ones on each line of the file.  There can be only
+ * one; a NULL name drops it.
+ */
+void
+restrict_file(
+	const char *	name,
+	unsigned short	mflags,
+	unsigned short	flags
+	)
+{
+	if (NULL == name) {
+		free(restrict_file_name);
+		restrict_file_name = NULL;
+		ZERO(restrict_file_stat);
+		publish_file_table(NULL);
+		return;
+	}
+	if (NULL != restrict_file_name) {
+		msyslog(LOG_ERR,
+			"RESTRICT: restrict file %s: already using %s, ignoring",
+			name, restrict_file_name);
+		return;
+	}
+	restrict_file_name = estrdup(name);
+	restrict_file_mflags = mflags;
+	restrict_file_flags = flags;
+	check_restrict_file(true);
+}
+
+
+/*
+ * check_restrict_file - reload the restrict file if it changed, or
+ * anyway if forced.  Called at startup, on SIGHUP and from timer(),
+ * which is also when limbo is freed.
+ */
+void
+check_restrict_file(
+	bool	force
+	)
+{
+	struct stat	sb;
+
+	res_reap();
+	if (NULL == restrict_file_name)
+		return;
+
+	if (0 != stat(restrict_file_name, &sb)) {
+		if (force)
+			msyslog(LOG_ERR,
+				"RESTRICT: restrict file %s: stat failed: %s",
+				restrict_file_name, strerror(errno));
+		return;
+	}
+	if (!force &&
+	    sb.st_mtime == restrict_file_stat.st_mtime &&
+	    sb.st_ctime == restrict_file_stat.st_ctime &&
+	    sb.st_ino == restrict_file_stat.st_ino &&
+	    sb.st_size == restrict_file_stat.st_size)
+		return;
+	if (load_restrict_file())
+		restrict_file_stat = sb;
+}
@@ -307,6 +307,7 @@ int scmp_sc[] = {
 #endif  /* ENABLE_EARLY_DROPROOT */
 
         SCMP_SYS(accept),
+	SCMP_SYS(accept4),	/* NTS-KE workers */
         SCMP_SYS(access),
 	SCMP_SYS(adjtimex),
 	SCMP_SYS(bind),
@@ -317,6 +318,11 @@ int scmp_sc[] = {
 	SCMP_SYS(clock_settime),
 	SCMP_SYS(close),
 	SCMP_SYS(connect),
+	SCMP_SYS(epoll_create1),
+	SCMP_SYS(epoll_ctl),
+	SCMP_SYS(epoll_pwait),
+	SCMP_SYS(epoll_wait),	/* extra workers */
+	SCMP_SYS(eventfd2),	/* extra workers, their doorbell */
 	SCMP_SYS(exit),
 	SCMP_SYS(exit_group),
 	SCMP_SYS(fcntl),
@@ -344,6 +350,11 @@ int scmp_sc[] = {
 	SCMP_SYS(gettimeofday),	/* mkstemp */
 	SCMP_SYS(getuid),	/* Needed on Alpine */
 	SCMP_SYS(ioctl),
+#ifdef __NR_io_uring_setup
+	SCMP_SYS(io_uring_enter),	/* extra uring */
+	SCMP_SYS(io_uring_register),
+	SCMP_SYS(io_uring_setup),
+#endif
 	SCMP_SYS(link),
 	SCMP_SYS(listen),
 	SCMP_SYS(lseek),
@@ -363,10 +374,12 @@ int scmp_sc[] = {
 				* (Or maybe sooner if a request arrives.)
 				*/
 	SCMP_SYS(recvmsg),
+	SCMP_SYS(recvmmsg),	/* extra recvbatch */
 	SCMP_SYS(rename),
 	SCMP_SYS(rt_sigaction),
 	SCMP_SYS(rt_sigprocmask),
 	SCMP_SYS(rt_sigreturn),
+	SCMP_SYS(sched_setaffinity),	/* extra iocpu */
 #ifdef __NR_rseq
 	SCMP_SYS(rseq),		/* needed by glibc-2.35+ for resumable sequences */
 #endif
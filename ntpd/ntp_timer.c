@@ -8,6 +8,7 @@
 #include "ntp_stdlib.h"
 #include "ntp_calendar.h"
 #include "ntp_leapsec.h"
+#include "ntp_workers.h"
 
 #include <stdio.h>
 #include <signal.h>
@@ -21,6 +22,7 @@
 #endif
 
 #define	EVENT_TIMEOUT	0	/* one second, that is */
+#define	RESFILE_CHECK	60	/* restrict file mtime check (s) */
 
 static void check_leapsec(time_t, bool);
 
@@ -44,6 +46,7 @@ static uptime_t adjust_timer;	/* second timer */
 static uptime_t hour_timer;
 static uptime_t leapf_timer;	/* Report leapfile problems once/day */
 static uptime_t huffpuff_timer;	/* huff-n'-puff timer */
+static uptime_t resfile_timer;	/* restrict file check timer */
 static unsigned long	leapsec; /* secs to next leap (proximity class) */
 unsigned int	leap_smear_intv;	/* Duration of smear.  Enables smear mode. */
 int	leapdif;		/* TAI difference step at next leap second*/
@@ -138,6 +141,7 @@ init_timer(void)
 	hour_timer = SECSPERHR;
 	leapf_timer = SECSPERDAY;
 	huffpuff_timer = 0;
+	resfile_timer = RESFILE_CHECK;
 	interface_timer = 0;
 	current_time = 0;
 	timer_xmtcalls = 0;
@@ -256,6 +260,14 @@ timer(void)
 			set_sys_leap(LEAP_NOWARNING);
 		}
 	}
+	/* orphan mode and leap smearing change the reply fields */
+	publish_server_state();
+
+	/* the server workers and MRU shards keep counts of their own */
+#ifdef USE_WORKERS
+	workers_collect();
+#endif
+	mon_sum_stats();
 
 	/*
 	 * Update huff-n'-puff filter.
@@ -265,6 +277,14 @@ timer(void)
 		huffpuff();
 	}
 
+	/*
+	 * Pick up a new restrict file
+	 */
+	if (resfile_timer <= current_time) {
+		resfile_timer += RESFILE_CHECK;
+		check_restrict_file(false);
+	}
+
 	/*
 	 * Interface update timer
 	 */
@@ -0,0 +1,659 @@
+/*
+ * ntp_uring.c - io_uring receive and send path for the NTP sockets
+ *
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * With "extra uring N", every NTP socket the main thread reads gets
+ * one multishot recvmsg() request on a ring of N entries.  The kernel
+ * picks a buffer for each datagram from a provided buffer ring of N
+ * buffers and posts a completion; no system call is made per packet.
+ * io_handler() waits on the ring's descriptor along with the others
+ * and calls uring_input() to reap whatever has completed.  Each
+ * datagram is copied into a recvbuf from the usual pool and goes
+ * through deliver_network_packet() and receive() as before.
+ *
+ * Replies made while a batch of completions is processed are queued
+ * as sendmsg() requests and submitted together, with one system call,
+ * once the batch is done.
+ *
+ * The ring is driven with the raw system calls, so liburing is not
+ * needed.  If the kernel has no io_uring, or one too old for
+ * multishot receives, the sockets stay with epoll or pselect().
+ */
+
+#include "config.h"
+
+#include <sys/mman.h>
+
+#include "ntpd.h"
+#include "ntp_uring.h"
+
+#ifdef USE_IO_URING
+
+/*
+ * Layout of a provided buffer once a datagram is in it: the header
+ * the kernel writes, the source address, the control messages with
+ * the receive timestamp, then the payload.  The name and control
+ * sizes are fixed by uring_msg and rounded so the control messages
+ * stay aligned.
+ */
+#define URING_NAMELEN		((sizeof(sockaddr_u) + 7) & ~(size_t)7)
+#define URING_CONTROLLEN	64
+#define URING_HDRLEN		(sizeof(struct io_uring_recvmsg_out) + \
+				 URING_NAMELEN + URING_CONTROLLEN)
+#define URING_BUFLEN		(URING_HDRLEN + RX_BUFF_SIZE)
+#define URING_BGID		1	/* our buffer group */
+
+/* what a request's user_data is for, in its top 32 bits */
+#define URING_RECV		1ULL
+#define URING_SEND		2ULL
+#define URING_CANCEL		3ULL
+#define URING_TAG(kind, idx)	(((kind) << 32) | (idx))
+
+/* a socket being read with a multishot recvmsg() */
+struct uring_sock {
+	endpt *		ep;		/* NULL once dropped */
+	SOCKET		fd;		/* INVALID_SOCKET => slot free */
+};
+
+/* a reply on its way out */
+struct uring_send {
+	endpt *		ep;		/* NULL once dropped */
+	struct msghdr	msg;
+	struct iovec	iov;
+	sockaddr_u	dest;
+	struct pkt	pkt;
+};
+
+unsigned int io_uring_entries = 0;
+
+static struct {
+	int		fd;
+	unsigned int	sq_entries;
+	unsigned int *	sq_head;
+	unsigned int *	sq_tail;
+	unsigned int *	sq_mask;
+	unsigned int *	sq_array;
+	unsigned int *	sq_flags;
+	unsigned int	sq_queued;	/* our tail, not yet published */
+	struct io_uring_sqe *sqes;
+	unsigned int *	cq_head;
+	unsigned int *	cq_tail;
+	unsigned int *	cq_mask;
+	struct io_uring_cqe *cqes;
+	struct io_uring_buf_ring *br;	/* provided buffer ring */
+	uint16_t	br_tail;
+	uint8_t *	bufs;		/* io_uring_entries of URING_BUFLEN */
+} ring = { .fd = -1 };
+
+static bool		uring_tried;	/* uring_init() has been called */
+static bool		uring_broken;	/* no more sockets to the ring */
+static bool		uring_batching;	/* inside uring_input() */
+
+static struct uring_sock *usocks;
+static unsigned int	nusocks;
+static struct uring_send *usends;	/* io_uring_entries of them */
+static unsigned int *	usend_free;	/* stack of free usends */
+static unsigned int	nusend_free;
+static struct msghdr	uring_msg;	/* sizes for multishot recvmsg */
+static uint64_t		uring_pkts;
+static unsigned int	usend_queued;	/* sends in this batch */
+
+static bool	uring_init	(void);
+static struct io_uring_sqe *uring_get_sqe(void);
+static void	uring_submit	(void);
+static bool	uring_arm	(unsigned int);
+static void	uring_put_buf	(unsigned int);
+static void	uring_recv_done	(unsigned int, const struct io_uring_cqe *);
+static void	uring_deliver	(struct uring_sock *, uint8_t *, size_t);
+static void	uring_send_done	(unsigned int, int);
+
+
+static int
+sys_io_uring_setup(
+	unsigned int		entries,
+	struct io_uring_params *p
+	)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+
+static int
+sys_io_uring_enter(
+	unsigned int	to_submit,
+	unsigned int	min_complete,
+	unsigned int	flags
+	)
+{
+	return (int)syscall(__NR_io_uring_enter, ring.fd, to_submit,
+			    min_complete, flags, NULL, 0);
+}
+
+
+/*
+ * uring_init - set up the ring and the buffers.  Called the first
+ * time an endpoint is offered, and only then.
+ */
+static bool
+uring_init(void)
+{
+	struct io_uring_params	p;
+	struct io_uring_buf_reg	reg;
+	size_t		sq_len, cq_len, br_len = 0;
+	size_t		ring_len = 0;
+	uint8_t *	mem = MAP_FAILED;
+	void *		sqes = MAP_FAILED;
+	void *		br = MAP_FAILED;
+	unsigned int	i;
+
+	uring_tried = true;
+	if (io_txstamps) {
+		msyslog(LOG_NOTICE,
+			"IO: io_uring does not read transmit timestamps, not used");
+		return false;
+	}
+
+	ZERO(p);
+	p.flags = IORING_SETUP_CQSIZE;
+	p.cq_entries = 4 * io_uring_entries;
+	ring.fd = sys_io_uring_setup(io_uring_entries, &p);
+	if (ring.fd < 0) {
+		msyslog(LOG_NOTICE, "IO: io_uring unavailable, not used: %s",
+			strerror(errno));
+		return false;
+	}
+	if (!(p.features & IORING_FEAT_SINGLE_MMAP) ||
+	    !(p.features & IORING_FEAT_NODROP)) {
+		msyslog(LOG_NOTICE, "IO: io_uring too old, not used");
+		goto fail;
+	}
+
+	sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	ring_len = max(sq_len, cq_len);
+	mem = mmap(NULL, ring_len, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+	if (MAP_FAILED == mem) {
+		msyslog(LOG_ERR, "IO: io_uring ring mmap(): %s",
+			strerror(errno));
+		goto fail;
+	}
+	sqes = mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+		    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		    ring.fd, IORING_OFF_SQES);
+	if (MAP_FAILED == sqes) {
+		msyslog(LOG_ERR, "IO: io_uring SQE mmap(): %s",
+			strerror(errno));
+		goto fail;
+	}
+	ring.sq_entries = p.sq_entries;
+	ring.sq_head = (unsigned int *)(mem + p.sq_off.head);
+	ring.sq_tail = (unsigned int *)(mem + p.sq_off.tail);
+	ring.sq_mask = (unsigned int *)(mem + p.sq_off.ring_mask);
+	ring.sq_array = (unsigned int *)(mem + p.sq_off.array);
+	ring.sq_flags = (unsigned int *)(mem + p.sq_off.flags);
+	ring.sq_queued = *ring.sq_tail;
+	ring.sqes = sqes;
+	ring.cq_head = (unsigned int *)(mem + p.cq_off.head);
+	ring.cq_tail = (unsigned int *)(mem + p.cq_off.tail);
+	ring.cq_mask = (unsigned int *)(mem + p.cq_off.ring_mask);
+	ring.cqes = (struct io_uring_cqe *)(mem + p.cq_off.cqes);
+
+	/* the buffer ring has to be page aligned, so mmap() it too */
+	br_len = io_uring_entries * sizeof(struct io_uring_buf);
+	br = mmap(NULL, br_len, PROT_READ | PROT_WRITE,
+		  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED == br) {
+		msyslog(LOG_ERR, "IO: io_uring buffer ring mmap(): %s",
+			strerror(errno));
+		goto fail;
+	}
+	ring.br = br;
+	ZERO(reg);
+	reg.ring_addr = (uintptr_t)br;
+	reg.ring_entries = io_uring_entries;
+	reg.bgid = URING_BGID;
+	if (syscall(__NR_io_uring_register, ring.fd,
+		    IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+		msyslog(LOG_NOTICE,
+			"IO: io_uring has no provided buffer rings, not used: %s",
+			strerror(errno));
+		goto fail;
+	}
+	ring.bufs = emalloc_zero(io_uring_entries * URING_BUFLEN);
+	for (i = 0; i < io_uring_entries; i++)
+		uring_put_buf(i);
+	__atomic_store_n(&ring.br->tail, ring.br_tail, __ATOMIC_RELEASE);
+
+	usends = emalloc_zero(io_uring_entries * sizeof(*usends));
+	usend_free = emalloc(io_uring_entries * sizeof(*usend_free));
+	for (i = 0; i < io_uring_entries; i++)
+		usend_free[nusend_free++] = io_uring_entries - 1 - i;
+
+	uring_msg.msg_namelen = URING_NAMELEN;
+	uring_msg.msg_controllen = URING_CONTROLLEN;
+
+	msyslog(LOG_INFO, "IO: io_uring with %u entries and buffers",
+		io_uring_entries);
+	return true;
+
+    fail:
+	/* close() leaves the mappings, so undo them first */
+	if (MAP_FAILED != br)
+		munmap(br, br_len);
+	if (MAP_FAILED != sqes)
+		munmap(sqes, p.sq_entries * sizeof(struct io_uring_sqe));
+	if (MAP_FAILED != mem)
+		munmap(mem, ring_len);
+	ring.br = NULL;
+	ring.sqes = NULL;
+	close(ring.fd);
+	ring.fd = -1;
+	return false;
+}
+
+
+/*
+ * uring_get_sqe - the next free submission queue entry, cleared.
+ * Submits what is queued if the queue is full.
+ */
+static struct io_uring_sqe *
+uring_get_sqe(void)
+{
+	struct io_uring_sqe *	sqe;
+	unsigned int		idx;
+
+	if (ring.sq_queued - __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE)
+	    >= ring.sq_entries) {
+		uring_submit();
+		if (ring.sq_queued -
+		    __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE)
+		    >= ring.sq_entries)
+			return NULL;
+	}
+	idx = ring.sq_queued & *ring.sq_mask;
+	sqe = &ring.sqes[idx];
+	memset(sqe, '\0', sizeof(*sqe));
+	ring.sq_array[idx] = idx;
+	ring.sq_queued++;
+	return sqe;
+}
+
+
+/*
+ * uring_submit - hand the kernel everything queued since last time
+ */
+static void
+uring_submit(void)
+{
+	unsigned int	pending;
+	int		rc;
+
+	__atomic_store_n(ring.sq_tail, ring.sq_queued, __ATOMIC_RELEASE);
+	pending = ring.sq_queued -
+	    __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE);
+	if (0 == pending)
+		return;
+	rc = sys_io_uring_enter(pending, 0, 0);
+	if (rc < 0 && EINTR != errno && EAGAIN != errno && EBUSY != errno)
+		msyslog(LOG_ERR, "IO: io_uring_enter(): %s", strerror(errno));
+}
+
+
+/*
+ * uring_put_buf - give a buffer back to the kernel.  The new tail
+ * is published by the caller.
+ */
+static void
+uring_put_buf(
+	unsigned int	bid
+	)
+{
+	struct io_uring_buf *b;
+
+	b = &ring.br->bufs[ring.br_tail & (io_uring_entries - 1)];
+	b->addr = (uintptr_t)(ring.bufs + (size_t)bid * URING_BUFLEN);
+	b->len = URING_BUFLEN;
+	b->bid = (uint16_t)bid;
+	ring.br_tail++;
+}
+
+
+/*
+ * uring_arm - start the multishot receive on a socket
+ */
+static bool
+uring_arm(
+	unsigned int	slot
+	)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = uring_get_sqe();
+	if (NULL == sqe)
+		return false;
+	sqe->opcode = IORING_OP_RECVMSG;
+	sqe->fd = usocks[slot].fd;
+	sqe->addr = (uintptr_t)&uring_msg;
+	sqe->len = 1;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = URING_BGID;
+	sqe->user_data = URING_TAG(URING_RECV, slot);
+	return true;
+}
+
+
+/*
+ * uring_add_endpt - read an endpoint's socket through the ring
+ */
+bool
+uring_add_endpt(
+	endpt *	ep,
+	SOCKET	fd
+	)
+{
+	unsigned int	slot;
+
+	if (0 == io_uring_entries || uring_broken)
+		return false;
+	if (!uring_tried && !uring_init())
+		uring_broken = true;
+	if (uring_broken)
+		return false;
+
+	for (slot = 0; slot < nusocks; slot++)
+		if (INVALID_SOCKET == usocks[slot].fd)
+			break;
+	if (slot == nusocks) {
+		nusocks = (0 == nusocks) ? 16 : 2 * nusocks;
+		usocks = erealloc(usocks, nusocks * sizeof(*usocks));
+		for (unsigned int i = slot; i < nusocks; i++)
+			usocks[i].fd = INVALID_SOCKET;
+	}
+	usocks[slot].ep = ep;
+	usocks[slot].fd = fd;
+	if (!uring_arm(slot)) {
+		usocks[slot].fd = INVALID_SOCKET;
+		return false;
+	}
+	uring_submit();
+	DPRINT(2, ("uring_add_endpt: %s fd %d slot %u\n",
+		   socktoa(&ep->sin), fd, slot));
+	return true;
+}
+
+
+/*
+ * uring_drop_endpt - stop reading a socket that is about to be
+ * closed.  The slot is reused once the receive request has ended.
+ */
+void
+uring_drop_endpt(
+	endpt *	ep
+	)
+{
+	struct io_uring_sqe *sqe;
+	unsigned int	i;
+
+	if (NULL == usocks)
+		return;
+	for (i = 0; i < io_uring_entries; i++)
+		if (ep == usends[i].ep)
+			usends[i].ep = NULL;
+	for (i = 0; i < nusocks; i++) {
+		if (ep != usocks[i].ep)
+			continue;
+		usocks[i].ep = NULL;
+		sqe = uring_get_sqe();
+		if (NULL != sqe) {
+			sqe->opcode = IORING_OP_ASYNC_CANCEL;
+			sqe->addr = URING_TAG(URING_RECV, i);
+			sqe->user_data = URING_TAG(URING_CANCEL, i);
+		}
+		uring_submit();
+	}
+}
+
+
+int
+uring_fd(void)
+{
+	return ring.fd;
+}
+
+
+/*
+ * uring_input - reap completions: deliver what was received, count
+ * what was sent, then submit the replies and anything re-armed
+ */
+void
+uring_input(void)
+{
+	struct io_uring_cqe	cqe;
+	unsigned int		head, tail;
+	uint64_t		before = uring_pkts;
+
+	uring_batching = true;
+	for (;;) {
+		head = *ring.cq_head;
+		tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+		if (head == tail) {
+			/* completions that did not fit wait in the kernel */
+			if (!(__atomic_load_n(ring.sq_flags, __ATOMIC_RELAXED)
+			      & IORING_SQ_CQ_OVERFLOW))
+				break;
+			(void)sys_io_uring_enter(0, 0, IORING_ENTER_GETEVENTS);
+			if (head == __atomic_load_n(ring.cq_tail,
+						    __ATOMIC_ACQUIRE))
+				break;
+			continue;
+		}
+		for (; head != tail; head++) {
+			cqe = ring.cqes[head & *ring.cq_mask];
+			switch (cqe.user_data >> 32) {
+			case URING_RECV:
+				uring_recv_done((unsigned int)cqe.user_data,
+						&cqe);
+				break;
+			case URING_SEND:
+				uring_send_done((unsigned int)cqe.user_data,
+						cqe.res);
+				break;
+			default:
+				break;
+			}
+		}
+		__atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+		__atomic_store_n(&ring.br->tail, ring.br_tail,
+				 __ATOMIC_RELEASE);
+	}
+	uring_batching = false;
+	uring_submit();
+
+	if (uring_pkts != before)
+		io_count_batch(uring_pkts - before);
+	if (0 != usend_queued)
+		io_count_batch_send();
+	usend_queued = 0;
+}
+
+
+/*
+ * uring_recv_done - one completion of a multishot receive
+ */
+static void
+uring_recv_done(
+	unsigned int			slot,
+	const struct io_uring_cqe *	cqe
+	)
+{
+	struct uring_sock *	us = &usocks[slot];
+	unsigned int		bid;
+
+	if (cqe->flags & IORING_CQE_F_BUFFER) {
+		bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+		if (cqe->res > 0 && NULL != us->ep)
+			uring_deliver(us,
+				      ring.bufs + (size_t)bid * URING_BUFLEN,
+				      (size_t)cqe->res);
+		uring_put_buf(bid);
+	}
+	if (cqe->flags & IORING_CQE_F_MORE)
+		return;
+
+	/* the request has ended */
+	if (NULL == us->ep) {
+		us->fd = INVALID_SOCKET;
+		return;
+	}
+	if (cqe->res >= 0 || -ENOBUFS == cqe->res || -EINTR == cqe->res) {
+		/* out of buffers, or the kernel just stopped; go again */
+		__atomic_store_n(&ring.br->tail, ring.br_tail,
+				 __ATOMIC_RELEASE);
+		if (uring_arm(slot))
+			return;
+	} else {
+		msyslog(LOG_NOTICE, "IO: io_uring receive on %s failed, "
+			"not used: %s", latoa(us->ep), strerror(-cqe->res));
+		uring_broken = true;
+	}
+	io_watch_fd(us->fd, true);
+	us->ep = NULL;
+	us->fd = INVALID_SOCKET;
+}
+
+
+/*
+ * uring_deliver - copy one datagram out of its provided buffer into
+ * a recvbuf and pass it on
+ */
+static void
+uring_deliver(
+	struct uring_sock *	us,
+	uint8_t *		buf,
+	size_t			len
+	)
+{
+	struct io_uring_recvmsg_out *out;
+	struct recvbuf *	rb;
+	struct msghdr		msghdr;
+	struct iovec		iov[2];
+	size_t			plen;
+
+	uring_pkts++;
+	if (len < URING_HDRLEN || us->ep->ignore_packets) {
+		io_count_dropped(us->ep, 1);
+		return;
+	}
+	rb = get_free_recv_buffer_iov(iov);
+	if (NULL == rb) {
+		io_count_dropped(us->ep, 1);
+		return;
+	}
+
+	out = (struct io_uring_recvmsg_out *)buf;
+	plen = min(out->payloadlen, len - URING_HDRLEN);
+	if (0 == plen) {
+		/* as read_network_packet(), nothing to deliver */
+		freerecvbuf(rb);
+		return;
+	}
+	ZERO(rb->recv_srcadr);
+	memcpy(&rb->recv_srcadr, buf + sizeof(*out),
+	       min(out->namelen, sizeof(rb->recv_srcadr)));
+	memcpy(iov[0].iov_base, buf + URING_HDRLEN, min(plen, iov[0].iov_len));
+	if (plen > iov[0].iov_len)
+		memcpy(iov[1].iov_base, buf + URING_HDRLEN + iov[0].iov_len,
+		       plen - iov[0].iov_len);
+	rb->recv_length = plen;
+	if (!recvbuf_settle(rb, iov, plen)) {
+		io_count_dropped(us->ep, 1);
+		freerecvbuf(rb);
+		return;
+	}
+
+	ZERO(msghdr);
+	msghdr.msg_control = buf + sizeof(*out) + URING_NAMELEN;
+	msghdr.msg_controllen = out->controllen;
+	DPRINT(3, ("uring_deliver: fd=%d length %zu from %s\n",
+		   us->fd, plen, socktoa(&rb->recv_srcadr)));
+	deliver_network_packet(us->fd, us->ep, rb, &msghdr);
+}
+
+
+/*
+ * uring_sendpkt - queue a reply to go out with the rest of the batch
+ */
+bool
+uring_sendpkt(
+	sockaddr_u *	dest,
+	endpt *		src,
+	void *		pkt,
+	unsigned int	len
+	)
+{
+	struct io_uring_sqe *	sqe;
+	struct uring_send *	us;
+	unsigned int		idx;
+
+	if (!uring_batching || 0 == nusend_free)
+		return false;
+	sqe = uring_get_sqe();
+	if (NULL == sqe)
+		return false;
+
+	idx = usend_free[--nusend_free];
+	us = &usends[idx];
+	us->ep = src;
+	memcpy(&us->pkt, pkt, len);
+	us->dest = *dest;
+	us->iov.iov_base = &us->pkt;
+	us->iov.iov_len = len;
+	ZERO(us->msg);
+	us->msg.msg_name = &us->dest.sa;
+	us->msg.msg_namelen = SOCKLEN(&us->dest);
+	us->msg.msg_iov = &us->iov;
+	us->msg.msg_iovlen = 1;
+
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = src->fd;
+	sqe->addr = (uintptr_t)&us->msg;
+	sqe->len = 1;
+	sqe->msg_flags = MSG_DONTWAIT;	/* fail rather than wait */
+	sqe->user_data = URING_TAG(URING_SEND, idx);
+	usend_queued++;
+	return true;
+}
+
+
+/*
+ * uring_send_done - count a queued reply as sent or not
+ */
+static void
+uring_send_done(
+	unsigned int	idx,
+	int		res
+	)
+{
+	struct uring_send *us = &usends[idx];
+
+	if (res < 0)
+		io_count_sent(us->ep, 0, 1);
+	else
+		io_count_sent(us->ep, 1, 0);
+	us->ep = NULL;
+	usend_free[nusend_free++] = idx;
+}
+
+
+/*
+ * uring_pkts_count - datagrams received through the ring
+ */
+uint64_t uring_pkts_count(void) {
+  return uring_pkts;
+}
+
+#endif	/* USE_IO_URING */
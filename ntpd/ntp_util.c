@@ -8,6 +8,7 @@
 #include "ntp_calendar.h"
 #include "ntp_config.h"
 #include "ntp_filegen.h"
+#include "ntp_hist.h"
 #include "ntp_leapsec.h"
 #include "ntp_stdlib.h"
 #include "ntp_auth.h"
@@ -66,6 +67,7 @@ static FILEGEN sysstats;
 static FILEGEN usestats;
 static FILEGEN ntsstats;
 static FILEGEN ntskestats;
+static FILEGEN stagestats;
 
 /*
  * This controls whether stats are written to the fileset. Provided
@@ -85,6 +87,7 @@ static	void	record_sys_stats(void);
 static	void	record_use_stats(void);
 static	void	record_nts_stats(void);
 static	void	record_ntske_stats(void);
+static	void	record_stage_stats(void);
 	void	ntpd_time_stepped(void);
 static  void	check_leap_expiration(bool, time_t);
 
@@ -120,6 +123,7 @@ uninit_util(void)
 	filegen_unregister("usestats");
 	filegen_unregister("ntsstats");
 	filegen_unregister("ntpkestats");
+	filegen_unregister("stagestats");
 }
 #endif /* DEBUG */
 
@@ -140,6 +144,7 @@ init_util(void)
 	filegen_register(statsdir, "usestats",	  &usestats);
 	filegen_register(statsdir, "ntsstats",	  &ntsstats);
 	filegen_register(statsdir, "ntskestats",  &ntskestats);
+	filegen_register(statsdir, "stagestats",  &stagestats);
 
 	/*
 	 * register with libntp ntp_set_tod() to call us back
@@ -211,6 +216,7 @@ write_stats(void) {
 	record_use_stats();
 	record_nts_stats();
 	record_ntske_stats();
+	record_stage_stats();
 	if (stats_drift_file != NULL) {
 
 		/*
@@ -737,6 +743,44 @@ void record_use_stats(void)
 	}
 }
 
+
+/*
+ * record_stage_stats - write receive path stage timing to file,
+ * one line per stage, counts since the last line
+ *
+ * file format
+ * day (MJD)
+ * time (s past midnight)
+ * stage
+ * packets timed
+ * total time in the stage (ns)
+ * LAT_HIST_BUCKETS histogram counts, as for lat_hist_str()
+ */
+static void
+record_stage_stats(void)
+{
+	struct timespec		now;
+	struct stage_stat	st;
+	int			stage;
+
+	if (!stats_control || 0 == stage_sample)
+		return;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	filegen_setup(&stagestats, now.tv_sec);
+	if (stagestats.fp != NULL) {
+		for (stage = 0; stage < RX_STAGES; stage++) {
+			stage_hour((enum rx_stage)stage, &st);
+			fprintf(stagestats.fp,
+			    "%s %s %" PRIu64 " %" PRIu64 " %s\n",
+			    timespec_to_MJDtime(&now), stage_names[stage],
+			    st.hist.count, st.ns, lat_hist_str(&st.hist));
+		}
+		fflush(stagestats.fp);
+	}
+	stage_hour_mark();
+}
+
 #define nts_since(CNT) ((unsigned long long)(nts_cnt.CNT - old_nts_cnt.CNT))
 uptime_t nts_stattime;
 void record_nts_stats(void) {
@@ -788,7 +832,8 @@ void record_ntske_stats(void) {
 	filegen_setup(&ntskestats, now.tv_sec);
 	if (ntsstats.fp != NULL) {
 		fprintf(ntskestats.fp,
-		    "%s %u %llu %.3f %.3f %llu %.3f %.3f %llu %.3f %.3f %llu %llu\n",
+		    "%s %u %llu %.3f %.3f %llu %.3f %.3f %llu %.3f %.3f %llu %llu"
+		    " %llu %llu %llu %llu\n",
 		    timespec_to_MJDtime(&now), current_time-ntske_stattime,
 		    ntske_since(serves_good),
 		    ntske_since_f(serves_good_wall),
@@ -800,7 +845,11 @@ void record_ntske_stats(void) {
 		    ntske_since_f(serves_bad_wall),
 		    ntske_since_f(serves_bad_cpu),
 		    ntske_since(probes_good),
-		    ntske_since(probes_bad) );
+		    ntske_since(probes_bad),
+		    ntske_since(serves_full),
+		    ntske_since(serves_resumed),
+		    ntske_since(probes_resumed),
+		    ntske_since(serves_limited) );
 		fflush(ntskestats.fp);
 	}
 	old_ntske_cnt = ntske_cnt;
@@ -945,3 +994,25 @@ ntpd_time_stepped(void) {
 		mon_start();
 	}
 }
+
+
+/*
+ * lat_hist_str - the bucket counts of a latency histogram, space
+ * separated, for mode 6 and the statistics files
+ */
+const char *
+lat_hist_str(
+	const struct lat_hist *	h
+	)
+{
+	static char	buf[LAT_HIST_BUCKETS * 21];
+	size_t		len = 0;
+	int		i;
+
+	buf[0] = '\0';
+	for (i = 0; i < LAT_HIST_BUCKETS; i++)
+		len += (size_t)snprintf(buf + len, sizeof(buf) - len,
+					"%s%" PRIu64, (i > 0) ? " " : "",
+					h->bucket[i]);
+	return buf;
+}
@@ -0,0 +1,548 @@
+/*
+ * ntp_workers.c - threads that answer client requests
+ *
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * With "extra workers N", each of N threads opens its own
+ * SO_REUSEPORT socket on every local address.  The kernel then
+ * spreads incoming datagrams over the main thread's socket and the
+ * workers' sockets.  A worker answers bare client requests itself
+ * (see is_simple_request()) and queues anything else for the main
+ * thread, which runs it through receive() as if it had read it.
+ * Peer packets, mode 6 and everything else with state stays there.
+ *
+ * Nothing a worker does takes a lock another worker wants.  The
+ * restrictions are looked up without locking, the MRU list is split
+ * into shards with a lock each, and the reply is built from a copy of
+ * the published server state.  Each worker counts into its own
+ * counters, which workers_collect() adds to the totals about once a
+ * second.  The worker holds its own lock while it handles a packet;
+ * the main thread only takes it to collect the counts, to take the
+ * queue, or to retire a socket, so it is hardly ever contended.
+ */
+
+#include "config.h"
+
+#include <signal.h>
+#include <pthread.h>
+
+#include "ntpd.h"
+#include "ntp_lists.h"
+#include "ntp_workers.h"
+
+#ifdef USE_WORKERS
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define WORKER_MAXEVENTS	64
+#define WORKER_BATCH		64	/* reads per socket per wakeup */
+#define WORKER_QUEUE		32	/* packets waiting for main thread */
+
+/* one worker's socket on one local address */
+typedef struct wsock wsock_t;
+struct wsock {
+	wsock_t *	link;
+	endpt *		ep;		/* NULL once the address is gone */
+	SOCKET		fd;
+	/* not yet added to the totals */
+	unsigned long	received;
+	unsigned long	dropped;	/* queue for main thread full */
+	unsigned long	sent;
+	unsigned long	notsent;
+};
+
+struct worker {
+	pthread_t	tid;
+	unsigned int	id;		/* restrict_online() reader */
+	int		epfd;
+	pthread_mutex_t	lock;		/* held while handling a packet */
+	wsock_t *	socks;		/* sockets being read */
+	wsock_t *	retired;	/* for the worker to close */
+	struct recvbuf *rbuf;		/* being read into */
+	struct recvbuf *spare;		/* free for the queue */
+	struct recvbuf *queue;		/* for the main thread, in order */
+	struct recvbuf **qtail;
+	/* not yet added to the totals */
+	struct statistics_counters *stats;
+	unsigned long	spoofed;
+	uint64_t	replies;
+	uint64_t	passed;
+};
+
+unsigned int io_workers = 0;
+
+static struct worker *	workers;	/* io_workers of them */
+static bool		workers_running;
+static SOCKET		wake_fd = INVALID_SOCKET;
+
+static uint64_t	worker_replies;		/* answered by a worker */
+static uint64_t	worker_passed;		/* queued for receive() */
+static uint64_t	worker_kernel_drops;	/* on sockets since retired */
+
+static void	init_workers	(void);
+static void *	worker_main	(void *);
+static void	worker_drain	(struct worker *, wsock_t *);
+static void	worker_pass	(struct worker *, wsock_t *);
+static void	wsock_collect	(wsock_t *);
+
+
+/*
+ * init_workers - allocate the worker table, epoll instances and
+ * the doorbell.  Called the first time an endpoint is opened with
+ * workers set.
+ */
+static void
+init_workers(void)
+{
+	struct worker *	w;
+	struct recvbuf *rb;
+	unsigned int	i, j;
+
+	wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wake_fd < 0) {
+		msyslog(LOG_ERR, "IO: worker eventfd(): %s", strerror(errno));
+		exit(1);
+	}
+	workers = emalloc_zero(io_workers * sizeof(*workers));
+	for (i = 0; i < io_workers; i++) {
+		w = &workers[i];
+		w->id = i;
+		w->epfd = epoll_create1(EPOLL_CLOEXEC);
+		if (w->epfd < 0) {
+			msyslog(LOG_ERR, "IO: worker epoll_create1(): %s",
+				strerror(errno));
+			exit(1);
+		}
+		pthread_mutex_init(&w->lock, NULL);
+		w->rbuf = new_private_recv_buffer();
+		for (j = 0; j < WORKER_QUEUE; j++) {
+			rb = new_private_recv_buffer();
+			LINK_SLIST(w->spare, rb, link);
+		}
+		w->qtail = &w->queue;
+		w->stats = stat_proto_new();
+	}
+}
+
+
+/*
+ * workers_add_endpt - give every worker a socket on a new endpoint
+ */
+void
+workers_add_endpt(
+	endpt *	ep
+	)
+{
+	struct epoll_event ev;
+	wsock_t *	ws;
+	SOCKET		fd;
+	unsigned int	i;
+
+	if (0 == io_workers || (INT_WILDCARD & ep->flags) ||
+	    ep->ignore_packets)
+		return;
+	if (NULL == workers)
+		init_workers();
+
+	for (i = 0; i < io_workers; i++) {
+		fd = open_worker_socket(ep);
+		if (INVALID_SOCKET == fd)
+			continue;	/* main thread still serves it */
+		ws = emalloc_zero(sizeof(*ws));
+		ws->ep = ep;
+		ws->fd = fd;
+		pthread_mutex_lock(&workers[i].lock);
+		LINK_SLIST(workers[i].socks, ws, link);
+		pthread_mutex_unlock(&workers[i].lock);
+
+		ZERO(ev);
+		ev.events = EPOLLIN;
+		ev.data.ptr = ws;
+		if (epoll_ctl(workers[i].epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+			msyslog(LOG_ERR, "IO: worker epoll_ctl(ADD, %d): %s",
+				fd, strerror(errno));
+			exit(1);
+		}
+	}
+	DPRINT(2, ("workers_add_endpt: %s on %u workers\n",
+		   socktoa(&ep->sin), io_workers));
+}
+
+
+/*
+ * workers_drop_endpt - retire the workers' sockets on an endpoint
+ * that is going away, and forget the packets they queued.  A running
+ * worker may be reading one right now, so it closes them itself
+ * once it is done with its batch.
+ */
+void
+workers_drop_endpt(
+	endpt *	ep
+	)
+{
+	struct worker *	w;
+	struct recvbuf *rb;
+	struct recvbuf **prb;
+	wsock_t *	ws;
+	unsigned int	i;
+
+	if (NULL == workers)
+		return;
+
+	for (i = 0; i < io_workers; i++) {
+		w = &workers[i];
+		pthread_mutex_lock(&w->lock);
+		for (prb = &w->queue; NULL != (rb = *prb); ) {
+			if (ep != rb->dstadr) {
+				prb = &rb->link;
+				continue;
+			}
+			*prb = rb->link;
+			LINK_SLIST(w->spare, rb, link);
+		}
+		w->qtail = prb;
+		UNLINK_EXPR_SLIST(ws, w->socks,
+		    ep == UNLINK_EXPR_SLIST_CURRENT()->ep, link, wsock_t);
+		if (NULL == ws) {
+			pthread_mutex_unlock(&w->lock);
+			continue;
+		}
+		(void)epoll_ctl(w->epfd, EPOLL_CTL_DEL, ws->fd, NULL);
+		worker_kernel_drops += socket_drops(ws->fd);
+		wsock_collect(ws);
+		ws->ep = NULL;
+		if (workers_running) {
+			LINK_SLIST(w->retired, ws, link);
+			ws = NULL;
+		}
+		pthread_mutex_unlock(&w->lock);
+		if (NULL != ws) {
+			close(ws->fd);
+			free(ws);
+		}
+	}
+}
+
+
+/*
+ * workers_start - start the threads
+ */
+void
+workers_start(void)
+{
+	sigset_t	block_mask, saved_sig_mask;
+	unsigned int	i;
+	int		rc;
+
+	if (NULL == workers)
+		return;
+
+	restrict_readers(io_workers);
+	workers_running = true;
+
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &saved_sig_mask);
+	for (i = 0; i < io_workers; i++) {
+		rc = pthread_create(&workers[i].tid, NULL, worker_main,
+				    &workers[i]);
+		if (rc) {
+			msyslog(LOG_ERR,
+				"IO: workers_start: error from pthread_create: %s",
+				strerror(rc));
+			exit(1);
+		}
+	}
+	pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
+
+	msyslog(LOG_INFO, "IO: started %u server worker threads",
+		io_workers);
+}
+
+
+/*
+ * worker_main - wait for requests and answer them
+ */
+static void *
+worker_main(
+	void *	arg
+	)
+{
+	struct worker *	w = arg;
+	struct epoll_event events[WORKER_MAXEVENTS];
+	wsock_t *	ws;
+	int		nevents;
+	int		i;
+
+	for (;;) {
+		nevents = epoll_wait(w->epfd, events, WORKER_MAXEVENTS, -1);
+		if (nevents < 0) {
+			if (EINTR == errno)
+				continue;
+			msyslog(LOG_ERR, "IO: worker epoll_wait(): %s",
+				strerror(errno));
+			exit(1);
+		}
+
+		for (i = 0; i < nevents; i++)
+			worker_drain(w, events[i].data.ptr);
+
+		/*
+		 * Close what the main thread retired.  Retired
+		 * sockets may still be in events[], so this waits
+		 * until we are done with them.
+		 */
+		pthread_mutex_lock(&w->lock);
+		while (NULL != (ws = w->retired)) {
+			w->retired = ws->link;
+			close(ws->fd);
+			free(ws);
+		}
+		pthread_mutex_unlock(&w->lock);
+	}
+
+	return NULL;
+}
+
+
+/*
+ * worker_drain - read a ready socket until it is empty, or for
+ * WORKER_BATCH datagrams; epoll will say if there is more.  Looks up
+ * restrictions only in between restrict_online() and
+ * restrict_offline(), so the main thread can free what it replaced
+ * once every worker has been through here.
+ */
+static void
+worker_drain(
+	struct worker *	w,
+	wsock_t *	ws
+	)
+{
+	struct recvbuf *	rb;
+	struct msghdr		msghdr;
+	struct iovec		iovec;
+	char			control[100];	/* as read_network_packet */
+	struct server_state	state;
+	struct pkt		xpkt;
+	ssize_t			buflen;
+	int			flags;
+	int			n;
+
+	restrict_online(w->id);
+	for (n = 0; n < WORKER_BATCH; n++) {
+		rb = w->rbuf;
+		iovec.iov_base = rb->recv_buffer;
+		iovec.iov_len = RX_BUFF_SIZE;
+		ZERO(msghdr);
+		msghdr.msg_name = &rb->recv_srcadr;
+		msghdr.msg_namelen = sizeof(rb->recv_srcadr);
+		msghdr.msg_iov = &iovec;
+		msghdr.msg_iovlen = 1;
+		msghdr.msg_control = (void *)&control;
+		msghdr.msg_controllen = sizeof(control);
+		buflen = recvmsg(ws->fd, &msghdr, 0);
+		if (buflen < 0) {
+			if (EAGAIN != errno && EWOULDBLOCK != errno &&
+			    EINTR != errno)
+				msyslog(LOG_ERR, "IO: worker recvmsg() fd=%d: %s",
+					ws->fd, strerror(errno));
+			break;
+		}
+		if (0 == buflen)
+			continue;	/* as read_network_packet() */
+		rb->recv_length = (size_t)buflen;
+		rb->recv_time = fetch_packetstamp(&msghdr);
+
+		pthread_mutex_lock(&w->lock);
+		if (NULL == ws->ep) {
+			pthread_mutex_unlock(&w->lock);
+			continue;
+		}
+		if (is_spoofed_loopback(ws->ep, &rb->recv_srcadr)) {
+			w->spoofed++;
+			pthread_mutex_unlock(&w->lock);
+			continue;
+		}
+		rb->dstadr = ws->ep;
+		rb->fd = ws->ep->fd;
+		ws->received++;
+		if (!is_simple_request(rb)) {
+			worker_pass(w, ws);
+		} else if (receive_simple(rb, &flags, w->stats)) {
+			read_server_state(&state);
+			fill_server_reply(rb, &state, flags, &xpkt);
+			if (sendto(ws->fd, &xpkt, LEN_PKT_NOMAC, 0,
+				   &rb->recv_srcadr.sa,
+				   SOCKLEN(&rb->recv_srcadr)) < 0)
+				ws->notsent++;
+			else
+				ws->sent++;
+			w->replies++;
+		}
+		pthread_mutex_unlock(&w->lock);
+	}
+	restrict_offline(w->id);
+}
+
+
+/*
+ * worker_pass - queue the packet just read for the main thread, and
+ * take a spare buffer to read the next one into.  Rings the doorbell
+ * if the main thread had taken everything before.
+ */
+static void
+worker_pass(
+	struct worker *	w,
+	wsock_t *	ws
+	)
+{
+	static const uint64_t one = 1;
+	struct recvbuf *rb = w->rbuf;
+	bool		ring;
+
+	if (NULL == w->spare) {
+		ws->dropped++;
+		return;
+	}
+	w->rbuf = w->spare;
+	w->spare = w->rbuf->link;
+	ring = (NULL == w->queue);
+	rb->link = NULL;
+	*w->qtail = rb;
+	w->qtail = &rb->link;
+	w->passed++;
+	if (ring && write(wake_fd, &one, sizeof(one)) < 0 &&
+	    EAGAIN != errno)
+		msyslog(LOG_ERR, "IO: worker eventfd write: %s",
+			strerror(errno));
+}
+
+
+/*
+ * workers_wake_fd - what the main thread waits on for queued packets
+ */
+SOCKET
+workers_wake_fd(void)
+{
+	return wake_fd;
+}
+
+
+/*
+ * workers_input - run the packets the workers queued through
+ * receive(), then give the buffers back
+ */
+void
+workers_input(void)
+{
+	struct worker *	w;
+	struct recvbuf *batch;
+	struct recvbuf *rb;
+	struct recvbuf **prb;
+	uint64_t	rings;
+	unsigned int	i;
+
+	if (read(wake_fd, &rings, sizeof(rings)) < 0 && EAGAIN != errno)
+		msyslog(LOG_ERR, "IO: worker eventfd read: %s",
+			strerror(errno));
+
+	for (i = 0; i < io_workers; i++) {
+		w = &workers[i];
+		pthread_mutex_lock(&w->lock);
+		batch = w->queue;
+		w->queue = NULL;
+		w->qtail = &w->queue;
+		pthread_mutex_unlock(&w->lock);
+		if (NULL == batch)
+			continue;
+
+		for (prb = &batch; NULL != (rb = *prb); prb = &rb->link)
+			receive(rb);
+
+		pthread_mutex_lock(&w->lock);
+		*prb = w->spare;
+		w->spare = batch;
+		pthread_mutex_unlock(&w->lock);
+	}
+}
+
+
+/*
+ * wsock_collect - add a socket's counts to its endpoint's and the
+ * totals.  The worker's lock is held.
+ */
+static void
+wsock_collect(
+	wsock_t *	ws
+	)
+{
+	io_count_received(ws->ep, ws->received);
+	io_count_sent(ws->ep, ws->sent, ws->notsent);
+	if (0 != ws->dropped)
+		io_count_dropped(ws->ep, ws->dropped);
+	ws->received = ws->dropped = ws->sent = ws->notsent = 0;
+}
+
+
+/*
+ * workers_collect - add the workers' counts to the totals
+ */
+void
+workers_collect(void)
+{
+	struct worker *	w;
+	wsock_t *	ws;
+	unsigned int	i;
+
+	if (!workers_running)
+		return;
+
+	for (i = 0; i < io_workers; i++) {
+		w = &workers[i];
+		pthread_mutex_lock(&w->lock);
+		stat_proto_fold(w->stats);
+		io_count_spoofed(w->spoofed);
+		worker_replies += w->replies;
+		worker_passed += w->passed;
+		w->spoofed = 0;
+		w->replies = w->passed = 0;
+		for (ws = w->socks; ws != NULL; ws = ws->link)
+			wsock_collect(ws);
+		pthread_mutex_unlock(&w->lock);
+	}
+}
+
+
+/*
+ * workers_replies_count - requests answered by the workers
+ */
+uint64_t workers_replies_count(void) {
+  return worker_replies;
+}
+
+/*
+ * workers_passed_count - worker packets queued for receive()
+ */
+uint64_t workers_passed_count(void) {
+  return worker_passed;
+}
+
+/*
+ * workers_socket_drops - datagrams the kernel dropped on the
+ * workers' sockets.  The main thread owns the socket lists.
+ */
+uint64_t workers_socket_drops(void) {
+  uint64_t drops = worker_kernel_drops;
+  wsock_t *ws;
+  unsigned int i;
+
+  if (NULL == workers)
+	return drops;
+  for (i = 0; i < io_workers; i++)
+	for (ws = workers[i].socks; ws != NULL; ws = ws->link)
+		drops += socket_drops(ws->fd);
+  return drops;
+}
+
+#endif	/* USE_WORKERS */
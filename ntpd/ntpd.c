@@ -14,6 +14,7 @@
 #include "ntp_assert.h"
 #include "ntp_auth.h"
 #include "ntp_dns.h"
+#include "ntp_workers.h"
 
 #include <unistd.h>
 #include <sys/stat.h>
@@ -925,6 +926,10 @@ void announce_starting(void) {
 static void mainloop(void)
 {
 	init_timer();
+#ifdef USE_WORKERS
+	workers_start();	/* after the sandbox, so they inherit it */
+#endif
+	io_pin_thread();	/* after the workers, so they don't */
 
 	for (;;) {
 		if (sig_flags.sawQuit)
@@ -961,6 +966,7 @@ static void mainloop(void)
 
 			check_logfile();
 			check_leap_file(false, time(NULL));
+			check_restrict_file(true);
 #ifndef DISABLE_NTS
 			check_cert_file();
 #endif
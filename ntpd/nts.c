@@ -44,6 +44,9 @@ struct ntsconfig_t ntsconfig = {
 	.ca = NULL,
 	.aead = NULL,
 	.tlscipherserverpreference = false,
+	.keworkers = NTS_KE_WORKERS,
+	.kelimit = NTS_KE_LIMIT,
+	.ketimeout = NTS_KE_TIMEOUT,
 };
 
 void nts_log_version(void);
@@ -15,6 +15,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <netinet/tcp.h>
 
 #ifdef HAVE_RES_INIT
 #include <netinet/in.h>
@@ -47,6 +48,7 @@ bool nts_client_send_request_core(uint8_t *buff, int buf_size, int *used, struct
 bool nts_client_process_response(SSL *ssl, struct peer *peer);
 bool nts_client_process_response_core(uint8_t *buff, int transferred, struct peer* peer);
 bool nts_server_lookup(char *server, sockaddr_u *addr, int af);
+static int nts_new_session(SSL *ssl, SSL_SESSION *session);
 
 static SSL_CTX *client_ctx = NULL;
 
@@ -73,6 +75,7 @@ bool nts_probe(struct peer * peer) {
 	int      server;
 	struct timespec start, finish;
 	int      err;
+	int      on = 1;
 
 	if (NULL == client_ctx)
 		return false;
@@ -110,6 +113,8 @@ bool nts_probe(struct peer * peer) {
 		ntske_cnt.probes_bad++;
 		return false;
 	}
+	/* Our Finished and the request are small separate writes. */
+	(void)setsockopt(server, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
 
 	if (NULL == peer->cfg.nts_cfg.ca)
 		ssl = SSL_new(client_ctx);
@@ -125,6 +130,13 @@ bool nts_probe(struct peer * peer) {
 	}
 	set_hostname(ssl, hostname);
 	SSL_set_fd(ssl, server);
+	SSL_set_app_data(ssl, peer);	/* for nts_new_session() */
+	if (NULL != peer->nts_state.session) {
+		if (SSL_SESSION_is_resumable(peer->nts_state.session))
+			SSL_set_session(ssl, peer->nts_state.session);
+		else
+			nts_free_session(peer);
+	}
 
 	if (1 != SSL_connect(ssl)) {
 		msyslog(LOG_INFO, "NTSc: SSL_connect failed");
@@ -138,10 +150,13 @@ bool nts_probe(struct peer * peer) {
 	}
 
 	/* This may be clutter, but this is how to do it. */
-	msyslog(LOG_INFO, "NTSc: Using %s, %s (%d)",
+	msyslog(LOG_INFO, "NTSc: Using %s, %s (%d)%s",
 		SSL_get_version(ssl),
 		SSL_get_cipher_name(ssl),
-		SSL_get_cipher_bits(ssl, NULL));
+		SSL_get_cipher_bits(ssl, NULL),
+		SSL_session_reused(ssl) ? ", resumed" : "");
+	if (SSL_session_reused(ssl))
+		ntske_cnt.probes_resumed++;
 
 	if (!check_certificate(ssl, peer))
 		goto bail;
@@ -174,6 +189,7 @@ bool nts_probe(struct peer * peer) {
 	if (!addrOK) {
 		ntske_cnt.probes_bad++;
 		peer->nts_state.count = -1;
+		nts_free_session(peer);		/* start afresh next time */
 	}
 	SSL_shutdown(ssl);
 	SSL_free(ssl);
@@ -188,6 +204,26 @@ bool nts_probe(struct peer * peer) {
 	return addrOK;
 }
 
+/* OpenSSL has a new session (TLS 1.3: a ticket) for the server of
+ * an NTS-KE exchange.  Keep it in the peer to resume next time.
+ */
+static int nts_new_session(SSL *ssl, SSL_SESSION *session) {
+	struct peer *peer = SSL_get_app_data(ssl);
+
+	if (NULL == peer)
+		return 0;
+	nts_free_session(peer);
+	peer->nts_state.session = session;
+	return 1;			/* we keep the reference */
+}
+
+void nts_free_session(struct peer *peer) {
+	if (NULL == peer->nts_state.session)
+		return;
+	SSL_SESSION_free(peer->nts_state.session);
+	peer->nts_state.session = NULL;
+}
+
 bool nts_check(struct peer *peer) {
 	if (0) {
 		char errbuf[100];
@@ -220,8 +256,11 @@ SSL_CTX* make_ssl_client_ctx(const char * filename) {
 		SSL_CTX_set_alpn_protos(ctx, alpn, sizeof(alpn));
 	}
 
-	SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
-	SSL_CTX_set_timeout(ctx, NTS_KE_TIMEOUT);   /* session lifetime */
+	/* Sessions are kept per peer, by nts_new_session(). */
+	SSL_CTX_set_session_cache_mode(ctx,
+		SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+	SSL_CTX_sess_set_new_cb(ctx, nts_new_session);
+	SSL_CTX_set_timeout(ctx, NTS_TICKET_LIFETIME);   /* session lifetime */
 
 	ok &= nts_load_versions(ctx);
 	ok &= nts_load_ciphers(ctx);
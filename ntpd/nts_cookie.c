@@ -27,8 +27,11 @@
 #include <string.h>
 #include <pthread.h>
 #include <unistd.h>
+#include "ntp_barrier.h"
 
 #include <aes_siv.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 
 #include "ntpd.h"
 #include "ntp_stdlib.h"
@@ -94,28 +97,91 @@ time_t K_time = 0;	/* time K was created, 0 for none */
 struct NTS_Key nts_keys[NTS_nKEYS];
 int nts_nKeys = 0;
 
-/* The mutex protects cookie_ctx
- * The NTS-KE servers can make cookies
- *   while the main NTP server thread is unpacking and making cookies.
- * If this becomes a bottleneck, we could use a cookie_ctx per thread. */
-pthread_mutex_t cookie_lock = PTHREAD_MUTEX_INITIALIZER;
-AES_SIV_CTX* cookie_ctx;
-
-void nts_lock_cookielock(void);
-void nts_unlock_cookielock(void);
+/* The keys above belong to the main thread.  The NTS-KE servers make
+ * cookies while the main NTP server thread (or a worker) is unpacking
+ * and making cookies, so they all work from copies.
+ *
+ * nts_publish_keys() copies the keys to published_keys.  keys_seq is
+ * odd while it does and counts key sets: each thread takes a copy
+ * when keys_seq has moved on since its last one, retrying until it
+ * sees the same even count on both sides, as read_server_state().
+ * Nothing is locked on the packet path.
+ *
+ * Each thread also has its own AES_SIV_CTX per key, keyed by
+ * AES_SIV_Init() on first use after each new key set: two AES key
+ * schedules and a CMAC of the zero block.  The keys change once a
+ * day, so a cookie only copies that context into the thread's
+ * scratch context and goes on from there.
+ *
+ * Cookie nonces come from a per-thread pool filled NONCE_POOL at a
+ * time, so a reply with 8 cookies costs at most one ntp_RAND_bytes()
+ * call rather than 8.  They go out in the clear, so holding a few
+ * in memory before use gives nothing away.
+ */
+struct cookie_keys {
+  int n;
+  int K_length;
+  struct NTS_Key keys[NTS_nKEYS];
+};
+static volatile struct cookie_keys published_keys;
+static volatile unsigned int keys_seq;	/* 0 until first published */
+
+/* NTS-KE session tickets are protected with keys derived from the
+ * cookie keys, so they rotate with them, and servers sharing a cookie
+ * file can resume each other's sessions.  A ticket key's name is I
+ * followed by 12 bytes derived from K.
+ */
+struct ticket_key {
+  uint8_t name[NTS_TICKET_NAME_LEN];
+  uint8_t aes[NTS_TICKET_KEY_LEN];
+  uint8_t hmac[NTS_TICKET_KEY_LEN];
+};
+
+#define NONCE_POOL 64		/* nonces per ntp_RAND_bytes() */
+
+struct cookie_thread {
+  unsigned int seq;			/* keys_seq of keys */
+  struct cookie_keys keys;
+  AES_SIV_CTX *ctx;			/* scratch */
+  AES_SIV_CTX *keyed[NTS_nKEYS];	/* keyed with keys.keys[i].K */
+  bool ready[NTS_nKEYS];
+  struct ticket_key tickets[NTS_nKEYS];	/* from keys.keys[i].K */
+  bool tickets_ready;
+  int nonces_left;			/* unused at the end of nonces */
+  uint8_t nonces[NONCE_POOL][NONCE_LENGTH];
+};
+static pthread_key_t cookie_thread_key;
+static pthread_once_t cookie_thread_once = PTHREAD_ONCE_INIT;
+
+static void nts_publish_keys(void);
+static struct cookie_thread *nts_cookie_thread(void);
+static AES_SIV_CTX *nts_cookie_keyed(struct cookie_thread *ct, int i);
+static const uint8_t *nts_cookie_nonce(struct cookie_thread *ct);
 
 // FIXME  AEAD_LENGTH
 /* Associated data: aead (rounded up to 4) plus NONCE */
 #define AD_LENGTH 20
 #define AEAD_LENGTH 4
 
-/* cookie_ctx needed for client side */
-bool nts_cookie_init(void) {
-  cookie_ctx = AES_SIV_CTX_new();
-  if (NULL == cookie_ctx) {
-    msyslog(LOG_ERR, "NTS: Can't init cookie_ctx");
+static void cookie_thread_free(void *arg) {
+  struct cookie_thread *ct = arg;
+  for (int i=0; i<NTS_nKEYS; i++)
+    AES_SIV_CTX_free(ct->keyed[i]);
+  AES_SIV_CTX_free(ct->ctx);
+  free(ct);
+}
+
+static void cookie_thread_init(void) {
+  int err = pthread_key_create(&cookie_thread_key, cookie_thread_free);
+  if (0 != err) {
+    msyslog(LOG_ERR, "NTS: Can't create cookie thread key: %d", err);
     exit(1);
   }
+}
+
+/* per-thread cookie contexts needed for client side */
+bool nts_cookie_init(void) {
+  pthread_once(&cookie_thread_once, cookie_thread_init);
   return true;
 }
 
@@ -212,6 +278,7 @@ bool nts_read_cookie_keys(void) {
 	  nts_nKeys = i+1;
 	}
 	fclose(in);
+	nts_publish_keys();
 	msyslog(LOG_INFO, "NTS: Read cookie file, %d keys.", nts_nKeys);
 	return true;
 
@@ -235,9 +302,159 @@ void nts_make_cookie_key(void) {
 	}
 	ntp_RAND_priv_bytes(nts_keys[0].K, K_length);
 	ntp_RAND_bytes((uint8_t *)&nts_keys[0].I, sizeof(nts_keys[0].I));
+	nts_publish_keys();
 	return;
 }
 
+/* Main thread only.  Call after changing the keys. */
+static void nts_publish_keys(void) {
+	struct cookie_keys fresh;
+
+	ZERO(fresh);
+	fresh.n = nts_nKeys;
+	fresh.K_length = K_length;
+	memcpy(fresh.keys, nts_keys, sizeof(fresh.keys));
+
+	keys_seq++;
+	memory_barrier();
+	published_keys = fresh;
+	memory_barrier();
+	keys_seq++;
+}
+
+/* This thread's contexts, with a copy of the current keys */
+static struct cookie_thread *nts_cookie_thread(void) {
+	struct cookie_thread *ct;
+	unsigned int seq;
+
+	ct = pthread_getspecific(cookie_thread_key);
+	if (NULL == ct) {
+		ct = emalloc_zero(sizeof(*ct));
+		ct->ctx = AES_SIV_CTX_new();
+		if (NULL == ct->ctx) {
+			msyslog(LOG_ERR, "NTS: Can't init cookie_ctx");
+			exit(1);
+		}
+		pthread_setspecific(cookie_thread_key, ct);
+	}
+
+	seq = keys_seq;
+	if (seq == ct->seq)
+		return ct;
+	for (;;) {
+		seq = keys_seq;
+		memory_barrier();
+		ct->keys = published_keys;
+		memory_barrier();
+		if (0 == (seq & 1) && seq == keys_seq)
+			break;
+	}
+	ct->seq = seq;
+	for (int i=0; i<NTS_nKEYS; i++)
+		ct->ready[i] = false;
+	ct->tickets_ready = false;
+	return ct;
+}
+
+/* Next nonce from this thread's pool, refilling it when empty */
+static const uint8_t *nts_cookie_nonce(struct cookie_thread *ct) {
+	if (0 == ct->nonces_left) {
+		ntp_RAND_bytes(&ct->nonces[0][0], sizeof(ct->nonces));
+		ct->nonces_left = NONCE_POOL;
+	}
+	return ct->nonces[--ct->nonces_left];
+}
+
+/* A NONCE_LENGTH nonce from the same pool, for the reply's AEEF */
+void nts_nonce(uint8_t *nonce) {
+	memcpy(nonce, nts_cookie_nonce(nts_cookie_thread()), NONCE_LENGTH);
+}
+
+/* This thread's context keyed with its copy of key i */
+static AES_SIV_CTX *nts_cookie_keyed(struct cookie_thread *ct, int i) {
+	struct NTS_Key *key = &ct->keys.keys[i];
+
+	if (ct->ready[i])
+		return ct->keyed[i];
+	if (NULL == ct->keyed[i]) {
+		ct->keyed[i] = AES_SIV_CTX_new();
+		if (NULL == ct->keyed[i]) {
+			msyslog(LOG_ERR, "NTS: Can't allocate cookie key ctx");
+			exit(1);
+		}
+	}
+	if (!AES_SIV_Init(ct->keyed[i], key->K, ct->keys.K_length)) {
+		msyslog(LOG_ERR, "NTS: Can't init cookie key ctx");
+		exit(1);
+	}
+	ct->ready[i] = true;
+	return ct->keyed[i];
+}
+
+/* HMAC-SHA256 of label keyed with K, truncated to length */
+static void nts_ticket_derive(const struct NTS_Key *key, int K_len,
+			      const char *label, uint8_t *out, size_t length) {
+	uint8_t md[EVP_MAX_MD_SIZE];
+	unsigned int mdlen = 0;
+
+	if (NULL == HMAC(EVP_sha256(), key->K, K_len,
+			 (const uint8_t *)label, strlen(label), md, &mdlen) ||
+	    mdlen < length) {
+		msyslog(LOG_ERR, "NTS: Can't derive ticket key");
+		exit(1);
+	}
+	memcpy(out, md, length);
+}
+
+/* Find the ticket key to encrypt with (find == NULL), or the one
+ * a ticket names.  Copies out name, AES and HMAC keys.  Returns the
+ * key's age: 0 for the current key, -1 if there is no such key.
+ */
+int nts_ticket_key(const uint8_t *find, uint8_t *name,
+		   uint8_t *aes, uint8_t *hmac) {
+	struct cookie_thread *ct;
+	struct ticket_key *tk;
+	int i;
+
+	if (0 == keys_seq)
+		return -1;		/* not a server, or not yet */
+	ct = nts_cookie_thread();
+	if (0 == ct->keys.n)
+		return -1;
+
+	if (!ct->tickets_ready) {
+		for (i=0; i<ct->keys.n; i++) {
+			struct NTS_Key *key = &ct->keys.keys[i];
+			tk = &ct->tickets[i];
+			memcpy(tk->name, &key->I, sizeof(key->I));
+			nts_ticket_derive(key, ct->keys.K_length,
+			    "NTS-KE ticket name", tk->name + sizeof(key->I),
+			    NTS_TICKET_NAME_LEN - sizeof(key->I));
+			nts_ticket_derive(key, ct->keys.K_length,
+			    "NTS-KE ticket AES", tk->aes, NTS_TICKET_KEY_LEN);
+			nts_ticket_derive(key, ct->keys.K_length,
+			    "NTS-KE ticket HMAC", tk->hmac, NTS_TICKET_KEY_LEN);
+		}
+		ct->tickets_ready = true;
+	}
+
+	i = 0;
+	if (NULL != find) {
+		for (; i<ct->keys.n; i++)
+			if (0 == memcmp(find, ct->tickets[i].name,
+					NTS_TICKET_NAME_LEN))
+				break;
+		if (ct->keys.n == i)
+			return -1;
+	}
+	tk = &ct->tickets[i];
+	if (NULL != name)
+		memcpy(name, tk->name, NTS_TICKET_NAME_LEN);
+	memcpy(aes, tk->aes, NTS_TICKET_KEY_LEN);
+	memcpy(hmac, tk->hmac, NTS_TICKET_KEY_LEN);
+	return i;
+}
+
 bool nts_write_cookie_keys(void) {
 	const char *cookiefile = NTS_COOKIE_KEY_FILE;
 	char tempfile[PATH_MAX];
@@ -285,20 +502,38 @@ bool nts_write_cookie_keys(void) {
 
 /* returns actual length */
 int nts_make_cookie(uint8_t *cookie,
+  uint16_t aead,
+  uint8_t *c2s, uint8_t *s2c, int keylen) {
+	return nts_make_cookies(cookie, NTS_MAX_COOKIELEN, 1,
+				aead, c2s, s2c, keylen);
+}
+
+/* Make count cookies for the same keys, stride bytes apart.
+ * The plaintext, the key and its keyed context are looked up once
+ * for the lot; each cookie then costs a nonce from the pool, a
+ * context copy and the encryption itself.
+ * Returns the length of each cookie, 0 if we have no keys yet.
+ */
+int nts_make_cookies(uint8_t *cookies, size_t stride, int count,
   uint16_t aead,
   uint8_t *c2s, uint8_t *s2c, int keylen) {
 	uint8_t plaintext[NTS_MAX_COOKIELEN];
-	uint8_t *nonce;
+	uint8_t *cookie, *nonce;
 	int used, plainlength;
 	bool ok;
 	uint8_t * finger;
 	uint32_t temp;	/* keep 4 byte alignment */
 	size_t left;
+	struct cookie_thread *ct;
+	AES_SIV_CTX *keyed;
 
-	if (NULL == cookie_ctx)
+	if (0 == keys_seq)
 		return 0;		/* We aren't initialized yet. */
+	ct = nts_cookie_thread();
+	if (0 == ct->keys.n)
+		return 0;
 
-	nts_cnt.cookie_make++;
+	nts_cnt.cookie_make += count;
 
 	INSIST(keylen <= NTS_MAX_KEYLEN);
 
@@ -316,43 +551,43 @@ int nts_make_cookie(uint8_t *cookie,
 	finger += keylen;
 	plainlength = finger-plaintext;
 
-	/* collect associated data */
-	finger = cookie;
-
-	memcpy(finger, &nts_keys[0].I, sizeof(nts_keys[0].I));
-	finger += sizeof(nts_keys[0].I);
-
-	nonce = finger;
-	ntp_RAND_bytes(finger, NONCE_LENGTH);
-	finger += NONCE_LENGTH;
-
-	used = finger-cookie;
-	left = NTS_MAX_COOKIELEN-used;
-
-	nts_lock_cookielock();
-
-	ok = AES_SIV_Encrypt(cookie_ctx,
-			     finger, &left,   /* left: in: max out length, out: length used */
-			     nts_keys[0].K, K_length,
-			     nonce, NONCE_LENGTH,
-			     plaintext, plainlength,
-			     cookie, AD_LENGTH);
-
-	nts_unlock_cookielock();
+	/* associated data, then CMAC, then ciphertext as long as the plaintext */
+	used = sizeof(ct->keys.keys[0].I) + NONCE_LENGTH;
+	left = 16 + plainlength;
+	INSIST(used + left <= NTS_MAX_COOKIELEN);
+	INSIST(1 == count || used + left <= stride);
+	used += left;
 
-	if (!ok) {
-		msyslog(LOG_ERR, "NTS: nts_make_cookie - Error from AES_SIV_Encrypt");
-		/* I don't think this should happen,
-		 * so crash rather than work incorrectly.
-		 * Hal, 2019-Feb-17
-		 * Similar code in ntp_extens
-		 */
-		exit(1);
+	keyed = nts_cookie_keyed(ct, 0);
+	for (cookie = cookies; 0 < count; count--, cookie += stride) {
+		/* collect associated data */
+		finger = cookie;
+
+		memcpy(finger, &ct->keys.keys[0].I, sizeof(ct->keys.keys[0].I));
+		finger += sizeof(ct->keys.keys[0].I);
+
+		nonce = finger;
+		memcpy(finger, nts_cookie_nonce(ct), NONCE_LENGTH);
+		finger += NONCE_LENGTH;
+
+		/* Same steps as AES_SIV_Encrypt() after its AES_SIV_Init() */
+		ok = AES_SIV_CTX_copy(ct->ctx, keyed) &&
+		     AES_SIV_AssociateData(ct->ctx, cookie, AD_LENGTH) &&
+		     AES_SIV_AssociateData(ct->ctx, nonce, NONCE_LENGTH) &&
+		     AES_SIV_EncryptFinal(ct->ctx, finger, finger + 16,
+					  plaintext, plainlength);
+
+		if (!ok) {
+			msyslog(LOG_ERR, "NTS: nts_make_cookie - Error from AES_SIV_EncryptFinal");
+			/* I don't think this should happen,
+			 * so crash rather than work incorrectly.
+			 * Hal, 2019-Feb-17
+			 * Similar code in ntp_extens
+			 */
+			exit(1);
+		}
 	}
 
-	used += left;
-	INSIST(used <= NTS_MAX_COOKIELEN);
-
 	return used;
 }
 
@@ -368,15 +603,18 @@ bool nts_unpack_cookie(uint8_t *cookie, int cookielen,
 	int cipherlength;
 	bool ok;
 	struct NTS_Key *key;
+	struct cookie_thread *ct;
 	int i;
 
-	if (NULL == cookie_ctx)
-		return false;	/* We aren't initialized yet. */
-
-	if (0 == nts_nKeys) {
+	if (0 == keys_seq) {
 		nts_cnt.cookie_not_server++;
 		return false;  /* We are not a NTS enabled server. */
 	}
+	ct = nts_cookie_thread();
+	if (0 == ct->keys.n) {
+		nts_cnt.cookie_not_server++;
+		return false;
+	}
 
 	/* We may get garbage from the net */
 	if (cookielen > NTS_MAX_COOKIELEN)
@@ -384,14 +622,14 @@ bool nts_unpack_cookie(uint8_t *cookie, int cookielen,
 
 	finger = cookie;
 	key = NULL;		/* squash uninitialized warning */
-	for (i=0; i<nts_nKeys; i++) {
-	  key = &nts_keys[i];
+	for (i=0; i<ct->keys.n; i++) {
+	  key = &ct->keys.keys[i];
 	  if (0 == memcmp(finger, &key->I, sizeof(key->I))) {
 		break;
 	  }
 	}
 	nts_cnt.cookie_decode_total++;  /* total attempts, includes too old */
-	if (nts_nKeys == i) {
+	if (ct->keys.n == i) {
 		nts_cnt.cookie_decode_too_old++;
 		return false;
         }
@@ -419,18 +657,18 @@ bool nts_unpack_cookie(uint8_t *cookie, int cookielen,
 	// require(AD_LENGTH==finger-cookie);
 
 	cipherlength = cookielen - AD_LENGTH;
-	plainlength = NTS_MAX_COOKIELEN;
-
-	nts_lock_cookielock();
-
-	ok = AES_SIV_Decrypt(cookie_ctx,
-			     plaintext, &plainlength,
-			     key->K, K_length,
-			     nonce, NONCE_LENGTH,
-			     finger, cipherlength,
-			     cookie, AD_LENGTH);
+	if (cipherlength < 16) {
+		nts_cnt.cookie_decode_error++;
+		return false;
+	}
+	plainlength = cipherlength - 16;
 
-	nts_unlock_cookielock();
+	/* Same steps as AES_SIV_Decrypt() after its AES_SIV_Init() */
+	ok = AES_SIV_CTX_copy(ct->ctx, nts_cookie_keyed(ct, i)) &&
+	     AES_SIV_AssociateData(ct->ctx, cookie, AD_LENGTH) &&
+	     AES_SIV_AssociateData(ct->ctx, nonce, NONCE_LENGTH) &&
+	     AES_SIV_DecryptFinal(ct->ctx, plaintext, finger, finger + 16,
+				  plainlength);
 
 	if (!ok) {
 		nts_cnt.cookie_decode_error++;
@@ -450,20 +688,4 @@ bool nts_unpack_cookie(uint8_t *cookie, int cookielen,
 	return true;
 }
 
-void nts_lock_cookielock(void) {
-	int err = pthread_mutex_lock(&cookie_lock);
-	if (0 != err) {
-		msyslog(LOG_ERR, "ERR: Can't lock cookie_lock: %d", err);
-		exit(2);
-	}
-}
-
-void nts_unlock_cookielock(void) {
-	int err = pthread_mutex_unlock(&cookie_lock);
-	if (0 != err) {
-		msyslog(LOG_ERR, "ERR: Can't unlock cookie_lock: %d", err);
-		exit(2);
-	}
-}
-
 /* end */
@@ -8,8 +8,8 @@
  *
  * We carefully arrange things so that no padding is necessary.
  *
- * This is only called by the main ntpd thread, so we don't need
- * a lock to protect wire_ctx.
+ * This is called by the main ntpd thread and by server worker
+ * threads.  Each has its own wire_ctx, so no lock is needed.
  */
 
 #include "config.h"
@@ -17,6 +17,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <aes_siv.h>
 
@@ -39,16 +40,37 @@ enum NtpExtFieldType {
 	NTS_AEEF = 0x404 /* Authenticated and Encrypted Extension Fields */
 };
 
-/* This is only called by the main thread so we don't need a lock. */
-AES_SIV_CTX* wire_ctx = NULL;
+/* one AES_SIV_CTX per thread, made on first use */
+static pthread_key_t wire_key;
+static pthread_once_t wire_once = PTHREAD_ONCE_INIT;
 
+static void wire_ctx_free(void *ctx) {
+	AES_SIV_CTX_free(ctx);
+}
 
-bool extens_init(void) {
-	wire_ctx = AES_SIV_CTX_new();
-	if (NULL == wire_ctx) {
-		msyslog(LOG_ERR, "NTS: Can't init wire_ctx");
+static void wire_key_init(void) {
+	int err = pthread_key_create(&wire_key, wire_ctx_free);
+	if (0 != err) {
+		msyslog(LOG_ERR, "NTS: Can't create wire_ctx key: %d", err);
 		exit(1);
 	}
+}
+
+static AES_SIV_CTX *wire_ctx(void) {
+	AES_SIV_CTX *ctx = pthread_getspecific(wire_key);
+	if (NULL == ctx) {
+		ctx = AES_SIV_CTX_new();
+		if (NULL == ctx) {
+			msyslog(LOG_ERR, "NTS: Can't init wire_ctx");
+			exit(1);
+		}
+		pthread_setspecific(wire_key, ctx);
+	}
+	return ctx;
+}
+
+bool extens_init(void) {
+	pthread_once(&wire_once, wire_key_init);
 	return true;
 }
 
@@ -94,7 +116,7 @@ int extens_client_send(struct peer *peer, struct pkt *xpkt) {
 	buf.next += NONCE_LENGTH;
 	buf.left -= NONCE_LENGTH;
 	left = buf.left;
-	ok = AES_SIV_Encrypt(wire_ctx,
+	ok = AES_SIV_Encrypt(wire_ctx(),
 			     buf.next, &left,   /* left: in: max out length, out: length used */
 			     peer->nts_state.c2s, peer->nts_state.keylen,
 			     nonce, NONCE_LENGTH,
@@ -214,7 +236,7 @@ bool extens_server_recv(struct ntspacket_t *ntspacket, uint8_t *pkt, int lng) {
 			nonce = buf.next;
 			cmac = nonce+NONCE_LENGTH;
 			outlen = 6;
-			ok = AES_SIV_Decrypt(wire_ctx,
+			ok = AES_SIV_Decrypt(wire_ctx(),
 					     NULL, &outlen,
 					     ntspacket->c2s, ntspacket->keylen,
 					     nonce, noncelen,
@@ -268,13 +290,16 @@ int extens_server_send(struct ntspacket_t *ntspacket, struct pkt *xpkt) {
 	size_t left;
 	uint8_t *nonce, *packet;
 	uint8_t *plaintext, *ciphertext;;
-	uint8_t cookie[NTS_MAX_COOKIELEN];
-	int cookielen, plainleng, aeadlen;
+	uint8_t cookies[NTS_MAX_COOKIES][NTS_MAX_COOKIELEN];
+	int cookielen, plainleng, aeadlen, batch;
 	bool ok;
 
-	/* get first cookie now so we have length */
-	cookielen = nts_make_cookie(cookie, ntspacket->aead,
-				    ntspacket->c2s, ntspacket->s2c, ntspacket->keylen);
+	/* make the cookies now, in one batch, so we have length */
+	batch = ntspacket->needed < NTS_MAX_COOKIES ?
+	    ntspacket->needed : NTS_MAX_COOKIES;
+	cookielen = nts_make_cookies(cookies[0], sizeof(cookies[0]), batch,
+				     ntspacket->aead, ntspacket->c2s,
+				     ntspacket->s2c, ntspacket->keylen);
 
 	packet = (uint8_t*)xpkt;
 	buf.next = xpkt->exten;
@@ -296,7 +321,7 @@ int extens_server_send(struct ntspacket_t *ntspacket, struct pkt *xpkt) {
 	append_uint16(&buf, plainleng+CMAC_LENGTH);
 
 	nonce = buf.next;
-	ntp_RAND_bytes(nonce, NONCE_LENGTH);
+	nts_nonce(nonce);
 	buf.next += NONCE_LENGTH;
 	buf.left -= NONCE_LENGTH;
 
@@ -306,22 +331,26 @@ int extens_server_send(struct ntspacket_t *ntspacket, struct pkt *xpkt) {
 	buf.left -= CMAC_LENGTH;
 	plaintext = buf.next;		/* encrypt in place */
 
-	ex_append_record_bytes(&buf, NTS_Cookie,
-			       cookie, cookielen);
-	for (int i=1; i<ntspacket->needed; i++) {
+	for (int i=0; i<ntspacket->needed; i++) {
 		/* WARN: This may get too big for the MTU. See length calculation above.
 		 * Responses are the same length as requests to avoid DDoS amplification.
 		 * So if it got to us, there is a good chance it will get back.  */
-		nts_make_cookie(cookie, ntspacket->aead,
-				ntspacket->c2s, ntspacket->s2c, ntspacket->keylen);
+		int j = i % NTS_MAX_COOKIES;
+		if (0 == j && 0 < i) {
+			batch = ntspacket->needed-i < NTS_MAX_COOKIES ?
+			    ntspacket->needed-i : NTS_MAX_COOKIES;
+			nts_make_cookies(cookies[0], sizeof(cookies[0]), batch,
+					 ntspacket->aead, ntspacket->c2s,
+					 ntspacket->s2c, ntspacket->keylen);
+		}
 		ex_append_record_bytes(&buf, NTS_Cookie,
-				       cookie, cookielen);
+				       cookies[j], cookielen);
 	}
 
 	//printf("ESSa: %d, %d, %d, %d\n",
 	//  adlength, plainleng, cookielen, ntspacket->needed);
 
-	ok = AES_SIV_Encrypt(wire_ctx,
+	ok = AES_SIV_Encrypt(wire_ctx(),
 			     ciphertext, &left,   /* left: in: max out length, out: length used */
 			     ntspacket->s2c, ntspacket->keylen,
 			     nonce, NONCE_LENGTH,
@@ -406,7 +435,7 @@ bool extens_client_recv(struct peer *peer, uint8_t *pkt, int lng) {
 			plaintext = ciphertext+CMAC_LENGTH;
 			outlen = buf.left-NONCE_LENGTH-CMAC_LENGTH;
 			//      printf("ECRa: %lu, %d\n", (long unsigned)outlen, noncelen);
-			ok = AES_SIV_Decrypt(wire_ctx,
+			ok = AES_SIV_Decrypt(wire_ctx(),
 					     plaintext, &outlen,
 					     peer->nts_state.s2c, peer->nts_state.keylen,
 					     nonce, noncelen,
@@ -11,17 +11,27 @@
 
 #include <signal.h>
 #include <pthread.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/x509.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+# include <openssl/core_names.h>
+#else
+# include <openssl/hmac.h>
+#endif
 
 #include "ntp.h"
 #include "ntpd.h"
+#include "ntp_lists.h"
 #include "ntp_stdlib.h"
 #include "nts.h"
 #include "nts2.h"
@@ -31,12 +41,48 @@
  *         enough for an IPv6 address.
  */
 
+/*
+ * With epoll, a pool of ntsconfig.keworkers threads serves NTS-KE.
+ * Each worker watches both listening sockets and the connections it
+ * has accepted, and drives every connection through a non-blocking
+ * TLS handshake, the request and the reply.  A slow or silent client
+ * ties up nothing but its own connection, and only until its
+ * deadline.  Without epoll, one thread per listening socket serves
+ * one connection at a time.
+ */
+#ifdef HAVE_EPOLL_CREATE1
+# include <sys/epoll.h>
+# define USE_KE_WORKERS
+# define KE_BACKLOG	128
+#else
+# define KE_BACKLOG	6
+#endif
+
+/* RFC 4: servers must accept 1024
+ * Our cookies can be 104, 136, or 168 for AES_SIV_CMAC_xxx
+ * 8*168 fits comfortably into 2K.
+ */
+#define KE_BUFF_SIZE	2048
+
+enum ke_result { KE_MORE, KE_GOOD, KE_NOSSL, KE_BAD };
 
 static bool create_listener4(int port);
 static bool create_listener6(int port);
+static bool nts_ke_reply(SSL *ssl, uint8_t *buff, int bytes_read, int *used);
+static void nts_ke_accept_fail(const char* addrbuf, double sec);
+static void nts_ke_handshake_done(SSL *ssl, char *usingbuf, size_t len);
+static void nts_ke_account(enum ke_result result, l_fp wall, l_fp cpu);
+static void nts_ke_log_done(const char *addrbuf, const char *good,
+			    const char *usingbuf, l_fp wall, l_fp usr, l_fp sys);
+#ifdef RUSAGE_THREAD
+static void nts_ke_cpu(struct timespec *usr, struct timespec *sys);
+#endif
+#ifdef USE_KE_WORKERS
+static void* ke_worker_main(void*);
+#else
 static void* nts_ke_listener(void*);
 static bool nts_ke_request(SSL *ssl);
-static void nts_ke_accept_fail(char* addrbuf, double sec);
+#endif
 
 static void nts_lock_certlock(void);
 static void nts_unlock_certlock(void);
@@ -50,6 +96,65 @@ static int listener6_sock = -1;
  * This seems like overkill, but it doesn't happen often. */
 pthread_mutex_t certificate_lock = PTHREAD_MUTEX_INITIALIZER;
 
+/* Several threads serve NTS-KE.  This covers ntske_cnt updates
+ * and, with workers, the per-address connection counts. */
+static pthread_mutex_t ke_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#ifdef USE_KE_WORKERS
+#define KE_MAXEVENTS	64
+#define KE_ACCEPTS	16	/* most accepts per listener wakeup */
+#define KE_SOURCES	256	/* address hash buckets, power of 2 */
+
+enum ke_state { KE_LISTEN, KE_ACCEPT, KE_READ, KE_WRITE };
+
+/* connections open from one client address */
+typedef struct ke_source ke_source;
+struct ke_source {
+	ke_source *	link;
+	sockaddr_u	addr;
+	int		count;
+};
+
+/* a listening socket, or a connection and how far it has got */
+typedef struct ke_conn ke_conn;
+struct ke_conn {
+	DECL_DLIST_LINK(ke_conn, list);	/* worker's, oldest first */
+	enum ke_state	state;
+	int		fd;
+	int		epfd;		/* worker's epoll */
+	uint32_t	events;		/* what epoll waits for */
+	SSL *		ssl;
+	ke_source *	src;		/* NULL when kelimit is 0 */
+	struct timespec	start;		/* wall clock */
+	struct timespec	deadline;
+	l_fp		usr, sys;	/* CPU spent on it so far */
+	int		used;		/* bytes of reply in buff */
+	char		addrbuf[100];
+	char		usingbuf[100];
+	uint8_t		buff[KE_BUFF_SIZE];
+};
+
+struct ke_worker {
+	pthread_t	tid;
+	int		epfd;
+	ke_conn		conns;		/* list head */
+};
+
+static ke_conn		ke_listeners[2];
+static struct ke_worker	*ke_workers;
+static ke_source *	ke_sources[KE_SOURCES];	/* under ke_lock */
+
+static bool ke_listen_on(struct ke_worker *w, ke_conn *l);
+static void ke_accept(struct ke_worker *w, ke_conn *l);
+static void ke_step(ke_conn *c);
+static enum ke_result ke_advance(ke_conn *c);
+static bool ke_wait(ke_conn *c, int rc);
+static void ke_close(ke_conn *c, enum ke_result result, const char *why);
+static int ke_expire(struct ke_worker *w);
+static bool ke_source_take(const sockaddr_u *addr, ke_source **srcp);
+static void ke_source_drop(ke_source *s);
+#endif
+
 static int alpn_select_cb(SSL *ssl,
 			  const unsigned char **out,
 			  unsigned char *outlen,
@@ -84,6 +189,72 @@ static int alpn_select_cb(SSL *ssl,
 	return SSL_TLSEXT_ERR_NOACK;
 }
 
+/* Session tickets are encrypted with the current ticket key and
+ * decrypted with whichever key they name.  The keys come from the
+ * cookie keys (nts_ticket_key()), so they rotate with the cookie
+ * file and every server sharing it can resume the others' sessions.
+ * An older key gets 2, which has OpenSSL issue a fresh ticket.
+ */
+static int ticket_key_setup(unsigned char *key_name, unsigned char *iv,
+			    EVP_CIPHER_CTX *ctx, uint8_t *hmac, int enc) {
+	uint8_t aes[NTS_TICKET_KEY_LEN];
+	int age;
+
+	if (enc) {
+		age = nts_ticket_key(NULL, key_name, aes, hmac);
+		if (0 > age)
+			return 0;		/* no keys yet, no ticket */
+		ntp_RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()));
+		if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), NULL,
+					    aes, iv))
+			return -1;
+		return 1;
+	}
+	age = nts_ticket_key(key_name, NULL, aes, hmac);
+	if (0 > age)
+		return 0;			/* unknown key: full handshake */
+	if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, aes, iv))
+		return -1;
+	return (0 == age) ? 1 : 2;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static int ticket_key_cb(SSL *ssl, unsigned char *key_name,
+			 unsigned char *iv, EVP_CIPHER_CTX *ctx,
+			 EVP_MAC_CTX *hctx, int enc) {
+	static char digest[] = "SHA256";
+	uint8_t hmac[NTS_TICKET_KEY_LEN];
+	OSSL_PARAM params[2];
+	int ret;
+
+	UNUSED_ARG(ssl);
+	ret = ticket_key_setup(key_name, iv, ctx, hmac, enc);
+	if (0 >= ret)
+		return ret;
+	params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+						     digest, 0);
+	params[1] = OSSL_PARAM_construct_end();
+	if (1 != EVP_MAC_init(hctx, hmac, sizeof(hmac), params))
+		return -1;
+	return ret;
+}
+#else
+static int ticket_key_cb(SSL *ssl, unsigned char *key_name,
+			 unsigned char *iv, EVP_CIPHER_CTX *ctx,
+			 HMAC_CTX *hctx, int enc) {
+	uint8_t hmac[NTS_TICKET_KEY_LEN];
+	int ret;
+
+	UNUSED_ARG(ssl);
+	ret = ticket_key_setup(key_name, iv, ctx, hmac, enc);
+	if (0 >= ret)
+		return ret;
+	if (1 != HMAC_Init_ex(hctx, hmac, sizeof(hmac), EVP_sha256(), NULL))
+		return -1;
+	return ret;
+}
+#endif
+
 bool nts_server_init(void) {
 	bool ok = true;
 
@@ -99,8 +270,15 @@ bool nts_server_init(void) {
 	}
 
 	SSL_CTX_set_alpn_select_cb(server_ctx, alpn_select_cb, NULL);
+	/* No session cache: clients resume from stateless tickets. */
 	SSL_CTX_set_session_cache_mode(server_ctx, SSL_SESS_CACHE_OFF);
-	SSL_CTX_set_timeout(server_ctx, NTS_KE_TIMEOUT);  /* session lifetime */
+	SSL_CTX_set_timeout(server_ctx, NTS_TICKET_LIFETIME);  /* session lifetime */
+	SSL_CTX_set_num_tickets(server_ctx, 1);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	SSL_CTX_set_tlsext_ticket_key_evp_cb(server_ctx, ticket_key_cb);
+#else
+	SSL_CTX_set_tlsext_ticket_key_cb(server_ctx, ticket_key_cb);
+#endif
 
 	ok &= nts_load_versions(server_ctx);
 	ok &= nts_load_ciphers(server_ctx);
@@ -125,6 +303,54 @@ bool nts_server_init(void) {
 	return ok;
 }
 
+#ifdef USE_KE_WORKERS
+bool nts_server_init2(void) {
+	sigset_t block_mask, saved_sig_mask;
+	int i, rc;
+	char errbuf[100];
+
+	if (!nts_load_certificate(server_ctx)) {
+		return false;
+	}
+
+	ke_listeners[0].state = KE_LISTEN;
+	ke_listeners[0].fd = listener4_sock;
+	ke_listeners[1].state = KE_LISTEN;
+	ke_listeners[1].fd = listener6_sock;
+
+	ke_workers = emalloc_zero(ntsconfig.keworkers * sizeof(*ke_workers));
+	for (i = 0; i < ntsconfig.keworkers; i++) {
+		struct ke_worker *w = &ke_workers[i];
+		w->epfd = epoll_create1(EPOLL_CLOEXEC);
+		if (w->epfd < 0) {
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_ERR, "NTSs: epoll_create1 failed: %s", errbuf);
+			return false;
+		}
+		INIT_DLIST(w->conns, list);
+		if (!ke_listen_on(w, &ke_listeners[0]) ||
+		    !ke_listen_on(w, &ke_listeners[1]))
+			return false;
+	}
+
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &saved_sig_mask);
+	for (i = 0; i < ntsconfig.keworkers; i++) {
+		rc = pthread_create(&ke_workers[i].tid, NULL, ke_worker_main,
+				    &ke_workers[i]);
+		if (rc) {
+			ntp_strerror_r(rc, errbuf, sizeof(errbuf));
+			msyslog(LOG_ERR, "NTSs: nts_server_init2: error from pthread_create: %s", errbuf);
+		}
+	}
+	pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
+
+	msyslog(LOG_INFO, "NTSs: started %d NTS-KE server threads, "
+		"limit %d per address, timeout %d sec",
+		ntsconfig.keworkers, ntsconfig.kelimit, ntsconfig.ketimeout);
+	return true;
+}
+#else
 bool nts_server_init2(void) {
 	pthread_t worker;
 	sigset_t block_mask, saved_sig_mask;
@@ -155,6 +381,7 @@ bool nts_server_init2(void) {
 
 	return true;
 }
+#endif
 
 /* called every hour */
 void nts_cert_timer(void) {
@@ -193,35 +420,456 @@ static inline double lfptox(l_fp r) {
 }
 
 
+#ifdef RUSAGE_THREAD
+/* CPU time this thread has used so far */
+void nts_ke_cpu(struct timespec *usr, struct timespec *sys) {
+	struct rusage usage;
+
+	getrusage(RUSAGE_THREAD, &usage);
+	*usr = tval_to_tspec(usage.ru_utime);
+	*sys = tval_to_tspec(usage.ru_stime);
+}
+#endif
+
+/* Add a finished connection to ntske_cnt. */
+void nts_ke_account(enum ke_result result, l_fp wall, l_fp cpu) {
+	pthread_mutex_lock(&ke_lock);
+	switch (result) {
+	    case KE_GOOD:
+		ntske_cnt.serves_good++;
+		ntske_cnt.serves_good_wall += wall;
+		ntske_cnt.serves_good_cpu += cpu;
+		break;
+	    case KE_NOSSL:
+		ntske_cnt.serves_nossl++;
+		ntske_cnt.serves_nossl_wall += wall;
+		ntske_cnt.serves_nossl_cpu += cpu;
+		break;
+	    case KE_BAD:
+		ntske_cnt.serves_bad++;
+		ntske_cnt.serves_bad_wall += wall;
+		ntske_cnt.serves_bad_cpu += cpu;
+		break;
+	    case KE_MORE:
+	    default:
+		break;
+	}
+	pthread_mutex_unlock(&ke_lock);
+}
+
+/* Count a finished TLS handshake, full or resumed, and save the
+ * details for the final message.
+ */
+void nts_ke_handshake_done(SSL *ssl, char *usingbuf, size_t len) {
+	bool resumed = SSL_session_reused(ssl);
+
+	snprintf(usingbuf, len, "%s, %s (%d)%s",
+		SSL_get_version(ssl),
+		SSL_get_cipher_name(ssl),
+		SSL_get_cipher_bits(ssl, NULL),
+		resumed ? ", resumed" : "");
+	pthread_mutex_lock(&ke_lock);
+	if (resumed)
+		ntske_cnt.serves_resumed++;
+	else
+		ntske_cnt.serves_full++;
+	pthread_mutex_unlock(&ke_lock);
+}
+
+/* One line per connection that got past SSL_accept. */
+void nts_ke_log_done(const char *addrbuf, const char *good,
+		     const char *usingbuf, l_fp wall, l_fp usr, l_fp sys) {
+#ifdef RUSAGE_THREAD
+	msyslog(LOG_INFO, "NTSs: NTS-KE from %s, %s, Using %s, took %.3f sec, CPU: %.3f+%.3f ms",
+		addrbuf, good, usingbuf, lfptox(wall),
+		lfptox(usr*1000), lfptox(sys*1000));
+#else
+	UNUSED_ARG(usr);
+	UNUSED_ARG(sys);
+	msyslog(LOG_INFO, "NTSs: NTS-KE from %s, %s, Using %s, took %.3f sec",
+		addrbuf, good, usingbuf, lfptox(wall));
+#endif
+}
+
+#ifdef USE_KE_WORKERS
+
+/* Have a worker's epoll wake it for connections on a listener. */
+bool ke_listen_on(struct ke_worker *w, ke_conn *l) {
+	struct epoll_event ev;
+	char errbuf[100];
+	int flags;
+
+	if (-1 == l->fd)
+		return true;
+	flags = fcntl(l->fd, F_GETFL, 0);
+	if (0 > flags || 0 > fcntl(l->fd, F_SETFL, flags | O_NONBLOCK)) {
+		ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+		msyslog(LOG_ERR, "NTSs: can't make listener non-blocking: %s", errbuf);
+		return false;
+	}
+	ZERO(ev);
+	ev.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+	ev.events |= EPOLLEXCLUSIVE;	/* wake one worker, not all */
+#endif
+	ev.data.ptr = l;
+	if (0 > epoll_ctl(w->epfd, EPOLL_CTL_ADD, l->fd, &ev)) {
+		ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+		msyslog(LOG_ERR, "NTSs: epoll_ctl on listener failed: %s", errbuf);
+		return false;
+	}
+	return true;
+}
+
+void* ke_worker_main(void* arg) {
+	struct ke_worker *w = arg;
+	struct epoll_event events[KE_MAXEVENTS];
+	char errbuf[100];
+	ke_conn *c;
+	int nevents, i;
+
+#ifdef HAVE_SECCOMP_H
+        setup_SIGSYS_trap();   /* enable trap for this thread */
+#endif
+
+	while(1) {
+		nevents = epoll_wait(w->epfd, events, KE_MAXEVENTS,
+				     ke_expire(w));
+		if (nevents < 0) {
+			if (EINTR == errno)
+				continue;
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_ERR, "NTSs: epoll_wait failed: %s", errbuf);
+			return NULL;
+		}
+		for (i = 0; i < nevents; i++) {
+			c = events[i].data.ptr;
+			if (KE_LISTEN == c->state)
+				ke_accept(w, c);
+			else
+				ke_step(c);
+		}
+	}
+	return NULL;
+}
+
+/* Take the connections waiting on a listener, and start their
+ * TLS handshakes.  Addresses that already have kelimit connections
+ * open are turned away here.
+ */
+void ke_accept(struct ke_worker *w, ke_conn *l) {
+	struct epoll_event ev;
+	char errbuf[100];
+	sockaddr_u addr;
+	socklen_t len;
+	ke_source *src;
+	ke_conn *c;
+	int client;
+	int on = 1;
+
+	for (int i = 0; i < KE_ACCEPTS; i++) {
+		len = sizeof(addr);
+		client = accept4(l->fd, &addr.sa, &len,
+				 SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (client < 0) {
+			if (EAGAIN == errno || EWOULDBLOCK == errno ||
+			    EINTR == errno)
+				return;
+			if (ECONNABORTED == errno)
+				continue;
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_ERR, "NTSs: TCP accept failed: %s", errbuf);
+			sleep(1);		/* avoid log clutter on bug */
+			return;
+		}
+		if (!ke_source_take(&addr, &src)) {
+			close(client);
+			continue;
+		}
+		/* The ticket and the reply are small separate writes. */
+		(void)setsockopt(client, IPPROTO_TCP, TCP_NODELAY,
+				 &on, sizeof(on));
+
+		c = emalloc_zero(sizeof(*c));
+		c->state = KE_ACCEPT;
+		c->fd = client;
+		c->epfd = w->epfd;
+		c->events = EPOLLIN;
+		c->src = src;
+		clock_gettime(CLOCK_MONOTONIC, &c->start);
+		c->deadline = c->start;
+		c->deadline.tv_sec += ntsconfig.ketimeout;
+		sockporttoa_r(&addr, c->addrbuf, sizeof(c->addrbuf));
+		LINK_TAIL_DLIST(w->conns, c, list);
+
+		nts_lock_certlock();
+		c->ssl = SSL_new(server_ctx);
+		nts_unlock_certlock();
+		if (NULL == c->ssl) {
+			nts_log_ssl_error();
+			ke_close(c, KE_NOSSL, "SSL_new failed");
+			continue;
+		}
+		SSL_set_fd(c->ssl, client);
+
+		ZERO(ev);
+		ev.events = c->events;
+		ev.data.ptr = c;
+		if (0 > epoll_ctl(w->epfd, EPOLL_CTL_ADD, client, &ev)) {
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_ERR, "NTSs: epoll_ctl on connection failed: %s", errbuf);
+			ke_close(c, KE_NOSSL, "epoll_ctl failed");
+		}
+	}
+}
+
+/* Run a connection that epoll says is ready, charging it the
+ * CPU time that takes, and close it if it is done.
+ */
+void ke_step(ke_conn *c) {
+	enum ke_result result;
+#ifdef RUSAGE_THREAD
+	struct timespec start_u, finish_u;	/* CPU user */
+	struct timespec start_s, finish_s;	/* CPU system */
+
+	nts_ke_cpu(&start_u, &start_s);
+#endif
+
+	result = ke_advance(c);
+
+#ifdef RUSAGE_THREAD
+	nts_ke_cpu(&finish_u, &finish_s);
+	c->usr += tspec_intv_to_lfp(sub_tspec(finish_u, start_u));
+	c->sys += tspec_intv_to_lfp(sub_tspec(finish_s, start_s));
+#endif
+
+	switch (result) {
+	    case KE_GOOD:
+		ke_close(c, result, "OK");
+		break;
+	    case KE_BAD:
+		ke_close(c, result, "Failed");
+		break;
+	    case KE_NOSSL:
+		ke_close(c, result, NULL);	/* already logged */
+		break;
+	    case KE_MORE:
+	    default:
+		break;
+	}
+}
+
+/* Take a connection as far as it will go without blocking.
+ * Returns KE_MORE if it has to wait on the socket.
+ */
+enum ke_result ke_advance(ke_conn *c) {
+	struct timespec finish;
+	char errbuf[100];
+	int rc;
+
+	ERR_clear_error();	/* the queue is per thread, not per SSL */
+	switch (c->state) {
+	    case KE_ACCEPT:
+		rc = SSL_accept(c->ssl);
+		if (rc <= 0) {
+			if (ke_wait(c, rc))
+				return KE_MORE;
+			clock_gettime(CLOCK_MONOTONIC, &finish);
+			nts_ke_accept_fail(c->addrbuf,
+			    lfptox(tspec_intv_to_lfp(sub_tspec(finish, c->start))));
+			return KE_NOSSL;
+		}
+		nts_ke_handshake_done(c->ssl, c->usingbuf, sizeof(c->usingbuf));
+		c->state = KE_READ;
+		/* FALLTHROUGH */
+	    case KE_READ:
+		rc = SSL_read(c->ssl, c->buff, sizeof(c->buff));
+		if (rc <= 0) {
+			if (ke_wait(c, rc))
+				return KE_MORE;
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_INFO, "NTS: SSL_read error: %s", errbuf);
+			nts_log_ssl_error();
+			return KE_BAD;
+		}
+		if (!nts_ke_reply(c->ssl, c->buff, rc, &c->used))
+			return KE_BAD;
+		c->state = KE_WRITE;
+		/* FALLTHROUGH */
+	    case KE_WRITE:
+		rc = SSL_write(c->ssl, c->buff, c->used);
+		if (rc <= 0) {
+			if (ke_wait(c, rc))
+				return KE_MORE;
+			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
+			msyslog(LOG_INFO, "NTS: SSL_write error: %s", errbuf);
+			nts_log_ssl_error();
+			return KE_BAD;
+		}
+		return KE_GOOD;
+	    case KE_LISTEN:
+	    default:
+		break;
+	}
+	return KE_BAD;
+}
+
+/* If SSL only needs the socket readable or writable to go on,
+ * have epoll wait for that and return true.
+ */
+bool ke_wait(ke_conn *c, int rc) {
+	struct epoll_event ev;
+	uint32_t events;
+
+	switch (SSL_get_error(c->ssl, rc)) {
+	    case SSL_ERROR_WANT_READ:
+		events = EPOLLIN;
+		break;
+	    case SSL_ERROR_WANT_WRITE:
+		events = EPOLLOUT;
+		break;
+	    default:
+		return false;
+	}
+	if (events != c->events) {
+		ZERO(ev);
+		ev.events = events;
+		ev.data.ptr = c;
+		/* If this fails, the deadline cleans up. */
+		(void)epoll_ctl(c->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+		c->events = events;
+	}
+	return true;
+}
+
+/* Finish with a connection: count it, log it and free it.
+ * For KE_NOSSL, why is a reason for the log, or NULL if the
+ * failure has been logged already.  Otherwise it is the word
+ * for the final message.
+ */
+void ke_close(ke_conn *c, enum ke_result result, const char *why) {
+	struct timespec finish;
+	l_fp wall;
+
+	if (NULL != c->ssl) {
+		if (KE_NOSSL != result)
+			SSL_shutdown(c->ssl);
+		SSL_free(c->ssl);
+	}
+	close(c->fd);		/* also takes it out of epoll */
+	UNLINK_DLIST(c, list);
+	ke_source_drop(c->src);
+
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	wall = tspec_intv_to_lfp(sub_tspec(finish, c->start));
+	nts_ke_account(result, wall, c->usr + c->sys);
+	if (KE_NOSSL != result)
+		nts_ke_log_done(c->addrbuf, why, c->usingbuf,
+				wall, c->usr, c->sys);
+	else if (NULL != why)
+		msyslog(LOG_INFO, "NTSs: SSL accept from %s failed: %s, took %.3f sec",
+			c->addrbuf, why, lfptox(wall));
+	free(c);
+}
+
+/* Drop connections that are past their deadline, and return the
+ * milliseconds until the next deadline, or -1 if there is none.
+ * Every connection gets the same time, so the oldest is due first.
+ */
+int ke_expire(struct ke_worker *w) {
+	struct timespec now, left;
+	ke_conn *c;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	while (NULL != (c = HEAD_DLIST(w->conns, list))) {
+		if (0 < cmp_tspec(c->deadline, now)) {
+			left = sub_tspec(c->deadline, now);
+			return (int)(left.tv_sec * 1000 +
+				     left.tv_nsec / 1000000) + 1;
+		}
+		if (KE_ACCEPT == c->state)
+			ke_close(c, KE_NOSSL, "timeout");
+		else
+			ke_close(c, KE_BAD, "Timeout");
+	}
+	return -1;
+}
+
+/* Count a new connection from addr.  Returns false, and counts
+ * it as limited, if the address already has kelimit open.
+ */
+bool ke_source_take(const sockaddr_u *addr, ke_source **srcp) {
+	ke_source **head, *s;
+	bool ok = true;
+
+	*srcp = NULL;
+	if (0 == ntsconfig.kelimit)
+		return true;
+
+	pthread_mutex_lock(&ke_lock);
+	head = &ke_sources[sock_hash(addr) & (KE_SOURCES - 1)];
+	for (s = *head; NULL != s; s = s->link)
+		if (SOCK_EQ(&s->addr, addr))
+			break;
+	if (NULL == s) {
+		s = emalloc_zero(sizeof(*s));
+		s->addr = *addr;
+		LINK_SLIST(*head, s, link);
+	}
+	if (s->count < ntsconfig.kelimit) {
+		s->count++;
+		*srcp = s;
+	} else {
+		ntske_cnt.serves_limited++;
+		ok = false;
+	}
+	pthread_mutex_unlock(&ke_lock);
+	return ok;
+}
+
+void ke_source_drop(ke_source *s) {
+	ke_source *found;
+
+	if (NULL == s)
+		return;
+	pthread_mutex_lock(&ke_lock);
+	if (0 == --s->count) {
+		UNLINK_SLIST(found, ke_sources[sock_hash(&s->addr) & (KE_SOURCES - 1)],
+			     s, link, ke_source);
+		INSIST(found == s);
+		free(s);
+	}
+	pthread_mutex_unlock(&ke_lock);
+}
+
+#else	/* !USE_KE_WORKERS */
+
 void* nts_ke_listener(void* arg) {
-	struct timeval timeout = {.tv_sec = NTS_KE_TIMEOUT, .tv_usec = 0};
+	struct timeval timeout = {.tv_sec = 0, .tv_usec = 0};
 	int sock = *(int*)arg;
 	char errbuf[100];
 	char addrbuf[100];
 	char usingbuf[100];
 	struct timespec start, finish;		/* wall clock */
-	l_fp wall;
+	l_fp wall, usr = 0, sys = 0;
 	bool worked;
-	const char *good;
 #ifdef RUSAGE_THREAD
 	struct timespec start_u, finish_u;	/* CPU user */
 	struct timespec start_s, finish_s;	/* CPU system */
-	l_fp usr, sys;
-	struct rusage usage;
 #endif
 
 #ifdef HAVE_SECCOMP_H
         setup_SIGSYS_trap();   /* enable trap for this thread */
 #endif
 
+	timeout.tv_sec = ntsconfig.ketimeout;
+
 #ifdef RUSAGE_THREAD
 	/* NB: start_u and start_s are from near the end of the previous cycle.
 	 * Thus usage timing includes the TCP accept and
 	 * writing the previous msyslog message.
 	 */
-	getrusage(RUSAGE_THREAD, &usage);
-	start_u = tval_to_tspec(usage.ru_utime);
-	start_s = tval_to_tspec(usage.ru_stime);
+	nts_ke_cpu(&start_u, &start_s);
 #endif
 
 	while(1) {
@@ -265,11 +913,11 @@ void* nts_ke_listener(void* arg) {
 			ntp_strerror_r(errno, errbuf, sizeof(errbuf));
 			msyslog(LOG_ERR, "NTSs: can't setsockopt: %s", errbuf);
 			close(client);
-			ntske_cnt.serves_bad++;
+			nts_ke_account(KE_BAD, 0, 0);
 			continue;
 		}
 
-		/* WARN: For high volume servers, this should go in a new thread. */
+		/* WARN: For high volume servers, use a system with epoll. */
 		nts_lock_certlock();
 		ssl = SSL_new(server_ctx);
 		nts_unlock_certlock();
@@ -281,35 +929,20 @@ void* nts_ke_listener(void* arg) {
 			nts_ke_accept_fail(addrbuf, lfptox(wall));
 			SSL_free(ssl);
 			close(client);
-			ntske_cnt.serves_nossl++;
-			ntske_cnt.serves_nossl_wall += wall;
 #ifdef RUSAGE_THREAD
-			getrusage(RUSAGE_THREAD, &usage);
-			finish_u = tval_to_tspec(usage.ru_utime);
-			finish_s = tval_to_tspec(usage.ru_stime);
+			nts_ke_cpu(&finish_u, &finish_s);
 			usr = tspec_intv_to_lfp(sub_tspec(finish_u, start_u));
 			sys = tspec_intv_to_lfp(sub_tspec(finish_s, start_s));
 			start_u = finish_u;
 			start_s = finish_s;
-			ntske_cnt.serves_nossl_cpu += usr;
-			ntske_cnt.serves_nossl_cpu += sys;
 #endif
+			nts_ke_account(KE_NOSSL, wall, usr + sys);
 			continue;
 		}
 
-		/* Save info for final message. */
-		snprintf(usingbuf, sizeof(usingbuf), "%s, %s (%d)",
-			SSL_get_version(ssl),
-			SSL_get_cipher_name(ssl),
-			SSL_get_cipher_bits(ssl, NULL));
-
-		if (nts_ke_request(ssl)) {
-			worked = true;
-			good = "OK";
-		} else {
-			worked = false;
-			good = "Failed";
-		}
+		nts_ke_handshake_done(ssl, usingbuf, sizeof(usingbuf));
+
+		worked = nts_ke_request(ssl);
 
 		SSL_shutdown(ssl);
 		SSL_free(ssl);
@@ -317,43 +950,42 @@ void* nts_ke_listener(void* arg) {
 
 		clock_gettime(CLOCK_MONOTONIC, &finish);
 		wall = tspec_intv_to_lfp(sub_tspec(finish, start));
-		if (worked) {
-			ntske_cnt.serves_good++;
-			ntske_cnt.serves_good_wall += wall;
-		} else {
-			ntske_cnt.serves_bad++;
-			ntske_cnt.serves_bad_wall += wall;
-		}
 #ifdef RUSAGE_THREAD
-		getrusage(RUSAGE_THREAD, &usage);
-		finish_u = tval_to_tspec(usage.ru_utime);
-		finish_s = tval_to_tspec(usage.ru_stime);
+		nts_ke_cpu(&finish_u, &finish_s);
 		usr = tspec_intv_to_lfp(sub_tspec(finish_u, start_u));
 		sys = tspec_intv_to_lfp(sub_tspec(finish_s, start_s));
 		start_u = finish_u;
 		start_s = finish_s;
-		if (worked) {
-			ntske_cnt.serves_good_cpu += usr;
-			ntske_cnt.serves_good_cpu += sys;
-		} else {
-			ntske_cnt.serves_bad_cpu += usr;
-			ntske_cnt.serves_bad_cpu += sys;
-		}
-		msyslog(LOG_INFO, "NTSs: NTS-KE from %s, %s, Using %s, took %.3f sec, CPU: %.3f+%.3f ms",
-			addrbuf, good, usingbuf, lfptox(wall),
-			lfptox(usr*1000), lfptox(sys*1000));
-#else
-		msyslog(LOG_INFO, "NTSs: NTS-KE from %s, %s, Using %s, took %.3f sec",
-			addrbuf, good, usingbuf, lfptox(wall));
 #endif
+		nts_ke_account(worked ? KE_GOOD : KE_BAD, wall, usr + sys);
+		nts_ke_log_done(addrbuf, worked ? "OK" : "Failed", usingbuf,
+				wall, usr, sys);
 	}
 	return NULL;
 }
 
+bool nts_ke_request(SSL *ssl) {
+	uint8_t buff[KE_BUFF_SIZE];
+	int bytes_read, bytes_written;
+	int used;
+
+	bytes_read = nts_ssl_read(ssl, buff, sizeof(buff));
+	if (0 > bytes_read)
+		return false;
+
+	if (!nts_ke_reply(ssl, buff, bytes_read, &used))
+		return false;
+
+	bytes_written = nts_ssl_write(ssl, buff, used);
+	return (bytes_written == used);
+}
+
+#endif	/* USE_KE_WORKERS */
+
 /* Analyze failure from SSL_accept
  * print single error message for common cases.
  */
-void nts_ke_accept_fail(char* addrbuf, double sec) {
+void nts_ke_accept_fail(const char* addrbuf, double sec) {
 	unsigned long err = ERR_peek_error();
 	int lib = ERR_GET_LIB(err);
 	int reason = ERR_GET_REASON(err);
@@ -376,21 +1008,14 @@ void nts_ke_accept_fail(char* addrbuf, double sec) {
 		addrbuf, msg, sec);
 }
 
-bool nts_ke_request(SSL *ssl) {
-	/* RFC 4: servers must accept 1024
-	 * Our cookies can be 104, 136, or 168 for AES_SIV_CMAC_xxx
-	 * 8*168 fits comfortably into 2K.
-	 */
-	uint8_t buff[2048];
+/* Process the request in buff and build the reply in its place.
+ * bytes_read is the length of the request, *used is set to the
+ * length of the reply.
+ */
+bool nts_ke_reply(SSL *ssl, uint8_t *buff, int bytes_read, int *used) {
 	uint8_t c2s[NTS_MAX_KEYLEN], s2c[NTS_MAX_KEYLEN];
 	int aead, keylen;
 	struct BufCtl_t buf;
-	int bytes_read, bytes_written;
-	int used;
-
-	bytes_read = nts_ssl_read(ssl, buff, sizeof(buff));
-	if (0 > bytes_read)
-		return false;
 
 	buf.next = buff;
 	buf.left = bytes_read;
@@ -408,19 +1033,16 @@ bool nts_ke_request(SSL *ssl) {
 		return false;
 
 	buf.next = buff;
-	buf.left = sizeof(buff);
+	buf.left = KE_BUFF_SIZE;
 	if (!nts_ke_setup_send(&buf, aead, c2s, s2c, keylen))
 		return false;
 
-	used = sizeof(buff)-buf.left;
-	bytes_written = nts_ssl_write(ssl, buff, used);
-	if (bytes_written != used)
-		return false;
+	*used = KE_BUFF_SIZE-buf.left;
 
 	/* Skip logging the normal case. */
 	if ((bytes_read!=16) || (aead!=15) )
-		msyslog(LOG_INFO, "NTSs: Read %d, wrote %d bytes.  AEAD=%d",
-			bytes_read, bytes_written, aead);
+		msyslog(LOG_INFO, "NTSs: Read %d, writing %d bytes.  AEAD=%d",
+			bytes_read, *used, aead);
 
 	return true;
 }
@@ -459,7 +1081,7 @@ bool create_listener4(int port) {
 		close(sock);
 		return false;
 	}
-	if (listen(sock, 6) < 0) {
+	if (listen(sock, KE_BACKLOG) < 0) {
 		ntp_strerror_r(errno, errbuf, sizeof(errbuf));
 		msyslog(LOG_ERR, "NTSs: can't listen4: %s", errbuf);
 		close(sock);
@@ -513,7 +1135,7 @@ bool create_listener6(int port) {
 		close(sock);
 		return false;
 	}
-	if (listen(sock, 6) < 0) {
+	if (listen(sock, KE_BACKLOG) < 0) {
 		ntp_strerror_r(errno, errbuf, sizeof(errbuf));
 		msyslog(LOG_ERR, "NTSs: can't listen6: %s", errbuf);
 		close(sock);
@@ -609,10 +1231,11 @@ bool nts_ke_setup_send(struct BufCtl_t *buf, int aead,
 	        ke_append_record_uint16(buf, nts_port_negotiation, extra_port);
 
 
+	uint8_t cookies[NTS_MAX_COOKIES][NTS_MAX_COOKIELEN];
+	int cookielen = nts_make_cookies(cookies[0], sizeof(cookies[0]),
+					 NTS_MAX_COOKIES, aead, c2s, s2c, keylen);
 	for (int i=0; i<NTS_MAX_COOKIES; i++) {
-		uint8_t cookie[NTS_MAX_COOKIELEN];
-		int cookielen = nts_make_cookie(cookie, aead, c2s, s2c, keylen);
-		ke_append_record_bytes(buf, nts_new_cookie, cookie, cookielen);
+		ke_append_record_bytes(buf, nts_new_cookie, cookies[i], cookielen);
 	}
 
 	/* 4.1.1: End, Critical */
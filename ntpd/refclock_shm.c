@@ -32,9 +32,7 @@
 #include <unistd.h>
 #include <stdio.h>
 
-#if defined(HAVE_STDATOMIC_H) && !defined(__COVERITY__)
-# include <stdatomic.h>
-#endif /* HAVE_STDATOMIC_H */
+#include "ntp_barrier.h"
 
 /*
  * This driver supports a reference clock attached through shared memory
@@ -305,12 +303,6 @@ struct shm_stat_t {
 	int leap;
 };
 
-static inline void memory_barrier(void) {
-#if defined(HAVE_STDATOMIC_H) && !defined(__COVERITY__)
-	atomic_thread_fence(memory_order_seq_cst);
-#endif /* HAVE_STDATOMIC_H */
-}
-
 static enum segstat_t shm_query(volatile struct shmTime *shm_in, struct shm_stat_t *shm_stat) {
 /* try to grab a sample from the specified SHM segment */
 	volatile struct shmTime shmcopy, *shm = shm_in;
@@ -1119,7 +1119,7 @@ trimble_io (
 	pp = peer->procptr;
 	up = pp->unitptr;
 
-	c = (char *) &rbufp->recv_buffer;
+	c = (char *) rbufp->recv_buffer;
 	d = c + rbufp->recv_length;
 
 	while (c != d) {
@@ -184,7 +184,7 @@ zyfer_receive(
 	peer = rbufp->recv_peer;
 	pp = peer->procptr;
 	up = pp->unitptr;
-	p = (uint8_t *) &rbufp->recv_buffer;
+	p = (uint8_t *) rbufp->recv_buffer;
 	/*
 	 * If lencode is 0:
 	 * - if *rbufp->recv_buffer is !
@@ -649,6 +649,7 @@ class MRUEntry:
         self.ct = 0             # count of packets received
         self.sc = None          # score
         self.dr = None          # dropped packets
+        self.pf = None          # limited for its prefix
 
     def avgint(self):
         last = ntp.ntpc.lfptofloat(self.last)
@@ -1355,7 +1356,8 @@ This combats source address spoofing
             elif tag == "last.newest":
                 # more finished
                 continue
-            for prefix in ("addr", "last", "first", "ct", "mv", "rs", "sc", "dr"):
+            for prefix in ("addr", "last", "first", "ct", "mv", "rs", "sc", "dr",
+                           "pf"):
                 if tag.startswith(prefix + "."):
                     (member, idx) = tag.split(".")
                     try:
@@ -1374,7 +1376,8 @@ This combats source address spoofing
             # Always 6 in practice, in the tests not so much
 #            if len(fake_dict[str(idx)]) != 6:
 #                continue
-            for prefix in ("addr", "last", "first", "ct", "mv", "rs", "sc", "dr"):
+            for prefix in ("addr", "last", "first", "ct", "mv", "rs", "sc", "dr",
+                           "pf"):
                 if prefix in fake_dict[str(idx)]:  # dodgy test needs this line
                     setattr(mru, prefix, fake_dict[str(idx)][prefix])
             span.entries.append(mru)
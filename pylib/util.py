@@ -1270,6 +1270,9 @@ class MRUSummary:
             rscode = 'L'
         else:
             rscode = '.'
+        if entry.pf:
+            # limited for its source prefix
+            rscode = rscode.lower()
         (ip, port) = portsplit(entry.addr)
         try:
             if not self.showhostnames & 1:  # if not & 1 display numeric IPs
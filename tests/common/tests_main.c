@@ -67,7 +67,9 @@ static void RunAllTests(void)
 #endif
 
 #ifdef TEST_NTPD
+	RUN_TEST_GROUP(destcache);
 	RUN_TEST_GROUP(leapsec);
+	RUN_TEST_GROUP(monitor);
 	RUN_TEST_GROUP(hackrestrict);
 	RUN_TEST_GROUP(recvbuff);
 #ifndef DISABLE_NTS
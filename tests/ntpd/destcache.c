@@ -0,0 +1,102 @@
+#include "config.h"
+
+#include "ntpd.h"
+
+#include "unity.h"
+#include "unity_fixture.h"
+
+static endpt	ep1, ep2, wild;
+
+static sockaddr_u
+v4(uint32_t addr)
+{
+	sockaddr_u sa;
+
+	ZERO(sa);
+	SET_AF(&sa, AF_INET);
+	SET_ADDR4(&sa, addr);
+	SET_PORT(&sa, 123);
+	return sa;
+}
+
+static bool
+cached(uint32_t addr, endpt *want)
+{
+	sockaddr_u	sa = v4(addr);
+	endpt *		ep = &ep1;	/* anything but want */
+
+	if (want == &ep1)
+		ep = &ep2;
+	return dest_cache_find(&sa, &ep) && ep == want;
+}
+
+static void
+store(uint32_t addr, endpt *ep)
+{
+	sockaddr_u sa = v4(addr);
+
+	dest_cache_store(&sa, ep);
+}
+
+TEST_GROUP(destcache);
+
+TEST_SETUP(destcache) {
+	dest_cache_flush();
+	wild.flags = INT_WILDCARD;
+	store(0x0a000001, &ep1);
+	store(0x0a000002, &ep2);
+	store(0x0a000003, &wild);
+	store(0x0a000004, NULL);
+}
+
+TEST_TEAR_DOWN(destcache) {
+	dest_cache_flush();
+}
+
+
+TEST(destcache, Hit) {
+	sockaddr_u	sa = v4(0x0a000001);
+	endpt *		ep = NULL;
+
+	TEST_ASSERT_TRUE(cached(0x0a000001, &ep1));
+	TEST_ASSERT_TRUE(cached(0x0a000004, NULL));
+	/* the port does not matter */
+	SET_PORT(&sa, 4567);
+	TEST_ASSERT_TRUE(dest_cache_find(&sa, &ep));
+	TEST_ASSERT_EQUAL_PTR(&ep1, ep);
+	/* nor does a destination never looked up */
+	sa = v4(0x0a000005);
+	TEST_ASSERT_FALSE(dest_cache_find(&sa, &ep));
+}
+
+TEST(destcache, NewEndpoint) {
+	/* a new endpoint leaves the bound choices alone */
+	dest_cache_drop_unbound();
+	TEST_ASSERT_TRUE(cached(0x0a000001, &ep1));
+	TEST_ASSERT_TRUE(cached(0x0a000002, &ep2));
+	TEST_ASSERT_FALSE(cached(0x0a000003, &wild));
+	TEST_ASSERT_FALSE(cached(0x0a000004, NULL));
+}
+
+TEST(destcache, EndpointGone) {
+	/* one going away takes only its own */
+	dest_cache_drop(&ep1);
+	TEST_ASSERT_FALSE(cached(0x0a000001, &ep1));
+	TEST_ASSERT_TRUE(cached(0x0a000002, &ep2));
+	TEST_ASSERT_TRUE(cached(0x0a000003, &wild));
+	TEST_ASSERT_TRUE(cached(0x0a000004, NULL));
+}
+
+TEST(destcache, RouteChange) {
+	dest_cache_flush();
+	TEST_ASSERT_FALSE(cached(0x0a000001, &ep1));
+	TEST_ASSERT_FALSE(cached(0x0a000002, &ep2));
+	TEST_ASSERT_FALSE(cached(0x0a000004, NULL));
+}
+
+TEST_GROUP_RUNNER(destcache) {
+	RUN_TEST_CASE(destcache, Hit);
+	RUN_TEST_CASE(destcache, NewEndpoint);
+	RUN_TEST_CASE(destcache, EndpointGone);
+	RUN_TEST_CASE(destcache, RouteChange);
+}
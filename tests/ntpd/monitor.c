@@ -0,0 +1,422 @@
+#include "config.h"
+
+#include <math.h>
+
+#include "ntpd.h"
+
+#include "unity.h"
+#include "unity_fixture.h"
+
+static struct monitor_data saved;
+static endpt	ep1, ep2;
+
+static void
+from(struct recvbuf *rb, uint32_t addr, endpt *ep, unsigned int sec)
+{
+	memset(rb, 0, sizeof(*rb));
+	rb->recv_buffer = rb->recv_space;
+	SET_AF(&rb->recv_srcadr, AF_INET);
+	SET_ADDR4(&rb->recv_srcadr, addr);
+	SET_PORT(&rb->recv_srcadr, 123);
+	rb->recv_buffer[0] = PKT_LI_VN_MODE(0, 4, MODE_CLIENT);
+	rb->recv_time = lfpinit((int32_t)sec, 0);
+	rb->dstadr = ep;
+}
+
+static void
+hit(uint32_t addr, endpt *ep, unsigned int sec)
+{
+	struct recvbuf rb;
+
+	from(&rb, addr, ep, sec);
+	ntp_monitor(&rb, 0);
+}
+
+/* the restrict flags ntp_monitor() hands back */
+static unsigned short
+limit(uint32_t addr, unsigned int sec, unsigned short flags)
+{
+	struct recvbuf rb;
+
+	from(&rb, addr, &ep1, sec);
+	return ntp_monitor(&rb, flags);
+}
+
+/* 2001:db8:0:<net>::<host> */
+static void
+hit6(unsigned int net, unsigned int host, unsigned int sec)
+{
+	struct recvbuf rb;
+	struct in6_addr a6;
+
+	from(&rb, 0, &ep1, sec);
+	memset(&a6, 0, sizeof(a6));
+	a6.s6_addr[0] = 0x20;
+	a6.s6_addr[1] = 0x01;
+	a6.s6_addr[2] = 0x0d;
+	a6.s6_addr[3] = 0xb8;
+	a6.s6_addr[6] = (uint8_t)(net >> 8);
+	a6.s6_addr[7] = (uint8_t)net;
+	a6.s6_addr[14] = (uint8_t)(host >> 8);
+	a6.s6_addr[15] = (uint8_t)host;
+	SET_AF(&rb.recv_srcadr, AF_INET6);
+	SET_ADDR6N(&rb.recv_srcadr, a6);
+	ntp_monitor(&rb, 0);
+}
+
+static mon_entry *
+lookup(uint32_t addr)
+{
+	sockaddr_u sa;
+
+	memset(&sa, 0, sizeof(sa));
+	SET_AF(&sa, AF_INET);
+	SET_ADDR4(&sa, addr);
+	return mon_get_slot(&sa);
+}
+
+
+TEST_GROUP(monitor);
+
+TEST_SETUP(monitor) {
+	saved = mon_data;	/* for the knobs */
+	ep1.ifnum = 1;
+	ep2.ifnum = 2;
+	mon_start();
+}
+
+TEST_TEAR_DOWN(monitor) {
+	mon_stop();
+	mon_data.mru_mindepth = saved.mru_mindepth;
+	mon_data.mru_maxdepth = saved.mru_maxdepth;
+	mon_data.mru_minage = saved.mru_minage;
+	mon_data.decay_time = saved.decay_time;
+	mon_data.prefix_v4 = saved.prefix_v4;
+	mon_data.prefix_v6 = saved.prefix_v6;
+	mon_data.prefix_limit = saved.prefix_limit;
+	mon_data.prefix_new = 0;
+	mon_data.prefix_recycled = 0;
+	mon_data.prefix_limited = 0;
+	mon_data.prefix_kods = 0;
+}
+
+
+TEST(monitor, CountsPerAddress) {
+	uint32_t a;
+	sockaddr_u sa;
+
+	for (a = 1; a <= 1000; a++)
+		hit(0x0a000000 + a, &ep1, 1000 + a);
+	for (a = 1; a <= 1000; a++)
+		hit(0x0a000000 + a, &ep1, 3000 + a);
+
+	mon_sum_stats();
+	TEST_ASSERT_EQUAL(1000, mon_data.mru_entries);
+	for (a = 1; a <= 1000; a++) {
+		mon_entry *mon = lookup(0x0a000000 + a);
+
+		TEST_ASSERT_NOT_NULL(mon);
+		TEST_ASSERT_EQUAL(2, mon->count);
+		/* one cache line each */
+		TEST_ASSERT_EQUAL(0, (uintptr_t)mon % 64);
+		mon_get_addr(mon, &sa);
+		TEST_ASSERT_EQUAL_UINT32(0x0a000000 + a, SRCADR(&sa));
+		TEST_ASSERT_EQUAL(123, SRCPORT(&sa));
+	}
+	TEST_ASSERT_NULL(lookup(0x0b000001));
+}
+
+TEST(monitor, MaxdepthRecyclesUnreferenced) {
+	uint32_t a;
+	unsigned int t = 10000;
+	unsigned int n;
+	uint64_t full;
+	mon_entry *mon;
+	sockaddr_u sa;
+
+	mon_data.mru_mindepth = 10;
+	mon_data.mru_maxdepth = 100;
+	mon_data.mru_minage = 0;
+	mon_sum_stats();
+	full = mon_data.mru_recyclefull;
+
+	/* a busy client keeps its entry while others churn */
+	for (a = 1; a <= 1000; a++) {
+		hit(0x0a000000 + a, &ep1, t++);
+		hit(0x0b000001, &ep1, t++);
+	}
+
+	mon_sum_stats();
+	TEST_ASSERT_EQUAL(100, mon_data.mru_entries);
+	TEST_ASSERT_TRUE(mon_data.mru_recyclefull > full);
+	TEST_ASSERT_EQUAL(1000, lookup(0x0b000001)->count);
+	TEST_ASSERT_NOT_NULL(lookup(0x0a000000 + 1000));
+	TEST_ASSERT_NULL(lookup(0x0a000001));
+
+	/* everything left is still found where it is */
+	mon_walk_start(NULL);
+	for (n = 0; NULL != (mon = mon_walk_next()); n++) {
+		mon_get_addr(mon, &sa);
+		TEST_ASSERT_EQUAL_PTR(mon, mon_get_slot(&sa));
+	}
+	TEST_ASSERT_EQUAL(100, n);
+}
+
+TEST(monitor, MaxageRecyclesOld) {
+	uint64_t old;
+
+	mon_data.mru_mindepth = 1;
+	mon_sum_stats();
+	old = mon_data.mru_recycleold;
+
+	hit(0x0a000001, &ep1, 1000);
+	hit(0x0a000002, &ep1, 1000 + mon_data.mru_maxage + 10);
+
+	mon_sum_stats();
+	TEST_ASSERT_EQUAL(1, mon_data.mru_entries);
+	TEST_ASSERT_EQUAL(old + 1, mon_data.mru_recycleold);
+	TEST_ASSERT_NULL(lookup(0x0a000001));
+	TEST_ASSERT_EQUAL(5, mon_get_oldest_age(
+		lfpinit((int32_t)(1000 + mon_data.mru_maxage + 15), 0)));
+}
+
+TEST(monitor, ClearInterface) {
+	uint32_t a;
+
+	for (a = 1; a <= 300; a++)
+		hit(0x0a000000 + a, (a % 3) ? &ep1 : &ep2, 1000 + a);
+	mon_clearinterface(&ep2);
+
+	mon_sum_stats();
+	TEST_ASSERT_EQUAL(200, mon_data.mru_entries);
+	for (a = 1; a <= 300; a++)
+		if (a % 3)
+			TEST_ASSERT_NOT_NULL(lookup(0x0a000000 + a));
+		else
+			TEST_ASSERT_NULL(lookup(0x0a000000 + a));
+}
+
+TEST(monitor, WalkIsOldestFirst) {
+	uint32_t a;
+	unsigned int n;
+	l_fp prev;
+	mon_entry *mon;
+
+	/* arrival order scrambled against address order */
+	for (a = 0; a < 500; a++)
+		hit(0x0a000000 + (a * 7919) % 500, &ep1, 1000 + a);
+
+	/* walk half way */
+	mon_walk_start(NULL);
+	for (n = 0; n < 250; n++)
+		mon = mon_walk_next();
+	TEST_ASSERT_EQUAL(1000 + 249, lfpuint(mon->last));
+
+	/* something the client already has is heard from again */
+	hit(0x0a000000, &ep1, 5000);
+
+	/* resume from the last one returned */
+	mon_walk_start(mon);
+	prev = mon->last;
+	for (n = 0; NULL != (mon = mon_walk_next()); n++) {
+		TEST_ASSERT_TRUE(mon->last > prev);
+		prev = mon->last;
+	}
+	TEST_ASSERT_EQUAL(251, n);
+	TEST_ASSERT_EQUAL(5000, lfpuint(prev));
+}
+
+TEST(monitor, WalkSpansSnapshots) {
+	uint32_t a;
+	unsigned int n;
+	l_fp prev;
+	mon_entry *mon;
+
+	/* several snapshots' worth */
+	for (a = 0; a < 2000; a++)
+		hit(0x0a000000 + (a * 7919) % 2000, &ep1, 1000 + a);
+
+	mon_walk_start(NULL);
+	prev = 0;
+	for (n = 0; NULL != (mon = mon_walk_next()); n++) {
+		TEST_ASSERT_TRUE(mon->last > prev);
+		prev = mon->last;
+		/* heard from again mid-walk, comes round once more */
+		if (700 == n)
+			hit(0x0a000000, &ep1, 9000);
+	}
+	TEST_ASSERT_EQUAL(2001, n);
+	TEST_ASSERT_EQUAL(9000, lfpuint(prev));
+}
+
+TEST(monitor, PrefixAggregatesV4) {
+	uint32_t a;
+
+	mon_data.prefix_v4 = 24;
+	for (a = 1; a <= 50; a++) {
+		hit(0x0a000000 + a, &ep1, 1000 + a);	/* 10.0.0.0/24 */
+		hit(0x0a000100 + a, &ep1, 1000 + a);	/* 10.0.1.0/24 */
+	}
+	hit(0x0a0001ff, &ep1, 2000);
+	mon_sum_stats();
+	TEST_ASSERT_EQUAL(101, mon_data.mru_entries);
+	TEST_ASSERT_EQUAL(2, mon_data.prefix_new);
+	TEST_ASSERT_EQUAL(2, mon_data.prefix_used);
+	TEST_ASSERT_EQUAL(0, mon_data.prefix_recycled);
+}
+
+TEST(monitor, PrefixAggregatesV6) {
+	unsigned int h;
+
+	mon_data.prefix_v6 = 64;
+	for (h = 1; h <= 50; h++) {
+		hit6(1, h, 1000 + h);
+		hit6(2, h, 1000 + h);
+	}
+	/* same bytes, other family, other prefix */
+	hit(0x20010db8, &ep1, 2000);
+	TEST_ASSERT_EQUAL(2, mon_data.prefix_new);
+
+	/* a /48 takes in both */
+	mon_stop();
+	mon_start();
+	mon_data.prefix_new = 0;
+	mon_data.prefix_v6 = 48;
+	hit6(1, 1, 3000);
+	hit6(2, 1, 3001);
+	TEST_ASSERT_EQUAL(1, mon_data.prefix_new);
+}
+
+TEST(monitor, PrefixEvictsStalest) {
+	unsigned int n, many, t = 1000;
+
+	/* a busy prefix is never the stalest of its set */
+	mon_data.prefix_v4 = 24;
+	hit(0x0b000001, &ep1, t++);
+	many = 2 * (unsigned int)mon_data.prefix_slots;
+	for (n = 0; n < many; n++) {
+		hit(0x0c000001 + (n << 8), &ep1, t++);
+		hit(0x0b000001, &ep1, t++);
+	}
+	TEST_ASSERT_EQUAL(1 + many, mon_data.prefix_new);
+	TEST_ASSERT_TRUE(mon_data.prefix_used <= mon_data.prefix_slots);
+	TEST_ASSERT_EQUAL(mon_data.prefix_new - mon_data.prefix_used,
+			  mon_data.prefix_recycled);
+}
+
+TEST(monitor, PrefixLimitFires) {
+	const unsigned short flags = RES_LIMITED | RES_KOD;
+	unsigned short mask;
+	uint32_t a;
+
+	/* many addresses, each well within its own limit */
+	mon_data.prefix_v4 = 24;
+	mon_data.prefix_limit = 2.0;
+	for (a = 1; a < 100; a++) {
+		mask = limit(0x0a000000 + a, 1000, flags);
+		if (mask & RES_LIMITED)
+			break;
+	}
+	/* 2.0 / (1/decay_time) packets at once, give or take rounding */
+	TEST_ASSERT_TRUE(a >= 2 * mon_data.decay_time &&
+			 a <= 2 * mon_data.decay_time + 1);
+	TEST_ASSERT_EQUAL(1, mon_data.prefix_limited);
+	TEST_ASSERT_EQUAL(1, mon_data.prefix_kods);
+	TEST_ASSERT_EQUAL(1, lookup(0x0a000000 + a)->prefixed);
+
+	/* another prefix is not held back */
+	mask = limit(0x0a000101, 1000, flags);
+	TEST_ASSERT_EQUAL(0, mask & (RES_LIMITED | RES_KOD));
+
+	/* nor is anything without RES_LIMITED */
+	mask = limit(0x0a000000 + 200, 1000, RES_KOD);
+	TEST_ASSERT_EQUAL(1, mon_data.prefix_limited);
+
+	/* a big burst gets no KoDs */
+	for (a = 300; a < 320; a++)
+		mask = limit(0x0a000000 + (a & 0xff), 1000, flags);
+	TEST_ASSERT_EQUAL(RES_LIMITED, mask & (RES_LIMITED | RES_KOD));
+}
+
+static l_fp
+random_interval(l_fp most)
+{
+	l_fp r = ((uint64_t)(uint32_t)random() << 32) | (uint32_t)random();
+
+	return r % most;
+}
+
+/* the float calculation ntp_monitor() did before the tables */
+static float
+ref_decay(l_fp interval)
+{
+	return expf(-ldexpf(interval, -32) / mon_data.decay_time);
+}
+
+TEST(monitor, DecayMatchesExpf) {
+	float taus[] = { 20, 8 };
+	float ref, got;
+	l_fp interval;
+	size_t i;
+	int n;
+
+	srandom(1);
+	for (i = 0; i < COUNTOF(taus); i++) {
+		mon_data.decay_time = taus[i];
+		mon_start();
+		for (n = 0; n < 200000; n++) {
+			interval = random_interval((uint64_t)300 << 32);
+			ref = ref_decay(interval);
+			got = mon_decay(interval);
+			TEST_ASSERT_TRUE(fabsf(got - ref) <= ref * 1e-5f);
+		}
+		TEST_ASSERT_EQUAL_FLOAT(1.0, mon_decay(0));
+	}
+}
+
+TEST(monitor, DecayGivesSameDecisions) {
+	const float limits[] = {
+		mon_data.rate_limit,
+		mon_data.rate_limit + mon_data.kod_limit
+	};
+	float ref, got;
+	l_fp interval;
+	size_t i;
+	int n, close = 0;
+
+	srandom(2);
+	mon_start();
+	ref = got = 1.0 / mon_data.decay_time;
+	for (n = 0; n < 1000000; n++) {
+		/* bursts, with the odd pause */
+		if (random() % 8)
+			interval = random_interval((uint64_t)1 << 31);
+		else
+			interval = random_interval((uint64_t)30 << 32);
+		ref = ref * ref_decay(interval) + 1.0 / mon_data.decay_time;
+		got = got * mon_decay(interval) + 1.0 / mon_data.decay_time;
+		TEST_ASSERT_TRUE(fabsf(got - ref) <= ref * 1e-4f);
+		for (i = 0; i < COUNTOF(limits); i++) {
+			if (fabsf(ref - limits[i]) <= limits[i] * 1e-4f)
+				close++;
+			else
+				TEST_ASSERT_EQUAL(ref < limits[i], got < limits[i]);
+		}
+	}
+	TEST_ASSERT_TRUE(close < 1000);
+}
+
+TEST_GROUP_RUNNER(monitor) {
+	RUN_TEST_CASE(monitor, CountsPerAddress);
+	RUN_TEST_CASE(monitor, MaxdepthRecyclesUnreferenced);
+	RUN_TEST_CASE(monitor, MaxageRecyclesOld);
+	RUN_TEST_CASE(monitor, ClearInterface);
+	RUN_TEST_CASE(monitor, WalkIsOldestFirst);
+	RUN_TEST_CASE(monitor, WalkSpansSnapshots);
+	RUN_TEST_CASE(monitor, PrefixAggregatesV4);
+	RUN_TEST_CASE(monitor, PrefixAggregatesV6);
+	RUN_TEST_CASE(monitor, PrefixEvictsStalest);
+	RUN_TEST_CASE(monitor, PrefixLimitFires);
+	RUN_TEST_CASE(monitor, DecayMatchesExpf);
+	RUN_TEST_CASE(monitor, DecayGivesSameDecisions);
+}
@@ -9,11 +9,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
 #include "aes_siv.h"
 
-extern AES_SIV_CTX* cookie_ctx;
 extern uint8_t K[NTS_MAX_KEYLEN], K2[NTS_MAX_KEYLEN];
 extern uint32_t I;
+extern int K_length;
 
 TEST_GROUP(nts_cookie);
 
@@ -77,6 +78,118 @@ TEST(nts_cookie, nts_make_unpack_cookie) {
 	TEST_ASSERT_EQUAL_UINT8_ARRAY(s2c, s2c_2, 16);
 }
 
+TEST(nts_cookie, nts_cookie_matches_oneshot) {
+	/* cookies made from the pre-keyed contexts are still plain
+	 * AES_SIV_Encrypt() output */
+	uint8_t cookie[NTS_MAX_COOKIELEN];
+	uint8_t plain[NTS_MAX_COOKIELEN];
+	uint8_t c2s[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+	uint8_t s2c[16] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+	size_t plainlen = sizeof(plain);
+	AES_SIV_CTX *ctx = AES_SIV_CTX_new();
+	int len;
+	int ok;
+	nts_cookie_init();
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	len = nts_make_cookie(cookie, AEAD_AES_SIV_CMAC_256, c2s, s2c, sizeof(c2s));
+	TEST_ASSERT_EQUAL(72, len);
+	ok = AES_SIV_Decrypt(ctx, plain, &plainlen,
+			     nts_keys[0].K, K_length,
+			     cookie + 4, 16,
+			     cookie + 20, len - 20,
+			     cookie, 20);
+	AES_SIV_CTX_free(ctx);
+	TEST_ASSERT_EQUAL(1, ok);
+	TEST_ASSERT_EQUAL(36, plainlen);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(c2s, plain + 4, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(s2c, plain + 20, 16);
+}
+
+TEST(nts_cookie, nts_make_cookies) {
+	/* a batch, stride apart, with a nonce of its own each,
+	 * more than one pool's worth */
+	uint8_t cookies[100][80];
+	uint8_t c2s[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+	uint8_t s2c[16] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+	uint8_t c2s_2[16], s2c_2[16];
+	uint16_t aead;
+	int keylen;
+	int len;
+	nts_cookie_init();
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	memset(cookies, 0xaa, sizeof(cookies));
+	len = nts_make_cookies(cookies[0], sizeof(cookies[0]), 100,
+			       AEAD_AES_SIV_CMAC_256, c2s, s2c, sizeof(c2s));
+	TEST_ASSERT_EQUAL(72, len);
+	for (int i=0; i<100; i++) {
+		TEST_ASSERT_EQUAL_UINT8(0xaa, cookies[i][72]);
+		TEST_ASSERT_TRUE(nts_unpack_cookie(cookies[i], len, &aead,
+						   c2s_2, s2c_2, &keylen));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(s2c, s2c_2, 16);
+		for (int j=0; j<i; j++)
+			TEST_ASSERT_TRUE(0 != memcmp(cookies[i] + 4,
+						     cookies[j] + 4,
+						     NONCE_LENGTH));
+	}
+}
+
+static uint8_t thread_cookie[NTS_MAX_COOKIELEN];
+
+static void *make_thread_cookie(void *arg) {
+	uint8_t c2s[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+	*(int *)arg = nts_make_cookie(thread_cookie, AEAD_AES_SIV_CMAC_256,
+				      c2s, c2s, sizeof(c2s));
+	return NULL;
+}
+
+TEST(nts_cookie, nts_cookie_other_thread) {
+	/* a cookie made on another thread, with its own contexts and
+	 * copy of the keys, opens here, and it sees new keys */
+	uint8_t c2s[16], s2c[16];
+	uint16_t aead;
+	pthread_t tid;
+	int keylen;
+	int len = 0;
+	nts_cookie_init();
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	TEST_ASSERT_EQUAL(0, pthread_create(&tid, NULL, make_thread_cookie, &len));
+	pthread_join(tid, NULL);
+	TEST_ASSERT_EQUAL(72, len);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&nts_keys[0].I, thread_cookie, 4);
+	TEST_ASSERT_TRUE(nts_unpack_cookie(thread_cookie, len, &aead,
+					   c2s, s2c, &keylen));
+	nts_make_cookie_key();
+	TEST_ASSERT_EQUAL(0, pthread_create(&tid, NULL, make_thread_cookie, &len));
+	pthread_join(tid, NULL);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&nts_keys[0].I, thread_cookie, 4);
+	TEST_ASSERT_TRUE(nts_unpack_cookie(thread_cookie, len, &aead,
+					   c2s, s2c, &keylen));
+}
+
+TEST(nts_cookie, nts_ticket_key) {
+	/* tickets use the newest key and name it; a named older key
+	 * is still found, and is gone once its cookie key is */
+	uint8_t name[NTS_TICKET_NAME_LEN], old[NTS_TICKET_NAME_LEN];
+	uint8_t aes[NTS_TICKET_KEY_LEN], hmac[NTS_TICKET_KEY_LEN];
+	uint8_t aes2[NTS_TICKET_KEY_LEN], hmac2[NTS_TICKET_KEY_LEN];
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	TEST_ASSERT_EQUAL(0, nts_ticket_key(NULL, old, aes, hmac));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&nts_keys[0].I, old, 4);
+	nts_make_cookie_key();
+	TEST_ASSERT_EQUAL(0, nts_ticket_key(NULL, name, aes2, hmac2));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&nts_keys[0].I, name, 4);
+	TEST_ASSERT_EQUAL(1, nts_ticket_key(old, NULL, aes2, hmac2));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(aes, aes2, NTS_TICKET_KEY_LEN);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(hmac, hmac2, NTS_TICKET_KEY_LEN);
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	TEST_ASSERT_EQUAL(-1, nts_ticket_key(old, NULL, aes2, hmac2));
+}
+
 const char *cookie_file_name = "test-cookie-keys";
 
 TEST(nts_cookie, nts_read_write_cookies) {
@@ -109,6 +222,10 @@ TEST(nts_cookie, nts_read_write_cookies) {
 
 TEST_GROUP_RUNNER(nts_cookie) {
 	RUN_TEST_CASE(nts_cookie, nts_make_unpack_cookie);
+	RUN_TEST_CASE(nts_cookie, nts_cookie_matches_oneshot);
+	RUN_TEST_CASE(nts_cookie, nts_make_cookies);
+	RUN_TEST_CASE(nts_cookie, nts_ticket_key);
+	RUN_TEST_CASE(nts_cookie, nts_cookie_other_thread);
 	RUN_TEST_CASE(nts_cookie, nts_make_cookie_key);
 	RUN_TEST_CASE(nts_cookie, nts_read_write_cookies);
 	/* This test gets run as root during install
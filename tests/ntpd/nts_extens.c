@@ -225,7 +225,51 @@ TEST(nts_extens, extens_server_recv) {
 	/* TEST_ASSERT_EQUAL(true, ok); //disable */
 }
 
+TEST(nts_extens, extens_server_send) {
+	/* one cookie out, seven placeholders: the reply carries a
+	 * batch of 8 fresh cookies the client can open and use */
+	struct peer peer;
+	struct ntspacket_t ntspkt;
+	struct pkt xpkt;
+	uint8_t c2s[32], s2c[32], c2s_2[32], s2c_2[32];
+	uint16_t aead;
+	int keylen;
+	int used;
+	memset(&peer, 0, sizeof(peer));
+	memset(&ntspkt, 0, sizeof(ntspkt));
+	memset(&xpkt, 0, sizeof(xpkt));
+	for (int i=0; i<32; i++) {
+		c2s[i] = i;
+		s2c[i] = 32-i;
+	}
+	nts_cookie_init();
+	nts_nKeys = 0;
+	nts_make_cookie_key();
+	memcpy(peer.nts_state.c2s, c2s, sizeof(c2s));
+	memcpy(peer.nts_state.s2c, s2c, sizeof(s2c));
+	peer.nts_state.keylen = sizeof(c2s);
+	peer.nts_state.cookielen = nts_make_cookie(peer.nts_state.cookies[0],
+		AEAD_AES_SIV_CMAC_256, c2s, s2c, sizeof(c2s));
+	peer.nts_state.count = 1;
+	peer.nts_state.writeIdx = 1;
+	/* Test */
+	used = extens_client_send(&peer, &xpkt);
+	TEST_ASSERT_TRUE(extens_server_recv(&ntspkt, (uint8_t *)&xpkt,
+					    LEN_PKT_NOMAC+used));
+	TEST_ASSERT_EQUAL(NTS_MAX_COOKIES, ntspkt.needed);
+	used = extens_server_send(&ntspkt, &xpkt);
+	TEST_ASSERT_TRUE(extens_client_recv(&peer, (uint8_t *)&xpkt,
+					    LEN_PKT_NOMAC+used));
+	TEST_ASSERT_EQUAL(NTS_MAX_COOKIES, peer.nts_state.count);
+	for (int i=0; i<NTS_MAX_COOKIES; i++) {
+		TEST_ASSERT_TRUE(nts_unpack_cookie(peer.nts_state.cookies[i],
+			peer.nts_state.cookielen, &aead, c2s_2, s2c_2, &keylen));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(s2c, s2c_2, sizeof(s2c));
+	}
+}
+
 TEST_GROUP_RUNNER(nts_extens) {
 	RUN_TEST_CASE(nts_extens, extens_client_send);
 	RUN_TEST_CASE(nts_extens, extens_server_recv);
+	RUN_TEST_CASE(nts_extens, extens_server_send);
 }
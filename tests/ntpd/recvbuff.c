@@ -28,7 +28,88 @@ TEST(recvbuff, GetAndFree) {
 	TEST_ASSERT_EQUAL(initial, free_recvbuffs());
 }
 
+TEST(recvbuff, Expand) {
+	unsigned long initial = total_recvbuffs();
+
+	/* never shrinks */
+	expand_recvbuff(1);
+	TEST_ASSERT_EQUAL(initial, total_recvbuffs());
+
+	expand_recvbuff(initial + RECV_BATCH_MAX);
+	TEST_ASSERT_EQUAL(initial + RECV_BATCH_MAX, total_recvbuffs());
+	TEST_ASSERT_EQUAL(initial + RECV_BATCH_MAX, free_recvbuffs());
+}
+
+TEST(recvbuff, SmallAndJumbo) {
+	unsigned long jumbos = free_jumbo_buffs();
+	struct iovec iov[2];
+	recvbuf_t* buf;
+
+	/* a bare request stays in the buffer, no jumbo slot is lent */
+	buf = get_free_recv_buffer_iov(iov);
+	TEST_ASSERT_NOT_NULL(buf);
+	TEST_ASSERT_EQUAL(jumbos, free_jumbo_buffs());
+	memset(iov[0].iov_base, 0xe3, LEN_PKT_NOMAC);
+	TEST_ASSERT_TRUE(recvbuf_settle(buf, iov, LEN_PKT_NOMAC));
+	TEST_ASSERT_EQUAL(jumbos, free_jumbo_buffs());
+	TEST_ASSERT_EQUAL_PTR(buf->recv_space, buf->recv_buffer);
+	TEST_ASSERT_NULL(buf->ntspacket);
+	freerecvbuf(buf);
+
+	/* a long one is put together in the jumbo slot */
+	buf = get_free_recv_buffer_iov(iov);
+	TEST_ASSERT_NOT_NULL(buf);
+	TEST_ASSERT_EQUAL(jumbos, free_jumbo_buffs());
+	memset(iov[0].iov_base, 0x11, iov[0].iov_len);
+	memset(iov[1].iov_base, 0x22, 100);
+	TEST_ASSERT_TRUE(recvbuf_settle(buf, iov, iov[0].iov_len + 100));
+	TEST_ASSERT_EQUAL(jumbos - 1, free_jumbo_buffs());
+	TEST_ASSERT_NOT_NULL(buf->ntspacket);
+	TEST_ASSERT_EQUAL_HEX8(0x11, buf->recv_buffer[0]);
+	TEST_ASSERT_EQUAL_HEX8(0x11, buf->recv_buffer[RX_SMALL_SIZE - 1]);
+	TEST_ASSERT_EQUAL_HEX8(0x22, buf->recv_buffer[RX_SMALL_SIZE]);
+	TEST_ASSERT_EQUAL_HEX8(0x22, buf->recv_buffer[RX_SMALL_SIZE + 99]);
+	freerecvbuf(buf);
+	TEST_ASSERT_EQUAL(jumbos, free_jumbo_buffs());
+}
+
+TEST(recvbuff, JumboShortfall) {
+	recvbuf_t* held[RECV_JUMBO_MAX];
+	unsigned long njumbo = 0;
+	struct iovec iov[2];
+	recvbuf_t* buf;
+	unsigned long i;
+
+	expand_recvbuff(RECV_JUMBO_MAX + 1);
+	while (free_jumbo_buffs() > 0 && njumbo < COUNTOF(held)) {
+		held[njumbo] = get_free_recv_buffer_iov(iov);
+		TEST_ASSERT_NOT_NULL(held[njumbo]);
+		TEST_ASSERT_TRUE(recvbuf_settle(held[njumbo], iov,
+						RX_SMALL_SIZE + 1));
+		njumbo++;
+	}
+	TEST_ASSERT_EQUAL(0, free_jumbo_buffs());
+
+	/* a small one still gets through, a long one is refused */
+	buf = get_free_recv_buffer_iov(iov);
+	TEST_ASSERT_NOT_NULL(buf);
+	TEST_ASSERT_TRUE(recvbuf_settle(buf, iov, LEN_PKT_NOMAC));
+	freerecvbuf(buf);
+	buf = get_free_recv_buffer_iov(iov);
+	TEST_ASSERT_NOT_NULL(buf);
+	TEST_ASSERT_FALSE(recvbuf_settle(buf, iov, RX_SMALL_SIZE + 1));
+	TEST_ASSERT_NULL(buf->jumbo);
+	freerecvbuf(buf);
+
+	for (i = 0; i < njumbo; i++)
+		freerecvbuf(held[i]);
+	TEST_ASSERT_EQUAL(njumbo, free_jumbo_buffs());
+}
+
 TEST_GROUP_RUNNER(recvbuff) {
 	RUN_TEST_CASE(recvbuff, Initialization);
 	RUN_TEST_CASE(recvbuff, GetAndFree);
+	RUN_TEST_CASE(recvbuff, Expand);
+	RUN_TEST_CASE(recvbuff, SmallAndJumbo);
+	RUN_TEST_CASE(recvbuff, JumboShortfall);
 }
@@ -21,6 +21,19 @@ create_sockaddr_u(unsigned short sin_port, const char* ip_addr)
 	return sockaddr;
 }
 
+static sockaddr_u
+create_sockaddr6_u(unsigned short sin_port, const char* ip_addr)
+{
+	sockaddr_u sockaddr;
+
+	memset(&sockaddr, 0, sizeof(sockaddr));
+	SET_AF(&sockaddr, AF_INET6);
+	NSRCPORT(&sockaddr) = htons(sin_port);
+	inet_pton(AF_INET6, ip_addr, PSOCK_ADDR6(&sockaddr));
+
+	return sockaddr;
+}
+
 TEST_GROUP(hackrestrict);
 
 TEST_SETUP(hackrestrict) {
@@ -52,6 +65,7 @@ TEST_TEAR_DOWN(hackrestrict) {
 	} while (current != NULL);
 
 	free(empty_restrict);
+	restrict_file(NULL, 0, 0);
 }
 
 /* Tests */
@@ -184,6 +198,245 @@ TEST(hackrestrict, RestrictUnflagWorks) {
 	TEST_ASSERT_EQUAL(1, restrictions(&resaddr));
 }
 
+
+TEST(hackrestrict, NtpOnlyMatchesOnlyNtpPort) {
+	sockaddr_u resaddr = create_sockaddr_u(54321, "11.22.0.0");
+	sockaddr_u resmask = create_sockaddr_u(54321, "255.255.0.0");
+	sockaddr_u client = create_sockaddr_u(54321, "11.22.33.44");
+	sockaddr_u server = create_sockaddr_u(NTP_PORT, "11.22.33.44");
+
+	hack_restrict(RESTRICT_FLAGS, &resaddr, &resmask, 0, 11);
+	hack_restrict(RESTRICT_FLAGS, &resaddr, &resmask, RESM_NTPONLY, 22);
+
+	TEST_ASSERT_EQUAL(11, restrictions(&client));
+	TEST_ASSERT_EQUAL(22, restrictions(&server));
+}
+
+
+TEST(hackrestrict, LongestPrefixWinsAfterRemoval) {
+	sockaddr_u addr8 = create_sockaddr_u(54321, "10.0.0.0");
+	sockaddr_u mask8 = create_sockaddr_u(54321, "255.0.0.0");
+	sockaddr_u addr24 = create_sockaddr_u(54321, "10.1.2.0");
+	sockaddr_u mask24 = create_sockaddr_u(54321, "255.255.255.0");
+	sockaddr_u addr25 = create_sockaddr_u(54321, "10.1.2.128");
+	sockaddr_u mask25 = create_sockaddr_u(54321, "255.255.255.128");
+	sockaddr_u low = create_sockaddr_u(54321, "10.1.2.3");
+	sockaddr_u high = create_sockaddr_u(54321, "10.1.2.200");
+	sockaddr_u other = create_sockaddr_u(54321, "10.9.9.9");
+
+	hack_restrict(RESTRICT_FLAGS, &addr25, &mask25, 0, 25);
+	hack_restrict(RESTRICT_FLAGS, &addr8, &mask8, 0, 8);
+	hack_restrict(RESTRICT_FLAGS, &addr24, &mask24, 0, 24);
+
+	TEST_ASSERT_EQUAL(24, restrictions(&low));
+	TEST_ASSERT_EQUAL(25, restrictions(&high));
+	TEST_ASSERT_EQUAL(8, restrictions(&other));
+
+	hack_restrict(RESTRICT_REMOVE, &addr24, &mask24, 0, 0);
+
+	TEST_ASSERT_EQUAL(8, restrictions(&low));
+	TEST_ASSERT_EQUAL(25, restrictions(&high));
+
+	hack_restrict(RESTRICT_REMOVE, &addr25, &mask25, 0, 0);
+	hack_restrict(RESTRICT_REMOVE, &addr8, &mask8, 0, 0);
+
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&high));
+}
+
+
+TEST(hackrestrict, RemovedEntryOutlivesLookups) {
+	sockaddr_u addr = create_sockaddr_u(54321, "10.1.2.0");
+	sockaddr_u mask = create_sockaddr_u(54321, "255.255.255.0");
+	sockaddr_u host = create_sockaddr_u(54321, "10.1.2.3");
+	restrict_u *res;
+
+	restrict_readers(1);
+	hack_restrict(RESTRICT_FLAGS, &addr, &mask, 0, 24);
+	res = rstrct.restrictlist4;
+	TEST_ASSERT_EQUAL(24, res->flags);
+
+	/* a worker may be looking at it while it goes */
+	restrict_online(0);
+	hack_restrict(RESTRICT_REMOVE, &addr, &mask, 0, 0);
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&host));
+	check_restrict_file(false);
+	check_restrict_file(false);
+	TEST_ASSERT_EQUAL(24, res->flags);
+
+	/* freed once it has let go */
+	restrict_offline(0);
+	check_restrict_file(false);
+	TEST_ASSERT_EQUAL(0, res->flags);
+	restrict_readers(0);
+}
+
+
+TEST(hackrestrict, OddMaskIsStillMatched) {
+	/* not a prefix, so lookups fall back to the list */
+	sockaddr_u resaddr = create_sockaddr_u(54321, "11.0.33.0");
+	sockaddr_u resmask = create_sockaddr_u(54321, "255.0.255.0");
+	sockaddr_u prefaddr = create_sockaddr_u(54321, "11.22.0.0");
+	sockaddr_u prefmask = create_sockaddr_u(54321, "255.255.0.0");
+	sockaddr_u target = create_sockaddr_u(54321, "11.22.33.44");
+
+	hack_restrict(RESTRICT_FLAGS, &prefaddr, &prefmask, 0, 22);
+	hack_restrict(RESTRICT_FLAGS, &resaddr, &resmask, 0, 33);
+
+	TEST_ASSERT_EQUAL(22, restrictions(&target));
+
+	hack_restrict(RESTRICT_REMOVE, &prefaddr, &prefmask, 0, 0);
+
+	TEST_ASSERT_EQUAL(33, restrictions(&target));
+}
+
+
+TEST(hackrestrict, Ipv6MostFittingRestrictionIsMatched) {
+	sockaddr_u addr32 = create_sockaddr6_u(54321, "2001:db8::");
+	sockaddr_u mask32 = create_sockaddr6_u(54321, "ffff:ffff::");
+	sockaddr_u addr64 = create_sockaddr6_u(54321, "2001:db8:1:2::");
+	sockaddr_u mask64 = create_sockaddr6_u(54321, "ffff:ffff:ffff:ffff::");
+	sockaddr_u inside = create_sockaddr6_u(54321, "2001:db8:1:2::99");
+	sockaddr_u beside = create_sockaddr6_u(54321, "2001:db8:1:3::99");
+	sockaddr_u outside = create_sockaddr6_u(54321, "2001:db9::1");
+
+	hack_restrict(RESTRICT_FLAGS, &addr32, &mask32, 0, 32);
+	hack_restrict(RESTRICT_FLAGS, &addr64, &mask64, 0, 64);
+
+	TEST_ASSERT_EQUAL(64, restrictions(&inside));
+	TEST_ASSERT_EQUAL(32, restrictions(&beside));
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&outside));
+}
+
+
+/* what the list walk finds, for checking the lookup against */
+static unsigned short
+list_restrictions(uint32_t addr, unsigned short port)
+{
+	restrict_u *res;
+
+	for (res = rstrct.restrictlist4; res != NULL; res = res->link)
+		if (res->u.v4.addr == (addr & res->u.v4.mask)
+		    && (!(RESM_NTPONLY & res->mflags) || NTP_PORT == port))
+			return res->flags;
+	return 0;
+}
+
+
+TEST(hackrestrict, LookupAgreesWithListWalk) {
+	static uint32_t addrs[2000], masks[2000];
+	sockaddr_u resaddr, resmask, target;
+	uint32_t addr;
+	unsigned short port, mflags;
+	int i, j;
+
+	srand(1234);
+	for (i = 0; i < 2000; i++) {
+		/* crowd a few /8s so the prefixes nest */
+		addrs[i] = ((uint32_t)(rand() % 4) << 24) |
+			   ((uint32_t)rand() & 0xffffff);
+		masks[i] = ~(uint32_t)0 << (rand() % 25);
+		j = (i % 5) ? i : rand() % (i + 1);	/* remove an old one */
+		mflags = (j % 3) ? 0 : RESM_NTPONLY;
+		resaddr = create_sockaddr_u(54321, "0.0.0.0");
+		resmask = create_sockaddr_u(54321, "0.0.0.0");
+		PSOCK_ADDR4(&resaddr)->s_addr = htonl(addrs[j]);
+		PSOCK_ADDR4(&resmask)->s_addr = htonl(masks[j]);
+		hack_restrict((i == j) ? RESTRICT_FLAGS : RESTRICT_REMOVE,
+			      &resaddr, &resmask, mflags,
+			      (unsigned short)(j & 0x3fff));
+	}
+	for (i = 0; i < 2000; i++) {
+		addr = ((uint32_t)(rand() % 4) << 24) |
+		       ((uint32_t)rand() & 0xffffff);
+		port = (i % 2) ? NTP_PORT : 54321;
+		target = create_sockaddr_u(port, "0.0.0.0");
+		PSOCK_ADDR4(&target)->s_addr = htonl(addr);
+		TEST_ASSERT_EQUAL(list_restrictions(addr, port),
+				  restrictions(&target));
+	}
+}
+
+
+TEST(hackrestrict, RestrictFileIsLoadedAndSwapped) {
+	char path[] = "/tmp/ntp_restrict_XXXXXX";
+	sockaddr_u listed = create_sockaddr_u(54321, "192.0.2.77");
+	sockaddr_u relisted = create_sockaddr_u(54321, "198.51.100.1");
+	sockaddr_u listed6 = create_sockaddr6_u(54321, "2001:db8::1");
+	FILE *fp;
+	int fd;
+
+	fd = mkstemp(path);
+	TEST_ASSERT_TRUE(fd >= 0);
+	fp = fdopen(fd, "w");
+	fputs("# blocklist\n"
+	      "192.0.2.0/24 ignore\n"
+	      "192.0.2.0/24 kod	# merged with the line above\n"
+	      "not-an-address ignore\n"
+	      "2001:db8::/32\n", fp);
+	fclose(fp);
+
+	restrict_file(path, 0, RES_NOQUERY);
+	TEST_ASSERT_EQUAL(RES_IGNORE|RES_KOD|RES_NOQUERY, restrictions(&listed));
+	TEST_ASSERT_EQUAL(RES_NOQUERY, restrictions(&listed6));
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&relisted));
+
+	fp = fopen(path, "w");
+	fputs("198.51.100.0/24 noserve\n", fp);
+	fclose(fp);
+
+	check_restrict_file(true);
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&listed));
+	TEST_ASSERT_EQUAL(RES_Default, restrictions(&listed6));
+	TEST_ASSERT_EQUAL(RES_NOSERVE|RES_NOQUERY, restrictions(&relisted));
+
+	/* a missing file leaves things as they were */
+	unlink(path);
+	check_restrict_file(true);
+	TEST_ASSERT_EQUAL(RES_NOSERVE|RES_NOQUERY, restrictions(&relisted));
+}
+
+
+TEST(hackrestrict, RestrictFileMergesWithConfig) {
+	char path[] = "/tmp/ntp_restrict_XXXXXX";
+	char other[] = "/tmp/ntp_restrict_XXXXXX";
+	sockaddr_u resaddr = create_sockaddr_u(0, "192.0.2.0");
+	sockaddr_u resmask = create_sockaddr_u(0, "255.255.255.0");
+	sockaddr_u host = create_sockaddr_u(54321, "192.0.2.77");
+	sockaddr_u near = create_sockaddr_u(54321, "192.0.2.1");
+	sockaddr_u far = create_sockaddr_u(54321, "192.0.3.1");
+	FILE *fp;
+	int fd;
+
+	fd = mkstemp(path);
+	TEST_ASSERT_TRUE(fd >= 0);
+	fp = fdopen(fd, "w");
+	fputs("192.0.2.77 ignore\n"
+	      "192.0.0.0/16 noserve\n", fp);
+	fclose(fp);
+	fd = mkstemp(other);
+	TEST_ASSERT_TRUE(fd >= 0);
+	fp = fdopen(fd, "w");
+	fputs("192.0.2.1 ignore\n", fp);
+	fclose(fp);
+
+	/* the more specific entry wins, wherever it came from */
+	hack_restrict(RESTRICT_FLAGS, &resaddr, &resmask, 0, RES_KOD);
+	restrict_file(path, 0, 0);
+	TEST_ASSERT_EQUAL(RES_IGNORE, restrictions(&host));
+	TEST_ASSERT_EQUAL(RES_KOD, restrictions(&near));
+	TEST_ASSERT_EQUAL(RES_NOSERVE, restrictions(&far));
+	TEST_ASSERT_NOT_NULL(restrict_file_list(false));
+	TEST_ASSERT_NULL(restrict_file_list(true));
+
+	/* a second file is turned away */
+	restrict_file(other, 0, 0);
+	check_restrict_file(true);
+	TEST_ASSERT_EQUAL(RES_KOD, restrictions(&near));
+
+	unlink(path);
+	unlink(other);
+}
+
 TEST_GROUP_RUNNER(hackrestrict) {
 	RUN_TEST_CASE(hackrestrict, RestrictionsAreEmptyAfterInit);
 	RUN_TEST_CASE(hackrestrict, ReturnsCorrectDefaultRestrictions);
@@ -193,4 +446,12 @@ TEST_GROUP_RUNNER(hackrestrict) {
 	RUN_TEST_CASE(hackrestrict, TheMostFittingRestrictionIsMatched);
 	RUN_TEST_CASE(hackrestrict, DeletedRestrictionIsNotMatched);
 	RUN_TEST_CASE(hackrestrict, RestrictUnflagWorks);
+	RUN_TEST_CASE(hackrestrict, NtpOnlyMatchesOnlyNtpPort);
+	RUN_TEST_CASE(hackrestrict, LongestPrefixWinsAfterRemoval);
+	RUN_TEST_CASE(hackrestrict, RemovedEntryOutlivesLookups);
+	RUN_TEST_CASE(hackrestrict, OddMaskIsStillMatched);
+	RUN_TEST_CASE(hackrestrict, Ipv6MostFittingRestrictionIsMatched);
+	RUN_TEST_CASE(hackrestrict, LookupAgreesWithListWalk);
+	RUN_TEST_CASE(hackrestrict, RestrictFileIsLoadedAndSwapped);
+	RUN_TEST_CASE(hackrestrict, RestrictFileMergesWithConfig);
 }
@@ -630,7 +630,7 @@ class TestMisc(unittest.TestCase):
                              "'addr': '11.22.33.44:23', 'rs': None, "
                              "'mv': None, 'sc': '0.12345', "
                              "'first': '0x00000100.00000000', "
-                             "'dr': None, 'ct': 4>")
+                             "'dr': None, 'ct': 4, 'pf': None>")
         elif sys.version_info[1] >= 6:  # Already know it is 3.something
             # Python 3.6+, dicts enumerate in assignment order
             self.assertEqual(cls.__repr__(),
@@ -638,7 +638,7 @@ class TestMisc(unittest.TestCase):
                              "'last': '0x00000200.00000000', "
                              "'first': '0x00000100.00000000', "
                              "'mv': None, 'rs': None, 'ct': 4, "
-                             "'sc': '0.12345', 'dr': None>")
+                             "'sc': '0.12345', 'dr': None, 'pf': None>")
         else:
             # Python 3.x < 3.6, dicts enumerate randomly
             # I can not test randomness of this type
@@ -937,6 +937,16 @@ class TestPylibUtilMethods(unittest.TestCase):
             self.assertEqual(cls.summary(ent),
                              "64730 23808    256   20 L 7 2     65"
                              "        -      -    42 foo.com")
+            # Test summary, limited for its prefix
+            mycache._cache = {}
+            ent.pf = 1
+            fakesockmod.gai_returns = [[("fam", "type", "proto",
+                                         "foo.bar.com", ("1.2.3.4", 42))]]
+            cdns_jig_returns = ["foo.com"]
+            self.assertEqual(cls.summary(ent),
+                             "64730 23808    256   20 l 7 2     65"
+                             "        -      -    42 foo.com")
+            ent.pf = None
             # Test summary, third options
             mycache._cache = {}
             ent.ct = 2
@@ -58,6 +58,8 @@ ext, ffi, or none. defaults to ffi.""", nargs=1)
                    help="Enable leaps on other than 1st of month.")
     grp.add_option('--enable-mssntp', action='store_true',
                    default=False, help="Enable Samba MS SNTP support.")
+    grp.add_option('--disable-io-uring', action='store_true',
+                   default=False, help="Disable the io_uring network path.")
 
     grp = ctx.add_option_group("Refclock configure options")
     grp.add_option(